@@ -1,9 +1,13 @@
 import argparse
+import csv
 import glob
+import hashlib
+import json
 import sys
 import os
 import subprocess
 import multiprocessing
+import time
 from functools import partial
 
 def is_game_path(path):
@@ -15,44 +19,128 @@ def is_game_path(path):
     return extension in ["cue", "chd"]
 
 
-def run_regression_test(runner, destdir, dump_interval, frames, renderer, cargs, gamepath):
+def load_manifest(path, default_frames):
+    # One game per line, as "path[,frames]". Blank lines and lines starting with # are ignored.
+    games = []
+    with open(path, "r", newline="") as f:
+        for row in csv.reader(f):
+            if len(row) == 0 or row[0].strip() == "" or row[0].lstrip().startswith("#"):
+                continue
+
+            gamepath = os.path.realpath(os.path.join(os.path.dirname(path), row[0].strip()))
+            frames = int(row[1]) if len(row) > 1 and row[1].strip() != "" else default_frames
+            games.append((gamepath, frames))
+
+    return games
+
+
+def run_regression_test(runner, destdir, dump_interval, renderer, cargs, reportdir, hashdir, goldendir, timeout, game):
+    gamepath, frames = game
     args = [runner,
             "-log", "error",
-            "-dumpdir", destdir,
             "-dumpinterval", str(dump_interval),
             "-frames", str(frames),
             "-renderer", ("Software" if renderer is None else renderer),
     ]
+    if destdir is not None:
+        args += ["-dumpdir", destdir]
+
+    reportpath = None
+    if reportdir is not None:
+        # Prefixed with the path hash, since different directories can contain images with the same name.
+        pathhash = hashlib.md5(gamepath.encode("utf-8")).hexdigest()[:8]
+        reportpath = os.path.join(reportdir, "%s_%s.json" % (pathhash, os.path.basename(gamepath)))
+        if os.path.isfile(reportpath):
+            os.remove(reportpath)
+        args += ["-report", reportpath]
+
+    # Hash logs are named after the image, so a golden set can be reused with the same games.
+    if hashdir is not None:
+        args += ["-hashlog", os.path.join(hashdir, "%s.hashes" % os.path.basename(gamepath))]
+    if goldendir is not None:
+        goldenpath = os.path.join(goldendir, "%s.hashes" % os.path.basename(gamepath))
+        if os.path.isfile(goldenpath):
+            args += ["-golden", goldenpath]
+
     args += cargs
     args += ["--", gamepath]
 
     print("Running '%s'" % (" ".join(args)))
-    subprocess.run(args)
-
-
-def run_regression_tests(runner, gamedir, destdir, dump_interval, frames, parallel, renderer, cargs):
-    paths = glob.glob(gamedir + "/*.*", recursive=True)
-    gamepaths = list(filter(is_game_path, paths))
+    start_time = time.monotonic()
+    try:
+        returncode = subprocess.run(args, timeout=timeout).returncode
+    except subprocess.TimeoutExpired:
+        returncode = None
+    wall_time = time.monotonic() - start_time
+
+    result = {"path": gamepath, "requested_frames": frames, "returncode": returncode, "wall_time": round(wall_time, 3)}
+    if reportpath is not None and os.path.isfile(reportpath):
+        try:
+            with open(reportpath, "r") as f:
+                result.update(json.load(f))
+        except (OSError, ValueError):
+            pass
+
+    # The runner only writes a report if it exits normally, so anything else is a crash or hang.
+    if returncode is None:
+        result["status"] = "timeout"
+    elif "status" not in result:
+        result["status"] = "crashed"
+
+    return result
+
+
+def write_report(path, results):
+    if path.lower().endswith(".json"):
+        with open(path, "w") as f:
+            json.dump(results, f, indent=2)
+        return
+
+    fields = ["path", "status", "returncode", "serial", "title", "renderer", "requested_frames", "frames", "elapsed",
+              "wall_time", "fps", "speed", "golden_mismatches", "first_golden_mismatch", "hashes"]
+    with open(path, "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=fields, extrasaction="ignore")
+        writer.writeheader()
+        for result in results:
+            row = dict(result)
+            row["hashes"] = " ".join("%d:%s" % (h["frame"], h["hash"]) for h in result.get("hashes", []))
+            writer.writerow(row)
+
+
+def run_regression_tests(runner, games, destdir, dump_interval, parallel, renderer, cargs, report, hashdir, goldendir,
+                         timeout):
+    gamepaths = [game[0] for game in games]
+
+    reportdir = None
+    if report is not None:
+        reportdir = os.path.join(os.path.dirname(report), "%s.runs" % os.path.basename(report))
 
     try:
-        if not os.path.isdir(destdir):
-            os.mkdir(destdir)
+        for dirpath in (destdir, reportdir, hashdir):
+            if dirpath is not None and not os.path.isdir(dirpath):
+                os.mkdir(dirpath)
     except OSError:
         print("Failed to create directory")
         return False
 
     print("Found %u games" % len(gamepaths))
 
+    func = partial(run_regression_test, runner, destdir, dump_interval, renderer, cargs, reportdir, hashdir, goldendir,
+                   timeout)
     if parallel <= 1:
-        for game in gamepaths:
-            run_regression_test(runner, destdir, dump_interval, frames, renderer, cargs, game)
+        results = [func(game) for game in games]
     else:
         print("Processing %u games on %u processors" % (len(gamepaths), parallel))
-        func = partial(run_regression_test, runner, destdir, dump_interval, frames, renderer, cargs)
         pool = multiprocessing.Pool(parallel)
-        pool.map(func, gamepaths, chunksize=1)
+        results = pool.map(func, games, chunksize=1)
         pool.close()
 
+    if report is not None:
+        write_report(report, results)
+        failed = [result for result in results if result["status"] != "ok"]
+        print("%u of %u games passed, report written to '%s'" % (len(results) - len(failed), len(results), report))
+        for result in failed:
+            print("  %s: %s" % (result["status"], result["path"]))
 
     return True
 
@@ -60,8 +148,13 @@ def run_regression_tests(runner, gamedir, destdir, dump_interval, frames, parall
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(description="Generate frame dump images for regression tests")
     parser.add_argument("-runner", action="store", required=True, help="Path to DuckStation regression test runner")
-    parser.add_argument("-gamedir", action="store", required=True, help="Directory containing game images")
-    parser.add_argument("-destdir", action="store", required=True, help="Base directory to dump frames to")
+    parser.add_argument("-gamedir", action="store", help="Directory containing game images")
+    parser.add_argument("-manifest", action="store", help="File listing game images and optional frame counts, as path[,frames]")
+    parser.add_argument("-destdir", action="store", help="Base directory to dump frames to")
+    parser.add_argument("-report", action="store", help="Write a combined report of all games, JSON if the name ends in .json, otherwise CSV")
+    parser.add_argument("-hashdir", action="store", help="Directory to write per-frame hash logs to")
+    parser.add_argument("-goldendir", action="store", help="Directory of hash logs to compare against, only divergent frames are dumped")
+    parser.add_argument("-timeout", action="store", type=int, help="Seconds after which a game is considered hung")
     parser.add_argument("-dumpinterval", action="store", type=int, default=600, help="Interval to dump frames at")
     parser.add_argument("-frames", action="store", type=int, default=36000, help="Number of frames to run")
     parser.add_argument("-parallel", action="store", type=int, default=1, help="Number of processes to run")
@@ -70,8 +163,22 @@ if __name__ == "__main__":
     parser.add_argument("-pgxp", action="store_true", help="Enable PGXP")
     parser.add_argument("-pgxpcpu", action="store_true", help="Enable PGXP CPU mode")
     parser.add_argument("-cpu", action="store", help="CPU execution mode")
+    parser.add_argument("-followjumps", action="store_true", help="Continue recompiler blocks through short forward jumps")
+    parser.add_argument("-compilethreshold", action="store", type=int, help="Interpret blocks this many times before recompiling them")
+    parser.add_argument("-superblocks", action="store_true", help="Continue recompiler blocks through jumps and biased branches")
 
     args = parser.parse_args()
+    if (args.gamedir is None) == (args.manifest is None):
+        parser.error("exactly one of -gamedir or -manifest is required")
+    if args.destdir is None and args.report is None and args.hashdir is None:
+        parser.error("at least one of -destdir, -report or -hashdir is required")
+
+    if args.manifest is not None:
+        games = load_manifest(os.path.realpath(args.manifest), args.frames)
+    else:
+        paths = glob.glob(os.path.realpath(args.gamedir) + "/*.*", recursive=True)
+        games = [(path, args.frames) for path in filter(is_game_path, paths)]
+
     cargs = []
     if (args.upscale is not None):
         cargs += ["-upscale", str(args.upscale)]
@@ -81,8 +188,18 @@ if __name__ == "__main__":
         cargs += ["-pgxp-cpu"]
     if (args.cpu is not None):
         cargs += ["-cpu", args.cpu]
-
-    if not run_regression_tests(args.runner, os.path.realpath(args.gamedir), os.path.realpath(args.destdir), args.dumpinterval, args.frames, args.parallel, args.renderer, cargs):
+    if (args.followjumps):
+        cargs += ["-followjumps"]
+    if (args.compilethreshold is not None):
+        cargs += ["-compilethreshold", str(args.compilethreshold)]
+    if (args.superblocks):
+        cargs += ["-superblocks"]
+
+    destdir = os.path.realpath(args.destdir) if args.destdir is not None else None
+    report = os.path.realpath(args.report) if args.report is not None else None
+    hashdir = os.path.realpath(args.hashdir) if args.hashdir is not None else None
+    goldendir = os.path.realpath(args.goldendir) if args.goldendir is not None else None
+    if not run_regression_tests(args.runner, games, destdir, args.dumpinterval, args.parallel, args.renderer, cargs, report, hashdir, goldendir, args.timeout):
         sys.exit(1)
     else:
         sys.exit(0)
@@ -11,7 +11,8 @@
 
 #if defined(_WIN32)
 #include "windows_headers.h"
-#elif !defined(__ANDROID__)
+#include <io.h>
+#else
 #include <cerrno>
 #include <fcntl.h>
 #include <sys/mman.h>
@@ -404,6 +405,46 @@ bool SharedMemoryMappingArea::Unmap(void* map_base, size_t map_size)
 
 #endif
 
+#ifdef _WIN32
+
+const void* MemMap::MapFileReadOnly(std::FILE* fp, size_t size)
+{
+  const HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(fp)));
+  if (file == INVALID_HANDLE_VALUE)
+    return nullptr;
+
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping)
+    return nullptr;
+
+  // The view keeps the mapping alive.
+  const void* ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+  CloseHandle(mapping);
+  return ptr;
+}
+
+void MemMap::UnmapFile(const void* ptr, size_t size)
+{
+  if (!UnmapViewOfFile(ptr))
+    Panic("Failed to unmap file");
+}
+
+#else
+
+const void* MemMap::MapFileReadOnly(std::FILE* fp, size_t size)
+{
+  void* ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+  return (ptr != MAP_FAILED) ? ptr : nullptr;
+}
+
+void MemMap::UnmapFile(const void* ptr, size_t size)
+{
+  if (munmap(const_cast<void*>(ptr), size) != 0)
+    Panic("Failed to unmap file");
+}
+
+#endif
+
 #if defined(__APPLE__) && defined(__aarch64__)
 
 static thread_local int s_code_write_depth = 0;
@@ -5,6 +5,7 @@
 
 #include "types.h"
 
+#include <cstdio>
 #include <map>
 #include <string>
 
@@ -42,6 +43,10 @@ void* MapSharedMemory(void* handle, size_t offset, void* baseaddr, size_t size,
 void UnmapSharedMemory(void* baseaddr, size_t size);
 bool MemProtect(void* baseaddr, size_t size, PageProtect mode);
 
+/// Maps the first size bytes of an open file for reading. The file can be closed once it is mapped.
+const void* MapFileReadOnly(std::FILE* fp, size_t size);
+void UnmapFile(const void* ptr, size_t size);
+
 /// JIT write protect for Apple Silicon. Needs to be called prior to writing to any RWX pages.
 #if !defined(__APPLE__) || !defined(__aarch64__)
 // clang-format off
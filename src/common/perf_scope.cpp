@@ -4,6 +4,7 @@
 
 #include "perf_scope.h"
 #include "assert.h"
+#include "log.h"
 #include "string_util.h"
 
 #include <array>
@@ -11,6 +12,7 @@
 
 #ifdef __linux__
 #include <atomic>
+#include <cerrno>
 #include <ctime>
 #include <elf.h>
 #include <mutex>
@@ -19,6 +21,8 @@
 #include <unistd.h>
 #endif
 
+Log_SetChannel(PerfScope);
+
 // #define ProfileWithPerf
 // #define ProfileWithPerfJitDump
 
@@ -49,7 +53,21 @@ static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
   std::fflush(s_map_file);
 }
 
-#elif defined(__linux__) && defined(ProfileWithPerfJitDump)
+static bool IsRegistrationActive()
+{
+  return true;
+}
+
+bool PerfScope::OpenJitDump(const char* directory)
+{
+  return false;
+}
+
+void PerfScope::CloseJitDump()
+{
+}
+
+#elif defined(__linux__)
 enum : u32
 {
   JIT_CODE_LOAD = 0,
@@ -98,10 +116,75 @@ static u64 JitDumpTimestamp()
 }
 
 static FILE* s_jitdump_file = nullptr;
+static void* s_jitdump_marker = nullptr;
 static bool s_jitdump_file_opened = false;
+static std::atomic_bool s_jitdump_active{false};
 static std::mutex s_jitdump_mutex;
 static u32 s_jitdump_record_id;
 
+static bool OpenJitDumpFile(const char* directory)
+{
+  char file[256];
+  snprintf(file, std::size(file), "%s/jit-%d.dump", directory, getpid());
+  s_jitdump_file = fopen(file, "w+b");
+  s_jitdump_file_opened = true;
+  if (!s_jitdump_file)
+  {
+    Log_ErrorPrintf("Failed to open jitdump file '%s': %d", file, errno);
+    return false;
+  }
+
+  // perf record picks up the file through this mapping.
+  s_jitdump_marker = mmap(nullptr, 4096, PROT_READ | PROT_EXEC, MAP_PRIVATE, fileno(s_jitdump_file), 0);
+  if (s_jitdump_marker == MAP_FAILED)
+  {
+    Log_ErrorPrintf("Failed to map perf marker for '%s': %d", file, errno);
+    s_jitdump_marker = nullptr;
+    std::fclose(s_jitdump_file);
+    s_jitdump_file = nullptr;
+    return false;
+  }
+
+  JITDUMP_HEADER jh = {};
+#if defined(__aarch64__)
+  jh.elf_mach = EM_AARCH64;
+#else
+  jh.elf_mach = EM_X86_64;
+#endif
+  jh.pid = getpid();
+  jh.timestamp = JitDumpTimestamp();
+  std::fwrite(&jh, sizeof(jh), 1, s_jitdump_file);
+  s_jitdump_active.store(true, std::memory_order_release);
+  return true;
+}
+
+static void CloseJitDumpFile()
+{
+  if (!s_jitdump_file)
+    return;
+
+  JITDUMP_RECORD_HEADER rh = {};
+  rh.id = JIT_CODE_CLOSE;
+  rh.total_size = sizeof(rh);
+  rh.timestamp = JitDumpTimestamp();
+  std::fwrite(&rh, sizeof(rh), 1, s_jitdump_file);
+
+  munmap(s_jitdump_marker, 4096);
+  s_jitdump_marker = nullptr;
+  std::fclose(s_jitdump_file);
+  s_jitdump_file = nullptr;
+  s_jitdump_active.store(false, std::memory_order_release);
+}
+
+static bool IsRegistrationActive()
+{
+#ifdef ProfileWithPerfJitDump
+  return true;
+#else
+  return s_jitdump_active.load(std::memory_order_acquire);
+#endif
+}
+
 static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
 {
   const u32 namelen = std::strlen(symbol) + 1;
@@ -109,28 +192,12 @@ static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
   std::unique_lock lock(s_jitdump_mutex);
   if (!s_jitdump_file)
   {
-    if (!s_jitdump_file_opened)
-    {
-      char file[256];
-      snprintf(file, std::size(file), "jit-%d.dump", getpid());
-      s_jitdump_file = fopen(file, "w+b");
-      s_jitdump_file_opened = true;
-      if (!s_jitdump_file)
-        return;
-    }
-
-    void* perf_marker = mmap(nullptr, 4096, PROT_READ | PROT_EXEC, MAP_PRIVATE, fileno(s_jitdump_file), 0);
-    AssertMsg(perf_marker != MAP_FAILED, "Map perf marker");
-
-    JITDUMP_HEADER jh = {};
-#if defined(__aarch64__)
-    jh.elf_mach = EM_AARCH64;
+#ifdef ProfileWithPerfJitDump
+    if (s_jitdump_file_opened || !OpenJitDumpFile("."))
+      return;
 #else
-    jh.elf_mach = EM_X86_64;
+    return;
 #endif
-    jh.pid = getpid();
-    jh.timestamp = JitDumpTimestamp();
-    std::fwrite(&jh, sizeof(jh), 1, s_jitdump_file);
   }
 
   JITDUMP_CODE_LOAD cl = {};
@@ -149,12 +216,28 @@ static void RegisterMethod(const void* ptr, size_t size, const char* symbol)
   std::fflush(s_jitdump_file);
 }
 
+bool PerfScope::OpenJitDump(const char* directory)
+{
+  std::unique_lock lock(s_jitdump_mutex);
+  CloseJitDumpFile();
+  return OpenJitDumpFile(directory);
+}
+
+void PerfScope::CloseJitDump()
+{
+  std::unique_lock lock(s_jitdump_mutex);
+  CloseJitDumpFile();
+}
+
 #endif
 
-#if defined(__linux__) && (defined(ProfileWithPerf) || defined(ProfileWithPerfJitDump))
+#ifdef __linux__
 
 void PerfScope::Register(const void* ptr, size_t size, const char* symbol)
 {
+  if (!IsRegistrationActive())
+    return;
+
   char full_symbol[128];
   if (HasPrefix())
     std::snprintf(full_symbol, std::size(full_symbol), "%s_%s", m_prefix, symbol);
@@ -165,6 +248,9 @@ void PerfScope::Register(const void* ptr, size_t size, const char* symbol)
 
 void PerfScope::RegisterPC(const void* ptr, size_t size, u32 pc)
 {
+  if (!IsRegistrationActive())
+    return;
+
   char full_symbol[128];
   if (HasPrefix())
     std::snprintf(full_symbol, std::size(full_symbol), "%s_%08X", m_prefix, pc);
@@ -175,6 +261,9 @@ void PerfScope::RegisterPC(const void* ptr, size_t size, u32 pc)
 
 void PerfScope::RegisterKey(const void* ptr, size_t size, const char* prefix, u64 key)
 {
+  if (!IsRegistrationActive())
+    return;
+
   char full_symbol[128];
   if (HasPrefix())
     std::snprintf(full_symbol, std::size(full_symbol), "%s_%s%016" PRIX64, m_prefix, prefix, key);
@@ -195,4 +284,13 @@ void PerfScope::RegisterKey(const void* ptr, size_t size, const char* prefix, u6
 {
 }
 
+bool PerfScope::OpenJitDump(const char* directory)
+{
+  return false;
+}
+
+void PerfScope::CloseJitDump()
+{
+}
+
 #endif
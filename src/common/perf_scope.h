@@ -15,6 +15,11 @@ public:
   void RegisterPC(const void* ptr, size_t size, u32 pc);
   void RegisterKey(const void* ptr, size_t size, const char* prefix, u64 key);
 
+  /// Starts writing registered code to a jitdump file in the specified directory, for use with perf inject. The file
+  /// is named jit-<pid>.dump, as perf expects. Only supported on Linux.
+  static bool OpenJitDump(const char* directory);
+  static void CloseJitDump();
+
 private:
   const char* m_prefix;
 };
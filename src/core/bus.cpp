@@ -365,7 +365,7 @@ void Bus::AddTTYString(const std::string_view& str)
     AddTTYCharacter(ch);
 }
 
-bool Bus::DoState(StateWrapper& sw)
+bool Bus::DoState(StateWrapper& sw, bool include_ram)
 {
   u32 ram_size = g_ram_size;
   sw.DoEx(&ram_size, 52, static_cast<u32>(RAM_2MB_SIZE));
@@ -382,7 +382,8 @@ bool Bus::DoState(StateWrapper& sw)
   sw.Do(&g_bios_access_time);
   sw.Do(&g_cdrom_access_time);
   sw.Do(&g_spu_access_time);
-  sw.DoBytes(g_ram, g_ram_size);
+  if (include_ram)
+    sw.DoBytes(g_ram, g_ram_size);
 
   if (sw.GetVersion() < 58)
   {
@@ -9,6 +9,7 @@
 #include "interrupt_controller.h"
 #include "settings.h"
 #include "spu.h"
+#include "subsystem_profiler.h"
 #include "system.h"
 
 #include "util/cd_image.h"
@@ -220,7 +221,6 @@ static void SoftReset(TickCount ticks_late);
 
 static bool IsDriveIdle();
 static bool IsMotorOn();
-static bool IsSeeking();
 static bool IsReadingOrPlaying();
 static bool CanReadMedia();
 static bool HasPendingCommand();
@@ -443,6 +443,7 @@ void CDROM::Initialize()
                                                             &CDROM::DeliverAsyncInterrupt, nullptr, false);
   s_drive_event = TimingEvents::CreateTimingEvent("CDROM Drive Event", 1, 1, &CDROM::ExecuteDrive, nullptr, false);
 
+  s_reader.SetReadCacheParameters(g_settings.cdrom_chd_hunk_cache_size, g_settings.cdrom_chd_prefetch_hunks);
   if (g_settings.cdrom_readahead_sectors > 0)
     s_reader.StartThread(g_settings.cdrom_readahead_sectors);
 
@@ -842,6 +843,11 @@ void CDROM::SetReadaheadSectors(u32 readahead_sectors)
     s_reader.QueueReadSector(s_requested_lba);
 }
 
+void CDROM::SetReadCacheParameters(u32 cache_blocks, u32 prefetch_blocks)
+{
+  s_reader.SetReadCacheParameters(cache_blocks, prefetch_blocks);
+}
+
 void CDROM::CPUClockChanged()
 {
   // reschedule the disc read event
@@ -1420,6 +1426,8 @@ void CDROM::EndCommand()
 
 void CDROM::ExecuteCommand(void*, TickCount ticks, TickCount ticks_late)
 {
+  SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::CDROM);
+
   const CommandInfo& ci = s_command_info[static_cast<u8>(s_command)];
   if (Log_DevVisible()) [[unlikely]]
   {
@@ -2129,6 +2137,8 @@ void CDROM::ExecuteTestCommand(u8 subcommand)
 
 void CDROM::ExecuteCommandSecondResponse(void*, TickCount ticks, TickCount ticks_late)
 {
+  SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::CDROM);
+
   switch (s_command_second_response)
   {
     case Command::GetID:
@@ -2187,6 +2197,8 @@ void CDROM::UpdateCommandEvent()
 
 void CDROM::ExecuteDrive(void*, TickCount ticks, TickCount ticks_late)
 {
+  SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::CDROM);
+
   switch (s_drive_state)
   {
     case DriveState::ShellOpening:
@@ -3392,6 +3404,15 @@ void CDROM::DrawDebugWindow()
       ImGui::Text("Last Sector: %02X:%02X:%02X (Mode %u)", s_last_sector_header.minute, s_last_sector_header.second,
                   s_last_sector_header.frame, s_last_sector_header.sector_mode);
 
+      CDImage::ReadCacheStats cache_stats;
+      if (media->GetReadCacheStats(&cache_stats))
+      {
+        ImGui::Text("Read Cache: %" PRIu64 " hits, %" PRIu64 " misses, %" PRIu64 " prefetched (%" PRIu64
+                    " used, %" PRIu64 " waited)",
+                    cache_stats.hits, cache_stats.misses, cache_stats.prefetched, cache_stats.prefetch_hits,
+                    cache_stats.prefetch_waits);
+      }
+
       if (s_show_current_file)
       {
         if (media->GetTrackNumber() == 1)
@@ -25,6 +25,9 @@ bool IsMediaPS1Disc();
 bool IsMediaAudioCD();
 bool DoesMediaRegionMatchConsole();
 
+/// Returns true if the drive is currently seeking, which usually means the game is loading.
+bool IsSeeking();
+
 void InsertMedia(std::unique_ptr<CDImage> media, DiscRegion region);
 std::unique_ptr<CDImage> RemoveMedia(bool for_disc_swap);
 bool PrecacheMedia();
@@ -40,6 +43,7 @@ void DMARead(u32* words, u32 word_count);
 void DrawDebugWindow();
 
 void SetReadaheadSectors(u32 readahead_sectors);
+void SetReadCacheParameters(u32 cache_blocks, u32 prefetch_blocks);
 
 /// Reads a frame from the audio FIFO, used by the SPU.
 std::tuple<s16, s16> GetAudioFrame();
@@ -50,6 +50,8 @@ void CDROMAsyncReader::SetMedia(std::unique_ptr<CDImage> media)
     CancelReadahead();
 
   m_media = std::move(media);
+  if (m_media && m_read_cache_blocks > 0)
+    m_media->SetReadCacheParameters(m_read_cache_blocks, m_read_cache_prefetch_blocks);
 }
 
 std::unique_ptr<CDImage> CDROMAsyncReader::RemoveMedia()
@@ -99,6 +101,19 @@ bool CDROMAsyncReader::Precache(ProgressCallback* callback)
   return (res == CDImage::PrecacheResult::Success);
 }
 
+void CDROMAsyncReader::SetReadCacheParameters(u32 cache_blocks, u32 prefetch_blocks)
+{
+  m_read_cache_blocks = cache_blocks;
+  m_read_cache_prefetch_blocks = prefetch_blocks;
+
+  // The image can't be reconfigured while the read thread is using it.
+  WaitForIdle();
+
+  std::unique_lock lock(m_mutex);
+  if (m_media)
+    m_media->SetReadCacheParameters(cache_blocks, prefetch_blocks);
+}
+
 void CDROMAsyncReader::QueueReadSector(CDImage::LBA lba)
 {
   if (!IsUsingThread())
@@ -49,6 +49,9 @@ public:
   /// Precaches image, either to memory, or using the underlying image precache.
   bool Precache(ProgressCallback* callback);
 
+  /// Sets the decompressed block cache parameters for the current and any future media.
+  void SetReadCacheParameters(u32 cache_blocks, u32 prefetch_blocks);
+
   void QueueReadSector(CDImage::LBA lba);
 
   bool WaitForReadToComplete();
@@ -85,4 +88,7 @@ private:
   std::atomic<u32> m_buffer_front{0};
   std::atomic<u32> m_buffer_back{0};
   std::atomic<u32> m_buffer_count{0};
+
+  u32 m_read_cache_blocks = 0;
+  u32 m_read_cache_prefetch_blocks = 0;
 };
@@ -2,19 +2,28 @@
 // SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
 
 #include "bus.h"
+#include "cdrom.h"
 #include "cpu_code_cache_private.h"
 #include "cpu_core.h"
 #include "cpu_core_private.h"
 #include "cpu_disasm.h"
 #include "cpu_recompiler_types.h"
 #include "settings.h"
+#include "subsystem_profiler.h"
 #include "system.h"
 #include "timing_event.h"
 
+#include "common/align.h"
 #include "common/assert.h"
+#include "common/file_system.h"
 #include "common/intrin.h"
 #include "common/log.h"
 #include "common/memmap.h"
+#include "common/path.h"
+#include "common/threading.h"
+#include "common/timer.h"
+
+#include "xxhash.h"
 
 Log_SetChannel(CPU::CodeCache);
 
@@ -26,6 +35,12 @@ Log_SetChannel(CPU::CodeCache);
 #include "cpu_newrec_compiler.h"
 #endif
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <zlib.h>
 
@@ -45,6 +60,16 @@ static constexpr u32 RECOMPILE_FRAMES_FOR_INTERPRETER_FALLBACK = 15;
 static constexpr u32 INVALIDATE_COUNT_FOR_MANUAL_PROTECTION = 4;
 static constexpr u32 INVALIDATE_FRAMES_FOR_MANUAL_PROTECTION = 20;
 
+// Blocks follow at most this many forward jumps, over gaps of at most this many instructions.
+static constexpr u32 MAX_FOLLOWED_JUMPS = 8;
+static constexpr u32 MAX_JUMP_GAP_INSTRUCTIONS = 64;
+static_assert(MAX_BLOCK_EXIT_LINKS >= (2 + MAX_FOLLOWED_JUMPS), "Not enough exit links for superblock side exits");
+
+// Superblocks follow conditional branches which went the same way at least this often while they were interpreted,
+// once they've been seen enough times.
+static constexpr u32 SUPERBLOCK_MIN_BRANCH_SAMPLES = 4;
+static constexpr u32 SUPERBLOCK_BRANCH_BIAS_PERCENT = 90;
+
 static CodeLUT DecodeCodeLUTPointer(u32 slot, CodeLUT ptr);
 static CodeLUT EncodeCodeLUTPointer(u32 slot, CodeLUT ptr);
 static CodeLUT OffsetCodeLUTPointer(CodeLUT fake_ptr, u32 pc);
@@ -57,12 +82,20 @@ static void InvalidateBlock(Block* block, BlockState new_state);
 static void ClearBlocks();
 
 static Block* LookupBlock(u32 pc);
-static Block* CreateBlock(u32 pc, const BlockInstructionList& instructions, const BlockMetadata& metadata);
+static Block* CreateBlock(u32 pc, const BlockInstructionList& instructions, const BlockMetadata& metadata,
+                          Block* allocated_block = nullptr);
 static bool IsBlockCodeCurrent(const Block* block);
 static bool RevalidateBlock(Block* block);
 PageProtectionMode GetProtectionModeForPC(u32 pc);
 PageProtectionMode GetProtectionModeForBlock(const Block* block);
-static bool ReadBlockInstructions(u32 start_pc, BlockInstructionList* instructions, BlockMetadata* metadata);
+static bool ReadBlockInstructions(u32 start_pc, BlockInstructionList* instructions, BlockMetadata* metadata,
+                                  bool allow_jump_following);
+static std::optional<u32> GetFollowedBranchTarget(const Instruction& branch, const InstructionInfo& info,
+                                                  bool superblocks);
+static bool ShouldFollowJump(u32 pc, u32 target, PageProtectionMode protection, u32 page, u32 num_jumps);
+static bool GetIdleLoopInstructionRegs(const Instruction& instruction, Reg* dst, Reg* src1, Reg* src2);
+static bool IsIdleLoop(u32 start_pc, const BlockInstructionList& instructions);
+static bool IsIdleLoopReadSafe(VirtualMemoryAddress address, u32 size);
 static void FillBlockRegInfo(Block* block);
 static void CopyRegInfo(InstructionInfo* dst, const InstructionInfo* src);
 static void SetRegAccess(InstructionInfo* inst, Reg reg, bool write);
@@ -73,7 +106,7 @@ static Common::PageFaultHandler::HandlerResult ExceptionHandler(void* exception_
 
 static Block* CreateCachedInterpreterBlock(u32 pc);
 [[noreturn]] static void ExecuteCachedInterpreter();
-template<PGXPMode pgxp_mode>
+template<PGXPMode pgxp_mode, bool threaded>
 [[noreturn]] static void ExecuteCachedInterpreterImpl();
 
 // Fast map provides lookup from PC to function
@@ -84,17 +117,142 @@ static std::unique_ptr<const void*[]> s_lut_code_pointers;
 static std::unique_ptr<Block*[]> s_lut_block_pointers;
 static PageProtectionArray s_page_protection = {};
 static std::vector<Block*> s_blocks;
+static CodeBufferStats s_code_buffer_stats = {};
 
 // for compiling - reuse to avoid allocations
 static BlockInstructionList s_block_instructions;
 
+// Outcomes of the conditional branches ending blocks in the recompiler's interpreter tier, keyed by branch PC.
+struct BranchProfile
+{
+  u32 taken;
+  u32 not_taken;
+};
+static std::unordered_map<u32, BranchProfile> s_branch_profiles;
+
+// Hot blocks from previous sessions, which get compiled ahead of time. Entries are keyed by a hash of the block's
+// instructions, seeded with its PC.
+static constexpr u32 BLOCK_PROFILE_MAGIC = 0x50425344; // DSBP
+static constexpr u32 BLOCK_PROFILE_VERSION = 1;
+static constexpr u32 MAX_BLOCK_PROFILE_ENTRIES = 65536;
+static constexpr u32 PRECOMPILE_CHECKS_PER_FRAME = 256;
+static constexpr u32 PRECOMPILE_BLOCKS_PER_FRAME = 32;
+static constexpr u32 PRECOMPILE_FRAMES = 60 * 60 * 5;
+
+struct BlockProfileHeader
+{
+  u32 magic;
+  u32 version;
+  u32 num_entries;
+  u32 reserved;
+};
+
+struct BlockProfileEntry
+{
+  u64 hash;
+  u32 pc;
+  u32 size;
+};
+
+static_assert(sizeof(BlockProfileHeader) == 16 && sizeof(BlockProfileEntry) == 16);
+
+static void LoadBlockProfile();
+static void SaveBlockProfile();
+
+// Execution counts for compiled blocks, collected when CPU/RecompilerBlockStats is enabled. Keyed by PC, so that the
+// counts survive the block being recompiled.
+struct BlockStats
+{
+  u64 execution_count;
+  u32 cycles_per_execution; // estimated, one per instruction plus uncached fetch ticks
+  u32 guest_instructions;
+  u32 host_code_size;
+  u32 compile_count;
+};
+
+static constexpr u32 BLOCK_STATS_LOG_COUNT = 10;
+
+static void RecordBlockStats(const Block* block, u32 host_code_size);
+static std::vector<std::pair<u32, BlockStats>> GetSortedBlockStats(u64* total_cycles);
+static void AppendBlockStatsLine(std::string* dest, u32 pc, const BlockStats& stats, u64 total_cycles);
+static void LogBlockStats();
+
+static std::unordered_map<u32, BlockStats> s_block_stats;
+
+static std::string s_block_profile_path;
+static std::unordered_map<u64, BlockProfileEntry> s_block_profile;
+static std::vector<BlockProfileEntry> s_precompile_queue;
+static u32 s_precompile_queue_position = 0;
+static u32 s_precompile_frames_remaining = 0;
+static bool s_block_profile_dirty = false;
+static bool s_idle_loop_skipped = false;
+
 #ifdef ENABLE_RECOMPILER_SUPPORT
 
 static void BacklinkBlocks(u32 pc, const void* dst);
 static void UnlinkBlockExits(Block* block);
 
+static bool InterpretColdBlock(u32 pc);
+static void RecordBranchOutcome(const Block* block);
+static void EnsureCodeBufferSpace(u32 pc, u32 block_size);
+static u64 GetBlockProfileHash(u32 pc, const void* instructions, u32 size);
+static void RecordProfiledBlock(const Block* block);
+static bool PrecompileProfiledBlock(const BlockProfileEntry& entry);
+
+static void RegisterCompiledBlock(Block* block, u32 host_code_size, u32 host_far_code_size);
+
+// Hot blocks are compiled on a separate thread when CPU/RecompilerBackgroundCompile is enabled, and keep running in
+// the interpreter tier until they're ready. One block is compiled at a time, straight into the free area of the code
+// buffer, so the CPU thread can't allocate code while it's in flight: it has to wait for the block and install it, or
+// throw it away. The compile thread works on a block which isn't in the LUT until it's installed, and the links and
+// backpatch info it emits are collected in the job, to be registered at the same time.
+static constexpr u32 MAX_BACKGROUND_COMPILE_QUEUE_SIZE = 64;
+
+struct BackgroundCompileRequest
+{
+  u32 pc;
+  BackgroundCompileRegs regs;
+};
+
+struct BackgroundCompileJob
+{
+  ~BackgroundCompileJob();
+
+  u32 pc = 0;
+  BackgroundCompileRegs regs = {};
+  BlockInstructionList instructions;
+  BlockMetadata metadata = {};
+  Block* block = nullptr; // not in the LUT until installed
+
+  const void* host_code = nullptr;
+  u32 host_code_size = 0;
+  u32 host_far_code_size = 0;
+  std::vector<std::pair<void*, u32>> links; // code, target pc
+  std::vector<std::pair<void*, LoadstoreBackpatchInfo>> loadstores;
+
+  std::atomic_bool compiled{false};
+};
+
+static bool UseBackgroundCompile();
+static bool QueueBackgroundCompile(Block* block);
+static Block* CreateBackgroundCompileBlock(u32 pc, const BlockInstructionList& instructions,
+                                           const BlockMetadata& metadata);
+static bool UpdateBackgroundCompile(u32 pc);
+static void StartBackgroundCompile();
+static void WaitForBackgroundCompile();
+static bool InstallBackgroundCompile();
+static void FinishBackgroundCompile();
+static void StopBackgroundCompileThread();
+static void BackgroundCompileThreadEntryPoint();
+
 static void ClearASMFunctions();
 static void CompileASMFunctions();
+static void InitializeCodeBufferSegments();
+static void SetCodeBufferSegment(u32 segment);
+static void EvictCodeBufferSegment(u32 segment);
+static void EvictBlock(Block* block);
+static u32 GetCodeBufferSegment(const void* host_code);
+static void EnsureBackpatchThunkSpace(const void* host_pc);
 static bool CompileBlock(Block* block);
 static Common::PageFaultHandler::HandlerResult HandleFastmemException(void* exception_pc, void* fault_address,
                                                                       bool is_write);
@@ -104,6 +262,25 @@ static BlockLinkMap s_block_links;
 static std::unordered_map<const void*, LoadstoreBackpatchInfo> s_fastmem_backpatch_info;
 static std::unordered_set<u32> s_fastmem_faulting_pcs;
 
+// Backpatch thunks are allocated from whichever code buffer segment is current when the fault happens, which isn't
+// necessarily the segment the patched block lives in. The block has to be thrown away when the thunk's segment is.
+struct BackpatchThunk
+{
+  const void* thunk_code;
+  const void* block_host_code;
+  u32 block_pc;
+};
+static std::vector<BackpatchThunk> s_backpatch_thunks;
+
+static std::deque<BackgroundCompileRequest> s_background_compile_queue;
+static std::unique_ptr<BackgroundCompileJob> s_background_compile_job;
+static BackgroundCompileJob* s_background_compile_request = nullptr; // protected by s_background_compile_mutex
+static std::thread s_background_compile_thread;
+static std::mutex s_background_compile_mutex;
+static std::condition_variable s_background_compile_cv;
+static bool s_background_compile_thread_shutdown = false;
+static thread_local BackgroundCompileJob* s_compiling_job = nullptr;
+
 NORETURN_FUNCTION_POINTER void (*g_enter_recompiler)();
 const void* g_compile_or_revalidate_block;
 const void* g_check_events_and_dispatch;
@@ -112,12 +289,8 @@ const void* g_dispatcher;
 const void* g_interpret_block;
 const void* g_discard_and_recompile_block;
 
-#ifdef ENABLE_RECOMPILER_PROFILING
-
 PerfScope MIPSPerfScope("MIPS");
 
-#endif
-
 // Currently remapping the code buffer doesn't work in macOS. TODO: Make dynamic instead...
 #ifndef __APPLE__
 #define USE_STATIC_CODE_BUFFER 1
@@ -137,7 +310,16 @@ static constexpr u32 RECOMPILER_GUARD_SIZE = 4096;
 alignas(HOST_PAGE_SIZE) static u8 s_code_storage[RECOMPILER_CODE_CACHE_SIZE + RECOMPILER_FAR_CODE_CACHE_SIZE];
 #endif
 
+// The code buffer is split into segments, which are filled in order. When the last one fills up, the oldest segment
+// is evicted and reused, instead of throwing away the whole cache. Any hot blocks which were in it get compiled again
+// into the current segment the next time they're executed.
+static constexpr u32 CODE_BUFFER_SEGMENT_COUNT = 8;
+
 static JitCodeBuffer s_code_buffer;
+static u32 s_code_segment_base = 0;
+static u32 s_code_segment_size = 0;
+static u32 s_far_code_segment_size = 0;
+static u32 s_current_code_segment = 0;
 
 #ifdef _DEBUG
 static u32 s_total_instructions_compiled = 0;
@@ -199,10 +381,13 @@ void CPU::CodeCache::Initialize()
   Assert(s_blocks.empty());
 
 #ifdef ENABLE_RECOMPILER_SUPPORT
+  s_code_buffer_stats = {};
+  s_block_stats.clear();
   if (IsUsingAnyRecompiler())
   {
     s_code_buffer.Reset();
     CompileASMFunctions();
+    InitializeCodeBufferSegments();
     ResetCodeLUT();
   }
 #endif
@@ -213,10 +398,28 @@ void CPU::CodeCache::Initialize()
 
 void CPU::CodeCache::Shutdown()
 {
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  CancelBackgroundCompile();
+  StopBackgroundCompileThread();
+  s_background_compile_queue.clear();
+#endif
+
   ClearBlocks();
 
 #ifdef ENABLE_RECOMPILER_SUPPORT
   ClearASMFunctions();
+
+  // Stats are kept until the next system starts, so they can still be written out.
+  if (!s_block_stats.empty())
+    LogBlockStats();
+
+  if (s_code_buffer_stats.evictions > 0)
+  {
+    Log_InfoFmt("Code buffer: {} evictions, {} blocks evicted, {} recompiled ({} bytes, {:.2f} ms)",
+                s_code_buffer_stats.evictions, s_code_buffer_stats.evicted_blocks,
+                s_code_buffer_stats.recompiled_blocks, s_code_buffer_stats.recompiled_bytes,
+                s_code_buffer_stats.recompile_time_ms);
+  }
 #endif
 
   Bus::UpdateFastmemViews(CPUFastmemMode::Disabled);
@@ -225,6 +428,11 @@ void CPU::CodeCache::Shutdown()
 
 void CPU::CodeCache::Reset()
 {
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  CancelBackgroundCompile();
+  s_background_compile_queue.clear();
+#endif
+
   ClearBlocks();
 
 #ifdef ENABLE_RECOMPILER_SUPPORT
@@ -233,6 +441,7 @@ void CPU::CodeCache::Reset()
     ClearASMFunctions();
     s_code_buffer.Reset();
     CompileASMFunctions();
+    InitializeCodeBufferSegments();
     ResetCodeLUT();
   }
 #endif
@@ -411,7 +620,7 @@ CPU::CodeCache::Block* CPU::CodeCache::LookupBlock(u32 pc)
 }
 
 CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructionList& instructions,
-                                                   const BlockMetadata& metadata)
+                                                   const BlockMetadata& metadata, Block* allocated_block)
 {
   const u32 size = static_cast<u32>(instructions.size());
   const u32 table = pc >> LUT_TABLE_SHIFT;
@@ -433,8 +642,8 @@ CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructio
     recompile_frame = block->compile_frame;
     recompile_count = block->compile_count;
 
-    // if it has the same number of instructions, we can reuse it
-    if (block->size != size)
+    // if it has the same number of instructions, we can reuse it, unless the caller already allocated one
+    if (block->size != size || allocated_block)
     {
       // this sucks.. hopefully won't happen very often
       // TODO: allocate max size, allow shrink but not grow
@@ -448,10 +657,18 @@ CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructio
     }
   }
 
-  if (!block)
+  if (allocated_block)
+  {
+    block = allocated_block;
+    s_blocks.push_back(block);
+  }
+  else if (!block)
   {
-    block =
-      static_cast<Block*>(std::malloc(sizeof(Block) + (sizeof(Instruction) * size) + (sizeof(InstructionInfo) * size)));
+    size_t alloc_size = sizeof(Block) + (sizeof(Instruction) * size) + (sizeof(InstructionInfo) * size);
+    if (g_settings.cpu_execution_mode == CPUExecutionMode::CachedInterpreter)
+      alloc_size += (alignof(CachedInterpreterInstruction) - 1) + (sizeof(CachedInterpreterInstruction) * size);
+
+    block = static_cast<Block*>(std::malloc(alloc_size));
     Assert(block);
     new (block) Block();
     s_blocks.push_back(block);
@@ -469,6 +686,7 @@ CPU::CodeCache::Block* CPU::CodeCache::CreateBlock(u32 pc, const BlockInstructio
   block->icache_line_count = metadata.icache_line_count;
   block->compile_frame = recompile_frame;
   block->compile_count = recompile_count + 1;
+  block->interpret_count = 0;
 
   // copy instructions/info
   {
@@ -681,6 +899,11 @@ void CPU::CodeCache::InvalidateBlock(Block* block, BlockState new_state)
   block->state = new_state;
 }
 
+const CPU::CodeCache::CodeBufferStats& CPU::CodeCache::GetCodeBufferStats()
+{
+  return s_code_buffer_stats;
+}
+
 void CPU::CodeCache::InvalidateAllRAMBlocks()
 {
   // TODO: maybe combine the backlink into one big instruction flush cache?
@@ -719,6 +942,7 @@ void CPU::CodeCache::ClearBlocks()
 #ifdef ENABLE_RECOMPILER_SUPPORT
   s_fastmem_backpatch_info.clear();
   s_fastmem_faulting_pcs.clear();
+  s_backpatch_thunks.clear();
   s_block_links.clear();
 #endif
 
@@ -728,6 +952,7 @@ void CPU::CodeCache::ClearBlocks()
     std::free(block);
   }
   s_blocks.clear();
+  s_branch_profiles.clear();
 
   std::memset(s_lut_block_pointers.get(), 0, sizeof(Block*) * GetLUTSlotCount(false));
 }
@@ -761,12 +986,19 @@ Common::PageFaultHandler::HandlerResult CPU::CodeCache::ExceptionHandler(void* e
 
 CPU::CodeCache::Block* CPU::CodeCache::CreateCachedInterpreterBlock(u32 pc)
 {
+  SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::CodeCompile);
+
   BlockMetadata metadata = {};
-  ReadBlockInstructions(pc, &s_block_instructions, &metadata);
-  return CreateBlock(pc, s_block_instructions, metadata);
+  ReadBlockInstructions(pc, &s_block_instructions, &metadata, false);
+
+  Block* block = CreateBlock(pc, s_block_instructions, metadata);
+  if (block->size > 0 && g_settings.cpu_execution_mode == CPUExecutionMode::CachedInterpreter)
+    DecodeThreadedBlock(block);
+
+  return block;
 }
 
-template<PGXPMode pgxp_mode>
+template<PGXPMode pgxp_mode, bool threaded>
 [[noreturn]] void CPU::CodeCache::ExecuteCachedInterpreterImpl()
 {
 #define CHECK_DOWNCOUNT()                                                                                              \
@@ -826,7 +1058,13 @@ template<PGXPMode pgxp_mode>
       if (g_settings.cpu_recompiler_icache)
         CheckAndUpdateICacheTags(block->icache_line_count, block->uncached_fetch_ticks);
 
-      InterpretCachedBlock<pgxp_mode>(block);
+      if constexpr (threaded)
+        InterpretThreadedBlock(block);
+      else
+        InterpretCachedBlock<pgxp_mode>(block);
+
+      if (g_state.pc == block->pc && block->HasFlag(BlockFlags::IdleLoop))
+        SkipIdleLoop();
 
       CHECK_DOWNCOUNT();
 
@@ -849,13 +1087,16 @@ template<PGXPMode pgxp_mode>
   if (g_settings.gpu_pgxp_enable)
   {
     if (g_settings.gpu_pgxp_cpu)
-      ExecuteCachedInterpreterImpl<PGXPMode::CPU>();
+      ExecuteCachedInterpreterImpl<PGXPMode::CPU, false>();
     else
-      ExecuteCachedInterpreterImpl<PGXPMode::Memory>();
+      ExecuteCachedInterpreterImpl<PGXPMode::Memory, false>();
   }
   else
   {
-    ExecuteCachedInterpreterImpl<PGXPMode::Disabled>();
+    if (g_settings.cpu_cached_interpreter_threaded)
+      ExecuteCachedInterpreterImpl<PGXPMode::Disabled, true>();
+    else
+      ExecuteCachedInterpreterImpl<PGXPMode::Disabled, false>();
   }
 }
 
@@ -888,7 +1129,8 @@ void CPU::CodeCache::LogCurrentState()
 // MARK: - Block Compilation: Shared Code
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* instructions, BlockMetadata* metadata)
+bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* instructions, BlockMetadata* metadata,
+                                           bool allow_jump_following)
 {
   // TODO: Jump to other block if it exists at this pc?
 
@@ -897,6 +1139,13 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
   bool is_branch_delay_slot = false;
   bool is_load_delay_slot = false;
 
+  // Only newrec knows how to skip over jump gaps and generate side exits. The icache check assumes the lines are
+  // contiguous.
+  const bool follow_jumps = allow_jump_following && g_settings.cpu_execution_mode == CPUExecutionMode::NewRec &&
+                            (g_settings.cpu_recompiler_follow_jumps || g_settings.cpu_recompiler_superblocks) &&
+                            !g_settings.cpu_recompiler_icache;
+  u32 num_followed_jumps = 0;
+
 #if 0
   if (pc == 0x0005aa90)
     __debugbreak();
@@ -996,7 +1245,51 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
     // if we're in a branch delay slot, the block is now done
     // except if this is a branch in a branch delay slot, then we grab the one after that, and so on...
     if (is_branch_delay_slot && !info.is_branch_instruction)
-      break;
+    {
+      // unless it's a short forward jump, or a branch which nearly always goes forward the same way, then we can
+      // keep going at the target, and skip over the gap
+      const BlockInstructionInfoPair branch = (*instructions)[instructions->size() - 2];
+      if (!follow_jumps || instruction.op == InstructionOp::cop0 || IsExitBlockInstruction(instruction))
+        break;
+
+      const std::optional<u32> target =
+        GetFollowedBranchTarget(branch.first, branch.second, g_settings.cpu_recompiler_superblocks);
+      if (!target.has_value() || !ShouldFollowJump(pc, target.value(), protection, last_page, num_followed_jumps))
+        break;
+
+      const size_t gap_start = instructions->size();
+      for (; pc != target.value(); pc += sizeof(Instruction))
+      {
+        Instruction gap_instruction;
+        if (!SafeReadInstruction(pc, &gap_instruction.bits))
+          break;
+
+        InstructionInfo gap_info;
+        std::memset(&gap_info, 0, sizeof(gap_info));
+        gap_info.pc = pc;
+        gap_info.is_jump_gap = true;
+        instructions->emplace_back(gap_instruction, gap_info);
+      }
+      if (pc != target.value())
+      {
+        instructions->resize(gap_start);
+        break;
+      }
+
+      Log_DevFmt("Continuing block 0x{:08X} at 0x{:08X}, skipping {} instructions", start_pc, target.value(),
+                 instructions->size() - gap_start);
+      num_followed_jumps++;
+
+      // Conditional branches keep going after the delay slot when they're not usually taken, no gap needed.
+      const bool is_jump = (branch.first.op == InstructionOp::j || branch.first.op == InstructionOp::jal);
+      if (is_jump || instructions->size() != gap_start)
+        metadata->flags |= BlockFlags::ContainsJumpGap;
+      if (!is_jump)
+        metadata->flags |= BlockFlags::ContainsSideExit;
+      is_branch_delay_slot = false;
+      is_load_delay_slot = info.has_load_delay;
+      continue;
+    }
 
     // if this is a branch, we grab the next instruction (delay slot), and then exit
     is_branch_delay_slot = info.is_branch_instruction;
@@ -1015,8 +1308,20 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
     return false;
   }
 
+  // the jump target couldn't be read, so the gap leading up to it is useless
+  while (instructions->back().second.is_jump_gap)
+    instructions->pop_back();
+
   instructions->back().second.is_last_instruction = true;
 
+  if (g_settings.cpu_recompiler_idle_loop_skipping &&
+      (metadata->flags & (BlockFlags::ContainsJumpGap | BlockFlags::ContainsSideExit)) == BlockFlags::None &&
+      IsIdleLoop(start_pc, *instructions))
+  {
+    Log_DevFmt("Block 0x{:08X} is an idle loop", start_pc);
+    metadata->flags |= BlockFlags::IdleLoop;
+  }
+
 #ifdef _DEBUG
   SmallString disasm;
   Log_DebugPrintf("Block at 0x%08X", start_pc);
@@ -1031,6 +1336,268 @@ bool CPU::CodeCache::ReadBlockInstructions(u32 start_pc, BlockInstructionList* i
   return true;
 }
 
+std::optional<u32> CPU::CodeCache::GetFollowedBranchTarget(const Instruction& branch, const InstructionInfo& info,
+                                                           bool superblocks)
+{
+  if (branch.op == InstructionOp::j || branch.op == InstructionOp::jal)
+    return GetDirectBranchTarget(branch, info.pc);
+
+  // Conditional branches are only followed the way they nearly always went while the block was being interpreted.
+  if (!superblocks || !info.is_direct_branch_instruction)
+    return std::nullopt;
+
+  const auto it = s_branch_profiles.find(info.pc);
+  if (it == s_branch_profiles.end())
+    return std::nullopt;
+
+  const u64 taken = it->second.taken;
+  const u64 not_taken = it->second.not_taken;
+  const u64 samples = taken + not_taken;
+  if (samples < SUPERBLOCK_MIN_BRANCH_SAMPLES)
+    return std::nullopt;
+  else if ((taken * 100) >= (samples * SUPERBLOCK_BRANCH_BIAS_PERCENT))
+    return GetDirectBranchTarget(branch, info.pc);
+  else if ((not_taken * 100) >= (samples * SUPERBLOCK_BRANCH_BIAS_PERCENT))
+    return info.pc + (sizeof(Instruction) * 2);
+  else
+    return std::nullopt;
+}
+
+bool CPU::CodeCache::ShouldFollowJump(u32 pc, u32 target, PageProtectionMode protection, u32 page, u32 num_jumps)
+{
+  // Only follow forward jumps, backwards jumps are loops, which are already handled well by block linking.
+  if (target < pc || ((target - pc) / sizeof(Instruction)) > MAX_JUMP_GAP_INSTRUCTIONS ||
+      num_jumps >= MAX_FOLLOWED_JUMPS)
+  {
+    return false;
+  }
+
+  // Keep the whole block within the page, otherwise writes to the other page won't invalidate it.
+  return (protection != PageProtectionMode::WriteProtected ||
+          (Bus::GetRAMCodePageIndex(pc) == page && Bus::GetRAMCodePageIndex(target) == page));
+}
+
+bool CPU::CodeCache::GetIdleLoopInstructionRegs(const Instruction& instruction, Reg* dst, Reg* src1, Reg* src2)
+{
+  *dst = Reg::zero;
+  *src1 = Reg::zero;
+  *src2 = Reg::zero;
+
+  switch (instruction.op)
+  {
+    case InstructionOp::lb:
+    case InstructionOp::lbu:
+    case InstructionOp::lh:
+    case InstructionOp::lhu:
+    case InstructionOp::lw:
+    case InstructionOp::addiu:
+    case InstructionOp::slti:
+    case InstructionOp::sltiu:
+    case InstructionOp::andi:
+    case InstructionOp::ori:
+    case InstructionOp::xori:
+      *dst = instruction.i.rt;
+      *src1 = instruction.i.rs;
+      return true;
+
+    case InstructionOp::lui:
+      *dst = instruction.i.rt;
+      return true;
+
+    case InstructionOp::beq:
+    case InstructionOp::bne:
+      *src1 = instruction.i.rs;
+      *src2 = instruction.i.rt;
+      return true;
+
+    case InstructionOp::blez:
+    case InstructionOp::bgtz:
+      *src1 = instruction.i.rs;
+      return true;
+
+    case InstructionOp::b:
+      *src1 = instruction.i.rs;
+      return ((static_cast<u8>(instruction.i.rt.GetValue()) & u8(0x1E)) != u8(0x10)); // no bltzal/bgezal
+
+    case InstructionOp::j:
+      return true;
+
+    case InstructionOp::funct:
+    {
+      switch (instruction.r.funct)
+      {
+        case InstructionFunct::sll:
+        case InstructionFunct::srl:
+        case InstructionFunct::sra:
+          *dst = instruction.r.rd;
+          *src1 = instruction.r.rt;
+          return true;
+
+        case InstructionFunct::sllv:
+        case InstructionFunct::srlv:
+        case InstructionFunct::srav:
+        case InstructionFunct::addu:
+        case InstructionFunct::subu:
+        case InstructionFunct::and_:
+        case InstructionFunct::or_:
+        case InstructionFunct::xor_:
+        case InstructionFunct::nor:
+        case InstructionFunct::slt:
+        case InstructionFunct::sltu:
+          *dst = instruction.r.rd;
+          *src1 = instruction.r.rs;
+          *src2 = instruction.r.rt;
+          return true;
+
+        case InstructionFunct::mfhi:
+        case InstructionFunct::mflo:
+          // HI/LO can't be written by anything we accept, so they're the same every iteration.
+          *dst = instruction.r.rd;
+          return true;
+
+        default:
+          return false;
+      }
+    }
+
+    default:
+      return false;
+  }
+}
+
+bool CPU::CodeCache::IsIdleLoop(u32 start_pc, const BlockInstructionList& instructions)
+{
+  // We're looking for a loop back to the start of the block, which only reads memory and computes values from it:
+  //
+  //   loop: lw v0, 0x1234(gp) / nop / beq v0, zero, loop / nop
+  //
+  // With no stores, and no values carried from one iteration to the next, each iteration behaves the same as the
+  // last until something other than the CPU changes memory, which can only happen in an event or an interrupt.
+  if (instructions.size() < 2)
+    return false;
+
+  const BlockInstructionInfoPair& branch = instructions[instructions.size() - 2];
+  if (!branch.second.is_direct_branch_instruction || GetDirectBranchTarget(branch.first, branch.second.pc) != start_pc)
+    return false;
+
+  Reg dst, src1, src2;
+  u32 loop_writes = 0;
+  for (const auto& [instruction, info] : instructions)
+  {
+    if (!GetIdleLoopInstructionRegs(instruction, &dst, &src1, &src2))
+      return false;
+
+    loop_writes |= (1u << static_cast<u8>(dst));
+  }
+  loop_writes &= ~(1u << static_cast<u8>(Reg::zero));
+
+  // Any register which is read before it's written in this iteration comes from the previous one. Loads don't land
+  // until after the next instruction, so that counts for reading a loaded register in the load delay slot too.
+  u32 available = 0;
+  u32 pending_load = 0;
+  for (const auto& [instruction, info] : instructions)
+  {
+    GetIdleLoopInstructionRegs(instruction, &dst, &src1, &src2);
+    const u32 reads = (1u << static_cast<u8>(src1)) | (1u << static_cast<u8>(src2));
+    if ((reads & loop_writes & ~available) != 0)
+      return false;
+
+    available |= std::exchange(pending_load, 0u);
+    if (info.is_load_instruction)
+      pending_load = (1u << static_cast<u8>(dst));
+    else
+      available |= (1u << static_cast<u8>(dst));
+  }
+
+  return true;
+}
+
+bool CPU::CodeCache::IsIdleLoopReadSafe(VirtualMemoryAddress address, u32 size)
+{
+  // RAM, BIOS and scratchpad only change when the CPU writes to them, or through DMA, which happens in events.
+  const PhysicalMemoryAddress paddr = VirtualAddressToPhysical(address);
+  if (paddr < Bus::RAM_MIRROR_END || (paddr >= Bus::BIOS_BASE && paddr < (Bus::BIOS_BASE + Bus::BIOS_SIZE)) ||
+      (address & SCRATCHPAD_ADDR_MASK) == SCRATCHPAD_ADDR)
+  {
+    return true;
+  }
+
+  // Same for the status registers which are commonly polled, i.e. interrupt and DMA registers, and CDROM status and
+  // interrupt flags. Timers count every cycle, reads from FIFOs have side effects, and GPUSTAT changes every scanline
+  // (and synchronizes the CRTC when read).
+  return ((paddr >= Bus::INTC_BASE && (paddr + size) <= (Bus::DMA_BASE + Bus::DMA_SIZE)) ||
+          (size == 1 && (paddr == Bus::CDROM_BASE || paddr == (Bus::CDROM_BASE + 3))));
+}
+
+void CPU::CodeCache::SkipIdleLoop()
+{
+  Block* block = LookupBlock(g_state.pc);
+  if (!block || !block->HasFlag(BlockFlags::IdleLoop))
+    return;
+
+  // Work out where the loop reads from. Base registers are either not written in the loop, so the current value is
+  // what it'll use, or are constructed from constants within the loop.
+  const Instruction* instructions = block->Instructions();
+  u32 values[static_cast<u8>(Reg::count)];
+  std::memcpy(values, g_state.regs.r, sizeof(values));
+
+  u32 known = 0;
+  Reg dst, src1, src2;
+  for (u32 i = 0; i < block->size; i++)
+  {
+    GetIdleLoopInstructionRegs(instructions[i], &dst, &src1, &src2);
+    known |= (1u << static_cast<u8>(dst));
+  }
+  known = ~known | (1u << static_cast<u8>(Reg::zero));
+
+  for (u32 i = 0; i < block->size; i++)
+  {
+    const Instruction inst = instructions[i];
+    GetIdleLoopInstructionRegs(inst, &dst, &src1, &src2);
+
+    const bool src1_known = ((known >> static_cast<u8>(src1)) & 1u) != 0;
+    const u32 src1_value = values[static_cast<u8>(src1)];
+    if (IsMemoryLoadInstruction(inst))
+    {
+      const u32 size =
+        (inst.op == InstructionOp::lw) ? 4 : ((inst.op == InstructionOp::lh || inst.op == InstructionOp::lhu) ? 2 : 1);
+      if (!src1_known || !IsIdleLoopReadSafe(src1_value + inst.i.imm_sext32(), size))
+      {
+        Log_DevFmt("Not skipping idle loop at 0x{:08X}, load at 0x{:08X} may not be side-effect free", block->pc,
+                   block->pc + (i * sizeof(Instruction)));
+        block->flags &= ~BlockFlags::IdleLoop;
+        return;
+      }
+    }
+
+    if (dst == Reg::zero)
+      continue;
+
+    bool dst_known = false;
+    u32 dst_value = 0;
+    if (inst.op == InstructionOp::lui)
+    {
+      dst_known = true;
+      dst_value = inst.i.imm_zext32() << 16;
+    }
+    else if (inst.op == InstructionOp::addiu || inst.op == InstructionOp::ori)
+    {
+      dst_known = src1_known;
+      dst_value = (inst.op == InstructionOp::addiu) ? (src1_value + inst.i.imm_sext32()) :
+                                                       (src1_value | inst.i.imm_zext32());
+    }
+
+    values[static_cast<u8>(dst)] = dst_value;
+    known = dst_known ? (known | (1u << static_cast<u8>(dst))) : (known & ~(1u << static_cast<u8>(dst)));
+  }
+
+  // Every iteration until the next event is going to do the same thing, so go straight there.
+  if (g_state.pending_ticks < g_state.downcount)
+    g_state.pending_ticks = g_state.downcount;
+
+  s_idle_loop_skipped = true;
+}
+
 void CPU::CodeCache::CopyRegInfo(InstructionInfo* dst, const InstructionInfo* src)
 {
   std::memcpy(dst->reg_flags, src->reg_flags, sizeof(dst->reg_flags));
@@ -1105,6 +1672,14 @@ void CPU::CodeCache::FillBlockRegInfo(Block* block)
     InstructionInfo* prev = inst - 1;
     CopyRegInfo(prev, inst);
 
+    // Jump gaps aren't executed, so liveness just passes through them.
+    if (inst->is_jump_gap)
+    {
+      inst--;
+      iinst--;
+      continue;
+    }
+
     const Reg rs = iinst->r.rs;
     const Reg rt = iinst->r.rt;
 
@@ -1294,6 +1869,17 @@ void CPU::CodeCache::FillBlockRegInfo(Block* block)
   } // end while
 }
 
+void CPU::CodeCache::CancelBackgroundCompile()
+{
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  if (!s_background_compile_job)
+    return;
+
+  WaitForBackgroundCompile();
+  s_background_compile_job.reset();
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // MARK: - Recompiler Glue
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1302,11 +1888,34 @@ void CPU::CodeCache::FillBlockRegInfo(Block* block)
 
 void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
 {
-  // TODO: this doesn't currently handle when the cache overflows...
   DebugAssert(IsUsingAnyRecompiler());
+
+  // No code is running, so anything the background compile thread has finished can be installed. If that's the block
+  // we're here for, the dispatcher will pick it up.
+  if (UpdateBackgroundCompile(start_pc))
+    return;
+
+  // Done before the profile scope, since it executes guest code. Hot blocks are compiled below on the CPU thread,
+  // unless background compilation is enabled, in which case they're queued and stay in the interpreter tier.
+  if (g_settings.cpu_recompiler_compile_threshold > 0 && InterpretColdBlock(start_pc))
+    return;
+
+  SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::CodeCompile);
   MemMap::BeginCodeWrite();
 
   Block* block = LookupBlock(start_pc);
+  bool promoted_block = false;
+  if (block && block->state == BlockState::Valid)
+  {
+    // Only blocks in the interpreter tier stay valid with the LUT pointing here. Promoting it to the recompiler
+    // shouldn't count towards the interpreter fallback.
+    DebugAssert(!block->host_code);
+    RemoveBlockFromPageList(block);
+    block->state = BlockState::NeedsRecompile;
+    block->compile_count--;
+    promoted_block = true;
+  }
+
   if (block)
   {
     // we should only be here if the block got invalidated
@@ -1325,7 +1934,7 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
   }
 
   BlockMetadata metadata = {};
-  if (!ReadBlockInstructions(start_pc, &s_block_instructions, &metadata))
+  if (!ReadBlockInstructions(start_pc, &s_block_instructions, &metadata, true))
   {
     Log_ErrorFmt("Failed to read block at 0x{:08X}, falling back to uncached interpreter", start_pc);
     SetCodeLUT(start_pc, g_interpret_block);
@@ -1334,15 +1943,17 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
     return;
   }
 
-  // Ensure we're not going to run out of space while compiling this block.
-  // We could definitely do better here... TODO: far code is no longer needed for newrec
-  const u32 block_size = static_cast<u32>(s_block_instructions.size());
-  if (s_code_buffer.GetFreeCodeSpace() < (block_size * Recompiler::MAX_NEAR_HOST_BYTES_PER_INSTRUCTION) ||
-      s_code_buffer.GetFreeFarCodeSpace() < (block_size * Recompiler::MAX_FAR_HOST_BYTES_PER_INSTRUCTION))
-  {
-    Log_ErrorFmt("Out of code space while compiling {:08X}. Resetting code cache.", start_pc);
-    CodeCache::Reset();
-  }
+  // Evicted blocks are left without host code, so we can tell them apart from regular recompiles.
+  const bool recompiling_evicted_block =
+    (!promoted_block && block && block->state == BlockState::NeedsRecompile && !block->host_code);
+
+  // The background compile thread owns the free area of the code buffer. If it's working on this block, the result
+  // gets thrown away, since the block is no longer in the interpreter tier.
+  FinishBackgroundCompile();
+  EnsureCodeBufferSpace(start_pc, static_cast<u32>(s_block_instructions.size()));
+
+  const Common::Timer::Value compile_start_time = recompiling_evicted_block ? Common::Timer::GetCurrentValue() : 0;
+  const u32 code_used_before = s_code_buffer.GetTotalUsed();
 
   if ((block = CreateBlock(start_pc, s_block_instructions, metadata)) == nullptr || block->size == 0 ||
       !CompileBlock(block))
@@ -1354,71 +1965,471 @@ void CPU::CodeCache::CompileOrRevalidateBlock(u32 start_pc)
     return;
   }
 
+  if (recompiling_evicted_block)
+  {
+    s_code_buffer_stats.recompiled_blocks++;
+    s_code_buffer_stats.recompiled_bytes += s_code_buffer.GetTotalUsed() - code_used_before;
+    s_code_buffer_stats.recompile_time_ms +=
+      Common::Timer::ConvertValueToMilliseconds(Common::Timer::GetCurrentValue() - compile_start_time);
+  }
+
+  RecordProfiledBlock(block);
+
   SetCodeLUT(start_pc, block->host_code);
   BacklinkBlocks(start_pc, block->host_code);
   MemMap::EndCodeWrite();
 }
 
-void CPU::CodeCache::DiscardAndRecompileBlock(u32 start_pc)
+void CPU::CodeCache::EnsureCodeBufferSpace(u32 pc, u32 block_size)
 {
-  MemMap::BeginCodeWrite();
+  // We could definitely do better here... TODO: far code is no longer needed for newrec
+  const u32 near_space_required = block_size * Recompiler::MAX_NEAR_HOST_BYTES_PER_INSTRUCTION;
+  const u32 far_space_required = block_size * Recompiler::MAX_FAR_HOST_BYTES_PER_INSTRUCTION;
+  if (s_code_buffer.GetFreeCodeSpace() >= near_space_required &&
+      s_code_buffer.GetFreeFarCodeSpace() >= far_space_required)
+  {
+    return;
+  }
 
-  Log_DevPrintf("Discard block %08X with manual protection", start_pc);
-  Block* block = LookupBlock(start_pc);
-  DebugAssert(block && block->state == BlockState::Valid);
-  InvalidateBlock(block, BlockState::NeedsRecompile);
-  CompileOrRevalidateBlock(start_pc);
+  s_current_code_segment = (s_current_code_segment + 1) % CODE_BUFFER_SEGMENT_COUNT;
+  EvictCodeBufferSegment(s_current_code_segment);
 
-  MemMap::EndCodeWrite();
+  if (s_code_buffer.GetFreeCodeSpace() < near_space_required ||
+      s_code_buffer.GetFreeFarCodeSpace() < far_space_required)
+  {
+    Log_ErrorFmt("Block {:08X} does not fit in a code buffer segment. Resetting code cache.", pc);
+    CodeCache::Reset();
+  }
 }
 
-const void* CPU::CodeCache::CreateBlockLink(Block* block, void* code, u32 newpc)
+bool CPU::CodeCache::InterpretColdBlock(u32 pc)
 {
-  // self-linking should be handled by the caller
-  DebugAssert(newpc != block->pc);
-
-  const void* dst = g_dispatcher;
-  if (g_settings.cpu_recompiler_block_linking)
+  Block* block = LookupBlock(pc);
+  if (block)
   {
-    const Block* next_block = LookupBlock(newpc);
-    if (next_block)
+    // The interpreter can't skip jump gaps or take side exits.
+    if ((block->flags & (BlockFlags::ContainsJumpGap | BlockFlags::ContainsSideExit)) != BlockFlags::None)
+      return false;
+
+    // Previously compiled, revalidate or recompile as usual. With background compilation, blocks which changed go
+    // back to the interpreter tier instead, so they don't stall the CPU thread either.
+    if (block->host_code)
     {
-      dst = (next_block->state == BlockState::Valid) ?
-              next_block->host_code :
-              ((next_block->state == BlockState::FallbackToInterpreter) ? g_interpret_block :
-                                                                          g_compile_or_revalidate_block);
-      DebugAssert(dst);
+      if (!UseBackgroundCompile() ||
+          (block->state < BlockState::NeedsRecompile && block->protection == GetProtectionModeForBlock(block) &&
+           IsBlockCodeCurrent(block)))
+      {
+        return false;
+      }
+
+      UnlinkBlockExits(block);
+      block = nullptr;
     }
-    else
+    else if ((block->state != BlockState::Valid && !RevalidateBlock(block)) ||
+             (block->protection == PageProtectionMode::ManualCheck && !IsBlockCodeCurrent(block)))
     {
-      dst = g_compile_or_revalidate_block;
+      block = nullptr;
     }
+  }
 
-    BlockLinkMap::iterator iter = s_block_links.emplace(newpc, code);
-    DebugAssert(block->num_exit_links < MAX_BLOCK_EXIT_LINKS);
-    block->exit_links[block->num_exit_links++] = iter;
+  if (!block)
+  {
+    if ((block = CreateCachedInterpreterBlock(pc))->size == 0) [[unlikely]]
+    {
+      MemMap::BeginCodeWrite();
+      SetCodeLUT(pc, g_interpret_block);
+      BacklinkBlocks(pc, g_interpret_block);
+      MemMap::EndCodeWrite();
+      return true;
+    }
   }
 
-  Log_DebugPrintf("Linking %p with dst pc %08X to %p%s", code, newpc, dst,
-                  (dst == g_compile_or_revalidate_block) ? "[compiler]" : "");
-  return dst;
-}
+  // Hot enough, time to compile it. With background compilation, it keeps being interpreted until it's ready.
+  if (block->interpret_count >= g_settings.cpu_recompiler_compile_threshold)
+  {
+    if (!UseBackgroundCompile() || !QueueBackgroundCompile(block))
+      return false;
+  }
+  else
+  {
+    block->interpret_count++;
+  }
 
-void CPU::CodeCache::BacklinkBlocks(u32 pc, const void* dst)
-{
-  if (!g_settings.cpu_recompiler_block_linking)
-    return;
+  if (g_settings.cpu_recompiler_icache)
+    CheckAndUpdateICacheTags(block->icache_line_count, block->uncached_fetch_ticks);
 
-  const auto link_range = s_block_links.equal_range(pc);
-  for (auto it = link_range.first; it != link_range.second; ++it)
+  if (g_settings.gpu_pgxp_enable)
   {
-    Log_DebugPrintf("Backlinking %p with dst pc %08X to %p%s", it->second, pc, dst,
-                    (dst == g_compile_or_revalidate_block) ? "[compiler]" : "");
-    EmitJump(it->second, dst, true);
+    if (g_settings.gpu_pgxp_cpu)
+      InterpretCachedBlock<PGXPMode::CPU>(block);
+    else
+      InterpretCachedBlock<PGXPMode::Memory>(block);
+  }
+  else
+  {
+    InterpretCachedBlock<PGXPMode::Disabled>(block);
   }
-}
 
-void CPU::CodeCache::UnlinkBlockExits(Block* block)
+  if (g_settings.cpu_recompiler_superblocks)
+    RecordBranchOutcome(block);
+
+  // Compiled blocks check for events on exit, the dispatcher doesn't.
+  if (g_state.pending_ticks >= g_state.downcount)
+    TimingEvents::RunEvents();
+
+  return true;
+}
+
+void CPU::CodeCache::RecordBranchOutcome(const Block* block)
+{
+  // Jumps always go the same way, only conditional branches are interesting.
+  if (block->size < 2 || !block->InstructionsInfo()[block->size - 1].is_branch_delay_slot)
+    return;
+
+  const Instruction& branch = block->Instructions()[block->size - 2];
+  const InstructionInfo& branch_info = block->InstructionsInfo()[block->size - 2];
+  if (!branch_info.is_direct_branch_instruction || branch.op == InstructionOp::j || branch.op == InstructionOp::jal)
+    return;
+
+  // Anywhere else means the block raised an exception.
+  if (g_state.pc == GetDirectBranchTarget(branch, branch_info.pc))
+    s_branch_profiles[branch_info.pc].taken++;
+  else if (g_state.pc == (branch_info.pc + (sizeof(Instruction) * 2)))
+    s_branch_profiles[branch_info.pc].not_taken++;
+}
+
+bool CPU::CodeCache::UseBackgroundCompile()
+{
+#ifdef ENABLE_NEWREC
+  return (g_settings.cpu_recompiler_background_compile && g_settings.cpu_execution_mode == CPUExecutionMode::NewRec);
+#else
+  return false;
+#endif
+}
+
+bool CPU::CodeCache::QueueBackgroundCompile(Block* block)
+{
+  const u32 pc = block->pc;
+  if ((s_background_compile_job && s_background_compile_job->pc == pc) ||
+      std::any_of(s_background_compile_queue.begin(), s_background_compile_queue.end(),
+                  [pc](const BackgroundCompileRequest& request) { return request.pc == pc; }))
+  {
+    return true;
+  }
+
+  // Keep interpreting it until there's space.
+  if (s_background_compile_queue.size() >= MAX_BACKGROUND_COMPILE_QUEUE_SIZE)
+    return true;
+
+  // We're about to execute the block, so this is the state it'll usually be entered with.
+  BackgroundCompileRequest& request = s_background_compile_queue.emplace_back();
+  request.pc = pc;
+  std::copy_n(g_state.regs.r, request.regs.gpr.size(), request.regs.gpr.begin());
+  request.regs.cop0_sr = g_state.cop0_regs.sr.bits;
+  return true;
+}
+
+CPU::CodeCache::Block* CPU::CodeCache::CreateBackgroundCompileBlock(u32 pc, const BlockInstructionList& instructions,
+                                                                    const BlockMetadata& metadata)
+{
+  const u32 size = static_cast<u32>(instructions.size());
+  Block* block = static_cast<Block*>(
+    std::malloc(sizeof(Block) + (sizeof(Instruction) * size) + (sizeof(InstructionInfo) * size)));
+  Assert(block);
+  new (block) Block();
+
+  block->pc = pc;
+  block->size = size;
+  block->host_code = nullptr;
+  block->next_block_in_page = nullptr;
+  block->num_exit_links = 0;
+  block->state = BlockState::Valid;
+  block->flags = metadata.flags;
+  block->protection = GetProtectionModeForBlock(block);
+  block->uncached_fetch_ticks = metadata.uncached_fetch_ticks;
+  block->icache_line_count = metadata.icache_line_count;
+  block->compile_frame = 0;
+  block->compile_count = 0;
+  block->interpret_count = 0;
+
+  const std::pair<Instruction, InstructionInfo>* ip = instructions.data();
+  Instruction* dsti = block->Instructions();
+  InstructionInfo* dstii = block->InstructionsInfo();
+  for (u32 i = 0; i < size; i++, ip++, dsti++, dstii++)
+  {
+    dsti->bits = ip->first.bits;
+    *dstii = ip->second;
+  }
+
+  FillBlockRegInfo(block);
+  return block;
+}
+
+CPU::CodeCache::BackgroundCompileJob::~BackgroundCompileJob()
+{
+  if (block)
+  {
+    block->~Block();
+    std::free(block);
+  }
+}
+
+bool CPU::CodeCache::UpdateBackgroundCompile(u32 pc)
+{
+  bool installed_pc = false;
+  if (s_background_compile_job)
+  {
+    if (!s_background_compile_job->compiled.load(std::memory_order_acquire))
+      return false;
+
+    const bool is_pc = (s_background_compile_job->pc == pc);
+    MemMap::BeginCodeWrite();
+    installed_pc = InstallBackgroundCompile() && is_pc;
+    MemMap::EndCodeWrite();
+  }
+
+  if (!s_background_compile_queue.empty())
+  {
+    MemMap::BeginCodeWrite();
+    StartBackgroundCompile();
+    MemMap::EndCodeWrite();
+  }
+
+  return installed_pc;
+}
+
+void CPU::CodeCache::StartBackgroundCompile()
+{
+  DebugAssert(!s_background_compile_job);
+
+  while (!s_background_compile_queue.empty())
+  {
+    const BackgroundCompileRequest request = s_background_compile_queue.front();
+    s_background_compile_queue.pop_front();
+
+    // Might have been invalidated or compiled since it was queued.
+    Block* cold_block = LookupBlock(request.pc);
+    if (!cold_block || cold_block->state != BlockState::Valid || cold_block->host_code)
+      continue;
+
+    std::unique_ptr<BackgroundCompileJob> job = std::make_unique<BackgroundCompileJob>();
+    job->pc = request.pc;
+    job->regs = request.regs;
+
+    if (!ReadBlockInstructions(request.pc, &job->instructions, &job->metadata, true))
+    {
+      Log_ErrorFmt("Failed to read block at 0x{:08X}, falling back to uncached interpreter", request.pc);
+      SetCodeLUT(request.pc, g_interpret_block);
+      BacklinkBlocks(request.pc, g_interpret_block);
+      continue;
+    }
+
+    job->block = CreateBackgroundCompileBlock(request.pc, job->instructions, job->metadata);
+    EnsureCodeBufferSpace(request.pc, job->block->size);
+
+    if (!s_background_compile_thread.joinable())
+      s_background_compile_thread = std::thread(BackgroundCompileThreadEntryPoint);
+
+    std::unique_lock lock(s_background_compile_mutex);
+    s_background_compile_request = job.get();
+    s_background_compile_job = std::move(job);
+    s_background_compile_cv.notify_all();
+    return;
+  }
+}
+
+void CPU::CodeCache::WaitForBackgroundCompile()
+{
+  std::unique_lock lock(s_background_compile_mutex);
+  s_background_compile_cv.wait(
+    lock, []() { return s_background_compile_job->compiled.load(std::memory_order_acquire); });
+}
+
+bool CPU::CodeCache::InstallBackgroundCompile()
+{
+  std::unique_ptr<BackgroundCompileJob> job = std::move(s_background_compile_job);
+  DebugAssert(job->compiled.load(std::memory_order_acquire));
+
+  // Only install it if the block is still in the interpreter tier, and its code hasn't changed since it was read.
+  const u32 pc = job->pc;
+  Block* block = LookupBlock(pc);
+  if (!job->host_code || !block || block->state != BlockState::Valid || block->host_code ||
+      job->block->protection != GetProtectionModeForBlock(job->block) ||
+      (AddressInRAM(pc) && !IsBlockCodeCurrent(job->block)))
+  {
+    Log_DevFmt("Discarding background compiled block at 0x{:08X}", pc);
+    return false;
+  }
+
+  // Same as promoting it in CompileOrRevalidateBlock().
+  RemoveBlockFromPageList(block);
+  block->state = BlockState::NeedsRecompile;
+  block->compile_count--;
+
+  // Blocks which store into themselves get truncated by the compiler.
+  if (job->block->size < job->instructions.size())
+  {
+    job->instructions.resize(job->block->size);
+    job->instructions.back().second.is_last_instruction = true;
+  }
+
+  // The compiled block replaces the interpreter one. Manually protected blocks compare against its instructions.
+  block = CreateBlock(pc, job->instructions, job->metadata, std::exchange(job->block, nullptr));
+  if (block->size == 0)
+  {
+    SetCodeLUT(pc, g_interpret_block);
+    BacklinkBlocks(pc, g_interpret_block);
+    return true;
+  }
+
+  DebugAssert(job->host_code == s_code_buffer.GetFreeCodePointer());
+  s_code_buffer.CommitCode(job->host_code_size);
+  s_code_buffer.CommitFarCode(job->host_far_code_size);
+  block->host_code = job->host_code;
+
+  // Exits were emitted as jumps to the compiler, link them now that we know where they go.
+  for (const auto& [code, target_pc] : job->links)
+  {
+    const void* dst = CreateBlockLink(block, code, target_pc);
+    if (dst != g_compile_or_revalidate_block)
+      EmitJump(code, dst, true);
+  }
+
+  for (const auto& [code_address, info] : job->loadstores)
+    s_fastmem_backpatch_info.insert_or_assign(code_address, info);
+
+  RegisterCompiledBlock(block, job->host_code_size, job->host_far_code_size);
+  RecordProfiledBlock(block);
+
+  SetCodeLUT(pc, block->host_code);
+  BacklinkBlocks(pc, block->host_code);
+  return true;
+}
+
+void CPU::CodeCache::FinishBackgroundCompile()
+{
+  if (!s_background_compile_job)
+    return;
+
+  WaitForBackgroundCompile();
+  InstallBackgroundCompile();
+}
+
+void CPU::CodeCache::StopBackgroundCompileThread()
+{
+  if (!s_background_compile_thread.joinable())
+    return;
+
+  {
+    std::unique_lock lock(s_background_compile_mutex);
+    s_background_compile_thread_shutdown = true;
+    s_background_compile_cv.notify_all();
+  }
+
+  s_background_compile_thread.join();
+  s_background_compile_thread_shutdown = false;
+}
+
+void CPU::CodeCache::BackgroundCompileThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("Background Compile");
+
+  std::unique_lock lock(s_background_compile_mutex);
+  for (;;)
+  {
+    s_background_compile_cv.wait(
+      lock, []() { return (s_background_compile_request != nullptr || s_background_compile_thread_shutdown); });
+    if (s_background_compile_thread_shutdown)
+      break;
+
+    BackgroundCompileJob* job = std::exchange(s_background_compile_request, nullptr);
+    lock.unlock();
+
+#ifdef ENABLE_NEWREC
+    s_compiling_job = job;
+    MemMap::BeginCodeWrite();
+    job->host_code = NewRec::g_background_compiler->CompileBlockInBackground(
+      job->block, job->regs, &job->host_code_size, &job->host_far_code_size);
+    MemMap::EndCodeWrite();
+    s_compiling_job = nullptr;
+#endif
+
+    lock.lock();
+    job->compiled.store(true, std::memory_order_release);
+    s_background_compile_cv.notify_all();
+  }
+}
+
+void CPU::CodeCache::DiscardAndRecompileBlock(u32 start_pc)
+{
+  MemMap::BeginCodeWrite();
+
+  Log_DevPrintf("Discard block %08X with manual protection", start_pc);
+  Block* block = LookupBlock(start_pc);
+  DebugAssert(block && block->state == BlockState::Valid);
+  InvalidateBlock(block, BlockState::NeedsRecompile);
+  CompileOrRevalidateBlock(start_pc);
+
+  MemMap::EndCodeWrite();
+}
+
+const void* CPU::CodeCache::CreateBlockLink(Block* block, void* code, u32 newpc)
+{
+  // self-linking should be handled by the caller
+  DebugAssert(newpc != block->pc);
+
+  // The compile thread can't touch the link map, the link is created when the block is installed.
+  if (s_compiling_job)
+  {
+    if (!g_settings.cpu_recompiler_block_linking)
+      return g_dispatcher;
+
+    s_compiling_job->links.emplace_back(code, newpc);
+    return g_compile_or_revalidate_block;
+  }
+
+  const void* dst = g_dispatcher;
+  if (g_settings.cpu_recompiler_block_linking)
+  {
+    const Block* next_block = LookupBlock(newpc);
+    if (next_block)
+    {
+      dst = (next_block->state == BlockState::Valid && next_block->host_code) ?
+              next_block->host_code :
+              ((next_block->state == BlockState::FallbackToInterpreter) ? g_interpret_block :
+                                                                          g_compile_or_revalidate_block);
+      DebugAssert(dst);
+    }
+    else
+    {
+      dst = g_compile_or_revalidate_block;
+    }
+
+    BlockLinkMap::iterator iter = s_block_links.emplace(newpc, code);
+    DebugAssert(block->num_exit_links < MAX_BLOCK_EXIT_LINKS);
+    block->exit_links[block->num_exit_links++] = iter;
+  }
+
+  Log_DebugPrintf("Linking %p with dst pc %08X to %p%s", code, newpc, dst,
+                  (dst == g_compile_or_revalidate_block) ? "[compiler]" : "");
+  return dst;
+}
+
+void CPU::CodeCache::BacklinkBlocks(u32 pc, const void* dst)
+{
+  if (!g_settings.cpu_recompiler_block_linking)
+    return;
+
+  const auto link_range = s_block_links.equal_range(pc);
+  for (auto it = link_range.first; it != link_range.second; ++it)
+  {
+    Log_DebugPrintf("Backlinking %p with dst pc %08X to %p%s", it->second, pc, dst,
+                    (dst == g_compile_or_revalidate_block) ? "[compiler]" : "");
+    EmitJump(it->second, dst, true);
+  }
+}
+
+void CPU::CodeCache::UnlinkBlockExits(Block* block)
 {
   const u32 num_exit_links = block->num_exit_links;
   for (u32 i = 0; i < num_exit_links; i++)
@@ -1468,14 +2479,144 @@ void CPU::CodeCache::CompileASMFunctions()
 
   const u32 asm_size = EmitASMFunctions(s_code_buffer.GetFreeCodePointer(), s_code_buffer.GetFreeCodeSpace());
 
-#ifdef ENABLE_RECOMPILER_PROFILING
   MIPSPerfScope.Register(s_code_buffer.GetFreeCodePointer(), asm_size, "ASMFunctions");
-#endif
 
   s_code_buffer.CommitCode(asm_size);
   MemMap::EndCodeWrite();
 }
 
+void CPU::CodeCache::InitializeCodeBufferSegments()
+{
+  // ASM functions live at the start of the buffer, and never get evicted.
+  s_code_segment_base = s_code_buffer.GetCodeUsed();
+  s_code_segment_size =
+    Common::AlignDownPow2((s_code_buffer.GetCodeSize() - s_code_segment_base) / CODE_BUFFER_SEGMENT_COUNT, 16);
+  s_far_code_segment_size = Common::AlignDownPow2(s_code_buffer.GetFarCodeSize() / CODE_BUFFER_SEGMENT_COUNT, 16);
+  s_current_code_segment = 0;
+  SetCodeBufferSegment(0);
+}
+
+void CPU::CodeCache::SetCodeBufferSegment(u32 segment)
+{
+  const u32 code_start = s_code_segment_base + (segment * s_code_segment_size);
+  const u32 far_code_start = segment * s_far_code_segment_size;
+  s_code_buffer.SetAllocationRange(code_start, code_start + s_code_segment_size, far_code_start,
+                                   far_code_start + s_far_code_segment_size);
+}
+
+void CPU::CodeCache::EvictCodeBufferSegment(u32 segment)
+{
+  SetCodeBufferSegment(segment);
+
+  const u8* code_start = s_code_buffer.GetFreeCodePointer();
+  const u8* code_end = code_start + s_code_buffer.GetFreeCodeSpace();
+  const u8* far_code_start = s_code_buffer.GetFreeFarCodePointer();
+  const u8* far_code_end = far_code_start + s_code_buffer.GetFreeFarCodeSpace();
+  u32 num_evicted = 0;
+
+  // A block's own far code is always allocated from the same segment as its near code.
+  for (Block* block : s_blocks)
+  {
+    const u8* host_code = static_cast<const u8*>(block->host_code);
+    if (host_code < code_start || host_code >= code_end)
+      continue;
+
+    EvictBlock(block);
+    num_evicted++;
+  }
+
+  // Backpatch thunks aren't, so blocks elsewhere which still jump to a thunk in this segment have to go too.
+  for (size_t i = 0; i < s_backpatch_thunks.size();)
+  {
+    const BackpatchThunk& thunk = s_backpatch_thunks[i];
+    const u8* thunk_code = static_cast<const u8*>(thunk.thunk_code);
+    const u8* block_host_code = static_cast<const u8*>(thunk.block_host_code);
+    if (thunk_code >= far_code_start && thunk_code < far_code_end)
+    {
+      // Only if it hasn't been recompiled since.
+      Block* block = LookupBlock(thunk.block_pc);
+      if (block && block->host_code && block->host_code == thunk.block_host_code)
+      {
+        Log_DevFmt("Evicting block {:08X} due to backpatch thunk at {}", block->pc, thunk.thunk_code);
+        EvictBlock(block);
+        num_evicted++;
+      }
+    }
+    else if (block_host_code < code_start || block_host_code >= code_end)
+    {
+      i++;
+      continue;
+    }
+
+    s_backpatch_thunks[i] = s_backpatch_thunks.back();
+    s_backpatch_thunks.pop_back();
+  }
+
+  for (auto iter = s_fastmem_backpatch_info.begin(); iter != s_fastmem_backpatch_info.end();)
+  {
+    const u8* code_address = static_cast<const u8*>(iter->first);
+    if ((code_address >= code_start && code_address < code_end) ||
+        (code_address >= far_code_start && code_address < far_code_end))
+    {
+      iter = s_fastmem_backpatch_info.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+
+  if (num_evicted > 0)
+  {
+    s_code_buffer_stats.evictions++;
+    s_code_buffer_stats.evicted_blocks += num_evicted;
+  }
+
+  Log_DevFmt("Evicted {} blocks from code buffer segment {}", num_evicted, segment);
+}
+
+void CPU::CodeCache::EvictBlock(Block* block)
+{
+  // Anything linking to this block gets sent back to the compiler. Its own exit links are in the code being
+  // thrown away, so they have to be removed from the link map too.
+  RemoveBlockFromPageList(block);
+  InvalidateBlock(block, BlockState::NeedsRecompile);
+  UnlinkBlockExits(block);
+  block->host_code = nullptr;
+
+  // Being evicted isn't the block's fault, don't count it towards the interpreter fallback.
+  block->compile_frame = System::GetFrameNumber();
+  block->compile_count = 0;
+}
+
+u32 CPU::CodeCache::GetCodeBufferSegment(const void* host_code)
+{
+  const u32 offset = static_cast<u32>(static_cast<const u8*>(host_code) - s_code_buffer.GetCodePointer());
+  DebugAssert(offset >= s_code_segment_base);
+  return std::min((offset - s_code_segment_base) / s_code_segment_size, CODE_BUFFER_SEGMENT_COUNT - 1);
+}
+
+void CPU::CodeCache::EnsureBackpatchThunkSpace(const void* host_pc)
+{
+  // Thunks are never bigger than the far code for a single instruction.
+  if (s_code_buffer.GetFreeFarCodeSpace() >= Recompiler::MAX_FAR_HOST_BYTES_PER_INSTRUCTION)
+    return;
+
+  // The faulting block is still executing, and can still jump to its own far code after the thunk returns, so the
+  // thunk can't be written over the top of it. If it's in the next segment, evict that, but skip over it for
+  // allocation. The memory won't be reused until the buffer wraps around again.
+  u32 segment = (s_current_code_segment + 1) % CODE_BUFFER_SEGMENT_COUNT;
+  if (GetCodeBufferSegment(host_pc) == segment)
+  {
+    EvictCodeBufferSegment(segment);
+    segment = (segment + 1) % CODE_BUFFER_SEGMENT_COUNT;
+  }
+
+  Log_DevFmt("No space for backpatch thunk in segment {}, moving to segment {}", s_current_code_segment, segment);
+  s_current_code_segment = segment;
+  EvictCodeBufferSegment(segment);
+}
+
 bool CPU::CodeCache::CompileBlock(Block* block)
 {
   const void* host_code = nullptr;
@@ -1503,6 +2644,14 @@ bool CPU::CodeCache::CompileBlock(Block* block)
     return false;
   }
 
+  RegisterCompiledBlock(block, host_code_size, host_far_code_size);
+  return true;
+}
+
+void CPU::CodeCache::RegisterCompiledBlock(Block* block, u32 host_code_size, u32 host_far_code_size)
+{
+  const void* host_code = block->host_code;
+
 #ifdef _DEBUG
   const u32 host_instructions = GetHostInstructionCount(host_code, host_code_size);
   s_total_instructions_compiled += block->size;
@@ -1526,11 +2675,10 @@ bool CPU::CodeCache::CompileBlock(Block* block)
   DisassembleAndLogHostCode(host_code, host_code_size);
 #endif
 
-#ifdef ENABLE_RECOMPILER_PROFILING
   MIPSPerfScope.RegisterPC(host_code, host_code_size, block->pc);
-#endif
 
-  return true;
+  if (g_settings.cpu_recompiler_block_stats)
+    RecordBlockStats(block, host_code_size + host_far_code_size);
 }
 
 void CPU::CodeCache::AddLoadStoreInfo(void* code_address, u32 code_size, u32 guest_pc, const void* thunk_address)
@@ -1556,10 +2704,6 @@ void CPU::CodeCache::AddLoadStoreInfo(void* code_address, u32 code_size, u32 gue
   DebugAssert(code_size < std::numeric_limits<u8>::max());
   DebugAssert(cycles >= 0 && cycles < std::numeric_limits<u16>::max());
 
-  auto iter = s_fastmem_backpatch_info.find(code_address);
-  if (iter != s_fastmem_backpatch_info.end())
-    s_fastmem_backpatch_info.erase(iter);
-
   LoadstoreBackpatchInfo info;
   info.thunk_address = nullptr;
   info.guest_pc = guest_pc;
@@ -1572,6 +2716,18 @@ void CPU::CodeCache::AddLoadStoreInfo(void* code_address, u32 code_size, u32 gue
   info.is_signed = is_signed;
   info.is_load = is_load;
   info.code_size = static_cast<u8>(code_size);
+
+  // Registered when the block is installed.
+  if (s_compiling_job)
+  {
+    s_compiling_job->loadstores.emplace_back(code_address, info);
+    return;
+  }
+
+  auto iter = s_fastmem_backpatch_info.find(code_address);
+  if (iter != s_fastmem_backpatch_info.end())
+    s_fastmem_backpatch_info.erase(iter);
+
   s_fastmem_backpatch_info.emplace(code_address, info);
 }
 
@@ -1613,7 +2769,7 @@ Common::PageFaultHandler::HandlerResult CPU::CodeCache::HandleFastmemException(v
 
   // if we're writing to ram, let it go through a few times, and use manual block protection to sort it out
   // TODO: path for manual protection to return back to read-only pages
-  LoadstoreBackpatchInfo& info = iter->second;
+  const LoadstoreBackpatchInfo info = iter->second;
   if (is_write && !g_state.cop0_regs.sr.Isc && AddressInRAM(guest_address))
   {
     Log_DevFmt("Ignoring fault due to RAM write @ 0x{:08X}", guest_address);
@@ -1626,16 +2782,31 @@ Common::PageFaultHandler::HandlerResult CPU::CodeCache::HandleFastmemException(v
              info.gpr_bitmask, static_cast<unsigned>(info.address_register), static_cast<unsigned>(info.data_register),
              info.AccessSizeInBytes(), static_cast<unsigned>(info.is_signed));
 
+  // Erase it now, making space for the thunk can evict segments, which invalidates the iterator.
+  s_fastmem_backpatch_info.erase(iter);
+
+  // The thunk can't be allocated while the compile thread is using the code buffer, and it reads the faulting PCs.
+  CancelBackgroundCompile();
+
   MemMap::BeginCodeWrite();
 
+  // newrec allocates the thunk now, oldrec already did when compiling the block
+  const bool allocates_thunk = (g_settings.cpu_execution_mode == CPUExecutionMode::NewRec);
+  if (allocates_thunk)
+    EnsureBackpatchThunkSpace(exception_pc);
+
+  const void* thunk_code = s_code_buffer.GetFreeFarCodePointer();
   BackpatchLoadStore(exception_pc, info);
 
   // queue block for recompilation later
-  if (g_settings.cpu_execution_mode == CPUExecutionMode::NewRec)
+  if (allocates_thunk)
   {
     Block* block = LookupBlock(info.guest_block);
     if (block)
     {
+      if (block->host_code)
+        s_backpatch_thunks.push_back(BackpatchThunk{thunk_code, block->host_code, block->pc});
+
       // This is a bit annoying, we have to remove it from the page list if it's a RAM block.
       Log_DevFmt("Queuing block {:08X} for recompilation due to backpatch", block->pc);
       RemoveBlockFromPageList(block);
@@ -1651,7 +2822,6 @@ Common::PageFaultHandler::HandlerResult CPU::CodeCache::HandleFastmemException(v
 
   // and store the pc in the faulting list, so that we don't emit another fastmem loadstore
   s_fastmem_faulting_pcs.insert(info.guest_pc);
-  s_fastmem_backpatch_info.erase(iter);
   return Common::PageFaultHandler::HandlerResult::ContinueExecution;
 }
 
@@ -1673,3 +2843,298 @@ void CPU::CodeCache::BackpatchLoadStore(void* host_pc, const LoadstoreBackpatchI
 }
 
 #endif // ENABLE_RECOMPILER_SUPPORT
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MARK: - Block Profile
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CPU::CodeCache::SetBlockProfilePath(std::string path)
+{
+  if (s_block_profile_path == path)
+    return;
+
+  SaveBlockProfile();
+
+  s_block_profile_path = std::move(path);
+  s_block_profile.clear();
+  s_precompile_queue.clear();
+  s_precompile_queue_position = 0;
+  s_precompile_frames_remaining = 0;
+  s_block_profile_dirty = false;
+
+  if (!s_block_profile_path.empty())
+    LoadBlockProfile();
+}
+
+void CPU::CodeCache::LoadBlockProfile()
+{
+  std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(s_block_profile_path.c_str());
+  if (!data.has_value())
+    return;
+
+  BlockProfileHeader header;
+  if (data->size() < sizeof(header))
+  {
+    Log_WarningFmt("Block profile '{}' is truncated.", Path::GetFileName(s_block_profile_path));
+    return;
+  }
+
+  std::memcpy(&header, data->data(), sizeof(header));
+  if (header.magic != BLOCK_PROFILE_MAGIC || header.version != BLOCK_PROFILE_VERSION ||
+      header.num_entries > MAX_BLOCK_PROFILE_ENTRIES ||
+      data->size() < (sizeof(header) + sizeof(BlockProfileEntry) * header.num_entries))
+  {
+    Log_WarningFmt("Block profile '{}' is invalid or from an older version, ignoring.",
+                   Path::GetFileName(s_block_profile_path));
+    return;
+  }
+
+  s_precompile_queue.resize(header.num_entries);
+  std::memcpy(s_precompile_queue.data(), data->data() + sizeof(header),
+              sizeof(BlockProfileEntry) * header.num_entries);
+  for (const BlockProfileEntry& entry : s_precompile_queue)
+    s_block_profile.emplace(entry.hash, entry);
+
+  s_precompile_frames_remaining = PRECOMPILE_FRAMES;
+  Log_InfoFmt("Loaded {} blocks from profile '{}'.", header.num_entries, Path::GetFileName(s_block_profile_path));
+}
+
+void CPU::CodeCache::SaveBlockProfile()
+{
+  if (s_block_profile_path.empty() || !s_block_profile_dirty)
+    return;
+
+  std::vector<u8> data(sizeof(BlockProfileHeader) + sizeof(BlockProfileEntry) * s_block_profile.size());
+  BlockProfileHeader header = {};
+  header.magic = BLOCK_PROFILE_MAGIC;
+  header.version = BLOCK_PROFILE_VERSION;
+  header.num_entries = static_cast<u32>(s_block_profile.size());
+  std::memcpy(data.data(), &header, sizeof(header));
+
+  u8* entry_ptr = data.data() + sizeof(header);
+  for (const auto& it : s_block_profile)
+  {
+    std::memcpy(entry_ptr, &it.second, sizeof(BlockProfileEntry));
+    entry_ptr += sizeof(BlockProfileEntry);
+  }
+
+  const std::string directory = std::string(Path::GetDirectory(s_block_profile_path));
+  if (!FileSystem::EnsureDirectoryExists(directory.c_str(), false) ||
+      !FileSystem::WriteBinaryFile(s_block_profile_path.c_str(), data.data(), data.size()))
+  {
+    Log_ErrorFmt("Failed to write block profile '{}'.", s_block_profile_path);
+    return;
+  }
+
+  Log_InfoFmt("Wrote {} blocks to profile '{}'.", header.num_entries, Path::GetFileName(s_block_profile_path));
+  s_block_profile_dirty = false;
+}
+
+void CPU::CodeCache::PrecompileProfiledBlocks()
+{
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  const bool idle_loop_skipped = std::exchange(s_idle_loop_skipped, false);
+  if (s_precompile_frames_remaining == 0 || !IsUsingAnyRecompiler())
+    return;
+
+  // Code usually isn't loaded when we boot, so keep checking the queue for a while. Anything which hasn't shown up
+  // after that is probably in a part of the game which isn't being played.
+  if ((--s_precompile_frames_remaining) == 0 || s_precompile_queue.empty())
+  {
+    s_precompile_frames_remaining = 0;
+    s_precompile_queue = {};
+    return;
+  }
+
+  // Only compile when the game is waiting anyway, i.e. it sat in an idle loop this frame, or it's loading from the
+  // disc. Otherwise we'd be adding the compile time on top of a busy frame, which is the stutter this is avoiding.
+  if (!idle_loop_skipped && !CDROM::IsSeeking())
+    return;
+
+  SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::CodeCompile);
+  MemMap::BeginCodeWrite();
+  FinishBackgroundCompile();
+
+  u32 blocks_compiled = 0;
+  for (u32 i = 0; i < PRECOMPILE_CHECKS_PER_FRAME && blocks_compiled < PRECOMPILE_BLOCKS_PER_FRAME &&
+                  !s_precompile_queue.empty();
+       i++)
+  {
+    if (s_precompile_queue_position >= s_precompile_queue.size())
+      s_precompile_queue_position = 0;
+
+    // Entries are dropped once they're compiled, or can never be.
+    const BlockProfileEntry& entry = s_precompile_queue[s_precompile_queue_position];
+    const u32 code_used = s_code_buffer.GetTotalUsed();
+    if (!PrecompileProfiledBlock(entry))
+    {
+      s_precompile_queue_position++;
+      continue;
+    }
+
+    blocks_compiled += BoolToUInt32(s_code_buffer.GetTotalUsed() != code_used);
+    s_precompile_queue[s_precompile_queue_position] = s_precompile_queue.back();
+    s_precompile_queue.pop_back();
+  }
+
+  MemMap::EndCodeWrite();
+
+  if (blocks_compiled > 0)
+    Log_DevFmt("Precompiled {} blocks, {} remaining.", blocks_compiled, s_precompile_queue.size());
+#endif
+}
+
+#ifdef ENABLE_RECOMPILER_SUPPORT
+
+u64 CPU::CodeCache::GetBlockProfileHash(u32 pc, const void* instructions, u32 size)
+{
+  return XXH64(instructions, sizeof(Instruction) * size, pc);
+}
+
+void CPU::CodeCache::RecordProfiledBlock(const Block* block)
+{
+  if (s_block_profile_path.empty() || !AddressInRAM(block->pc) || s_block_profile.size() >= MAX_BLOCK_PROFILE_ENTRIES)
+    return;
+
+  const u64 hash = GetBlockProfileHash(block->pc, block->Instructions(), block->size);
+  if (s_block_profile.emplace(hash, BlockProfileEntry{hash, block->pc, block->size}).second)
+    s_block_profile_dirty = true;
+}
+
+bool CPU::CodeCache::PrecompileProfiledBlock(const BlockProfileEntry& entry)
+{
+  // Already compiled, or was compiled and then invalidated, leave it to the normal path.
+  const u32 table = entry.pc >> LUT_TABLE_SHIFT;
+  if (!s_block_lut[table] || LookupBlock(entry.pc))
+    return true;
+
+  const PhysicalMemoryAddress phys_addr = VirtualAddressToPhysical(entry.pc);
+  if (entry.size == 0 || (phys_addr + (sizeof(Instruction) * entry.size)) > Bus::g_ram_size)
+    return true;
+
+  // Not loaded yet?
+  if (GetBlockProfileHash(entry.pc, Bus::g_ram + phys_addr, entry.size) != entry.hash)
+    return false;
+
+  BlockMetadata metadata = {};
+  if (!ReadBlockInstructions(entry.pc, &s_block_instructions, &metadata, true) ||
+      s_block_instructions.size() != entry.size)
+  {
+    return true;
+  }
+
+  EnsureCodeBufferSpace(entry.pc, entry.size);
+
+  Block* block = CreateBlock(entry.pc, s_block_instructions, metadata);
+  if (block->size == 0 || !CompileBlock(block))
+  {
+    SetCodeLUT(entry.pc, g_interpret_block);
+    BacklinkBlocks(entry.pc, g_interpret_block);
+    return true;
+  }
+
+  SetCodeLUT(entry.pc, block->host_code);
+  BacklinkBlocks(entry.pc, block->host_code);
+  return true;
+}
+
+#endif // ENABLE_RECOMPILER_SUPPORT
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MARK: - Block Statistics
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifdef ENABLE_RECOMPILER_SUPPORT
+
+void CPU::CodeCache::CountBlockExecution()
+{
+  // Blocks store their PC before calling, since linked blocks don't go through the dispatcher.
+  const auto iter = s_block_stats.find(g_state.pc);
+  if (iter != s_block_stats.end())
+    iter->second.execution_count++;
+}
+
+void CPU::CodeCache::RecordBlockStats(const Block* block, u32 host_code_size)
+{
+  const InstructionInfo* iinfo = block->InstructionsInfo();
+  u32 guest_instructions = 0;
+  for (u32 i = 0; i < block->size; i++)
+    guest_instructions += BoolToUInt32(!iinfo[i].is_jump_gap);
+
+  BlockStats& stats = s_block_stats[block->pc];
+  stats.cycles_per_execution = guest_instructions + static_cast<u32>(block->uncached_fetch_ticks);
+  stats.guest_instructions = guest_instructions;
+  stats.host_code_size = host_code_size;
+  stats.compile_count++;
+}
+
+std::vector<std::pair<u32, CPU::CodeCache::BlockStats>> CPU::CodeCache::GetSortedBlockStats(u64* total_cycles)
+{
+  std::vector<std::pair<u32, BlockStats>> ret(s_block_stats.begin(), s_block_stats.end());
+  std::sort(ret.begin(), ret.end(), [](const auto& lhs, const auto& rhs) {
+    const u64 lhs_cycles = lhs.second.execution_count * lhs.second.cycles_per_execution;
+    const u64 rhs_cycles = rhs.second.execution_count * rhs.second.cycles_per_execution;
+    return (lhs_cycles != rhs_cycles) ? (lhs_cycles > rhs_cycles) : (lhs.first < rhs.first);
+  });
+
+  *total_cycles = 0;
+  for (const auto& it : ret)
+    *total_cycles += it.second.execution_count * it.second.cycles_per_execution;
+
+  return ret;
+}
+
+void CPU::CodeCache::AppendBlockStatsLine(std::string* dest, u32 pc, const BlockStats& stats, u64 total_cycles)
+{
+  const u64 cycles = stats.execution_count * stats.cycles_per_execution;
+  fmt::format_to(std::back_inserter(*dest), "{:08X} {:>12} {:>14} {:>7.2f}% {:>6} {:>9} {:>8}", pc,
+                 stats.execution_count, cycles,
+                 (total_cycles > 0) ? (static_cast<double>(cycles) * 100.0 / static_cast<double>(total_cycles)) : 0.0,
+                 stats.guest_instructions, stats.host_code_size, stats.compile_count);
+}
+
+void CPU::CodeCache::LogBlockStats()
+{
+  u64 total_cycles;
+  const std::vector<std::pair<u32, BlockStats>> sorted = GetSortedBlockStats(&total_cycles);
+
+  Log_InfoFmt("Block stats: {} blocks, {} estimated cycles, hottest blocks:", sorted.size(), total_cycles);
+  std::string line;
+  for (size_t i = 0; i < std::min<size_t>(sorted.size(), BLOCK_STATS_LOG_COUNT); i++)
+  {
+    line.clear();
+    AppendBlockStatsLine(&line, sorted[i].first, sorted[i].second, total_cycles);
+    Log_InfoFmt("  {}", line);
+  }
+}
+
+#endif // ENABLE_RECOMPILER_SUPPORT
+
+bool CPU::CodeCache::WriteBlockStatsReport(const char* path)
+{
+#ifdef ENABLE_RECOMPILER_SUPPORT
+  u64 total_cycles;
+  const std::vector<std::pair<u32, BlockStats>> sorted = GetSortedBlockStats(&total_cycles);
+
+  std::string report = fmt::format("# {} blocks, {} estimated cycles\n", sorted.size(), total_cycles);
+  fmt::format_to(std::back_inserter(report), "# {:<6} {:>12} {:>14} {:>8} {:>6} {:>9} {:>8}\n", "PC", "Executions",
+                 "Cycles", "Percent", "Insns", "HostBytes", "Compiles");
+  for (const auto& [pc, stats] : sorted)
+  {
+    AppendBlockStatsLine(&report, pc, stats, total_cycles);
+    report.push_back('\n');
+  }
+
+  if (!FileSystem::WriteStringToFile(path, report))
+  {
+    Log_ErrorFmt("Failed to write block stats to '{}'.", path);
+    return false;
+  }
+
+  Log_InfoFmt("Wrote stats for {} blocks to '{}'.", sorted.size(), path);
+  return true;
+#else
+  Log_ErrorPrint("Block stats require a recompiler.");
+  return false;
+#endif
+}
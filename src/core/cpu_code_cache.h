@@ -6,8 +6,20 @@
 #include "bus.h"
 #include "cpu_types.h"
 
+#include <string>
+
 namespace CPU::CodeCache {
 
+/// Statistics for partial code buffer evictions, only updated when a recompiler is in use.
+struct CodeBufferStats
+{
+  u32 evictions;            // number of code buffer segments which were reused
+  u32 evicted_blocks;       // number of blocks which were discarded by evictions
+  u32 recompiled_blocks;    // number of evicted blocks which were compiled again
+  u64 recompiled_bytes;     // host code bytes emitted for recompiled blocks
+  double recompile_time_ms; // time spent compiling previously-evicted blocks
+};
+
 /// Returns true if any recompiler is in use.
 bool IsUsingAnyRecompiler();
 
@@ -38,4 +50,23 @@ void InvalidateBlocksWithPageIndex(u32 page_index);
 /// Invalidates all blocks in the cache.
 void InvalidateAllRAMBlocks();
 
+/// Returns eviction statistics since the system started.
+const CodeBufferStats& GetCodeBufferStats();
+
+/// Sets the file which hot blocks for the running game are recorded to, writing out the previous one. Blocks from the
+/// new profile get compiled ahead of time once their code is in RAM. An empty path disables profiling.
+void SetBlockProfilePath(std::string path);
+
+/// Compiles a batch of blocks from the block profile, call once per frame. Nothing is compiled unless an idle loop was
+/// skipped during the frame, or the CD drive is seeking.
+void PrecompileProfiledBlocks();
+
+/// Waits for the block being compiled on the background compile thread, if any, and throws it away. The block is
+/// queued again the next time it's executed. Call before changing anything the compiler reads, e.g. settings.
+void CancelBackgroundCompile();
+
+/// Writes the execution count, estimated guest cycles, and host code size of every compiled block, hottest first.
+/// Only populated when CPU/RecompilerBlockStats is enabled.
+bool WriteBlockStatsReport(const char* path);
+
 } // namespace CPU::CodeCache
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "bus.h"
+#include "common/align.h"
 #include "common/bitfield.h"
 #include "common/perf_scope.h"
 #include "cpu_code_cache.h"
@@ -31,7 +32,8 @@ enum : u32
   LUT_TABLE_SIZE = 0x10000 / sizeof(u32), // 16384, one for each PC
   LUT_TABLE_SHIFT = 16,
 
-  MAX_BLOCK_EXIT_LINKS = 2,
+  // two for the branch ending the block, plus the side exits of superblocks
+  MAX_BLOCK_EXIT_LINKS = 10,
 };
 
 using CodeLUT = const void**;
@@ -59,6 +61,7 @@ struct InstructionInfo
   bool is_last_instruction : 1;
   bool has_load_delay : 1;
   bool can_trap : 1;
+  bool is_jump_gap : 1; // Skipped over by a followed jump, never executed.
 
   u8 reg_flags[static_cast<u8>(Reg::count)];
   // Reg write_reg[3];
@@ -86,6 +89,19 @@ struct InstructionInfo
   inline bool ReadsReg(Reg reg) const { return (read_reg[0] == reg || read_reg[1] == reg || read_reg[2] == reg); }
 };
 
+/// Instruction pre-decoded by the cached interpreter, so it can be executed with a single indirect call.
+struct CachedInterpreterInstruction
+{
+  void (*handler)(const CachedInterpreterInstruction* ci);
+  u32 bits;
+  u32 pc;
+  u32 imm; // sign/zero-extended or shifted as the instruction needs, or the shift amount
+  u8 rd;
+  u8 rs;
+  u8 rt;
+  bool is_branch_delay_slot;
+};
+
 enum class BlockState : u8
 {
   Valid,
@@ -100,6 +116,9 @@ enum class BlockFlags : u8
   ContainsLoadStoreInstructions = (1 << 0),
   SpansPages = (1 << 1),
   BranchDelaySpansPages = (1 << 2),
+  ContainsJumpGap = (1 << 3),
+  IdleLoop = (1 << 4),
+  ContainsSideExit = (1 << 5),
 };
 IMPLEMENT_ENUM_CLASS_BITWISE_OPERATORS(BlockFlags);
 
@@ -145,6 +164,9 @@ struct alignas(16) Block
   u32 compile_frame;
   u8 compile_count;
 
+  // number of times executed by the interpreter tier, before being compiled
+  u16 interpret_count;
+
   // followed by Instruction * size, InstructionRegInfo * size
   ALWAYS_INLINE const Instruction* Instructions() const { return reinterpret_cast<const Instruction*>(this + 1); }
   ALWAYS_INLINE Instruction* Instructions() { return reinterpret_cast<Instruction*>(this + 1); }
@@ -158,6 +180,18 @@ struct alignas(16) Block
     return reinterpret_cast<InstructionInfo*>(Instructions() + size);
   }
 
+  // cached interpreter blocks are additionally followed by CachedInterpreterInstruction * size
+  ALWAYS_INLINE const CachedInterpreterInstruction* CachedInterpreterInstructions() const
+  {
+    return reinterpret_cast<const CachedInterpreterInstruction*>(Common::AlignUpPow2(
+      reinterpret_cast<uintptr_t>(InstructionsInfo() + size), alignof(CachedInterpreterInstruction)));
+  }
+  ALWAYS_INLINE CachedInterpreterInstruction* CachedInterpreterInstructions()
+  {
+    return reinterpret_cast<CachedInterpreterInstruction*>(Common::AlignUpPow2(
+      reinterpret_cast<uintptr_t>(InstructionsInfo() + size), alignof(CachedInterpreterInstruction)));
+  }
+
   // returns true if the block has a given flag
   ALWAYS_INLINE bool HasFlag(BlockFlags flag) const { return ((flags & flag) != BlockFlags::None); }
 
@@ -230,6 +264,12 @@ void InterpretCachedBlock(const Block* block);
 template<PGXPMode pgxp_mode>
 void InterpretUncachedBlock();
 
+/// Fills in the pre-decoded instructions for a cached interpreter block.
+void DecodeThreadedBlock(Block* block);
+
+/// Executes a block through its pre-decoded instructions. Only usable without PGXP.
+void InterpretThreadedBlock(const Block* block);
+
 void LogCurrentState();
 
 #if defined(ENABLE_RECOMPILER) || defined(ENABLE_NEWREC)
@@ -240,11 +280,6 @@ void LogCurrentState();
 #define ENABLE_HOST_DISASSEMBLY 1
 #endif
 
-#if false
-// Enable profiling of JIT blocks.
-#define ENABLE_RECOMPILER_PROFILING 1
-#endif
-
 JitCodeBuffer& GetCodeBuffer();
 const void* GetInterpretUncachedBlockFunction();
 
@@ -258,6 +293,21 @@ void AddLoadStoreInfo(void* code_address, u32 code_size, u32 guest_pc, u32 guest
                       bool is_load);
 bool HasPreviouslyFaultedOnPC(u32 guest_pc);
 
+/// CPU state captured when a block is queued for background compilation. The compile thread starts its speculative
+/// constants from this, since g_state keeps changing underneath it.
+struct BackgroundCompileRegs
+{
+  std::array<u32, static_cast<u8>(Reg::count)> gpr;
+  u32 cop0_sr;
+};
+
+/// Called on entry to each compiled block when block stats are enabled, with g_state.pc set to the block's PC.
+void CountBlockExecution();
+
+/// Called when an idle loop block branches back to itself, with g_state.pc set to the block's PC. Fast-forwards to
+/// the next event if the loop only reads memory which can't change before then.
+void SkipIdleLoop();
+
 u32 EmitASMFunctions(void* code, u32 code_size);
 u32 EmitJump(void* code, const void* dst, bool flush_icache);
 
@@ -275,12 +325,8 @@ extern const void* g_block_dispatcher;
 extern const void* g_interpret_block;
 extern const void* g_discard_and_recompile_block;
 
-#ifdef ENABLE_RECOMPILER_PROFILING
-
 extern PerfScope MIPSPerfScope;
 
-#endif // ENABLE_RECOMPILER_PROFILING
-
 #endif // ENABLE_RECOMPILER
 
 } // namespace CPU::CodeCache
@@ -2370,6 +2370,289 @@ template void CPU::CodeCache::InterpretCachedBlock<PGXPMode::Disabled>(const Blo
 template void CPU::CodeCache::InterpretCachedBlock<PGXPMode::Memory>(const Block* block);
 template void CPU::CodeCache::InterpretCachedBlock<PGXPMode::CPU>(const Block* block);
 
+namespace CPU::CodeCache {
+static void ThreadedNop(const CachedInterpreterInstruction* ci);
+static void ThreadedGeneric(const CachedInterpreterInstruction* ci);
+static void (*GetThreadedHandler(const Instruction inst, CachedInterpreterInstruction* ci))(
+  const CachedInterpreterInstruction*);
+} // namespace CPU::CodeCache
+
+// Simple instructions don't need any of the current instruction state, only loads and stores which can raise
+// exceptions do. These never run in a branch delay slot, nor is the previous instruction a taken branch.
+#define THREADED_SET_EXCEPTION_STATE()                                                                                 \
+  g_state.current_instruction.bits = ci->bits;                                                                         \
+  g_state.current_instruction_pc = ci->pc;                                                                             \
+  g_state.current_instruction_in_branch_delay_slot = false;                                                            \
+  g_state.current_instruction_was_branch_taken = false;
+
+#define THREADED_RS() g_state.regs.r[ci->rs]
+#define THREADED_RT() g_state.regs.r[ci->rt]
+#define THREADED_ALU(name, dst, expr)                                                                                  \
+  static void Threaded_##name(const CachedInterpreterInstruction* ci)                                                  \
+  {                                                                                                                    \
+    WriteReg(static_cast<Reg>(ci->dst), (expr));                                                                       \
+  }
+
+namespace CPU::CodeCache {
+// rd/rt is never $zero for these, those instructions are decoded as nops.
+THREADED_ALU(sll, rd, THREADED_RT() << ci->imm);
+THREADED_ALU(srl, rd, THREADED_RT() >> ci->imm);
+THREADED_ALU(sra, rd, static_cast<u32>(static_cast<s32>(THREADED_RT()) >> ci->imm));
+THREADED_ALU(sllv, rd, THREADED_RT() << (THREADED_RS() & 0x1F));
+THREADED_ALU(srlv, rd, THREADED_RT() >> (THREADED_RS() & 0x1F));
+THREADED_ALU(srav, rd, static_cast<u32>(static_cast<s32>(THREADED_RT()) >> (THREADED_RS() & 0x1F)));
+THREADED_ALU(mfhi, rd, g_state.regs.hi);
+THREADED_ALU(mflo, rd, g_state.regs.lo);
+THREADED_ALU(addu, rd, THREADED_RS() + THREADED_RT());
+THREADED_ALU(subu, rd, THREADED_RS() - THREADED_RT());
+THREADED_ALU(and, rd, THREADED_RS() & THREADED_RT());
+THREADED_ALU(or, rd, THREADED_RS() | THREADED_RT());
+THREADED_ALU(xor, rd, THREADED_RS() ^ THREADED_RT());
+THREADED_ALU(nor, rd, ~(THREADED_RS() | THREADED_RT()));
+THREADED_ALU(slt, rd, BoolToUInt32(static_cast<s32>(THREADED_RS()) < static_cast<s32>(THREADED_RT())));
+THREADED_ALU(sltu, rd, BoolToUInt32(THREADED_RS() < THREADED_RT()));
+THREADED_ALU(addiu, rt, THREADED_RS() + ci->imm);
+THREADED_ALU(slti, rt, BoolToUInt32(static_cast<s32>(THREADED_RS()) < static_cast<s32>(ci->imm)));
+THREADED_ALU(sltiu, rt, BoolToUInt32(THREADED_RS() < ci->imm));
+THREADED_ALU(andi, rt, THREADED_RS() & ci->imm);
+THREADED_ALU(ori, rt, THREADED_RS() | ci->imm);
+THREADED_ALU(xori, rt, THREADED_RS() ^ ci->imm);
+THREADED_ALU(lui, rt, ci->imm);
+
+static void Threaded_lb(const CachedInterpreterInstruction* ci)
+{
+  THREADED_SET_EXCEPTION_STATE();
+  u8 value;
+  if (ReadMemoryByte(THREADED_RS() + ci->imm, &value))
+    WriteRegDelayed(static_cast<Reg>(ci->rt), SignExtend32(value));
+}
+
+static void Threaded_lbu(const CachedInterpreterInstruction* ci)
+{
+  THREADED_SET_EXCEPTION_STATE();
+  u8 value;
+  if (ReadMemoryByte(THREADED_RS() + ci->imm, &value))
+    WriteRegDelayed(static_cast<Reg>(ci->rt), ZeroExtend32(value));
+}
+
+static void Threaded_lh(const CachedInterpreterInstruction* ci)
+{
+  THREADED_SET_EXCEPTION_STATE();
+  u16 value;
+  if (ReadMemoryHalfWord(THREADED_RS() + ci->imm, &value))
+    WriteRegDelayed(static_cast<Reg>(ci->rt), SignExtend32(value));
+}
+
+static void Threaded_lhu(const CachedInterpreterInstruction* ci)
+{
+  THREADED_SET_EXCEPTION_STATE();
+  u16 value;
+  if (ReadMemoryHalfWord(THREADED_RS() + ci->imm, &value))
+    WriteRegDelayed(static_cast<Reg>(ci->rt), ZeroExtend32(value));
+}
+
+static void Threaded_lw(const CachedInterpreterInstruction* ci)
+{
+  THREADED_SET_EXCEPTION_STATE();
+  u32 value;
+  if (ReadMemoryWord(THREADED_RS() + ci->imm, &value))
+    WriteRegDelayed(static_cast<Reg>(ci->rt), value);
+}
+
+static void Threaded_sb(const CachedInterpreterInstruction* ci)
+{
+  THREADED_SET_EXCEPTION_STATE();
+  WriteMemoryByte(THREADED_RS() + ci->imm, THREADED_RT());
+}
+
+static void Threaded_sh(const CachedInterpreterInstruction* ci)
+{
+  THREADED_SET_EXCEPTION_STATE();
+  WriteMemoryHalfWord(THREADED_RS() + ci->imm, THREADED_RT());
+}
+
+static void Threaded_sw(const CachedInterpreterInstruction* ci)
+{
+  THREADED_SET_EXCEPTION_STATE();
+  WriteMemoryWord(THREADED_RS() + ci->imm, THREADED_RT());
+}
+} // namespace CPU::CodeCache
+
+#undef THREADED_ALU
+#undef THREADED_RT
+#undef THREADED_RS
+#undef THREADED_SET_EXCEPTION_STATE
+
+void CPU::CodeCache::ThreadedNop(const CachedInterpreterInstruction* ci)
+{
+}
+
+void CPU::CodeCache::ThreadedGeneric(const CachedInterpreterInstruction* ci)
+{
+  g_state.current_instruction.bits = ci->bits;
+  g_state.current_instruction_pc = ci->pc;
+  g_state.current_instruction_in_branch_delay_slot = ci->is_branch_delay_slot;
+  g_state.current_instruction_was_branch_taken = g_state.branch_was_taken;
+  g_state.branch_was_taken = false;
+  ExecuteInstruction<PGXPMode::Disabled, false>();
+}
+
+void (*CPU::CodeCache::GetThreadedHandler(const Instruction inst, CachedInterpreterInstruction* ci))(
+  const CachedInterpreterInstruction*)
+{
+  switch (inst.op)
+  {
+    case InstructionOp::funct:
+    {
+      if (inst.r.rd == Reg::zero)
+      {
+        // Writes to $zero with no side effects. Anything which can trap or touches hi/lo still has to run.
+        switch (inst.r.funct)
+        {
+          case InstructionFunct::sll:
+          case InstructionFunct::srl:
+          case InstructionFunct::sra:
+          case InstructionFunct::sllv:
+          case InstructionFunct::srlv:
+          case InstructionFunct::srav:
+          case InstructionFunct::mfhi:
+          case InstructionFunct::mflo:
+          case InstructionFunct::addu:
+          case InstructionFunct::subu:
+          case InstructionFunct::and_:
+          case InstructionFunct::or_:
+          case InstructionFunct::xor_:
+          case InstructionFunct::nor:
+          case InstructionFunct::slt:
+          case InstructionFunct::sltu:
+            return &ThreadedNop;
+
+          default:
+            return &ThreadedGeneric;
+        }
+      }
+
+      ci->imm = inst.r.shamt;
+      switch (inst.r.funct)
+      {
+          // clang-format off
+        case InstructionFunct::sll: return &Threaded_sll;
+        case InstructionFunct::srl: return &Threaded_srl;
+        case InstructionFunct::sra: return &Threaded_sra;
+        case InstructionFunct::sllv: return &Threaded_sllv;
+        case InstructionFunct::srlv: return &Threaded_srlv;
+        case InstructionFunct::srav: return &Threaded_srav;
+        case InstructionFunct::mfhi: return &Threaded_mfhi;
+        case InstructionFunct::mflo: return &Threaded_mflo;
+        case InstructionFunct::addu: return &Threaded_addu;
+        case InstructionFunct::subu: return &Threaded_subu;
+        case InstructionFunct::and_: return &Threaded_and;
+        case InstructionFunct::or_: return &Threaded_or;
+        case InstructionFunct::xor_: return &Threaded_xor;
+        case InstructionFunct::nor: return &Threaded_nor;
+        case InstructionFunct::slt: return &Threaded_slt;
+        case InstructionFunct::sltu: return &Threaded_sltu;
+        default: return &ThreadedGeneric;
+          // clang-format on
+      }
+    }
+
+    case InstructionOp::addiu:
+    case InstructionOp::slti:
+    case InstructionOp::sltiu:
+    case InstructionOp::andi:
+    case InstructionOp::ori:
+    case InstructionOp::xori:
+    case InstructionOp::lui:
+    {
+      if (inst.i.rt == Reg::zero)
+        return &ThreadedNop;
+
+      switch (inst.op)
+      {
+          // clang-format off
+        case InstructionOp::addiu: return &Threaded_addiu;
+        case InstructionOp::slti: return &Threaded_slti;
+        case InstructionOp::sltiu: return &Threaded_sltiu;
+        case InstructionOp::andi: ci->imm = inst.i.imm_zext32(); return &Threaded_andi;
+        case InstructionOp::ori: ci->imm = inst.i.imm_zext32(); return &Threaded_ori;
+        case InstructionOp::xori: ci->imm = inst.i.imm_zext32(); return &Threaded_xori;
+        case InstructionOp::lui: ci->imm = inst.i.imm_zext32() << 16; return &Threaded_lui;
+        default: return &ThreadedGeneric;
+          // clang-format on
+      }
+    }
+
+      // Loads to $zero still have to go through the bus, WriteRegDelayed() drops the value.
+      // clang-format off
+    case InstructionOp::lb: return &Threaded_lb;
+    case InstructionOp::lbu: return &Threaded_lbu;
+    case InstructionOp::lh: return &Threaded_lh;
+    case InstructionOp::lhu: return &Threaded_lhu;
+    case InstructionOp::lw: return &Threaded_lw;
+    case InstructionOp::sb: return &Threaded_sb;
+    case InstructionOp::sh: return &Threaded_sh;
+    case InstructionOp::sw: return &Threaded_sw;
+      // clang-format on
+
+    default:
+      return &ThreadedGeneric;
+  }
+}
+
+void CPU::CodeCache::DecodeThreadedBlock(Block* block)
+{
+  const Instruction* instruction = block->Instructions();
+  const InstructionInfo* info = block->InstructionsInfo();
+  CachedInterpreterInstruction* ci = block->CachedInterpreterInstructions();
+
+  for (u32 i = 0; i < block->size; i++, instruction++, info++, ci++)
+  {
+    ci->bits = instruction->bits;
+    ci->pc = info->pc;
+    ci->imm = instruction->i.imm_sext32();
+    ci->rd = static_cast<u8>(instruction->r.rd.GetValue());
+    ci->rs = static_cast<u8>(instruction->r.rs.GetValue());
+    ci->rt = static_cast<u8>(instruction->r.rt.GetValue());
+    ci->is_branch_delay_slot = info->is_branch_delay_slot;
+
+    // Branches need the full state for links and delay slots, and so does the end of the block, since it's what the
+    // uncached interpreter picks up from if an interrupt is pending.
+    ci->handler = (info->is_branch_delay_slot || info->is_last_instruction) ? &ThreadedGeneric :
+                                                                              GetThreadedHandler(*instruction, ci);
+  }
+}
+
+void CPU::CodeCache::InterpretThreadedBlock(const Block* block)
+{
+  DebugAssert(g_state.pc == block->pc);
+  g_state.npc = block->pc + 4;
+  g_state.exception_raised = false;
+
+  const CachedInterpreterInstruction* ci = block->CachedInterpreterInstructions();
+  const CachedInterpreterInstruction* const end_ci = ci + block->size;
+
+  do
+  {
+    g_state.pending_ticks++;
+    g_state.pc = g_state.npc;
+    g_state.npc += 4;
+
+    ci->handler(ci);
+
+    // next load delay
+    UpdateLoadDelay();
+
+    if (g_state.exception_raised)
+      break;
+
+    ci++;
+  } while (ci != end_ci);
+
+  // cleanup so the interpreter can kick in if needed
+  g_state.next_instruction_is_branch_delay_slot = false;
+}
+
 template<PGXPMode pgxp_mode>
 void CPU::CodeCache::InterpretUncachedBlock()
 {
@@ -80,6 +80,12 @@ void CPU::NewRec::Compiler::BeginBlock()
   if (m_block->uncached_fetch_ticks > 0 || m_block->icache_line_count > 0)
     GenerateICacheCheckAndUpdate();
 
+  if (g_settings.cpu_recompiler_block_stats)
+  {
+    StoreConstantToCPUPointer(m_block->pc, &g_state.pc);
+    GenerateCall(reinterpret_cast<const void*>(&CPU::CodeCache::CountBlockExecution));
+  }
+
   if (g_settings.bios_tty_logging)
   {
     if (m_block->pc == 0xa0)
@@ -141,12 +147,25 @@ const void* CPU::NewRec::Compiler::CompileBlock(CodeCache::Block* block, u32* ho
   const void* code = EndCompile(&code_size, &far_code_size);
   *host_code_size = code_size;
   *host_far_code_size = far_code_size;
-  buffer.CommitCode(code_size);
-  buffer.CommitFarCode(far_code_size);
+  if (!m_background_regs)
+  {
+    buffer.CommitCode(code_size);
+    buffer.CommitFarCode(far_code_size);
+  }
 
   return code;
 }
 
+const void* CPU::NewRec::Compiler::CompileBlockInBackground(CodeCache::Block* block,
+                                                            const CodeCache::BackgroundCompileRegs& regs,
+                                                            u32* host_code_size, u32* host_far_code_size)
+{
+  m_background_regs = &regs;
+  const void* code = CompileBlock(block, host_code_size, host_far_code_size);
+  m_background_regs = nullptr;
+  return code;
+}
+
 void CPU::NewRec::Compiler::SetConstantReg(Reg r, u32 v)
 {
   DebugAssert(r < Reg::count && r != Reg::zero);
@@ -333,6 +352,41 @@ u32 CPU::NewRec::Compiler::GetConditionalBranchTarget(CompileFlags cf) const
   return current_pc + (inst->i.imm_sext32() << 2);
 }
 
+bool CPU::NewRec::Compiler::DoesBlockContinueAfterBranchNotTaken() const
+{
+  // Superblocks keep going after a biased branch's delay slot. The taken side starts with a gap up to the target.
+  // Blocks also continue after a branch in a branch delay slot, that's not a superblock.
+  const CodeCache::InstructionInfo* branch_info = m_block->InstructionsInfo() + (inst - m_block->Instructions());
+  if (branch_info->is_last_instruction)
+    return false;
+
+  const CodeCache::InstructionInfo* delay_slot_info = branch_info + 1;
+  return (!delay_slot_info->is_last_instruction && !delay_slot_info->is_branch_instruction &&
+          !(delay_slot_info + 1)->is_jump_gap);
+}
+
+CPU::NewRec::Compiler::BranchCondition CPU::NewRec::Compiler::InvertBranchCondition(BranchCondition cond)
+{
+  switch (cond)
+  {
+    case BranchCondition::Equal:
+      return BranchCondition::NotEqual;
+    case BranchCondition::NotEqual:
+      return BranchCondition::Equal;
+    case BranchCondition::GreaterThanZero:
+      return BranchCondition::LessEqualZero;
+    case BranchCondition::GreaterEqualZero:
+      return BranchCondition::LessThanZero;
+    case BranchCondition::LessThanZero:
+      return BranchCondition::GreaterEqualZero;
+    case BranchCondition::LessEqualZero:
+      return BranchCondition::GreaterThanZero;
+    default:
+      UnreachableCode();
+      return cond;
+  }
+}
+
 u32 CPU::NewRec::Compiler::GetBranchReturnAddress(CompileFlags cf) const
 {
   // compiler pc has already been advanced when swapping branch delay slots
@@ -1361,6 +1415,34 @@ void CPU::NewRec::Compiler::CompileBranchDelaySlot(bool dirty_pc /* = true */)
   m_current_instruction_branch_delay_slot = false;
 }
 
+bool CPU::NewRec::Compiler::TryFollowJump(u32 newpc)
+{
+  // A branch in the delay slot ends the block itself.
+  if (m_block_ended || iinfo->is_last_instruction || iinfo->is_branch_instruction)
+    return false;
+
+  // Registers stay cached across the jump, the main loop will step onto the target.
+  u32 gap_size = 0;
+  while ((iinfo + 1 + gap_size)->is_jump_gap)
+    gap_size++;
+  if ((iinfo + 1 + gap_size)->pc != newpc)
+    return false;
+
+  // Swapped delay slots leave inst at the branch, and iinfo at the delay slot.
+  iinfo += gap_size;
+  inst = m_block->Instructions() + (iinfo - m_block->InstructionsInfo());
+  Log_DebugFmt("Following jump to {:08X}", newpc);
+  m_current_instruction_pc = newpc - sizeof(Instruction);
+  m_compiler_pc = newpc;
+  return true;
+}
+
+void CPU::NewRec::Compiler::GenerateIdleLoopSkip(const std::optional<u32>& newpc)
+{
+  if (newpc.has_value() && newpc.value() == m_block->pc && m_block->HasFlag(CodeCache::BlockFlags::IdleLoop))
+    GenerateCall(reinterpret_cast<const void*>(&CPU::CodeCache::SkipIdleLoop));
+}
+
 void CPU::NewRec::Compiler::CompileTemplate(void (Compiler::*const_func)(CompileFlags),
                                             void (Compiler::*func)(CompileFlags), const void* pgxp_cpu_func, u32 tflags)
 {
@@ -1749,7 +1831,8 @@ void CPU::NewRec::Compiler::Compile_j()
   // TODO: Delay slot swap.
   // We could also move the cycle commit back.
   CompileBranchDelaySlot();
-  EndBlock(newpc, true);
+  if (!TryFollowJump(newpc))
+    EndBlock(newpc, true);
 }
 
 void CPU::NewRec::Compiler::Compile_jr_const(CompileFlags cf)
@@ -1771,7 +1854,8 @@ void CPU::NewRec::Compiler::Compile_jal()
   const u32 newpc = (m_compiler_pc & UINT32_C(0xF0000000)) | (inst->j.target << 2);
   SetConstantReg(Reg::ra, GetBranchReturnAddress({}));
   CompileBranchDelaySlot();
-  EndBlock(newpc, true);
+  if (!TryFollowJump(newpc))
+    EndBlock(newpc, true);
 }
 
 void CPU::NewRec::Compiler::Compile_jalr_const(CompileFlags cf)
@@ -1811,7 +1895,10 @@ void CPU::NewRec::Compiler::Compile_b_const(CompileFlags cf)
     SetConstantReg(Reg::ra, GetBranchReturnAddress(cf));
 
   CompileBranchDelaySlot();
-  EndBlock(taken ? taken_pc : m_compiler_pc, true);
+
+  const u32 newpc = taken ? taken_pc : m_compiler_pc;
+  if (!TryFollowJump(newpc))
+    EndBlock(newpc, true);
 }
 
 void CPU::NewRec::Compiler::Compile_b(CompileFlags cf)
@@ -1904,7 +1991,10 @@ void CPU::NewRec::Compiler::Compile_bxx_const(CompileFlags cf, BranchCondition c
 
   const u32 taken_pc = GetConditionalBranchTarget(cf);
   CompileBranchDelaySlot();
-  EndBlock(taken ? taken_pc : m_compiler_pc, true);
+
+  const u32 newpc = taken ? taken_pc : m_compiler_pc;
+  if (!TryFollowJump(newpc))
+    EndBlock(newpc, true);
 }
 
 void CPU::NewRec::Compiler::Compile_sll_const(CompileFlags cf)
@@ -2314,6 +2404,7 @@ void CPU::NewRec::BackpatchLoadStore(void* exception_pc, const CodeCache::Loadst
     static_cast<TickCount>(static_cast<u32>(info.cycles)) - (info.is_load ? Bus::RAM_READ_TICKS : 0);
   const TickCount cycles_to_remove = static_cast<TickCount>(static_cast<u32>(info.cycles));
 
+  // the code cache has already made room for the thunk in the current segment
   JitCodeBuffer& buffer = CodeCache::GetCodeBuffer();
   void* thunk_address = buffer.GetFreeFarCodePointer();
   const u32 thunk_size = CompileLoadStoreThunk(
@@ -2333,6 +2424,16 @@ void CPU::NewRec::BackpatchLoadStore(void* exception_pc, const CodeCache::Loadst
 
 void CPU::NewRec::Compiler::InitSpeculativeRegs()
 {
+  if (m_background_regs)
+  {
+    for (u8 i = 0; i < static_cast<u8>(Reg::count); i++)
+      m_speculative_constants.regs[i] = m_background_regs->gpr[i];
+
+    m_speculative_constants.cop0_sr = m_background_regs->cop0_sr;
+    m_speculative_constants.memory.clear();
+    return;
+  }
+
   for (u8 i = 0; i < static_cast<u8>(Reg::count); i++)
     m_speculative_constants.regs[i] = g_state.regs.r[i];
 
@@ -2382,6 +2483,10 @@ CPU::NewRec::Compiler::SpecValue CPU::NewRec::Compiler::SpecReadMem(VirtualMemor
   if (it != m_speculative_constants.memory.end())
     return it->second;
 
+  // The CPU thread could be writing to it.
+  if (m_background_regs)
+    return std::nullopt;
+
   u32 value;
   if ((address & SCRATCHPAD_ADDR_MASK) == SCRATCHPAD_ADDR)
   {
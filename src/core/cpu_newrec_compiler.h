@@ -41,6 +41,12 @@ public:
 
   const void* CompileBlock(CodeCache::Block* block, u32* host_code_size, u32* host_far_code_size);
 
+  /// Compiles a block on the background compile thread. Speculative constants start from the captured registers, and
+  /// RAM isn't speculated on, since the CPU thread is still running. The code is left uncommitted in the free area of
+  /// the code buffer, for the CPU thread to commit when it installs the block.
+  const void* CompileBlockInBackground(CodeCache::Block* block, const CodeCache::BackgroundCompileRegs& regs,
+                                       u32* host_code_size, u32* host_far_code_size);
+
 protected:
   enum FlushFlags : u32
   {
@@ -196,6 +202,8 @@ protected:
 
   Reg MipsD() const;
   u32 GetConditionalBranchTarget(CompileFlags cf) const;
+  bool DoesBlockContinueAfterBranchNotTaken() const;
+  static BranchCondition InvertBranchCondition(BranchCondition cond);
   u32 GetBranchReturnAddress(CompileFlags cf) const;
   bool TrySwapDelaySlot(Reg rs = Reg::zero, Reg rt = Reg::zero, Reg rd = Reg::zero);
   void SetCompilerPC(u32 newpc);
@@ -266,6 +274,13 @@ protected:
   void CompileInstruction();
   void CompileBranchDelaySlot(bool dirty_pc = true);
 
+  /// Skips over the gap after a branch's delay slot when the block continues at newpc. Returns false if the block ends
+  /// after the delay slot, or continues along the other side of a conditional branch.
+  bool TryFollowJump(u32 newpc);
+
+  /// Fast-forwards to the next event when an idle loop branches back to itself. Registers must be flushed.
+  void GenerateIdleLoopSkip(const std::optional<u32>& newpc);
+
   void CompileTemplate(void (Compiler::*const_func)(CompileFlags), void (Compiler::*func)(CompileFlags),
                        const void* pgxp_cpu_func, u32 tflags);
   void CompileLoadStoreTemplate(void (Compiler::*func)(CompileFlags, MemoryAccessSize, bool, bool,
@@ -397,6 +412,7 @@ protected:
   static std::pair<u32*, GTERegisterAccessAction> GetGTERegisterPointer(u32 index, bool writing);
 
   CodeCache::Block* m_block = nullptr;
+  const CodeCache::BackgroundCompileRegs* m_background_regs = nullptr;
   u32 m_compiler_pc = 0;
   TickCount m_cycles = 0;
   TickCount m_gte_done_cycle = 0;
@@ -532,4 +548,5 @@ u32 CompileLoadStoreThunk(void* thunk_code, u32 thunk_space, void* code_address,
                           MemoryAccessSize size, bool is_signed, bool is_load);
 
 extern Compiler* g_compiler;
+extern Compiler* g_background_compiler;
 } // namespace CPU::NewRec
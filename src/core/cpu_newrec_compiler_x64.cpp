@@ -47,6 +47,8 @@ using CPU::Recompiler::IsCallerSavedRegister;
 namespace CPU::NewRec {
 X64Compiler s_instance;
 Compiler* g_compiler = &s_instance;
+X64Compiler s_background_instance;
+Compiler* g_background_compiler = &s_background_instance;
 } // namespace CPU::NewRec
 
 CPU::NewRec::X64Compiler::X64Compiler() = default;
@@ -232,6 +234,7 @@ void CPU::NewRec::X64Compiler::EndBlock(const std::optional<u32>& newpc, bool do
 
   // flush regs
   Flush(FLUSH_END_BLOCK);
+  GenerateIdleLoopSkip(newpc);
   EndAndLinkBlock(newpc, do_event_test, false);
 }
 
@@ -680,6 +683,12 @@ void CPU::NewRec::X64Compiler::Compile_bxx(CompileFlags cf, BranchCondition cond
 {
   const u32 taken_pc = GetConditionalBranchTarget(cf);
 
+  // Superblocks carry on along the path at the label, so it has to be the one the block continues with. The inline
+  // path then becomes the side exit.
+  const bool continue_not_taken = DoesBlockContinueAfterBranchNotTaken();
+  if (continue_not_taken)
+    cond = InvertBranchCondition(cond);
+
   Flush(FLUSH_FOR_BRANCH);
 
   DebugAssert(cf.valid_host_s);
@@ -741,7 +750,7 @@ void CPU::NewRec::X64Compiler::Compile_bxx(CompileFlags cf, BranchCondition cond
   if (!cf.delay_slot_swapped)
     CompileBranchDelaySlot();
 
-  EndBlock(m_compiler_pc, true);
+  EndBlock(continue_not_taken ? taken_pc : m_compiler_pc, true);
 
   cg->L(taken);
 
@@ -749,7 +758,9 @@ void CPU::NewRec::X64Compiler::Compile_bxx(CompileFlags cf, BranchCondition cond
   if (!cf.delay_slot_swapped)
     CompileBranchDelaySlot();
 
-  EndBlock(taken_pc, true);
+  const u32 label_pc = continue_not_taken ? m_compiler_pc : taken_pc;
+  if (!TryFollowJump(label_pc))
+    EndBlock(label_pc, true);
 }
 
 void CPU::NewRec::X64Compiler::Compile_addi(CompileFlags cf)
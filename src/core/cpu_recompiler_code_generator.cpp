@@ -996,6 +996,12 @@ void CodeGenerator::BlockPrologue()
       EmitFunctionCall(nullptr, &CPU::HandleB0Syscall);
   }
 
+  if (g_settings.cpu_recompiler_block_stats)
+  {
+    EmitStoreCPUStructField(offsetof(State, pc), Value::FromConstantU32(m_pc));
+    EmitFunctionCall(nullptr, &CodeCache::CountBlockExecution);
+  }
+
   if (m_block->uncached_fetch_ticks > 0 || m_block->icache_line_count > 0)
     EmitICacheCheckAndUpdate();
 
@@ -2436,6 +2442,18 @@ bool CodeGenerator::Compile_Branch(Instruction instruction, const CodeCache::Ins
       EmitLoadCPUStructField(pending_ticks.GetHostRegister(), RegSize_32, offsetof(State, pending_ticks));
       EmitLoadCPUStructField(downcount.GetHostRegister(), RegSize_32, offsetof(State, downcount));
 
+      // idle loops fast-forward to the next event when branching back to themselves
+      const auto skip_idle_loop = [this, &pending_ticks](const Value& target) {
+        if (!m_block->HasFlag(CodeCache::BlockFlags::IdleLoop) || !target.IsConstant() ||
+            static_cast<u32>(target.constant_value) != m_block->pc)
+        {
+          return;
+        }
+
+        EmitFunctionCall(nullptr, &CodeCache::SkipIdleLoop);
+        EmitLoadCPUStructField(pending_ticks.GetHostRegister(), RegSize_32, offsetof(State, pending_ticks));
+      };
+
       // pending < downcount
       LabelType return_to_dispatcher;
 
@@ -2445,6 +2463,7 @@ bool CodeGenerator::Compile_Branch(Instruction instruction, const CodeCache::Ins
         m_register_cache.PushState();
         {
           WriteNewPC(branch_target, false);
+          skip_idle_loop(branch_target);
           EmitConditionalBranch(Condition::GreaterEqual, false, pending_ticks.GetHostRegister(), downcount,
                                 &return_to_dispatcher);
 
@@ -2479,6 +2498,7 @@ bool CodeGenerator::Compile_Branch(Instruction instruction, const CodeCache::Ins
       else
       {
         WriteNewPC(branch_target, true);
+        skip_idle_loop(branch_target);
       }
 
       EmitConditionalBranch(Condition::GreaterEqual, false, pending_ticks.GetHostRegister(), downcount,
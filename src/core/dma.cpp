@@ -589,6 +589,29 @@ bool DMA::TransferChannel()
       {
         do
         {
+          if constexpr (channel == Channel::GPU)
+          {
+            // Blocks going to a VRAM write never drop the request, so the blocks the slice would run can be sent as
+            // one span. Ticks are still counted per block.
+            const TickCount block_ticks = Bus::GetDMARAMTickCount(block_size);
+            const u32 slice_blocks = static_cast<u32>(std::max((ticks_remaining + block_ticks - 1) / block_ticks, 1));
+            const u32 count =
+              std::min(std::min(g_gpu->GetBulkDMAWriteWordCount() / block_size, blocks_remaining), slice_blocks);
+            const u32 span_address = current_address & mask;
+            if (count > 1 && increment == 4 && ((span_address + (increment * block_size * count)) & mask) > span_address)
+            {
+              blocks_remaining -= count;
+
+              TransferMemoryToDevice<channel>(span_address, increment, block_size * count);
+              const TickCount ticks = block_ticks * static_cast<TickCount>(count);
+              CPU::AddPendingTicks(ticks);
+              ticks_remaining -= ticks;
+
+              current_address = (current_address + (increment * block_size * count));
+              continue;
+            }
+          }
+
           blocks_remaining--;
 
           const TickCount ticks = TransferMemoryToDevice<channel>(current_address & mask, increment, block_size);
@@ -711,12 +734,20 @@ TickCount DMA::TransferMemoryToDevice(u32 address, u32 increment, u32 word_count
       if (g_gpu->BeginDMAWrite()) [[likely]]
       {
         u8* ram_pointer = Bus::g_ram;
-        for (u32 i = 0; i < word_count; i++)
+        if (increment == 4 && ((address + (increment * word_count)) & mask) > address)
         {
-          u32 value;
-          std::memcpy(&value, &ram_pointer[address], sizeof(u32));
-          g_gpu->DMAWrite(address, value);
-          address = (address + increment) & mask;
+          // Doesn't wrap around RAM, so commands and VRAM writes can be read straight from it.
+          g_gpu->DMAWriteSpan(address, reinterpret_cast<const u32*>(&ram_pointer[address]), word_count);
+        }
+        else
+        {
+          for (u32 i = 0; i < word_count; i++)
+          {
+            u32 value;
+            std::memcpy(&value, &ram_pointer[address], sizeof(u32));
+            g_gpu->DMAWrite(address, value);
+            address = (address + increment) & mask;
+          }
         }
         g_gpu->EndDMAWrite();
       }
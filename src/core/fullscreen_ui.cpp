@@ -3046,6 +3046,16 @@ void FullscreenUI::DrawConsoleSettingsPage()
     bsi, FSUI_CSTR("Readahead Sectors"),
     FSUI_CSTR("Reduces hitches in emulation by reading/decompressing CD data asynchronously on a worker thread."),
     "CDROM", "ReadaheadSectors", Settings::DEFAULT_CDROM_READAHEAD_SECTORS, 0, 32, "%d sectors");
+  DrawIntRangeSetting(bsi, FSUI_CSTR("CHD Hunk Cache Size"),
+                      FSUI_CSTR("Number of decompressed CHD hunks kept in memory. Larger values reduce decompression "
+                                "when games re-read recently accessed data."),
+                      "CDROM", "CHDHunkCacheSize", Settings::DEFAULT_CDROM_CHD_HUNK_CACHE_SIZE, 1,
+                      Settings::MAX_CDROM_CHD_HUNK_CACHE_SIZE, "%d hunks");
+  DrawIntRangeSetting(
+    bsi, FSUI_CSTR("CHD Prefetch Hunks"),
+    FSUI_CSTR("Decompresses upcoming CHD hunks on worker threads during sequential reads. Set to zero to disable."),
+    "CDROM", "CHDPrefetchHunks", Settings::DEFAULT_CDROM_CHD_PREFETCH_HUNKS, 0, Settings::MAX_CDROM_CHD_PREFETCH_HUNKS,
+    "%d hunks");
 
   DrawToggleSetting(bsi, FSUI_CSTR("Enable Region Check"),
                     FSUI_CSTR("Simulates the region check present in original, unmodified consoles."), "CDROM",
@@ -3131,6 +3141,15 @@ void FullscreenUI::DrawEmulationSettingsPage()
     bsi, FSUI_CSTR("Rewind Save Slots"),
     FSUI_CSTR("How many saves will be kept for rewinding. Higher values have greater memory requirements."), "Main",
     "RewindSaveSlots", 10, 1, 10000, "%d Frames");
+  DrawToggleSetting(bsi, FSUI_CSTR("Rewind Delta Compression"),
+                    FSUI_CSTR("Stores rewind states as differences against the previous state, keeping as many as "
+                              "fit in the system memory the save slots would use. VRAM is read back for each state, "
+                              "so hardware renderers rewind at native resolution."),
+                    "Main", "RewindDeltaCompression", false);
+  DrawIntRangeSetting(
+    bsi, FSUI_CSTR("Rewind Keyframe Interval"),
+    FSUI_CSTR("How many delta-compressed rewind states are stored between each complete state."), "Main",
+    "RewindKeyframeInterval", 10, 1, 1000, "%d Saves");
 
   const s32 runahead_frames = GetEffectiveIntSetting(bsi, "Main", "RunaheadFrameCount", 0);
   const bool runahead_enabled = (runahead_frames > 0);
@@ -3949,6 +3968,10 @@ void FullscreenUI::DrawDisplaySettingsPage()
       DrawToggleSetting(bsi, FSUI_CSTR("Threaded Rendering"),
                         FSUI_CSTR("Uses a second thread for drawing graphics. Speed boost, and safe to use."), "GPU",
                         "UseThread", true);
+      DrawIntRangeSetting(bsi, FSUI_CSTR("Rasterizer Threads"),
+                          FSUI_CSTR("Splits software rasterization across multiple threads. 0 or 1 disables the "
+                                    "parallel rasterizer. Requires threaded rendering."),
+                          "GPU", "SoftwareRasterizerThreads", 0, 0, Settings::MAX_SW_RASTERIZER_THREADS);
     }
     break;
 
@@ -4798,6 +4821,23 @@ void FullscreenUI::DrawAdvancedSettingsPage()
     bsi, FSUI_CSTR("Enable Recompiler Block Linking"),
     FSUI_CSTR("Performance enhancement - jumps directly between blocks instead of returning to the dispatcher."), "CPU",
     "RecompilerBlockLinking", true);
+  DrawIntRangeSetting(bsi, FSUI_CSTR("Recompiler Compile Threshold"),
+                      FSUI_CSTR("Runs new blocks in the interpreter until they have executed this many times, reducing "
+                                "stutter from compiling code which only runs once. 0 compiles blocks immediately."),
+                      "CPU", "RecompilerCompileThreshold", 0, 0, Settings::MAX_CPU_RECOMPILER_COMPILE_THRESHOLD,
+                      "%d executions");
+  DrawToggleSetting(bsi, FSUI_CSTR("Enable Recompiler Jump Following"),
+                    FSUI_CSTR("Continues blocks through forward jumps instead of ending them, keeping registers cached "
+                              "across the jump. Only used by the new recompiler."),
+                    "CPU", "RecompilerFollowJumps", false);
+  DrawToggleSetting(bsi, FSUI_CSTR("Enable Recompiler Superblocks"),
+                    FSUI_CSTR("Continues blocks through forward jumps and branches which almost always go the same way, "
+                              "with an exit for the other direction. Needs a compile threshold to find those branches."),
+                    "CPU", "RecompilerSuperblocks", false);
+  DrawToggleSetting(bsi, FSUI_CSTR("Skip Idle Loops"),
+                    FSUI_CSTR("Fast-forwards loops which wait for the next frame or for hardware, instead of emulating "
+                              "every iteration. Reduces host CPU usage, but may affect timing in some games."),
+                    "CPU", "RecompilerIdleLoopSkipping", false);
   DrawEnumSetting(bsi, FSUI_CSTR("Recompiler Fast Memory Access"),
                   FSUI_CSTR("Avoids calls to C++ code, significantly speeding up the recompiler."), "CPU",
                   "FastmemMode", Settings::DEFAULT_CPU_FASTMEM_MODE, &Settings::ParseCPUFastmemMode,
@@ -6842,6 +6882,8 @@ TRANSLATE_NOOP("FullscreenUI", "Behavior");
 TRANSLATE_NOOP("FullscreenUI", "Borderless Fullscreen");
 TRANSLATE_NOOP("FullscreenUI", "Buffer Size");
 TRANSLATE_NOOP("FullscreenUI", "CD-ROM Emulation");
+TRANSLATE_NOOP("FullscreenUI", "CHD Hunk Cache Size");
+TRANSLATE_NOOP("FullscreenUI", "CHD Prefetch Hunks");
 TRANSLATE_NOOP("FullscreenUI", "CPU Emulation");
 TRANSLATE_NOOP("FullscreenUI", "CPU Mode");
 TRANSLATE_NOOP("FullscreenUI", "Cancel");
@@ -6893,6 +6935,7 @@ TRANSLATE_NOOP("FullscreenUI", "Crop Mode");
 TRANSLATE_NOOP("FullscreenUI", "Culling Correction");
 TRANSLATE_NOOP("FullscreenUI", "Current Game");
 TRANSLATE_NOOP("FullscreenUI", "Debugging Settings");
+TRANSLATE_NOOP("FullscreenUI", "Decompresses upcoming CHD hunks on worker threads during sequential reads. Set to zero to disable.");
 TRANSLATE_NOOP("FullscreenUI", "Default");
 TRANSLATE_NOOP("FullscreenUI", "Default Boot");
 TRANSLATE_NOOP("FullscreenUI", "Default View");
@@ -7022,6 +7065,7 @@ TRANSLATE_NOOP("FullscreenUI", "Hardcore mode will be enabled on next game resta
 TRANSLATE_NOOP("FullscreenUI", "Hide Cursor In Fullscreen");
 TRANSLATE_NOOP("FullscreenUI", "Hides the mouse pointer/cursor when the emulator is in fullscreen mode.");
 TRANSLATE_NOOP("FullscreenUI", "Hotkey Settings");
+TRANSLATE_NOOP("FullscreenUI", "How many delta-compressed rewind states are stored between each complete state.");
 TRANSLATE_NOOP("FullscreenUI", "How many saves will be kept for rewinding. Higher values have greater memory requirements.");
 TRANSLATE_NOOP("FullscreenUI", "How often a rewind state will be created. Higher frequencies have greater system requirements.");
 TRANSLATE_NOOP("FullscreenUI", "Identifies any new files added to the game directories.");
@@ -7099,6 +7143,7 @@ TRANSLATE_NOOP("FullscreenUI", "None (Double Speed)");
 TRANSLATE_NOOP("FullscreenUI", "None (Normal Speed)");
 TRANSLATE_NOOP("FullscreenUI", "Not Logged In");
 TRANSLATE_NOOP("FullscreenUI", "Not Scanning Subdirectories");
+TRANSLATE_NOOP("FullscreenUI", "Number of decompressed CHD hunks kept in memory. Larger values reduce decompression when games re-read recently accessed data.");
 TRANSLATE_NOOP("FullscreenUI", "OK");
 TRANSLATE_NOOP("FullscreenUI", "OSD Scale");
 TRANSLATE_NOOP("FullscreenUI", "On-Screen Display");
@@ -7143,6 +7188,7 @@ TRANSLATE_NOOP("FullscreenUI", "Provides vibration and LED control support over
 TRANSLATE_NOOP("FullscreenUI", "Push a controller button or axis now.");
 TRANSLATE_NOOP("FullscreenUI", "Quick Save");
 TRANSLATE_NOOP("FullscreenUI", "RAIntegration is being used instead of the built-in achievements implementation.");
+TRANSLATE_NOOP("FullscreenUI", "Rasterizer Threads");
 TRANSLATE_NOOP("FullscreenUI", "Read Speedup");
 TRANSLATE_NOOP("FullscreenUI", "Readahead Sectors");
 TRANSLATE_NOOP("FullscreenUI", "Recompiler Fast Memory Access");
@@ -7173,6 +7219,8 @@ TRANSLATE_NOOP("FullscreenUI", "Restores the state of the system prior to the la
 TRANSLATE_NOOP("FullscreenUI", "Resume");
 TRANSLATE_NOOP("FullscreenUI", "Resume Game");
 TRANSLATE_NOOP("FullscreenUI", "Reverses the game list sort order from the default (usually ascending to descending).");
+TRANSLATE_NOOP("FullscreenUI", "Rewind Delta Compression");
+TRANSLATE_NOOP("FullscreenUI", "Rewind Keyframe Interval");
 TRANSLATE_NOOP("FullscreenUI", "Rewind Save Frequency");
 TRANSLATE_NOOP("FullscreenUI", "Rewind Save Slots");
 TRANSLATE_NOOP("FullscreenUI", "Rewind for {0} frames, lasting {1:.2f} seconds will require up to {2} MB of RAM and {3} MB of VRAM.");
@@ -7258,6 +7306,7 @@ TRANSLATE_NOOP("FullscreenUI", "Spectator Mode");
 TRANSLATE_NOOP("FullscreenUI", "Speed Control");
 TRANSLATE_NOOP("FullscreenUI", "Speeds up CD-ROM reads by the specified factor. May improve loading speeds in some games, and break others.");
 TRANSLATE_NOOP("FullscreenUI", "Speeds up CD-ROM seeks by the specified factor. May improve loading speeds in some games, and break others.");
+TRANSLATE_NOOP("FullscreenUI", "Splits software rasterization across multiple threads. 0 or 1 disables the parallel rasterizer. Requires threaded rendering.");
 TRANSLATE_NOOP("FullscreenUI", "Stage {}: {}");
 TRANSLATE_NOOP("FullscreenUI", "Start BIOS");
 TRANSLATE_NOOP("FullscreenUI", "Start Download");
@@ -7265,6 +7314,7 @@ TRANSLATE_NOOP("FullscreenUI", "Start File");
 TRANSLATE_NOOP("FullscreenUI", "Start Fullscreen");
 TRANSLATE_NOOP("FullscreenUI", "Start the console without any disc inserted.");
 TRANSLATE_NOOP("FullscreenUI", "Starts the console from where it was before it was last closed.");
+TRANSLATE_NOOP("FullscreenUI", "Stores rewind states as differences against the previous state, keeping as many as fit in the system memory the save slots would use. VRAM is read back for each state, so hardware renderers rewind at native resolution.");
 TRANSLATE_NOOP("FullscreenUI", "Stores the current settings to an input profile.");
 TRANSLATE_NOOP("FullscreenUI", "Stretch Display Vertically");
 TRANSLATE_NOOP("FullscreenUI", "Stretch Mode");
@@ -37,7 +37,7 @@ namespace GameDatabase {
 enum : u32
 {
   GAME_DATABASE_CACHE_SIGNATURE = 0x45434C48,
-  GAME_DATABASE_CACHE_VERSION = 6,
+  GAME_DATABASE_CACHE_VERSION = 7,
 };
 
 static Entry* GetMutableEntry(const std::string_view& serial);
@@ -72,6 +72,7 @@ static std::array<const char*, static_cast<u32>(GameDatabase::Trait::Count)> s_t
   "ForceRecompilerMemoryExceptions",
   "ForceRecompilerICache",
   "ForceRecompilerLUTFastmem",
+  "DisableIdleLoopSkipping",
   "IsLibCryptProtected",
 }};
 
@@ -484,6 +485,12 @@ void GameDatabase::Entry::ApplySettings(Settings& settings, bool display_osd_mes
     settings.cpu_fastmem_mode = CPUFastmemMode::LUT;
   }
 
+  if (HasTrait(Trait::DisableIdleLoopSkipping))
+  {
+    Log_WarningPrint("Idle loop skipping disabled by compatibility settings.");
+    settings.cpu_recompiler_idle_loop_skipping = false;
+  }
+
 #define BIT_FOR(ctype) (static_cast<u16>(1) << static_cast<u32>(ctype))
 
   if (supported_controllers != 0 && supported_controllers != static_cast<u16>(-1))
@@ -48,6 +48,7 @@ enum class Trait : u32
   ForceRecompilerMemoryExceptions,
   ForceRecompilerICache,
   ForceRecompilerLUTFastmem,
+  DisableIdleLoopSkipping,
   IsLibCryptProtected,
 
   Count
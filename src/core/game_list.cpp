@@ -16,15 +16,22 @@
 #include "common/file_system.h"
 #include "common/heterogeneous_containers.h"
 #include "common/log.h"
+#include "common/memmap.h"
 #include "common/path.h"
 #include "common/progress_callback.h"
 #include "common/string_util.h"
+#include "common/threading.h"
+
+#include "xxhash.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
 #include <ctime>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -41,13 +48,19 @@ namespace {
 enum : u32
 {
   GAME_LIST_CACHE_SIGNATURE = 0x45434C48,
-  GAME_LIST_CACHE_VERSION = 34,
+  GAME_LIST_CACHE_VERSION = 35,
+
+  // Compaction is triggered once the journal reaches this many entries, or 1/16th of the indexed entries, whichever
+  // is smaller. Keeps the amount of parsing at startup bounded regardless of library size.
+  MAX_CACHE_JOURNAL_ENTRIES = 32,
 
   PLAYED_TIME_SERIAL_LENGTH = 32,
   PLAYED_TIME_LAST_TIME_LENGTH = 20,  // uint64
   PLAYED_TIME_TOTAL_TIME_LENGTH = 20, // uint64
   PLAYED_TIME_LINE_LENGTH =
     PLAYED_TIME_SERIAL_LENGTH + 1 + PLAYED_TIME_LAST_TIME_LENGTH + 1 + PLAYED_TIME_TOTAL_TIME_LENGTH,
+
+  MAX_SCAN_THREADS = 8,
 };
 
 struct PlayedTimeEntry
@@ -56,6 +69,73 @@ struct PlayedTimeEntry
   std::time_t total_played_time;
 };
 
+struct ScanRequest
+{
+  std::string path;
+  std::time_t timestamp;
+};
+
+// Cache file layout:
+//   CacheHeader
+//   CacheRecord[record_count]
+//   CacheIndexEntry[record_count], sorted by path hash
+//   String table, referenced by records
+//   Journal of entries added since the last compaction, in the serialized stream format
+struct CacheHeader
+{
+  u32 signature;
+  u32 version;
+  u32 record_count;
+  u32 reserved;
+  u64 records_offset;
+  u64 index_offset;
+  u64 strings_offset;
+  u64 strings_size;
+  u64 journal_offset;
+};
+static_assert(sizeof(CacheHeader) == 56);
+
+struct CacheStringRef
+{
+  u32 offset;
+  u32 length;
+};
+
+struct CacheRecord
+{
+  CacheStringRef path;
+  CacheStringRef serial;
+  CacheStringRef title;
+  CacheStringRef disc_set_name;
+  CacheStringRef genre;
+  CacheStringRef publisher;
+  CacheStringRef developer;
+  u64 hash;
+  s64 file_size;
+  u64 uncompressed_size;
+  u64 last_modified_time;
+  u64 release_date;
+  u16 supported_controllers;
+  u8 type;
+  u8 region;
+  u8 min_players;
+  u8 max_players;
+  u8 min_blocks;
+  u8 max_blocks;
+  s8 disc_set_index;
+  u8 compatibility;
+  u8 pad[6];
+};
+static_assert(sizeof(CacheRecord) == 112);
+
+struct CacheIndexEntry
+{
+  u64 path_hash;
+  u32 record_index;
+  u32 pad;
+};
+static_assert(sizeof(CacheIndexEntry) == 16);
+
 } // namespace
 
 using CacheMap = PreferUnorderedStringMap<Entry>;
@@ -72,15 +152,27 @@ static void ScanDirectory(const char* path, bool recursive, bool only_cache,
                           const std::vector<std::string>& excluded_paths, const PlayedTimeMap& played_time_map,
                           ProgressCallback* progress);
 static bool AddFileFromCache(const std::string& path, std::time_t timestamp, const PlayedTimeMap& played_time_map);
-static bool ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
-                     const PlayedTimeMap& played_time_map);
+static u32 GetScanThreadCount(size_t num_files);
+static void ScanFiles(std::vector<ScanRequest>& requests, const PlayedTimeMap& played_time_map,
+                      ProgressCallback* progress, u32 progress_base);
+static bool ScanFile(std::string path, std::time_t timestamp, Entry* entry);
+static void CommitScannedEntries(Entry* entries, const bool* valid, size_t count, const PlayedTimeMap& played_time_map);
 
 static std::string GetCacheFilename();
+static u64 GetCachePathHash(std::string_view path);
 static void LoadCache();
+static void UnloadCache();
+static bool ValidateCacheHeader();
 static bool LoadEntriesFromCache(ByteStream* stream);
+static bool ReadEntryFromCache(ByteStream* stream, Entry* entry);
+static bool GetIndexedCacheEntry(const std::string& path, Entry* entry);
+static bool DecodeCacheRecord(const CacheRecord& record, Entry* entry);
 static bool OpenCacheForWriting();
 static bool WriteEntryToCache(const Entry* entry);
+static void AddEntryToCache(const Entry& entry);
 static void CloseCacheFileStream();
+static bool ShouldCompactCache();
+static bool CompactCache();
 static void DeleteCacheFile();
 
 static std::string GetPlayedTimeFile();
@@ -93,8 +185,11 @@ static PlayedTimeEntry UpdatePlayedTimeFile(const std::string& path, const std::
 
 static std::vector<GameList::Entry> s_entries;
 static std::recursive_mutex s_mutex;
-static GameList::CacheMap s_cache_map;
+static GameList::CacheMap s_cache_map; // journal entries, newer than the indexed entries
 static std::unique_ptr<ByteStream> s_cache_write_stream;
+static const u8* s_cache_mapping = nullptr;
+static size_t s_cache_mapping_size = 0;
+static u32 s_cache_journal_entries = 0;
 
 static bool s_game_list_loaded = false;
 
@@ -304,62 +399,156 @@ bool GameList::PopulateEntryFromPath(const std::string& path, Entry* entry)
 
 bool GameList::GetGameListEntryFromCache(const std::string& path, Entry* entry)
 {
+  // Journal first, it's newer than anything in the index.
   auto iter = s_cache_map.find(path);
-  if (iter == s_cache_map.end())
+  if (iter != s_cache_map.end())
+  {
+    *entry = iter->second;
+    return true;
+  }
+
+  return GetIndexedCacheEntry(path, entry);
+}
+
+u64 GameList::GetCachePathHash(std::string_view path)
+{
+  return XXH64(path.data(), path.size(), 0);
+}
+
+bool GameList::GetIndexedCacheEntry(const std::string& path, Entry* entry)
+{
+  if (!s_cache_mapping)
     return false;
 
-  *entry = std::move(iter->second);
-  s_cache_map.erase(iter);
-  return true;
+  const CacheHeader* header = reinterpret_cast<const CacheHeader*>(s_cache_mapping);
+  const CacheIndexEntry* index_begin = reinterpret_cast<const CacheIndexEntry*>(s_cache_mapping + header->index_offset);
+  const CacheIndexEntry* index_end = index_begin + header->record_count;
+  const CacheRecord* records = reinterpret_cast<const CacheRecord*>(s_cache_mapping + header->records_offset);
+  const char* strings = reinterpret_cast<const char*>(s_cache_mapping + header->strings_offset);
+
+  const u64 path_hash = GetCachePathHash(path);
+  for (const CacheIndexEntry* it = std::lower_bound(
+         index_begin, index_end, path_hash,
+         [](const CacheIndexEntry& ie, u64 hash) { return (ie.path_hash < hash); });
+       it != index_end && it->path_hash == path_hash; ++it)
+  {
+    if (it->record_index >= header->record_count)
+      break;
+
+    // Could be a hash collision.
+    const CacheRecord& record = records[it->record_index];
+    if (record.path.length != path.length() ||
+        (static_cast<u64>(record.path.offset) + record.path.length) > header->strings_size ||
+        std::memcmp(strings + record.path.offset, path.data(), path.length()) != 0)
+    {
+      continue;
+    }
+
+    if (!DecodeCacheRecord(record, entry))
+    {
+      Log_WarningPrintf("Game list cache record for '%s' is corrupted", path.c_str());
+      return false;
+    }
+
+    return true;
+  }
+
+  return false;
 }
 
-bool GameList::LoadEntriesFromCache(ByteStream* stream)
+bool GameList::DecodeCacheRecord(const CacheRecord& record, Entry* entry)
 {
-  u32 file_signature, file_version;
-  if (!stream->ReadU32(&file_signature) || !stream->ReadU32(&file_version) ||
-      file_signature != GAME_LIST_CACHE_SIGNATURE || file_version != GAME_LIST_CACHE_VERSION)
+  const CacheHeader* header = reinterpret_cast<const CacheHeader*>(s_cache_mapping);
+  const char* strings = reinterpret_cast<const char*>(s_cache_mapping + header->strings_offset);
+  const auto get_string = [header, strings](const CacheStringRef& ref, std::string* out) {
+    if ((static_cast<u64>(ref.offset) + ref.length) > header->strings_size)
+      return false;
+
+    out->assign(strings + ref.offset, ref.length);
+    return true;
+  };
+
+  if (record.region >= static_cast<u8>(DiscRegion::Count) || record.type >= static_cast<u8>(EntryType::Count) ||
+      record.compatibility >= static_cast<u8>(GameDatabase::CompatibilityRating::Count) ||
+      !get_string(record.path, &entry->path) || !get_string(record.serial, &entry->serial) ||
+      !get_string(record.title, &entry->title) || !get_string(record.disc_set_name, &entry->disc_set_name) ||
+      !get_string(record.genre, &entry->genre) || !get_string(record.publisher, &entry->publisher) ||
+      !get_string(record.developer, &entry->developer))
   {
-    Log_WarningPrintf("Game list cache is corrupted");
     return false;
   }
 
+  entry->type = static_cast<EntryType>(record.type);
+  entry->region = static_cast<DiscRegion>(record.region);
+  entry->hash = record.hash;
+  entry->file_size = record.file_size;
+  entry->uncompressed_size = record.uncompressed_size;
+  entry->last_modified_time = static_cast<std::time_t>(record.last_modified_time);
+  entry->release_date = record.release_date;
+  entry->supported_controllers = record.supported_controllers;
+  entry->min_players = record.min_players;
+  entry->max_players = record.max_players;
+  entry->min_blocks = record.min_blocks;
+  entry->max_blocks = record.max_blocks;
+  entry->disc_set_index = record.disc_set_index;
+  entry->compatibility = static_cast<GameDatabase::CompatibilityRating>(record.compatibility);
+  return true;
+}
+
+bool GameList::LoadEntriesFromCache(ByteStream* stream)
+{
   while (stream->GetPosition() != stream->GetSize())
   {
-    std::string path;
     Entry ge;
-
-    u8 type;
-    u8 region;
-    u8 compatibility_rating;
-
-    if (!stream->ReadU8(&type) || !stream->ReadU8(&region) || !stream->ReadSizePrefixedString(&path) ||
-        !stream->ReadSizePrefixedString(&ge.serial) || !stream->ReadSizePrefixedString(&ge.title) ||
-        !stream->ReadSizePrefixedString(&ge.disc_set_name) || !stream->ReadSizePrefixedString(&ge.genre) ||
-        !stream->ReadSizePrefixedString(&ge.publisher) || !stream->ReadSizePrefixedString(&ge.developer) ||
-        !stream->ReadU64(&ge.hash) || !stream->ReadS64(&ge.file_size) || !stream->ReadU64(&ge.uncompressed_size) ||
-        !stream->ReadU64(reinterpret_cast<u64*>(&ge.last_modified_time)) || !stream->ReadU64(&ge.release_date) ||
-        !stream->ReadU16(&ge.supported_controllers) || !stream->ReadU8(&ge.min_players) ||
-        !stream->ReadU8(&ge.max_players) || !stream->ReadU8(&ge.min_blocks) || !stream->ReadU8(&ge.max_blocks) ||
-        !stream->ReadS8(&ge.disc_set_index) || !stream->ReadU8(&compatibility_rating) ||
-        region >= static_cast<u8>(DiscRegion::Count) || type >= static_cast<u8>(EntryType::Count) ||
-        compatibility_rating >= static_cast<u8>(GameDatabase::CompatibilityRating::Count))
+    if (!ReadEntryFromCache(stream, &ge))
     {
       Log_WarningPrintf("Game list cache entry is corrupted");
       return false;
     }
 
-    ge.path = path;
-    ge.region = static_cast<DiscRegion>(region);
-    ge.type = static_cast<EntryType>(type);
-    ge.compatibility = static_cast<GameDatabase::CompatibilityRating>(compatibility_rating);
+    s_cache_journal_entries++;
 
     auto iter = s_cache_map.find(ge.path);
     if (iter != s_cache_map.end())
+    {
       iter->second = std::move(ge);
+    }
     else
+    {
+      std::string path = ge.path;
       s_cache_map.emplace(std::move(path), std::move(ge));
+    }
+  }
+
+  return true;
+}
+
+bool GameList::ReadEntryFromCache(ByteStream* stream, Entry* entry)
+{
+  u8 type;
+  u8 region;
+  u8 compatibility_rating;
+
+  if (!stream->ReadU8(&type) || !stream->ReadU8(&region) || !stream->ReadSizePrefixedString(&entry->path) ||
+      !stream->ReadSizePrefixedString(&entry->serial) || !stream->ReadSizePrefixedString(&entry->title) ||
+      !stream->ReadSizePrefixedString(&entry->disc_set_name) || !stream->ReadSizePrefixedString(&entry->genre) ||
+      !stream->ReadSizePrefixedString(&entry->publisher) || !stream->ReadSizePrefixedString(&entry->developer) ||
+      !stream->ReadU64(&entry->hash) || !stream->ReadS64(&entry->file_size) ||
+      !stream->ReadU64(&entry->uncompressed_size) ||
+      !stream->ReadU64(reinterpret_cast<u64*>(&entry->last_modified_time)) ||
+      !stream->ReadU64(&entry->release_date) || !stream->ReadU16(&entry->supported_controllers) ||
+      !stream->ReadU8(&entry->min_players) || !stream->ReadU8(&entry->max_players) ||
+      !stream->ReadU8(&entry->min_blocks) || !stream->ReadU8(&entry->max_blocks) ||
+      !stream->ReadS8(&entry->disc_set_index) || !stream->ReadU8(&compatibility_rating) ||
+      region >= static_cast<u8>(DiscRegion::Count) || type >= static_cast<u8>(EntryType::Count) ||
+      compatibility_rating >= static_cast<u8>(GameDatabase::CompatibilityRating::Count))
+  {
+    return false;
   }
 
+  entry->region = static_cast<DiscRegion>(region);
+  entry->type = static_cast<EntryType>(type);
+  entry->compatibility = static_cast<GameDatabase::CompatibilityRating>(compatibility_rating);
   return true;
 }
 
@@ -390,6 +579,22 @@ bool GameList::WriteEntryToCache(const Entry* entry)
   return result;
 }
 
+void GameList::AddEntryToCache(const Entry& entry)
+{
+  if (!s_cache_write_stream && !OpenCacheForWriting())
+    return;
+
+  if (!WriteEntryToCache(&entry))
+  {
+    Log_WarningPrintf("Failed to write entry '%s' to cache", entry.path.c_str());
+    return;
+  }
+
+  // Keep a copy for when the journal gets compacted.
+  s_cache_journal_entries++;
+  s_cache_map[entry.path] = entry;
+}
+
 static std::string GameList::GetCacheFilename()
 {
   return Path::Combine(EmuFolders::Cache, "gamelist.cache");
@@ -397,20 +602,74 @@ static std::string GameList::GetCacheFilename()
 
 void GameList::LoadCache()
 {
+  // Only the header and journal are read here, indexed entries are looked up on demand.
   std::string filename(GetCacheFilename());
-  std::unique_ptr<ByteStream> stream =
-    ByteStream::OpenFile(filename.c_str(), BYTESTREAM_OPEN_READ | BYTESTREAM_OPEN_STREAMED);
-  if (!stream)
+  FileSystem::ManagedCFilePtr fp = FileSystem::OpenManagedCFile(filename.c_str(), "rb");
+  if (!fp)
+    return;
+
+  const s64 size = FileSystem::FSize64(fp.get());
+  if (size >= static_cast<s64>(sizeof(CacheHeader)))
+  {
+    s_cache_mapping = static_cast<const u8*>(MemMap::MapFileReadOnly(fp.get(), static_cast<size_t>(size)));
+    s_cache_mapping_size = static_cast<size_t>(size);
+  }
+  fp.reset();
+
+  if (!s_cache_mapping || !ValidateCacheHeader())
+  {
+    Log_WarningPrintf("Deleting corrupted cache file '%s'", filename.c_str());
+    UnloadCache();
+    DeleteCacheFile();
     return;
+  }
 
+  const CacheHeader* header = reinterpret_cast<const CacheHeader*>(s_cache_mapping);
+  std::unique_ptr<ReadOnlyMemoryByteStream> stream =
+    ByteStream::CreateReadOnlyMemoryStream(s_cache_mapping + header->journal_offset,
+                                           static_cast<u32>(s_cache_mapping_size - header->journal_offset));
   if (!LoadEntriesFromCache(stream.get()))
   {
     Log_WarningPrintf("Deleting corrupted cache file '%s'", filename.c_str());
     stream.reset();
-    s_cache_map.clear();
+    UnloadCache();
     DeleteCacheFile();
     return;
   }
+
+  Log_DevPrintf("Game list cache has %u indexed entries and %u journal entries", header->record_count,
+                s_cache_journal_entries);
+}
+
+void GameList::UnloadCache()
+{
+  if (s_cache_mapping)
+  {
+    MemMap::UnmapFile(s_cache_mapping, s_cache_mapping_size);
+    s_cache_mapping = nullptr;
+    s_cache_mapping_size = 0;
+  }
+
+  s_cache_map.clear();
+  s_cache_journal_entries = 0;
+}
+
+bool GameList::ValidateCacheHeader()
+{
+  const CacheHeader* header = reinterpret_cast<const CacheHeader*>(s_cache_mapping);
+  if (header->signature != GAME_LIST_CACHE_SIGNATURE || header->version != GAME_LIST_CACHE_VERSION)
+    return false;
+
+  // Everything before the journal is fixed once written, so only the bounds need checking.
+  const u64 records_size = static_cast<u64>(header->record_count) * sizeof(CacheRecord);
+  const u64 index_size = static_cast<u64>(header->record_count) * sizeof(CacheIndexEntry);
+  return (header->journal_offset <= s_cache_mapping_size && header->journal_offset >= sizeof(CacheHeader) &&
+          (header->records_offset % alignof(CacheRecord)) == 0 &&
+          (header->index_offset % alignof(CacheIndexEntry)) == 0 &&
+          header->records_offset >= sizeof(CacheHeader) &&
+          (header->records_offset + records_size) <= header->journal_offset &&
+          (header->index_offset + index_size) <= header->journal_offset &&
+          (header->strings_offset + header->strings_size) <= header->journal_offset);
 }
 
 bool GameList::OpenCacheForWriting()
@@ -441,9 +700,15 @@ bool GameList::OpenCacheForWriting()
   if (!s_cache_write_stream)
     return false;
 
-  // new cache file, write header
-  if (!s_cache_write_stream->WriteU32(GAME_LIST_CACHE_SIGNATURE) ||
-      !s_cache_write_stream->WriteU32(GAME_LIST_CACHE_VERSION))
+  // new cache file, write an empty index, everything goes in the journal until it's compacted
+  CacheHeader header = {};
+  header.signature = GAME_LIST_CACHE_SIGNATURE;
+  header.version = GAME_LIST_CACHE_VERSION;
+  header.records_offset = sizeof(CacheHeader);
+  header.index_offset = sizeof(CacheHeader);
+  header.strings_offset = sizeof(CacheHeader);
+  header.journal_offset = sizeof(CacheHeader);
+  if (!s_cache_write_stream->Write2(&header, sizeof(header)))
   {
     Log_ErrorPrintf("Failed to write game list cache header");
     s_cache_write_stream.reset();
@@ -463,6 +728,128 @@ void GameList::CloseCacheFileStream()
   s_cache_write_stream.reset();
 }
 
+bool GameList::ShouldCompactCache()
+{
+  if (s_cache_journal_entries == 0)
+    return false;
+
+  const u32 record_count =
+    s_cache_mapping ? reinterpret_cast<const CacheHeader*>(s_cache_mapping)->record_count : 0;
+  return (s_cache_journal_entries >= std::min<u32>(MAX_CACHE_JOURNAL_ENTRIES, std::max<u32>(record_count / 16, 1)));
+}
+
+bool GameList::CompactCache()
+{
+  Assert(!s_cache_write_stream);
+
+  // Merge the indexed entries with the journal. Journal entries take precedence, they're newer.
+  CacheMap entries = std::move(s_cache_map);
+  s_cache_map.clear();
+  if (s_cache_mapping)
+  {
+    const CacheHeader* header = reinterpret_cast<const CacheHeader*>(s_cache_mapping);
+    const CacheRecord* records = reinterpret_cast<const CacheRecord*>(s_cache_mapping + header->records_offset);
+    for (u32 i = 0; i < header->record_count; i++)
+    {
+      Entry entry;
+      if (!DecodeCacheRecord(records[i], &entry))
+        continue;
+
+      if (entries.find(entry.path) == entries.end())
+      {
+        std::string path = entry.path;
+        entries.emplace(std::move(path), std::move(entry));
+      }
+    }
+  }
+
+  // Common strings such as genres and publishers only get stored once.
+  std::vector<CacheRecord> records;
+  std::vector<CacheIndexEntry> index;
+  std::string strings;
+  std::unordered_map<std::string_view, CacheStringRef> string_refs;
+  records.reserve(entries.size());
+  index.reserve(entries.size());
+  const auto add_string = [&strings, &string_refs](const std::string& str) {
+    auto iter = string_refs.find(str);
+    if (iter != string_refs.end())
+      return iter->second;
+
+    const CacheStringRef ref = {static_cast<u32>(strings.size()), static_cast<u32>(str.size())};
+    strings.append(str);
+    string_refs.emplace(str, ref);
+    return ref;
+  };
+
+  for (const auto& it : entries)
+  {
+    const Entry& entry = it.second;
+    CacheRecord& record = records.emplace_back();
+    std::memset(&record, 0, sizeof(record));
+    record.path = add_string(entry.path);
+    record.serial = add_string(entry.serial);
+    record.title = add_string(entry.title);
+    record.disc_set_name = add_string(entry.disc_set_name);
+    record.genre = add_string(entry.genre);
+    record.publisher = add_string(entry.publisher);
+    record.developer = add_string(entry.developer);
+    record.hash = entry.hash;
+    record.file_size = entry.file_size;
+    record.uncompressed_size = entry.uncompressed_size;
+    record.last_modified_time = static_cast<u64>(entry.last_modified_time);
+    record.release_date = entry.release_date;
+    record.supported_controllers = entry.supported_controllers;
+    record.type = static_cast<u8>(entry.type);
+    record.region = static_cast<u8>(entry.region);
+    record.min_players = entry.min_players;
+    record.max_players = entry.max_players;
+    record.min_blocks = entry.min_blocks;
+    record.max_blocks = entry.max_blocks;
+    record.disc_set_index = entry.disc_set_index;
+    record.compatibility = static_cast<u8>(entry.compatibility);
+
+    index.push_back(CacheIndexEntry{GetCachePathHash(entry.path), static_cast<u32>(records.size() - 1), 0});
+  }
+
+  std::sort(index.begin(), index.end(), [](const CacheIndexEntry& lhs, const CacheIndexEntry& rhs) {
+    return (lhs.path_hash < rhs.path_hash || (lhs.path_hash == rhs.path_hash && lhs.record_index < rhs.record_index));
+  });
+
+  CacheHeader header = {};
+  header.signature = GAME_LIST_CACHE_SIGNATURE;
+  header.version = GAME_LIST_CACHE_VERSION;
+  header.record_count = static_cast<u32>(records.size());
+  header.records_offset = sizeof(CacheHeader);
+  header.index_offset = header.records_offset + records.size() * sizeof(CacheRecord);
+  header.strings_offset = header.index_offset + index.size() * sizeof(CacheIndexEntry);
+  header.strings_size = strings.size();
+  header.journal_offset = header.strings_offset + header.strings_size;
+
+  // Can't replace the file while it's mapped on Windows.
+  string_refs.clear();
+  UnloadCache();
+
+  const std::string filename(GetCacheFilename());
+  std::unique_ptr<ByteStream> stream =
+    ByteStream::OpenFile(filename.c_str(), BYTESTREAM_OPEN_CREATE | BYTESTREAM_OPEN_TRUNCATE | BYTESTREAM_OPEN_WRITE |
+                                             BYTESTREAM_OPEN_ATOMIC_UPDATE | BYTESTREAM_OPEN_STREAMED);
+  if (!stream || !stream->Write2(&header, sizeof(header)) ||
+      (!records.empty() && !stream->Write2(records.data(), static_cast<u32>(records.size() * sizeof(CacheRecord)))) ||
+      (!index.empty() && !stream->Write2(index.data(), static_cast<u32>(index.size() * sizeof(CacheIndexEntry)))) ||
+      (!strings.empty() && !stream->Write2(strings.data(), static_cast<u32>(strings.size()))) || !stream->Commit())
+  {
+    Log_ErrorPrintf("Failed to write compacted game list cache '%s'", filename.c_str());
+    if (stream)
+      stream->Discard();
+
+    return false;
+  }
+
+  Log_InfoPrintf("Compacted game list cache to %u entries (%zu bytes of strings)", header.record_count,
+                 strings.size());
+  return true;
+}
+
 void GameList::DeleteCacheFile()
 {
   Assert(!s_cache_write_stream);
@@ -502,14 +889,17 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
   progress->SetProgressRange(static_cast<u32>(files.size()));
   progress->SetProgressValue(0);
 
+  // Cache lookups are cheap, so do those up front, and only send the files which need to be opened to the workers.
+  std::vector<ScanRequest> requests;
   u32 files_scanned = 0;
   for (FILESYSTEM_FIND_DATA& ffd : files)
   {
-    files_scanned++;
+    if (progress->IsCancelled())
+      break;
 
-    if (progress->IsCancelled() || !GameList::IsScannableFilename(ffd.FileName) ||
-        IsPathExcluded(excluded_paths, ffd.FileName))
+    if (!GameList::IsScannableFilename(ffd.FileName) || IsPathExcluded(excluded_paths, ffd.FileName))
     {
+      files_scanned++;
       continue;
     }
 
@@ -517,15 +907,18 @@ void GameList::ScanDirectory(const char* path, bool recursive, bool only_cache,
     if (GetEntryForPath(ffd.FileName.c_str()) ||
         AddFileFromCache(ffd.FileName, ffd.ModificationTime, played_time_map) || only_cache)
     {
+      files_scanned++;
       continue;
     }
 
-    progress->SetFormattedStatusText("Scanning '%s'...", FileSystem::GetDisplayNameFromPath(ffd.FileName).c_str());
-    ScanFile(std::move(ffd.FileName), ffd.ModificationTime, lock, played_time_map);
-    progress->SetProgressValue(files_scanned);
+    requests.push_back(ScanRequest{std::move(ffd.FileName), ffd.ModificationTime});
   }
 
   progress->SetProgressValue(files_scanned);
+  if (!requests.empty() && !progress->IsCancelled())
+    ScanFiles(requests, played_time_map, progress, files_scanned);
+
+  progress->SetProgressValue(static_cast<u32>(files.size()));
   progress->PopState();
 }
 
@@ -546,39 +939,153 @@ bool GameList::AddFileFromCache(const std::string& path, std::time_t timestamp,
   return true;
 }
 
-bool GameList::ScanFile(std::string path, std::time_t timestamp, std::unique_lock<std::recursive_mutex>& lock,
-                        const PlayedTimeMap& played_time_map)
+u32 GameList::GetScanThreadCount(size_t num_files)
 {
-  // don't block UI while scanning
-  lock.unlock();
+  // Opening images is mostly I/O bound, so it's worth having a few threads even on low core count machines.
+  u32 num_threads = Host::GetBaseUIntSettingValue("GameList", "ScanThreads", 0);
+  if (num_threads == 0)
+    num_threads = std::max(std::thread::hardware_concurrency(), 2u);
 
-  Log_DevPrintf("Scanning '%s'...", path.c_str());
+  return static_cast<u32>(std::min<size_t>(std::min<u32>(num_threads, MAX_SCAN_THREADS), num_files));
+}
 
-  Entry entry;
-  if (!PopulateEntryFromPath(path, &entry))
-    return false;
+void GameList::ScanFiles(std::vector<ScanRequest>& requests, const PlayedTimeMap& played_time_map,
+                         ProgressCallback* progress, u32 progress_base)
+{
+  const size_t num_files = requests.size();
+  const u32 num_threads = GetScanThreadCount(num_files);
+
+  std::unique_ptr<Entry[]> entries = std::make_unique<Entry[]>(num_files);
+  std::unique_ptr<bool[]> valid = std::make_unique<bool[]>(num_files);
+  if (num_threads <= 1)
+  {
+    for (size_t i = 0; i < num_files; i++)
+    {
+      if (progress->IsCancelled())
+        break;
 
-  entry.path = std::move(path);
-  entry.last_modified_time = timestamp;
+      progress->SetFormattedStatusText("Scanning '%s'...",
+                                       FileSystem::GetDisplayNameFromPath(requests[i].path).c_str());
+      valid[i] = ScanFile(std::move(requests[i].path), requests[i].timestamp, &entries[i]);
+      CommitScannedEntries(&entries[i], &valid[i], 1, played_time_map);
+      progress->SetProgressValue(progress_base + static_cast<u32>(i + 1));
+    }
 
-  if (s_cache_write_stream || OpenCacheForWriting())
+    return;
+  }
+
+  Log_DevPrintf("Scanning %zu files with %u threads", num_files, num_threads);
+
+  // Database is lazily loaded, make sure that doesn't happen on the workers.
+  GameDatabase::EnsureLoaded();
+
+  // Files are handed out in order, and committed in order, so the list and cache end up the same as a serial scan.
+  std::unique_ptr<std::atomic_bool[]> completed = std::make_unique<std::atomic_bool[]>(num_files);
+  std::atomic<size_t> next_index{0};
+  std::atomic_bool cancelled{false};
+  std::mutex completed_mutex;
+  std::condition_variable completed_cv;
+  for (size_t i = 0; i < num_files; i++)
+    completed[i].store(false, std::memory_order_relaxed);
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (u32 i = 0; i < num_threads; i++)
   {
-    if (!WriteEntryToCache(&entry))
-      Log_WarningPrintf("Failed to write entry '%s' to cache", entry.path.c_str());
+    threads.emplace_back([&]() {
+      Threading::SetNameOfCurrentThread("Game List Scan");
+      for (;;)
+      {
+        const size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+        if (index >= num_files || cancelled.load(std::memory_order_relaxed))
+          break;
+
+        valid[index] = ScanFile(std::move(requests[index].path), requests[index].timestamp, &entries[index]);
+
+        std::unique_lock lock(completed_mutex);
+        completed[index].store(true, std::memory_order_release);
+        completed_cv.notify_one();
+      }
+    });
   }
 
-  auto iter = played_time_map.find(entry.serial);
-  if (iter != played_time_map.end())
+  size_t committed = 0;
+  while (committed < num_files)
   {
-    entry.last_played_time = iter->second.last_played_time;
-    entry.total_played_time = iter->second.total_played_time;
+    size_t batch_end = committed;
+    {
+      // Wake up periodically to check for cancellation.
+      std::unique_lock lock(completed_mutex);
+      completed_cv.wait_for(lock, std::chrono::milliseconds(100),
+                            [&]() { return completed[committed].load(std::memory_order_acquire); });
+      while (batch_end < num_files && completed[batch_end].load(std::memory_order_acquire))
+        batch_end++;
+    }
+
+    if (progress->IsCancelled())
+    {
+      cancelled.store(true, std::memory_order_relaxed);
+      break;
+    }
+
+    if (batch_end == committed)
+      continue;
+
+    if (valid[batch_end - 1])
+    {
+      progress->SetFormattedStatusText("Scanning '%s'...",
+                                       FileSystem::GetDisplayNameFromPath(entries[batch_end - 1].path).c_str());
+    }
+
+    CommitScannedEntries(&entries[committed], &valid[committed], batch_end - committed, played_time_map);
+    committed = batch_end;
+    progress->SetProgressValue(progress_base + static_cast<u32>(committed));
   }
 
-  lock.lock();
-  s_entries.push_back(std::move(entry));
+  for (std::thread& thread : threads)
+    thread.join();
+}
+
+bool GameList::ScanFile(std::string path, std::time_t timestamp, Entry* entry)
+{
+  Log_DevPrintf("Scanning '%s'...", path.c_str());
+
+  if (!PopulateEntryFromPath(path, entry))
+    return false;
+
+  entry->path = std::move(path);
+  entry->last_modified_time = timestamp;
   return true;
 }
 
+void GameList::CommitScannedEntries(Entry* entries, const bool* valid, size_t count,
+                                    const PlayedTimeMap& played_time_map)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    if (!valid[i])
+      continue;
+
+    Entry& entry = entries[i];
+    AddEntryToCache(entry);
+
+    auto iter = played_time_map.find(entry.serial);
+    if (iter != played_time_map.end())
+    {
+      entry.last_played_time = iter->second.last_played_time;
+      entry.total_played_time = iter->second.total_played_time;
+    }
+  }
+
+  // Only take the lock once per batch, so the UI isn't blocked.
+  std::unique_lock lock(s_mutex);
+  for (size_t i = 0; i < count; i++)
+  {
+    if (valid[i])
+      s_entries.push_back(std::move(entries[i]));
+  }
+}
+
 std::unique_lock<std::recursive_mutex> GameList::GetLock()
 {
   return std::unique_lock<std::recursive_mutex>(s_mutex);
@@ -699,7 +1206,9 @@ void GameList::Refresh(bool invalidate_cache, bool only_cache, ProgressCallback*
 
   // don't need unused cache entries
   CloseCacheFileStream();
-  s_cache_map.clear();
+  if (ShouldCompactCache())
+    CompactCache();
+  UnloadCache();
 }
 
 std::string GameList::GetCoverImagePathForEntry(const Entry* entry)
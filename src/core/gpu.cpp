@@ -25,6 +25,7 @@
 
 #include "stb_image_resize.h"
 #include "stb_image_write.h"
+#include "xxhash.h"
 
 #include <cmath>
 #include <thread>
@@ -57,6 +58,8 @@ bool GPU::Initialize()
     true);
   m_fifo_size = g_settings.gpu_fifo_size;
   m_max_run_ahead = g_settings.gpu_max_run_ahead;
+  m_bulk_vram_writes = g_settings.gpu_bulk_vram_writes;
+  m_direct_dma_commands = g_settings.gpu_direct_dma_commands;
   m_console_is_pal = System::IsPALRegion();
   UpdateCRTCConfig();
 
@@ -76,6 +79,8 @@ void GPU::UpdateSettings(const Settings& old_settings)
   m_force_progressive_scan = g_settings.gpu_disable_interlacing;
   m_fifo_size = g_settings.gpu_fifo_size;
   m_max_run_ahead = g_settings.gpu_max_run_ahead;
+  m_bulk_vram_writes = g_settings.gpu_bulk_vram_writes;
+  m_direct_dma_commands = g_settings.gpu_direct_dma_commands;
 
   if (m_force_ntsc_timings != g_settings.gpu_force_ntsc_timings || m_console_is_pal != System::IsPALRegion())
   {
@@ -117,6 +122,12 @@ std::tuple<u32, u32> GPU::GetFullDisplayResolution(bool scaled /* = true */)
 
 void GPU::Reset(bool clear_vram)
 {
+  if (m_dump_recorder)
+  {
+    Log_WarningPrintf("GPU was reset, stopping recording.");
+    StopRecording();
+  }
+
   m_GPUSTAT.bits = 0x14802000;
   m_set_texture_disable_mask = false;
   m_GPUREAD_latch = 0;
@@ -136,7 +147,7 @@ void GPU::SoftReset()
 {
   FlushRender();
   if (m_blitter_state == BlitterState::WritingVRAM)
-    FinishVRAMWrite();
+    FinishVRAMWrite(m_blit_buffer.data());
 
   m_GPUSTAT.texture_page_x_base = 0;
   m_GPUSTAT.texture_page_y_base = 0;
@@ -404,6 +415,8 @@ u32 GPU::ReadRegister(u32 offset)
   switch (offset)
   {
     case 0x00:
+      if (m_dump_recorder && m_blitter_state == BlitterState::ReadingVRAM) [[unlikely]]
+        m_dump_recorder->WriteGPUREAD(1);
       return ReadGPUREAD();
 
     case 0x04:
@@ -429,12 +442,16 @@ void GPU::WriteRegister(u32 offset, u32 value)
   switch (offset)
   {
     case 0x00:
+      if (m_dump_recorder) [[unlikely]]
+        m_dump_recorder->WriteGP0(value);
       m_fifo.Push(value);
       ExecuteCommands();
       UpdateCommandTickEvent();
       return;
 
     case 0x04:
+      if (m_dump_recorder) [[unlikely]]
+        m_dump_recorder->WriteGP1(value);
       WriteGP1(value);
       return;
 
@@ -453,10 +470,38 @@ void GPU::DMARead(u32* words, u32 word_count)
     return;
   }
 
+  if (m_dump_recorder && m_blitter_state == BlitterState::ReadingVRAM) [[unlikely]]
+    m_dump_recorder->WriteGPUREAD(word_count);
+
   for (u32 i = 0; i < word_count; i++)
     words[i] = ReadGPUREAD();
 }
 
+void GPU::DMAWriteVRAM(const u32* words, u32 word_count)
+{
+  if (m_dump_recorder) [[unlikely]]
+    m_dump_recorder->WriteGP0(words, word_count);
+
+  AppendVRAMWrite(words, word_count);
+}
+
+void GPU::AppendVRAMWrite(const u32* words, u32 word_count)
+{
+  DebugAssert(m_blitter_state == BlitterState::WritingVRAM && word_count <= m_blit_remaining_words);
+  m_blit_remaining_words -= word_count;
+  if (m_blit_remaining_words == 0 && m_blit_buffer.empty())
+  {
+    Log_DebugPrintf("VRAM write of %u words direct from DMA", word_count);
+    FinishVRAMWrite(words);
+    return;
+  }
+
+  m_blit_buffer.insert(m_blit_buffer.end(), words, words + word_count);
+  Log_DebugPrintf("VRAM write burst of %u words from DMA, %u words remaining", word_count, m_blit_remaining_words);
+  if (m_blit_remaining_words == 0)
+    FinishVRAMWrite(m_blit_buffer.data());
+}
+
 void GPU::EndDMAWrite()
 {
   m_fifo_pushed = true;
@@ -948,6 +993,12 @@ void GPU::CRTCTickEvent(TickCount ticks)
           m_crtc_state.interlaced_display_field = m_crtc_state.interlaced_field ^ 1u;
         else
           m_crtc_state.interlaced_display_field = 0;
+
+        if (m_dump_recorder) [[unlikely]]
+        {
+          m_dump_recorder->WriteVSync(ZeroExtend32(m_crtc_state.interlaced_field) |
+                                      (ZeroExtend32(m_crtc_state.interlaced_display_field) << 1));
+        }
       }
 
       Timers::SetGate(HBLANK_TIMER_INDEX, new_vblank);
@@ -1117,7 +1168,7 @@ void GPU::WriteGP1(u32 value)
 
       // flush partial writes
       if (m_blitter_state == BlitterState::WritingVRAM)
-        FinishVRAMWrite();
+        FinishVRAMWrite(m_blit_buffer.data());
 
       m_blitter_state = BlitterState::Idle;
       m_command_total_words = 0;
@@ -2184,6 +2235,141 @@ bool GPU::DumpVRAMToFile(const char* filename)
   }
 }
 
+u64 GPU::GetVRAMHash()
+{
+  ReadVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+  return XXH64(m_vram_ptr, VRAM_WIDTH * VRAM_HEIGHT * sizeof(u16), 0);
+}
+
+bool GPU::StartRecording(const char* filename, Error* error)
+{
+  StopRecording();
+
+  std::unique_ptr<GPUDump::Recorder> recorder = GPUDump::Recorder::Create(filename, error);
+  if (!recorder)
+    return false;
+
+  if (m_blitter_state != BlitterState::Idle)
+    Log_WarningPrintf("GPU is busy, the first command in the recording will be incomplete.");
+
+  FlushRender();
+  ReadVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT);
+  recorder->WriteVRAM(m_vram_ptr);
+
+  // Recreate the display and drawing state with the commands which would have set it.
+  recorder->WriteGP1(0x09000000u | BoolToUInt32(m_set_texture_disable_mask));
+  recorder->WriteGP1(0x08000000u | ((m_GPUSTAT.bits >> 17) & 0x3Fu) |
+                     (ZeroExtend32(m_GPUSTAT.horizontal_resolution_2.GetValue()) << 6) |
+                     (BoolToUInt32(m_GPUSTAT.reverse_flag) << 7));
+  recorder->WriteGP1(0x05000000u | m_crtc_state.regs.display_address_start);
+  recorder->WriteGP1(0x06000000u | m_crtc_state.regs.horizontal_display_range);
+  recorder->WriteGP1(0x07000000u | m_crtc_state.regs.vertical_display_range);
+  recorder->WriteGP1(0x03000000u | BoolToUInt32(m_GPUSTAT.display_disable));
+  recorder->WriteGP0(0xE1000000u | ZeroExtend32(m_draw_mode.mode_reg.bits));
+  recorder->WriteGP0(0xE2000000u | m_draw_mode.texture_window_value);
+  recorder->WriteGP0(0xE3000000u | (m_drawing_area.top << 10) | m_drawing_area.left);
+  recorder->WriteGP0(0xE4000000u | (m_drawing_area.bottom << 10) | m_drawing_area.right);
+  recorder->WriteGP0(0xE5000000u | (static_cast<u32>(m_drawing_offset.x) & 0x7FFu) |
+                     ((static_cast<u32>(m_drawing_offset.y) & 0x7FFu) << 11));
+  recorder->WriteGP0(0xE6000000u | BoolToUInt32(m_GPUSTAT.set_mask_while_drawing) |
+                     (BoolToUInt32(m_GPUSTAT.check_mask_before_draw) << 1));
+
+  // Anything still in the FIFO hasn't executed yet.
+  for (u32 i = 0; i < m_fifo.GetSize(); i++)
+    recorder->WriteGP0(Truncate32(m_fifo.Peek(i)));
+
+  Log_InfoPrintf("Recording GPU commands to '%s'.", filename);
+  m_dump_recorder = std::move(recorder);
+  return true;
+}
+
+bool GPU::StopRecording()
+{
+  if (!m_dump_recorder)
+    return true;
+
+  const bool result = m_dump_recorder->Close();
+  m_dump_recorder.reset();
+  return result;
+}
+
+void GPU::ProcessDumpPacket(GPUDump::PacketType type, const u32* data, u32 word_count)
+{
+  // Pending ticks are thrown away after each command, so run-ahead never holds up execution. Stops when the FIFO is
+  // empty or waiting on more words/a VRAM read.
+  const auto execute_fifo = [this]() {
+    u32 fifo_size;
+    do
+    {
+      fifo_size = m_fifo.GetSize();
+      m_pending_command_ticks = 0;
+      ExecuteCommands();
+    } while (!m_fifo.IsEmpty() && m_fifo.GetSize() != fifo_size);
+  };
+  const auto update_active_line_lsb = [this]() {
+    m_crtc_state.active_line_lsb =
+      m_GPUSTAT.InInterleaved480iMode() ?
+        Truncate8((m_crtc_state.regs.Y + BoolToUInt32(m_crtc_state.interlaced_display_field)) & u32(1)) :
+        0;
+  };
+
+  switch (type)
+  {
+    case GPUDump::PacketType::GP0:
+    {
+      while (word_count > 0)
+      {
+        const u32 count = std::min(word_count, MAX_FIFO_SIZE - m_fifo.GetSize());
+        if (count == 0)
+        {
+          Log_ErrorPrintf("GPU FIFO is full, dropping %u words of GPU dump.", word_count);
+          break;
+        }
+
+        for (u32 i = 0; i < count; i++)
+          m_fifo.Push(ZeroExtend64(data[i]));
+        data += count;
+        word_count -= count;
+        execute_fifo();
+      }
+    }
+    break;
+
+    case GPUDump::PacketType::GP1:
+    {
+      for (u32 i = 0; i < word_count; i++)
+        WriteGP1(data[i]);
+      update_active_line_lsb();
+    }
+    break;
+
+    case GPUDump::PacketType::GPUREAD:
+    {
+      for (u32 i = 0; i < data[0]; i++)
+        ReadGPUREAD();
+      execute_fifo();
+    }
+    break;
+
+    case GPUDump::PacketType::VSync:
+    {
+      m_crtc_state.interlaced_field = Truncate8(data[0] & 1u);
+      FlushRender();
+      UpdateDisplay();
+      m_crtc_state.interlaced_display_field = Truncate8((data[0] >> 1) & 1u);
+      update_active_line_lsb();
+    }
+    break;
+
+    case GPUDump::PacketType::VRAM:
+    {
+      FlushRender();
+      UpdateVRAM(0, 0, VRAM_WIDTH, VRAM_HEIGHT, data, false, false);
+    }
+    break;
+  }
+}
+
 bool GPU::DumpVRAMToFile(const char* filename, u32 width, u32 height, u32 stride, const void* buffer, bool remove_alpha)
 {
   auto fp = FileSystem::OpenManagedCFile(filename, "wb");
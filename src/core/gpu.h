@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
 
 #pragma once
+#include "gpu_dump.h"
 #include "gpu_types.h"
 #include "timers.h"
 #include "types.h"
@@ -22,6 +23,7 @@
 
 class StateWrapper;
 
+class GPUBackend;
 class GPUDevice;
 class GPUTexture;
 class GPUPipeline;
@@ -87,6 +89,7 @@ public:
   virtual ~GPU();
 
   virtual const Threading::Thread* GetSWThread() const = 0;
+  virtual GPUBackend* GetSWBackend() = 0;
   virtual bool IsHardwareRenderer() const = 0;
 
   virtual bool Initialize();
@@ -112,10 +115,31 @@ public:
   ALWAYS_INLINE bool BeginDMAWrite() const { return (m_GPUSTAT.dma_direction == DMADirection::CPUtoGP0); }
   ALWAYS_INLINE void DMAWrite(u32 address, u32 value)
   {
+    if (m_dump_recorder) [[unlikely]]
+      m_dump_recorder->WriteGP0(value);
+
     m_fifo.Push((ZeroExtend64(address) << 32) | ZeroExtend64(value));
   }
   void EndDMAWrite();
 
+  /// Returns the number of words which can be passed to DMAWriteVRAM() instead of going through the FIFO. Only possible
+  /// while a CPU->VRAM write is in progress and the FIFO would be drained immediately anyway, otherwise zero.
+  ALWAYS_INLINE u32 GetBulkDMAWriteWordCount() const
+  {
+    return (m_bulk_vram_writes && m_blitter_state == BlitterState::WritingVRAM && m_fifo.IsEmpty() && !m_syncing &&
+            m_pending_command_ticks <= m_max_run_ahead) ?
+             m_blit_remaining_words :
+             0;
+  }
+
+  /// Appends words to the current VRAM write. If they make up the whole write, VRAM is updated straight from the
+  /// caller's buffer. Must be between BeginDMAWrite() and EndDMAWrite().
+  void DMAWriteVRAM(const u32* words, u32 word_count);
+
+  /// Equivalent to DMAWrite() for each word of a contiguous span of RAM. When the FIFO is empty, commands are executed
+  /// straight from the span, and only what can't be executed yet is queued.
+  void DMAWriteSpan(u32 address, const u32* words, u32 word_count);
+
   /// Returns true if no data is being sent from VRAM to the DAC or that no portion of VRAM would be visible on screen.
   ALWAYS_INLINE bool IsDisplayDisabled() const
   {
@@ -181,6 +205,9 @@ public:
   // Dumps raw VRAM to a file.
   bool DumpVRAMToFile(const char* filename);
 
+  // Returns a hash of the contents of VRAM. Used for regression testing.
+  u64 GetVRAMHash();
+
   // Ensures all buffered vertices are drawn.
   virtual void FlushRender();
 
@@ -207,6 +234,25 @@ public:
   /// Draws the current display texture, with any post-processing.
   bool PresentDisplay();
 
+  /// Starts writing everything sent to the GPU to a GPU dump, beginning with the current VRAM and drawing state.
+  bool StartRecording(const char* filename, Error* error);
+  bool StopRecording();
+  ALWAYS_INLINE bool IsRecording() const { return static_cast<bool>(m_dump_recorder); }
+
+  /// Executes a packet from a GPU dump. Commands run immediately, ignoring their timing.
+  void ProcessDumpPacket(GPUDump::PacketType type, const u32* data, u32 word_count);
+
+  /// Host time and number of executions for each GP0 command, in timer ticks.
+  struct CommandTimings
+  {
+    std::array<u64, 256> time;
+    std::array<u64, 256> count;
+  };
+
+  /// Accumulates the time taken by each GP0 command into the specified structure, or stops if null. With a threaded
+  /// renderer, this only includes the time taken to queue the work.
+  ALWAYS_INLINE void SetCommandTimings(CommandTimings* timings) { m_command_timings = timings; }
+
 protected:
   TickCount CRTCTicksToSystemTicks(TickCount crtc_ticks, TickCount fractional_ticks) const;
   TickCount SystemTicksToCRTCTicks(TickCount sysclk_ticks, TickCount* fractional_ticks) const;
@@ -265,7 +311,8 @@ protected:
   void SetTextureWindow(u32 value);
 
   u32 ReadGPUREAD();
-  void FinishVRAMWrite();
+  void AppendVRAMWrite(const u32* words, u32 word_count);
+  void FinishVRAMWrite(const void* data);
 
   /// Returns the number of vertices in the buffered poly-line.
   ALWAYS_INLINE u32 GetPolyLineVertexCount() const
@@ -298,6 +345,7 @@ protected:
   void WriteGP1(u32 value);
   void EndCommand();
   void ExecuteCommands();
+  bool ExecuteGP0Command(u32 command);
   void HandleGetGPUInfoCommand(u32 value);
 
   // Rendering in the backend
@@ -555,12 +603,59 @@ protected:
   u32 m_blit_remaining_words;
   GPURenderCommand m_render_command{};
 
-  ALWAYS_INLINE u32 FifoPop() { return Truncate32(m_fifo.Pop()); }
-  ALWAYS_INLINE u32 FifoPeek() { return Truncate32(m_fifo.Peek()); }
-  ALWAYS_INLINE u32 FifoPeek(u32 i) { return Truncate32(m_fifo.Peek(i)); }
+  /// Span of RAM which commands are read from instead of the FIFO, set by DMAWriteSpan(). The FIFO is always empty
+  /// while this is in use.
+  const u32* m_dma_span_ptr = nullptr;
+  u32 m_dma_span_address = 0;
+  u32 m_dma_span_size = 0;
+
+  ALWAYS_INLINE u32 FifoSize() const { return m_dma_span_ptr ? m_dma_span_size : m_fifo.GetSize(); }
+  ALWAYS_INLINE u32 FifoPop()
+  {
+    if (m_dma_span_ptr)
+    {
+      m_dma_span_address += sizeof(u32);
+      m_dma_span_size--;
+      return *(m_dma_span_ptr++);
+    }
+
+    return Truncate32(m_fifo.Pop());
+  }
+  ALWAYS_INLINE u64 FifoPopWithAddress()
+  {
+    if (m_dma_span_ptr)
+    {
+      const u64 value = (ZeroExtend64(m_dma_span_address) << 32) | ZeroExtend64(*m_dma_span_ptr);
+      m_dma_span_ptr++;
+      m_dma_span_address += sizeof(u32);
+      m_dma_span_size--;
+      return value;
+    }
+
+    return m_fifo.Pop();
+  }
+  ALWAYS_INLINE void FifoRemoveOne()
+  {
+    if (m_dma_span_ptr)
+    {
+      m_dma_span_ptr++;
+      m_dma_span_address += sizeof(u32);
+      m_dma_span_size--;
+      return;
+    }
+
+    m_fifo.RemoveOne();
+  }
+  ALWAYS_INLINE u32 FifoPeek() { return m_dma_span_ptr ? m_dma_span_ptr[0] : Truncate32(m_fifo.Peek()); }
+  ALWAYS_INLINE u32 FifoPeek(u32 i) { return m_dma_span_ptr ? m_dma_span_ptr[i] : Truncate32(m_fifo.Peek(i)); }
 
   TickCount m_max_run_ahead = 128;
   u32 m_fifo_size = 128;
+  bool m_bulk_vram_writes = true;
+  bool m_direct_dma_commands = true;
+
+  std::unique_ptr<GPUDump::Recorder> m_dump_recorder;
+  CommandTimings* m_command_timings = nullptr;
 
   void ClearDisplayTexture();
   void SetDisplayTexture(GPUTexture* texture, s32 view_x, s32 view_y, s32 view_width, s32 view_height);
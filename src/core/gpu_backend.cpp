@@ -102,46 +102,67 @@ void* GPUBackend::AllocateCommand(GPUBackendCommandType command, u32 size)
   // Ensure size is a multiple of 4 so we don't end up with an unaligned command.
   size = Common::AlignUpPow2(size, 4);
 
+  // Only this thread writes the write pointer, and the cached read pointer can only lag behind the real one, so
+  // the space computed from it is never more than is actually free.
+  u32 write_ptr = m_command_fifo_write_ptr.load(std::memory_order_relaxed);
   for (;;)
   {
-    u32 read_ptr = m_command_fifo_read_ptr.load();
-    u32 write_ptr = m_command_fifo_write_ptr.load();
+    const u32 read_ptr = m_cached_read_ptr;
     if (read_ptr > write_ptr)
     {
-      u32 available_size = read_ptr - write_ptr;
-      while (available_size < (size + sizeof(GPUBackendCommandType)))
-      {
-        WakeGPUThread();
-        read_ptr = m_command_fifo_read_ptr.load();
-        available_size = (read_ptr > write_ptr) ? (read_ptr - write_ptr) : (COMMAND_QUEUE_SIZE - write_ptr);
-      }
+      // Don't fill the gap completely, a full queue would look empty.
+      if ((read_ptr - write_ptr) > size)
+        break;
     }
     else
     {
-      const u32 available_size = COMMAND_QUEUE_SIZE - write_ptr;
-      if ((size + sizeof(GPUBackendCommand)) > available_size)
+      if ((size + sizeof(GPUBackendCommand)) <= (COMMAND_QUEUE_SIZE - write_ptr))
+        break;
+
+      // Same goes for wrapping around while the reader is still at the start of the buffer.
+      if (read_ptr != 0)
       {
         // allocate a dummy command to wrap the buffer around
         GPUBackendCommand* dummy_cmd = reinterpret_cast<GPUBackendCommand*>(&m_command_fifo_data[write_ptr]);
         dummy_cmd->type = GPUBackendCommandType::Wraparound;
-        dummy_cmd->size = available_size;
+        dummy_cmd->size = COMMAND_QUEUE_SIZE - write_ptr;
         dummy_cmd->params.bits = 0;
-        m_command_fifo_write_ptr.store(0);
+        write_ptr = 0;
+        m_command_fifo_write_ptr.store(0, std::memory_order_release);
         continue;
       }
     }
 
-    GPUBackendCommand* cmd = reinterpret_cast<GPUBackendCommand*>(&m_command_fifo_data[write_ptr]);
-    cmd->type = command;
-    cmd->size = size;
-    return cmd;
+    WaitForCommandSpace();
   }
+
+  GPUBackendCommand* cmd = reinterpret_cast<GPUBackendCommand*>(&m_command_fifo_data[write_ptr]);
+  cmd->type = command;
+  cmd->size = size;
+  return cmd;
+}
+
+void GPUBackend::WaitForCommandSpace()
+{
+  const u32 last_read_ptr = m_cached_read_ptr;
+  m_cached_read_ptr = m_command_fifo_read_ptr.load(std::memory_order_acquire);
+  if (m_cached_read_ptr != last_read_ptr)
+    return;
+
+  // Queue is genuinely full, the GPU thread has to catch up.
+  const Common::Timer::Value start_time = Common::Timer::GetCurrentValue();
+  WakeGPUThread();
+  while ((m_cached_read_ptr = m_command_fifo_read_ptr.load(std::memory_order_acquire)) == last_read_ptr)
+    ;
+
+  m_stats_stall_ticks += Common::Timer::GetCurrentValue() - start_time;
+  m_stats_stall_count++;
 }
 
 u32 GPUBackend::GetPendingCommandSize() const
 {
-  const u32 read_ptr = m_command_fifo_read_ptr.load();
-  const u32 write_ptr = m_command_fifo_write_ptr.load();
+  const u32 read_ptr = m_command_fifo_read_ptr.load(std::memory_order_acquire);
+  const u32 write_ptr = m_command_fifo_write_ptr.load(std::memory_order_acquire);
   return (write_ptr >= read_ptr) ? (write_ptr - read_ptr) : (COMMAND_QUEUE_SIZE - read_ptr + write_ptr);
 }
 
@@ -155,21 +176,35 @@ void GPUBackend::PushCommand(GPUBackendCommand* cmd)
   }
   else
   {
-    const u32 new_write_ptr = m_command_fifo_write_ptr.fetch_add(cmd->size) + cmd->size;
+    // Publishing is a plain store, but checking whether the GPU thread needs waking isn't, so only do that once
+    // enough commands have built up.
+    const u32 new_write_ptr = m_command_fifo_write_ptr.load(std::memory_order_relaxed) + cmd->size;
     DebugAssert(new_write_ptr <= COMMAND_QUEUE_SIZE);
-    UNREFERENCED_VARIABLE(new_write_ptr);
-    if (GetPendingCommandSize() >= THRESHOLD_TO_WAKE_GPU)
+    m_command_fifo_write_ptr.store(new_write_ptr, std::memory_order_release);
+
+    m_unsignalled_size += cmd->size;
+    if (m_unsignalled_size >= THRESHOLD_TO_WAKE_GPU)
+    {
+      m_unsignalled_size = 0;
+
+      const u32 depth = GetPendingCommandSize();
+      m_stats_depth_sum += depth;
+      m_stats_depth_samples++;
+      m_stats_max_depth = std::max(m_stats_max_depth, depth);
+
       WakeGPUThread();
+    }
   }
 }
 
 void GPUBackend::WakeGPUThread()
 {
-  std::unique_lock<std::mutex> lock(m_sync_mutex);
-  if (!m_gpu_thread_sleeping.load())
+  // Pairs with the fence in RunGPULoop(). Either we see the GPU thread going to sleep, or it sees our commands.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!m_gpu_thread_sleeping.load(std::memory_order_relaxed) || !m_gpu_thread_sleeping.exchange(false))
     return;
 
-  m_wake_gpu_thread_cv.notify_one();
+  m_wake_semaphore.Post();
 }
 
 void GPUBackend::StartGPUThread()
@@ -203,28 +238,67 @@ void GPUBackend::Sync(bool allow_sleep)
   PushCommand(cmd);
   WakeGPUThread();
 
+  const Common::Timer::Value start_time = Common::Timer::GetCurrentValue();
   m_sync_semaphore.Wait();
+  m_stats_stall_ticks += Common::Timer::GetCurrentValue() - start_time;
+  m_stats_stall_count++;
+}
+
+GPUBackend::QueueStats GPUBackend::GetAndResetQueueStats()
+{
+  QueueStats stats;
+  stats.average_depth =
+    (m_stats_depth_samples > 0) ? static_cast<u32>(m_stats_depth_sum / m_stats_depth_samples) : 0;
+  stats.max_depth = m_stats_max_depth;
+  stats.stall_count = m_stats_stall_count;
+  stats.stall_time = static_cast<float>(Common::Timer::ConvertValueToMilliseconds(m_stats_stall_ticks));
+
+  m_stats_depth_samples = 0;
+  m_stats_max_depth = 0;
+  m_stats_stall_count = 0;
+  m_stats_depth_sum = 0;
+  m_stats_stall_ticks = 0;
+  return stats;
 }
 
 void GPUBackend::RunGPULoop()
 {
-  static constexpr double SPIN_TIME_NS = 1 * 1000000;
+  // How long to spin for before sleeping adapts to how long the CPU thread usually leaves us waiting. Short gaps
+  // between batches (e.g. within a frame) aren't worth a kernel round trip, but spinning through the rest of the
+  // frame after the last batch is wasted.
+  static constexpr double MIN_SPIN_TIME_NS = 20 * 1000;
+  static constexpr double MAX_SPIN_TIME_NS = 1 * 1000000;
+  const Common::Timer::Value min_spin_time = Common::Timer::ConvertNanosecondsToValue(MIN_SPIN_TIME_NS);
+  const Common::Timer::Value max_spin_time = Common::Timer::ConvertNanosecondsToValue(MAX_SPIN_TIME_NS);
   Common::Timer::Value last_command_time = 0;
+  m_spin_time = max_spin_time;
 
   for (;;)
   {
-    u32 write_ptr = m_command_fifo_write_ptr.load();
-    u32 read_ptr = m_command_fifo_read_ptr.load();
+    u32 write_ptr = m_command_fifo_write_ptr.load(std::memory_order_acquire);
+    u32 read_ptr = m_command_fifo_read_ptr.load(std::memory_order_relaxed);
     if (read_ptr == write_ptr)
     {
       const Common::Timer::Value current_time = Common::Timer::GetCurrentValue();
-      if (Common::Timer::ConvertValueToNanoseconds(current_time - last_command_time) < SPIN_TIME_NS)
+      if ((current_time - last_command_time) < m_spin_time)
         continue;
 
-      std::unique_lock<std::mutex> lock(m_sync_mutex);
-      m_gpu_thread_sleeping.store(true);
-      m_wake_gpu_thread_cv.wait(lock, [this]() { return m_gpu_loop_done.load() || GetPendingCommandSize() > 0; });
-      m_gpu_thread_sleeping.store(false);
+      m_gpu_thread_sleeping.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (GetPendingCommandSize() == 0 && !m_gpu_loop_done.load())
+      {
+        m_wake_semaphore.Wait();
+
+        // Woken up soon after giving up? Spin for longer next time. Otherwise, back off.
+        const Common::Timer::Value slept_time = Common::Timer::GetCurrentValue() - current_time;
+        m_spin_time = (slept_time < max_spin_time) ? std::min(m_spin_time * 2, max_spin_time) :
+                                                     std::max(m_spin_time / 2, min_spin_time);
+      }
+      else if (!m_gpu_thread_sleeping.exchange(false))
+      {
+        // CPU thread is already waking us, consume it so the semaphore doesn't get out of step.
+        m_wake_semaphore.Wait();
+      }
 
       if (m_gpu_loop_done.load())
         break;
@@ -246,14 +320,18 @@ void GPUBackend::RunGPULoop()
         case GPUBackendCommandType::Wraparound:
         {
           DebugAssert(read_ptr == COMMAND_QUEUE_SIZE);
-          write_ptr = m_command_fifo_write_ptr.load();
+          write_ptr = m_command_fifo_write_ptr.load(std::memory_order_acquire);
           read_ptr = 0;
+
+          // Let the CPU thread reuse the end of the buffer while we work through the start.
+          m_command_fifo_read_ptr.store(0, std::memory_order_release);
         }
         break;
 
         case GPUBackendCommandType::Sync:
         {
           DebugAssert(read_ptr == write_ptr);
+          FlushRender();
           m_sync_semaphore.Post();
           allow_sleep = static_cast<const GPUBackendSyncCommand*>(cmd)->allow_sleep;
         }
@@ -266,7 +344,7 @@ void GPUBackend::RunGPULoop()
     }
 
     last_command_time = allow_sleep ? 0 : Common::Timer::GetCurrentValue();
-    m_command_fifo_read_ptr.store(read_ptr);
+    m_command_fifo_read_ptr.store(read_ptr, std::memory_order_release);
   }
 }
 
@@ -6,9 +6,7 @@
 #include "common/threading.h"
 #include "gpu_types.h"
 #include <atomic>
-#include <condition_variable>
 #include <memory>
-#include <mutex>
 #include <thread>
 
 #ifdef _MSC_VER
@@ -19,6 +17,14 @@
 class GPUBackend
 {
 public:
+  struct QueueStats
+  {
+    u32 average_depth; // in bytes, sampled each time the GPU thread is signalled
+    u32 max_depth;
+    u32 stall_count;
+    float stall_time; // in milliseconds, waiting for queue space or syncs
+  };
+
   GPUBackend();
   virtual ~GPUBackend();
 
@@ -44,9 +50,13 @@ public:
   /// Processes all pending GPU commands.
   void RunGPULoop();
 
+  /// Returns command queue statistics since the last call, and resets them. Only callable from the CPU thread.
+  QueueStats GetAndResetQueueStats();
+
 protected:
   void* AllocateCommand(GPUBackendCommandType command, u32 size);
   u32 GetPendingCommandSize() const;
+  void WaitForCommandSpace();
   void WakeGPUThread();
   void StartGPUThread();
   void StopGPUThread();
@@ -69,16 +79,10 @@ protected:
   Common::Rectangle<u32> m_drawing_area{};
 
   Threading::KernelSemaphore m_sync_semaphore;
-  std::atomic_bool m_gpu_thread_sleeping{false};
-  std::atomic_bool m_gpu_loop_done{false};
+  Threading::KernelSemaphore m_wake_semaphore;
   Threading::Thread m_gpu_thread;
   bool m_use_gpu_thread = false;
 
-  std::mutex m_sync_mutex;
-  std::condition_variable m_sync_cpu_thread_cv;
-  std::condition_variable m_wake_gpu_thread_cv;
-  bool m_sync_done = false;
-
   enum : u32
   {
     COMMAND_QUEUE_SIZE = 4 * 1024 * 1024,
@@ -86,8 +90,26 @@ protected:
   };
 
   FixedHeapArray<u8, COMMAND_QUEUE_SIZE> m_command_fifo_data;
-  alignas(64) std::atomic<u32> m_command_fifo_read_ptr{0};
+
+  // Each side of the queue owns a cache line, so the CPU thread doesn't bounce the GPU thread's state around when
+  // writing commands, and vice versa. The read pointer is only fetched when the queue looks full, or when signalling.
+
+  // CPU thread
   alignas(64) std::atomic<u32> m_command_fifo_write_ptr{0};
+  u32 m_cached_read_ptr = 0;
+  u32 m_unsignalled_size = 0;
+  u32 m_stats_depth_samples = 0;
+  u32 m_stats_max_depth = 0;
+  u32 m_stats_stall_count = 0;
+  u64 m_stats_depth_sum = 0;
+  u64 m_stats_stall_ticks = 0;
+
+  // GPU thread
+  alignas(64) std::atomic<u32> m_command_fifo_read_ptr{0};
+  u64 m_spin_time = 0;
+
+  alignas(64) std::atomic_bool m_gpu_thread_sleeping{false};
+  std::atomic_bool m_gpu_loop_done{false};
 };
 
 #ifdef _MSC_VER
@@ -4,14 +4,16 @@
 #include "common/assert.h"
 #include "common/log.h"
 #include "common/string_util.h"
+#include "common/timer.h"
 #include "gpu.h"
 #include "interrupt_controller.h"
+#include "subsystem_profiler.h"
 #include "system.h"
 #include "texture_replacements.h"
 Log_SetChannel(GPU);
 
 #define CHECK_COMMAND_SIZE(num_words)                                                                                  \
-  if (m_fifo.GetSize() < num_words)                                                                                    \
+  if (FifoSize() < num_words)                                                                                          \
   {                                                                                                                    \
     m_command_total_words = num_words;                                                                                 \
     return false;                                                                                                      \
@@ -25,8 +27,25 @@ static constexpr u32 ReplaceZero(u32 value, u32 value_for_zero)
   return value == 0 ? value_for_zero : value;
 }
 
+ALWAYS_INLINE_RELEASE bool GPU::ExecuteGP0Command(u32 command)
+{
+  if (!m_command_timings) [[likely]]
+    return (this->*s_GP0_command_handler_table[command])();
+
+  // Incomplete commands aren't counted, only the call which executes them.
+  const Common::Timer::Value start = Common::Timer::GetCurrentValue();
+  if (!(this->*s_GP0_command_handler_table[command])())
+    return false;
+
+  m_command_timings->time[command] += Common::Timer::GetCurrentValue() - start;
+  m_command_timings->count[command]++;
+  return true;
+}
+
 void GPU::ExecuteCommands()
 {
+  SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::GPU);
+
   m_syncing = true;
 
   for (;;)
@@ -38,7 +57,7 @@ void GPU::ExecuteCommands()
         case BlitterState::Idle:
         {
           const u32 command = FifoPeek(0) >> 24;
-          if ((this->*s_GP0_command_handler_table[command])())
+          if (ExecuteGP0Command(command))
             continue;
           else
             goto batch_done;
@@ -47,7 +66,7 @@ void GPU::ExecuteCommands()
         case BlitterState::WritingVRAM:
         {
           DebugAssert(m_blit_remaining_words > 0);
-          const u32 words_to_copy = std::min(m_blit_remaining_words, m_fifo.GetSize());
+          const u32 words_to_copy = std::min(m_blit_remaining_words, FifoSize());
           m_blit_buffer.reserve(m_blit_buffer.size() + words_to_copy);
           for (u32 i = 0; i < words_to_copy; i++)
             m_blit_buffer.push_back(FifoPop());
@@ -55,7 +74,7 @@ void GPU::ExecuteCommands()
 
           Log_DebugPrintf("VRAM write burst of %u words, %u words remaining", words_to_copy, m_blit_remaining_words);
           if (m_blit_remaining_words == 0)
-            FinishVRAMWrite();
+            FinishVRAMWrite(m_blit_buffer.data());
 
           continue;
         }
@@ -71,7 +90,7 @@ void GPU::ExecuteCommands()
           const u32 words_per_vertex = m_render_command.shading_enable ? 2 : 1;
           u32 terminator_index =
             m_render_command.shading_enable ? ((static_cast<u32>(m_blit_buffer.size()) & 1u) ^ 1u) : 0u;
-          for (; terminator_index < m_fifo.GetSize(); terminator_index += words_per_vertex)
+          for (; terminator_index < FifoSize(); terminator_index += words_per_vertex)
           {
             // polyline must have at least two vertices, and the terminator is (word & 0xf000f000) == 0x50005000.
             // terminator is on the first word for the vertex
@@ -79,8 +98,8 @@ void GPU::ExecuteCommands()
               break;
           }
 
-          const bool found_terminator = (terminator_index < m_fifo.GetSize());
-          const u32 words_to_copy = std::min(terminator_index, m_fifo.GetSize());
+          const bool found_terminator = (terminator_index < FifoSize());
+          const u32 words_to_copy = std::min(terminator_index, FifoSize());
           if (words_to_copy > 0)
           {
             m_blit_buffer.reserve(m_blit_buffer.size() + words_to_copy);
@@ -92,7 +111,7 @@ void GPU::ExecuteCommands()
           if (found_terminator)
           {
             // drop terminator
-            m_fifo.RemoveOne();
+            FifoRemoveOne();
             Log_DebugPrintf("Drawing poly-line with %u vertices", GetPolyLineVertexCount());
             DispatchRenderCommand();
             m_blit_buffer.clear();
@@ -115,6 +134,59 @@ void GPU::ExecuteCommands()
   m_syncing = false;
 }
 
+void GPU::DMAWriteSpan(u32 address, const u32* words, u32 word_count)
+{
+  // Same as ExecuteCommands() with the words in the FIFO, except they're read from RAM. Only possible when the FIFO is
+  // empty, otherwise the span would jump ahead of it. Anything which can't run yet goes into the FIFO as usual. The
+  // CPU and other DMA channels don't run until the transfer returns, so the span can't change underneath us.
+  if (m_dump_recorder) [[unlikely]]
+    m_dump_recorder->WriteGP0(words, word_count);
+
+  if (m_fifo.IsEmpty() && !m_syncing)
+  {
+    SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::GPU);
+    m_syncing = true;
+
+    while (word_count > 0 && m_pending_command_ticks <= m_max_run_ahead)
+    {
+      if (m_blitter_state == BlitterState::Idle && m_direct_dma_commands)
+      {
+        m_dma_span_ptr = words;
+        m_dma_span_address = address;
+        m_dma_span_size = word_count;
+
+        const u32 command = words[0] >> 24;
+        const bool executed = ExecuteGP0Command(command);
+
+        const u32 words_used = word_count - m_dma_span_size;
+        m_dma_span_ptr = nullptr;
+        words += words_used;
+        address += words_used * sizeof(u32);
+        word_count -= words_used;
+        if (!executed)
+          break;
+      }
+      else if (m_blitter_state == BlitterState::WritingVRAM && m_bulk_vram_writes)
+      {
+        const u32 words_used = std::min(word_count, m_blit_remaining_words);
+        AppendVRAMWrite(words, words_used);
+        words += words_used;
+        address += words_used * sizeof(u32);
+        word_count -= words_used;
+      }
+      else
+      {
+        break;
+      }
+    }
+
+    m_syncing = false;
+  }
+
+  for (u32 i = 0; i < word_count; i++)
+    m_fifo.Push((ZeroExtend64(address + (i * sizeof(u32))) << 32) | ZeroExtend64(words[i]));
+}
+
 void GPU::EndCommand()
 {
   m_blitter_state = BlitterState::Idle;
@@ -179,18 +251,18 @@ bool GPU::HandleUnknownGP0Command()
   Log_ErrorPrintf("Unimplemented GP0 command 0x%02X", command);
 
   SmallString dump;
-  for (u32 i = 0; i < m_fifo.GetSize(); i++)
+  for (u32 i = 0; i < FifoSize(); i++)
     dump.append_format("{}{:08X}", (i > 0) ? " " : "", FifoPeek(i));
   Log_ErrorPrintf("FIFO: %s", dump.c_str());
 
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
   EndCommand();
   return true;
 }
 
 bool GPU::HandleNOPCommand()
 {
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
   EndCommand();
   return true;
 }
@@ -199,7 +271,7 @@ bool GPU::HandleClearCacheCommand()
 {
   Log_DebugPrintf("GP0 clear cache");
   m_draw_mode.SetTexturePageChanged();
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
   AddCommandTicks(1);
   EndCommand();
   return true;
@@ -214,7 +286,7 @@ bool GPU::HandleInterruptRequestCommand()
     InterruptController::InterruptRequest(InterruptController::IRQ::GPU);
   }
 
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
   AddCommandTicks(1);
   EndCommand();
   return true;
@@ -355,7 +427,7 @@ bool GPU::HandleRenderPolygonCommand()
   m_stats.num_vertices += num_vertices;
   m_stats.num_polygons++;
   m_render_command.bits = rc.bits;
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   DispatchRenderCommand();
   EndCommand();
@@ -387,7 +459,7 @@ bool GPU::HandleRenderRectangleCommand()
   m_stats.num_vertices++;
   m_stats.num_polygons++;
   m_render_command.bits = rc.bits;
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   DispatchRenderCommand();
   EndCommand();
@@ -409,7 +481,7 @@ bool GPU::HandleRenderLineCommand()
   m_stats.num_vertices += 2;
   m_stats.num_polygons++;
   m_render_command.bits = rc.bits;
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   DispatchRenderCommand();
   EndCommand();
@@ -433,7 +505,7 @@ bool GPU::HandleRenderPolyLineCommand()
                   rc.shading_enable ? "shaded" : "monochrome", setup_ticks);
 
   m_render_command.bits = rc.bits;
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   const u32 words_to_pop = min_words - 1;
   // m_blit_buffer.resize(words_to_pop);
@@ -477,7 +549,7 @@ bool GPU::HandleFillRectangleCommand()
 bool GPU::HandleCopyRectangleCPUToVRAMCommand()
 {
   CHECK_COMMAND_SIZE(3);
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   const u32 dst_x = FifoPeek() & VRAM_WIDTH_MASK;
   const u32 dst_y = (FifoPop() >> 16) & VRAM_HEIGHT_MASK;
@@ -501,7 +573,7 @@ bool GPU::HandleCopyRectangleCPUToVRAMCommand()
   return true;
 }
 
-void GPU::FinishVRAMWrite()
+void GPU::FinishVRAMWrite(const void* data)
 {
   if (IsInterlacedRenderingEnabled() && IsCRTCScanlinePending())
     SynchronizeCRTC();
@@ -513,17 +585,17 @@ void GPU::FinishVRAMWrite()
     if (g_settings.debugging.dump_cpu_to_vram_copies)
     {
       DumpVRAMToFile(TinyString::from_format("cpu_to_vram_copy_{}.png", s_cpu_to_vram_dump_id++), m_vram_transfer.width,
-                     m_vram_transfer.height, sizeof(u16) * m_vram_transfer.width, m_blit_buffer.data(), true);
+                     m_vram_transfer.height, sizeof(u16) * m_vram_transfer.width, data, true);
     }
 
     if (g_settings.texture_replacements.ShouldDumpVRAMWrite(m_vram_transfer.width, m_vram_transfer.height))
     {
       g_texture_replacements.DumpVRAMWrite(m_vram_transfer.width, m_vram_transfer.height,
-                                           reinterpret_cast<const u16*>(m_blit_buffer.data()));
+                                           static_cast<const u16*>(data));
     }
 
-    UpdateVRAM(m_vram_transfer.x, m_vram_transfer.y, m_vram_transfer.width, m_vram_transfer.height,
-               m_blit_buffer.data(), m_GPUSTAT.set_mask_while_drawing, m_GPUSTAT.check_mask_before_draw);
+    UpdateVRAM(m_vram_transfer.x, m_vram_transfer.y, m_vram_transfer.width, m_vram_transfer.height, data,
+               m_GPUSTAT.set_mask_while_drawing, m_GPUSTAT.check_mask_before_draw);
   }
   else
   {
@@ -538,7 +610,7 @@ void GPU::FinishVRAMWrite()
       "Partial VRAM write - transfer finished with %u of %u words remaining (%u full rows, %u last row)",
       m_blit_remaining_words, num_words, transferred_full_rows, transferred_width_last_row);
 
-    const u8* blit_ptr = reinterpret_cast<const u8*>(m_blit_buffer.data());
+    const u8* blit_ptr = static_cast<const u8*>(data);
     if (transferred_full_rows > 0)
     {
       UpdateVRAM(m_vram_transfer.x, m_vram_transfer.y, m_vram_transfer.width, transferred_full_rows, blit_ptr,
@@ -561,7 +633,7 @@ void GPU::FinishVRAMWrite()
 bool GPU::HandleCopyRectangleVRAMToCPUCommand()
 {
   CHECK_COMMAND_SIZE(3);
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   m_vram_transfer.x = Truncate16(FifoPeek() & VRAM_WIDTH_MASK);
   m_vram_transfer.y = Truncate16((FifoPop() >> 16) & VRAM_HEIGHT_MASK);
@@ -595,7 +667,7 @@ bool GPU::HandleCopyRectangleVRAMToCPUCommand()
 bool GPU::HandleCopyRectangleVRAMToVRAMCommand()
 {
   CHECK_COMMAND_SIZE(4);
-  m_fifo.RemoveOne();
+  FifoRemoveOne();
 
   const u32 src_x = FifoPeek() & VRAM_WIDTH_MASK;
   const u32 src_y = (FifoPop() >> 16) & VRAM_HEIGHT_MASK;
@@ -0,0 +1,263 @@
+// SPDX-FileCopyrightText: 2019-2023 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "gpu_dump.h"
+#include "gpu.h"
+#include "gpu_types.h"
+
+#include "common/error.h"
+#include "common/log.h"
+
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+Log_SetChannel(GPUDump);
+
+namespace GPUDump {
+static constexpr char FILE_MAGIC[8] = {'D', 'S', 'G', 'P', 'U', 'D', 'M', 'P'};
+static constexpr u32 FILE_VERSION = 1;
+static constexpr u32 HEADER_WORDS = (sizeof(FILE_MAGIC) / sizeof(u32)) + 1;
+static constexpr u32 VRAM_WORDS = (VRAM_WIDTH * VRAM_HEIGHT) / 2;
+
+// Packets are split at this size, it needs to fit in the lower 24 bits of the packet header.
+static constexpr u32 MAX_PACKET_WORDS = 64 * 1024;
+static constexpr u32 PACKET_LENGTH_MASK = 0xFFFFFFu;
+
+ALWAYS_INLINE static u32 MakePacketHeader(PacketType type, u32 word_count)
+{
+  return (static_cast<u32>(type) << 24) | word_count;
+}
+} // namespace GPUDump
+
+GPUDump::Recorder::Recorder(FileSystem::ManagedCFilePtr fp, std::string filename)
+  : m_fp(std::move(fp)), m_filename(std::move(filename))
+{
+  m_packet.reserve(MAX_PACKET_WORDS);
+}
+
+GPUDump::Recorder::~Recorder()
+{
+  if (m_fp)
+    Close();
+}
+
+std::unique_ptr<GPUDump::Recorder> GPUDump::Recorder::Create(const char* filename, Error* error)
+{
+  FileSystem::ManagedCFilePtr fp = FileSystem::OpenManagedCFile(filename, "wb", error);
+  if (!fp)
+    return {};
+
+  const u32 version = FILE_VERSION;
+  if (std::fwrite(FILE_MAGIC, sizeof(FILE_MAGIC), 1, fp.get()) != 1 ||
+      std::fwrite(&version, sizeof(version), 1, fp.get()) != 1)
+  {
+    Error::SetErrno(error, errno);
+    return {};
+  }
+
+  return std::unique_ptr<Recorder>(new Recorder(std::move(fp), filename));
+}
+
+void GPUDump::Recorder::BeginPacket(PacketType type)
+{
+  if (m_packet_type != type || m_packet.size() >= MAX_PACKET_WORDS)
+  {
+    FlushPacket();
+    m_packet_type = type;
+  }
+}
+
+void GPUDump::Recorder::FlushPacket()
+{
+  if (m_packet.empty())
+    return;
+
+  const u32 header = MakePacketHeader(m_packet_type, static_cast<u32>(m_packet.size()));
+  if (!m_write_failed && (std::fwrite(&header, sizeof(header), 1, m_fp.get()) != 1 ||
+                          std::fwrite(m_packet.data(), sizeof(u32), m_packet.size(), m_fp.get()) != m_packet.size()))
+  {
+    Log_ErrorPrintf("Failed to write to GPU dump '%s', the rest of the recording will be lost.", m_filename.c_str());
+    m_write_failed = true;
+  }
+
+  m_packet.clear();
+}
+
+void GPUDump::Recorder::WriteGP0(u32 value)
+{
+  BeginPacket(PacketType::GP0);
+  m_packet.push_back(value);
+}
+
+void GPUDump::Recorder::WriteGP0(const u32* words, u32 word_count)
+{
+  while (word_count > 0)
+  {
+    BeginPacket(PacketType::GP0);
+    const u32 count = std::min(word_count, MAX_PACKET_WORDS - static_cast<u32>(m_packet.size()));
+    m_packet.insert(m_packet.end(), words, words + count);
+    words += count;
+    word_count -= count;
+  }
+}
+
+void GPUDump::Recorder::WriteGP1(u32 value)
+{
+  BeginPacket(PacketType::GP1);
+  m_packet.push_back(value);
+}
+
+void GPUDump::Recorder::WriteGPUREAD(u32 word_count)
+{
+  // Consecutive reads are merged, they're only needed to end the transfer at the right point in the stream.
+  if (m_packet_type == PacketType::GPUREAD && !m_packet.empty())
+  {
+    m_packet[0] += word_count;
+    return;
+  }
+
+  BeginPacket(PacketType::GPUREAD);
+  m_packet.push_back(word_count);
+}
+
+void GPUDump::Recorder::WriteVSync(u32 fields)
+{
+  BeginPacket(PacketType::VSync);
+  m_packet.push_back(fields);
+  FlushPacket();
+  m_frame_count++;
+}
+
+void GPUDump::Recorder::WriteVRAM(const u16* vram)
+{
+  FlushPacket();
+  m_packet_type = PacketType::VRAM;
+  m_packet.resize(VRAM_WORDS);
+  std::memcpy(m_packet.data(), vram, VRAM_WORDS * sizeof(u32));
+  FlushPacket();
+}
+
+bool GPUDump::Recorder::Close()
+{
+  FlushPacket();
+  if (!m_write_failed && std::fflush(m_fp.get()) != 0)
+  {
+    Log_ErrorPrintf("Failed to flush GPU dump '%s'.", m_filename.c_str());
+    m_write_failed = true;
+  }
+
+  m_fp.reset();
+  Log_InfoPrintf("Closed GPU dump '%s' after %u frames.", m_filename.c_str(), m_frame_count);
+  return !m_write_failed;
+}
+
+GPUDump::Player::Player(std::vector<u32> data, u32 frame_count) : m_data(std::move(data)), m_frame_count(frame_count)
+{
+  Rewind();
+}
+
+GPUDump::Player::~Player() = default;
+
+std::unique_ptr<GPUDump::Player> GPUDump::Player::Open(const char* filename, Error* error)
+{
+  std::optional<std::vector<u8>> file_data = FileSystem::ReadBinaryFile(filename, error);
+  if (!file_data.has_value())
+    return {};
+
+  if (file_data->size() < (HEADER_WORDS * sizeof(u32)) || (file_data->size() % sizeof(u32)) != 0 ||
+      std::memcmp(file_data->data(), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+  {
+    Error::SetString(error, fmt::format("'{}' is not a GPU dump.", filename));
+    return {};
+  }
+
+  std::vector<u32> data(file_data->size() / sizeof(u32));
+  std::memcpy(data.data(), file_data->data(), file_data->size());
+  file_data.reset();
+
+  if (data[HEADER_WORDS - 1] != FILE_VERSION)
+  {
+    Error::SetString(error, fmt::format("GPU dump '{}' is version {}, expected version {}.", filename,
+                                        data[HEADER_WORDS - 1], FILE_VERSION));
+    return {};
+  }
+
+  // Check the packets up front, so playback doesn't need to.
+  u32 frame_count = 0;
+  bool has_vram = false;
+  for (size_t position = HEADER_WORDS; position < data.size();)
+  {
+    const PacketType type = static_cast<PacketType>(data[position] >> 24);
+    const u32 length = data[position] & PACKET_LENGTH_MASK;
+    if ((data.size() - position - 1) < length || length == 0)
+    {
+      Error::SetString(error, fmt::format("GPU dump '{}' is truncated at word {}.", filename, position));
+      return {};
+    }
+
+    switch (type)
+    {
+      case PacketType::GP0:
+      case PacketType::GP1:
+        break;
+
+      case PacketType::GPUREAD:
+      case PacketType::VSync:
+      case PacketType::VRAM:
+      {
+        const u32 expected_length = (type == PacketType::VRAM) ? VRAM_WORDS : 1;
+        if (length != expected_length)
+        {
+          Error::SetString(error, fmt::format("GPU dump '{}' has a packet of type {} with {} words at word {}.",
+                                              filename, static_cast<u32>(type), length, position));
+          return {};
+        }
+
+        frame_count += BoolToUInt32(type == PacketType::VSync);
+        has_vram |= (type == PacketType::VRAM);
+      }
+      break;
+
+      default:
+      {
+        Error::SetString(error, fmt::format("GPU dump '{}' has an unknown packet type {} at word {}.", filename,
+                                            static_cast<u32>(type), position));
+        return {};
+      }
+    }
+
+    position += 1 + length;
+  }
+
+  if (!has_vram)
+  {
+    Error::SetString(error, fmt::format("GPU dump '{}' does not contain VRAM.", filename));
+    return {};
+  }
+
+  return std::unique_ptr<Player>(new Player(std::move(data), frame_count));
+}
+
+void GPUDump::Player::Rewind()
+{
+  m_position = HEADER_WORDS;
+}
+
+bool GPUDump::Player::ProcessFrame()
+{
+  while (m_position < m_data.size())
+  {
+    const PacketType type = static_cast<PacketType>(m_data[m_position] >> 24);
+    const u32 length = m_data[m_position] & PACKET_LENGTH_MASK;
+    g_gpu->ProcessDumpPacket(type, &m_data[m_position + 1], length);
+    m_position += 1 + length;
+
+    if (type == PacketType::VSync)
+      return true;
+  }
+
+  return false;
+}
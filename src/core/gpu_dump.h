@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2019-2023 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include "types.h"
+
+#include "common/file_system.h"
+
+#include <memory>
+#include <vector>
+
+class Error;
+
+// Recording of everything the CPU and DMA send to the GPU, which can be replayed later without the rest of the
+// system. The file is a header followed by packets, each packet is a u32 with the type in the upper 8 bits and the
+// number of data words in the lower 24 bits, followed by the data words. Recordings start with a VRAM packet and the
+// commands needed to restore the drawing and display state, so they can begin at any frame.
+namespace GPUDump {
+
+enum class PacketType : u8
+{
+  GP0 = 1,     // Words written to GP0, from the CPU or DMA.
+  GP1 = 2,     // Words written to GP1.
+  GPUREAD = 3, // One word, the number of words read from GPUREAD while a VRAM read was in progress.
+  VSync = 4,   // One word, the displayed field in bit 0 and the field drawn next in bit 1. Marks the end of a frame.
+  VRAM = 5,    // VRAM_WIDTH * VRAM_HEIGHT / 2 words, the contents of VRAM.
+};
+
+class Recorder
+{
+public:
+  ~Recorder();
+
+  static std::unique_ptr<Recorder> Create(const char* filename, Error* error);
+
+  ALWAYS_INLINE u32 GetFrameCount() const { return m_frame_count; }
+
+  void WriteGP0(u32 value);
+  void WriteGP0(const u32* words, u32 word_count);
+  void WriteGP1(u32 value);
+  void WriteGPUREAD(u32 word_count);
+  void WriteVSync(u32 fields);
+  void WriteVRAM(const u16* vram);
+
+  /// Writes any buffered packet and closes the file. Returns false if any write failed.
+  bool Close();
+
+private:
+  Recorder(FileSystem::ManagedCFilePtr fp, std::string filename);
+
+  void BeginPacket(PacketType type);
+  void FlushPacket();
+
+  FileSystem::ManagedCFilePtr m_fp;
+  std::string m_filename;
+  std::vector<u32> m_packet;
+  PacketType m_packet_type = PacketType::GP0;
+  u32 m_frame_count = 0;
+  bool m_write_failed = false;
+};
+
+class Player
+{
+public:
+  ~Player();
+
+  static std::unique_ptr<Player> Open(const char* filename, Error* error);
+
+  ALWAYS_INLINE u32 GetFrameCount() const { return m_frame_count; }
+
+  /// Returns to the start of the recording.
+  void Rewind();
+
+  /// Sends packets to the current GPU up to and including the next VSync. Returns false at the end of the recording.
+  bool ProcessFrame();
+
+private:
+  Player(std::vector<u32> data, u32 frame_count);
+
+  std::vector<u32> m_data;
+  size_t m_position = 0;
+  u32 m_frame_count = 0;
+};
+
+} // namespace GPUDump
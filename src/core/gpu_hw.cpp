@@ -194,6 +194,11 @@ const Threading::Thread* GPU_HW::GetSWThread() const
   return m_sw_renderer ? m_sw_renderer->GetThread() : nullptr;
 }
 
+GPUBackend* GPU_HW::GetSWBackend()
+{
+  return m_sw_renderer.get();
+}
+
 bool GPU_HW::IsHardwareRenderer() const
 {
   return true;
@@ -1650,7 +1655,7 @@ void GPU_HW::LoadVertices()
       for (u32 i = 0; i < num_vertices; i++)
       {
         const u32 color = (shaded && i > 0) ? (FifoPop() & UINT32_C(0x00FFFFFF)) : first_color;
-        const u64 maddr_and_pos = m_fifo.Pop();
+        const u64 maddr_and_pos = FifoPopWithAddress();
         const GPUVertexPosition vp{Truncate32(maddr_and_pos)};
         const u16 texcoord = textured ? Truncate16(FifoPop()) : 0;
         const s32 native_x = m_drawing_offset.x + vp.x;
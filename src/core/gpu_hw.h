@@ -43,6 +43,7 @@ public:
   ~GPU_HW() override;
 
   const Threading::Thread* GetSWThread() const override;
+  GPUBackend* GetSWBackend() override;
   bool IsHardwareRenderer() const override;
 
   bool Initialize() override;
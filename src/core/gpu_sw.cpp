@@ -40,6 +40,11 @@ const Threading::Thread* GPU_SW::GetSWThread() const
   return m_backend.GetThread();
 }
 
+GPUBackend* GPU_SW::GetSWBackend()
+{
+  return &m_backend;
+}
+
 bool GPU_SW::IsHardwareRenderer() const
 {
   return false;
@@ -585,7 +590,7 @@ void GPU_SW::DispatchRenderCommand()
       {
         GPUBackendDrawPolygonCommand::Vertex* vert = &cmd->vertices[i];
         vert->color = (shaded && i > 0) ? (FifoPop() & UINT32_C(0x00FFFFFF)) : first_color;
-        const u64 maddr_and_pos = m_fifo.Pop();
+        const u64 maddr_and_pos = FifoPopWithAddress();
         const GPUVertexPosition vp{Truncate32(maddr_and_pos)};
         vert->x = m_drawing_offset.x + vp.x;
         vert->y = m_drawing_offset.y + vp.y;
@@ -28,6 +28,7 @@ public:
   ALWAYS_INLINE const GPU_SW_Backend& GetBackend() const { return m_backend; }
 
   const Threading::Thread* GetSWThread() const override;
+  GPUBackend* GetSWBackend() override;
   bool IsHardwareRenderer() const override;
 
   bool Initialize() override;
@@ -2,11 +2,22 @@
 // SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
 
 #include "gpu_sw_backend.h"
+#include "settings.h"
 #include "system.h"
 
 #include "util/gpu_device.h"
 
+#include "common/align.h"
+#include "common/intrin.h"
+#include "common/log.h"
+#include "common/timer.h"
+
 #include <algorithm>
+Log_SetChannel(GPU_SW_Backend);
+
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+#define GPU_SW_SIMD 1
+#endif
 
 GPU_SW_Backend::GPU_SW_Backend() : GPUBackend()
 {
@@ -14,11 +25,39 @@ GPU_SW_Backend::GPU_SW_Backend() : GPUBackend()
   m_vram_ptr = m_vram.data();
 }
 
-GPU_SW_Backend::~GPU_SW_Backend() = default;
+GPU_SW_Backend::~GPU_SW_Backend()
+{
+  StopRasterizerThreads();
+}
 
 bool GPU_SW_Backend::Initialize(bool force_thread)
 {
-  return GPUBackend::Initialize(force_thread);
+  if (!GPUBackend::Initialize(force_thread))
+    return false;
+
+  m_use_simd = g_settings.gpu_sw_use_simd;
+  m_simd_validation = g_settings.gpu_sw_simd_validation;
+
+  if (m_use_gpu_thread)
+    StartRasterizerThreads(g_settings.gpu_sw_rasterizer_threads);
+
+  return true;
+}
+
+void GPU_SW_Backend::UpdateSettings()
+{
+  GPUBackend::UpdateSettings();
+
+  m_use_simd = g_settings.gpu_sw_use_simd;
+  m_simd_validation = g_settings.gpu_sw_simd_validation;
+
+  // Sync() above flushed any pending batch, so the pool is idle.
+  const u32 thread_count = m_use_gpu_thread ? g_settings.gpu_sw_rasterizer_threads : 0;
+  if (thread_count != (m_rasterizer_threads.empty() ? 0 : static_cast<u32>(m_rasterizer_threads.size() + 1)))
+  {
+    StopRasterizerThreads();
+    StartRasterizerThreads(thread_count);
+  }
 }
 
 void GPU_SW_Backend::Reset(bool clear_vram)
@@ -29,7 +68,48 @@ void GPU_SW_Backend::Reset(bool clear_vram)
     m_vram.fill(0);
 }
 
+void GPU_SW_Backend::Shutdown()
+{
+  GPUBackend::Shutdown();
+  StopRasterizerThreads();
+}
+
+GPU_SW_Backend::RasterizerStats GPU_SW_Backend::GetRasterizerStats() const
+{
+  return RasterizerStats{m_stat_batches.load(std::memory_order_relaxed),
+                         m_stat_parallel_batches.load(std::memory_order_relaxed),
+                         m_stat_commands.load(std::memory_order_relaxed),
+                         m_stat_wall_time.load(std::memory_order_relaxed),
+                         m_stat_busy_time.load(std::memory_order_relaxed),
+                         m_stat_simd_checks.load(std::memory_order_relaxed),
+                         m_stat_simd_mismatches.load(std::memory_order_relaxed)};
+}
+
 void GPU_SW_Backend::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
+{
+  if (IsBatchingEnabled())
+    QueueCommand(cmd);
+  else
+    RasterizePolygon(cmd, m_drawing_area);
+}
+
+void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
+{
+  if (IsBatchingEnabled())
+    QueueCommand(cmd);
+  else
+    RasterizeRectangle(cmd, m_drawing_area);
+}
+
+void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd)
+{
+  if (IsBatchingEnabled())
+    QueueCommand(cmd);
+  else
+    RasterizeLine(cmd, m_drawing_area);
+}
+
+void GPU_SW_Backend::RasterizePolygon(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip)
 {
   const GPURenderCommand rc{cmd->rc.bits};
   const bool dithering_enable = rc.IsDitheringEnabled() && cmd->draw_mode.dither_enable;
@@ -37,28 +117,49 @@ void GPU_SW_Backend::DrawPolygon(const GPUBackendDrawPolygonCommand* cmd)
   const DrawTriangleFunction DrawFunction = GetDrawTriangleFunction(
     rc.shading_enable, rc.texture_enable, rc.raw_texture_enable, rc.transparency_enable, dithering_enable);
 
-  (this->*DrawFunction)(cmd, &cmd->vertices[0], &cmd->vertices[1], &cmd->vertices[2]);
+  (this->*DrawFunction)(cmd, clip, &cmd->vertices[0], &cmd->vertices[1], &cmd->vertices[2]);
   if (rc.quad_polygon)
-    (this->*DrawFunction)(cmd, &cmd->vertices[2], &cmd->vertices[1], &cmd->vertices[3]);
+    (this->*DrawFunction)(cmd, clip, &cmd->vertices[2], &cmd->vertices[1], &cmd->vertices[3]);
 }
 
-void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
+void GPU_SW_Backend::RasterizeRectangle(const GPUBackendDrawRectangleCommand* cmd, const Common::Rectangle<u32>& clip)
 {
   const GPURenderCommand rc{cmd->rc.bits};
 
   const DrawRectangleFunction DrawFunction =
     GetDrawRectangleFunction(rc.texture_enable, rc.raw_texture_enable, rc.transparency_enable);
 
-  (this->*DrawFunction)(cmd);
+  (this->*DrawFunction)(cmd, clip);
 }
 
-void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd)
+void GPU_SW_Backend::RasterizeLine(const GPUBackendDrawLineCommand* cmd, const Common::Rectangle<u32>& clip)
 {
   const DrawLineFunction DrawFunction =
     GetDrawLineFunction(cmd->rc.shading_enable, cmd->rc.transparency_enable, cmd->IsDitheringEnabled());
 
   for (u16 i = 1; i < cmd->num_vertices; i++)
-    (this->*DrawFunction)(cmd, &cmd->vertices[i - 1], &cmd->vertices[i]);
+    (this->*DrawFunction)(cmd, clip, &cmd->vertices[i - 1], &cmd->vertices[i]);
+}
+
+void GPU_SW_Backend::RasterizeCommand(const GPUBackendDrawCommand* cmd, const Common::Rectangle<u32>& clip)
+{
+  switch (cmd->type)
+  {
+    case GPUBackendCommandType::DrawPolygon:
+      RasterizePolygon(static_cast<const GPUBackendDrawPolygonCommand*>(cmd), clip);
+      break;
+
+    case GPUBackendCommandType::DrawRectangle:
+      RasterizeRectangle(static_cast<const GPUBackendDrawRectangleCommand*>(cmd), clip);
+      break;
+
+    case GPUBackendCommandType::DrawLine:
+      RasterizeLine(static_cast<const GPUBackendDrawLineCommand*>(cmd), clip);
+      break;
+
+    default:
+      break;
+  }
 }
 
 constexpr GPU_SW_Backend::DitherLUT GPU_SW_Backend::ComputeDitherLUT()
@@ -80,51 +181,51 @@ constexpr GPU_SW_Backend::DitherLUT GPU_SW_Backend::ComputeDitherLUT()
 
 static constexpr GPU_SW_Backend::DitherLUT s_dither_lut = GPU_SW_Backend::ComputeDitherLUT();
 
-template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
-void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u8 color_r,
-                                                      u8 color_g, u8 color_b, u8 texcoord_x, u8 texcoord_y)
+ALWAYS_INLINE_RELEASE u16 GPU_SW_Backend::FetchTexel(const GPUBackendDrawCommand* cmd, u8 texcoord_x,
+                                                      u8 texcoord_y) const
 {
-  VRAMPixel color;
-  if constexpr (texture_enable)
-  {
-    // Apply texture window
-    texcoord_x = (texcoord_x & cmd->window.and_x) | cmd->window.or_x;
-    texcoord_y = (texcoord_y & cmd->window.and_y) | cmd->window.or_y;
+  // Apply texture window
+  texcoord_x = (texcoord_x & cmd->window.and_x) | cmd->window.or_x;
+  texcoord_y = (texcoord_y & cmd->window.and_y) | cmd->window.or_y;
 
-    VRAMPixel texture_color;
-    switch (cmd->draw_mode.texture_mode)
+  switch (cmd->draw_mode.texture_mode)
+  {
+    case GPUTextureMode::Palette4Bit:
     {
-      case GPUTextureMode::Palette4Bit:
-      {
-        const u16 palette_value =
-          GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 4)) % VRAM_WIDTH,
-                   (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
-        const u16 palette_index = (palette_value >> ((texcoord_x % 4) * 4)) & 0x0Fu;
+      const u16 palette_value =
+        GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 4)) % VRAM_WIDTH,
+                 (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
+      const u16 palette_index = (palette_value >> ((texcoord_x % 4) * 4)) & 0x0Fu;
 
-        texture_color.bits =
-          GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
-      }
-      break;
+      return GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
+    }
 
-      case GPUTextureMode::Palette8Bit:
-      {
-        const u16 palette_value =
-          GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 2)) % VRAM_WIDTH,
-                   (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
-        const u16 palette_index = (palette_value >> ((texcoord_x % 2) * 8)) & 0xFFu;
-        texture_color.bits =
-          GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
-      }
-      break;
+    case GPUTextureMode::Palette8Bit:
+    {
+      const u16 palette_value =
+        GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x / 2)) % VRAM_WIDTH,
+                 (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
+      const u16 palette_index = (palette_value >> ((texcoord_x % 2) * 8)) & 0xFFu;
+      return GetPixel((cmd->palette.GetXBase() + ZeroExtend32(palette_index)) % VRAM_WIDTH, cmd->palette.GetYBase());
+    }
 
-      default:
-      {
-        texture_color.bits = GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x)) % VRAM_WIDTH,
-                                      (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
-      }
-      break;
+    default:
+    {
+      return GetPixel((cmd->draw_mode.GetTexturePageBaseX() + ZeroExtend32(texcoord_x)) % VRAM_WIDTH,
+                      (cmd->draw_mode.GetTexturePageBaseY() + ZeroExtend32(texcoord_y)) % VRAM_HEIGHT);
     }
+  }
+}
 
+template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
+void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u8 color_r,
+                                                      u8 color_g, u8 color_b, u8 texcoord_x, u8 texcoord_y)
+{
+  VRAMPixel color;
+  if constexpr (texture_enable)
+  {
+    VRAMPixel texture_color;
+    texture_color.bits = FetchTexel(cmd, texcoord_x, texcoord_y);
     if (texture_color.bits == 0)
       return;
 
@@ -223,8 +324,423 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixel(const GPUBackendDrawComman
   SetPixel(static_cast<u32>(x), static_cast<u32>(y), color.bits | cmd->params.GetMaskOR());
 }
 
+bool GPU_SW_Backend::SpanReadsOwnRow(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u32 width)
+{
+  // Texels are fetched for a whole group before any pixel is written, so a span which samples from the row it writes
+  // could see different values to the scalar path.
+  Common::Rectangle<u32> read_rects[2];
+  const u32 num_read_rects = GetCommandReadBounds(cmd, read_rects);
+  const Common::Rectangle<u32> span_rect(x, y, x + width, y + 1);
+  for (u32 i = 0; i < num_read_rects; i++)
+  {
+    if (read_rects[i].Intersects(span_rect))
+      return true;
+  }
+
+  return false;
+}
+
+#ifdef GPU_SW_SIMD
+
+// Thin wrappers over SSE2/NEON, so the kernels below only need to be written once.
+#if defined(CPU_ARCH_SSE)
+
+using SIMDU16 = __m128i;
+using SIMDU32 = __m128i;
+
+static ALWAYS_INLINE SIMDU16 SIMDLoadU16(const void* ptr)
+{
+  return _mm_loadu_si128(static_cast<const __m128i*>(ptr));
+}
+static ALWAYS_INLINE void SIMDStoreU16(void* ptr, SIMDU16 v)
+{
+  _mm_storeu_si128(static_cast<__m128i*>(ptr), v);
+}
+static ALWAYS_INLINE SIMDU16 SIMDLoadU8ToU16(const u8* ptr)
+{
+  return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr)), _mm_setzero_si128());
+}
+static ALWAYS_INLINE SIMDU16 SIMDSetU16(u16 v)
+{
+  return _mm_set1_epi16(static_cast<s16>(v));
+}
+static ALWAYS_INLINE SIMDU16 SIMDAnd(SIMDU16 a, SIMDU16 b)
+{
+  return _mm_and_si128(a, b);
+}
+static ALWAYS_INLINE SIMDU16 SIMDOr(SIMDU16 a, SIMDU16 b)
+{
+  return _mm_or_si128(a, b);
+}
+static ALWAYS_INLINE SIMDU16 SIMDSelect(SIMDU16 mask, SIMDU16 a, SIMDU16 b)
+{
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+static ALWAYS_INLINE SIMDU16 SIMDCmpEqU16(SIMDU16 a, SIMDU16 b)
+{
+  return _mm_cmpeq_epi16(a, b);
+}
+static ALWAYS_INLINE SIMDU16 SIMDAddU16(SIMDU16 a, SIMDU16 b)
+{
+  return _mm_add_epi16(a, b);
+}
+static ALWAYS_INLINE SIMDU16 SIMDMulU16(SIMDU16 a, SIMDU16 b)
+{
+  return _mm_mullo_epi16(a, b);
+}
+static ALWAYS_INLINE SIMDU16 SIMDMaxS16(SIMDU16 a, SIMDU16 b)
+{
+  return _mm_max_epi16(a, b);
+}
+static ALWAYS_INLINE SIMDU16 SIMDMinS16(SIMDU16 a, SIMDU16 b)
+{
+  return _mm_min_epi16(a, b);
+}
+template<int n>
+static ALWAYS_INLINE SIMDU16 SIMDShlU16(SIMDU16 a)
+{
+  return _mm_slli_epi16(a, n);
+}
+template<int n>
+static ALWAYS_INLINE SIMDU16 SIMDShrU16(SIMDU16 a)
+{
+  return _mm_srli_epi16(a, n);
+}
+template<int n>
+static ALWAYS_INLINE SIMDU16 SIMDSarS16(SIMDU16 a)
+{
+  return _mm_srai_epi16(a, n);
+}
+static ALWAYS_INLINE SIMDU32 SIMDWidenLowU16(SIMDU16 a)
+{
+  return _mm_unpacklo_epi16(a, _mm_setzero_si128());
+}
+static ALWAYS_INLINE SIMDU32 SIMDWidenHighU16(SIMDU16 a)
+{
+  return _mm_unpackhi_epi16(a, _mm_setzero_si128());
+}
+static ALWAYS_INLINE SIMDU16 SIMDNarrowU32(SIMDU32 low, SIMDU32 high)
+{
+  // No unsigned saturating pack in SSE2, so sign-extend the low halves to keep packs_epi32 from clamping.
+  return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(low, 16), 16), _mm_srai_epi32(_mm_slli_epi32(high, 16), 16));
+}
+static ALWAYS_INLINE SIMDU32 SIMDSetU32(u32 v)
+{
+  return _mm_set1_epi32(static_cast<s32>(v));
+}
+static ALWAYS_INLINE SIMDU32 SIMDAndU32(SIMDU32 a, SIMDU32 b)
+{
+  return _mm_and_si128(a, b);
+}
+static ALWAYS_INLINE SIMDU32 SIMDOrU32(SIMDU32 a, SIMDU32 b)
+{
+  return _mm_or_si128(a, b);
+}
+static ALWAYS_INLINE SIMDU32 SIMDXorU32(SIMDU32 a, SIMDU32 b)
+{
+  return _mm_xor_si128(a, b);
+}
+static ALWAYS_INLINE SIMDU32 SIMDAddU32(SIMDU32 a, SIMDU32 b)
+{
+  return _mm_add_epi32(a, b);
+}
+static ALWAYS_INLINE SIMDU32 SIMDSubU32(SIMDU32 a, SIMDU32 b)
+{
+  return _mm_sub_epi32(a, b);
+}
+template<int n>
+static ALWAYS_INLINE SIMDU32 SIMDShrU32(SIMDU32 a)
+{
+  return _mm_srli_epi32(a, n);
+}
+
+#elif defined(CPU_ARCH_NEON)
+
+using SIMDU16 = uint16x8_t;
+using SIMDU32 = uint32x4_t;
+
+static ALWAYS_INLINE SIMDU16 SIMDLoadU16(const void* ptr)
+{
+  return vld1q_u16(static_cast<const u16*>(ptr));
+}
+static ALWAYS_INLINE void SIMDStoreU16(void* ptr, SIMDU16 v)
+{
+  vst1q_u16(static_cast<u16*>(ptr), v);
+}
+static ALWAYS_INLINE SIMDU16 SIMDLoadU8ToU16(const u8* ptr)
+{
+  return vmovl_u8(vld1_u8(ptr));
+}
+static ALWAYS_INLINE SIMDU16 SIMDSetU16(u16 v)
+{
+  return vdupq_n_u16(v);
+}
+static ALWAYS_INLINE SIMDU16 SIMDAnd(SIMDU16 a, SIMDU16 b)
+{
+  return vandq_u16(a, b);
+}
+static ALWAYS_INLINE SIMDU16 SIMDOr(SIMDU16 a, SIMDU16 b)
+{
+  return vorrq_u16(a, b);
+}
+static ALWAYS_INLINE SIMDU16 SIMDSelect(SIMDU16 mask, SIMDU16 a, SIMDU16 b)
+{
+  return vbslq_u16(mask, a, b);
+}
+static ALWAYS_INLINE SIMDU16 SIMDCmpEqU16(SIMDU16 a, SIMDU16 b)
+{
+  return vceqq_u16(a, b);
+}
+static ALWAYS_INLINE SIMDU16 SIMDAddU16(SIMDU16 a, SIMDU16 b)
+{
+  return vaddq_u16(a, b);
+}
+static ALWAYS_INLINE SIMDU16 SIMDMulU16(SIMDU16 a, SIMDU16 b)
+{
+  return vmulq_u16(a, b);
+}
+static ALWAYS_INLINE SIMDU16 SIMDMaxS16(SIMDU16 a, SIMDU16 b)
+{
+  return vreinterpretq_u16_s16(vmaxq_s16(vreinterpretq_s16_u16(a), vreinterpretq_s16_u16(b)));
+}
+static ALWAYS_INLINE SIMDU16 SIMDMinS16(SIMDU16 a, SIMDU16 b)
+{
+  return vreinterpretq_u16_s16(vminq_s16(vreinterpretq_s16_u16(a), vreinterpretq_s16_u16(b)));
+}
+template<int n>
+static ALWAYS_INLINE SIMDU16 SIMDShlU16(SIMDU16 a)
+{
+  return vshlq_n_u16(a, n);
+}
+template<int n>
+static ALWAYS_INLINE SIMDU16 SIMDShrU16(SIMDU16 a)
+{
+  return vshrq_n_u16(a, n);
+}
+template<int n>
+static ALWAYS_INLINE SIMDU16 SIMDSarS16(SIMDU16 a)
+{
+  return vreinterpretq_u16_s16(vshrq_n_s16(vreinterpretq_s16_u16(a), n));
+}
+static ALWAYS_INLINE SIMDU32 SIMDWidenLowU16(SIMDU16 a)
+{
+  return vmovl_u16(vget_low_u16(a));
+}
+static ALWAYS_INLINE SIMDU32 SIMDWidenHighU16(SIMDU16 a)
+{
+  return vmovl_u16(vget_high_u16(a));
+}
+static ALWAYS_INLINE SIMDU16 SIMDNarrowU32(SIMDU32 low, SIMDU32 high)
+{
+  return vcombine_u16(vmovn_u32(low), vmovn_u32(high));
+}
+static ALWAYS_INLINE SIMDU32 SIMDSetU32(u32 v)
+{
+  return vdupq_n_u32(v);
+}
+static ALWAYS_INLINE SIMDU32 SIMDAndU32(SIMDU32 a, SIMDU32 b)
+{
+  return vandq_u32(a, b);
+}
+static ALWAYS_INLINE SIMDU32 SIMDOrU32(SIMDU32 a, SIMDU32 b)
+{
+  return vorrq_u32(a, b);
+}
+static ALWAYS_INLINE SIMDU32 SIMDXorU32(SIMDU32 a, SIMDU32 b)
+{
+  return veorq_u32(a, b);
+}
+static ALWAYS_INLINE SIMDU32 SIMDAddU32(SIMDU32 a, SIMDU32 b)
+{
+  return vaddq_u32(a, b);
+}
+static ALWAYS_INLINE SIMDU32 SIMDSubU32(SIMDU32 a, SIMDU32 b)
+{
+  return vsubq_u32(a, b);
+}
+template<int n>
+static ALWAYS_INLINE SIMDU32 SIMDShrU32(SIMDU32 a)
+{
+  return vshrq_n_u32(a, n);
+}
+
+#endif
+
+// Per-lane dither offsets for each (y & 3, x & 3) starting position.
+static constexpr auto s_dither_offsets = []() {
+  std::array<std::array<std::array<s16, GPU_SW_Backend::SIMD_PIXELS>, DITHER_MATRIX_SIZE>, DITHER_MATRIX_SIZE> ret = {};
+  for (u32 y = 0; y < DITHER_MATRIX_SIZE; y++)
+  {
+    for (u32 x = 0; x < DITHER_MATRIX_SIZE; x++)
+    {
+      for (u32 i = 0; i < GPU_SW_Backend::SIMD_PIXELS; i++)
+        ret[y][x][i] = static_cast<s16>(DITHER_MATRIX[y][(x + i) % DITHER_MATRIX_SIZE]);
+    }
+  }
+  return ret;
+}();
+
+/// Vector equivalent of s_dither_lut, i.e. clamp((value + offset) >> 3, 0, 31).
+static ALWAYS_INLINE SIMDU16 SIMDDitherChannel(SIMDU16 value, SIMDU16 offset)
+{
+  return SIMDMinS16(SIMDMaxS16(SIMDSarS16<3>(SIMDAddU16(value, offset)), SIMDSetU16(0)), SIMDSetU16(31));
+}
+
+/// Same blargg 15bpp pixel math as ShadePixel(), on four zero-extended pixels.
+static ALWAYS_INLINE SIMDU32 SIMDBlendPixels(GPUTransparencyMode mode, SIMDU32 fg_bits, SIMDU32 bg_bits)
+{
+  switch (mode)
+  {
+    case GPUTransparencyMode::HalfBackgroundPlusHalfForeground:
+    {
+      bg_bits = SIMDOrU32(bg_bits, SIMDSetU32(0x8000u));
+      return SIMDShrU32<1>(SIMDSubU32(SIMDAddU32(fg_bits, bg_bits),
+                                      SIMDAndU32(SIMDXorU32(fg_bits, bg_bits), SIMDSetU32(0x0421u))));
+    }
+
+    case GPUTransparencyMode::BackgroundMinusForeground:
+    {
+      bg_bits = SIMDOrU32(bg_bits, SIMDSetU32(0x8000u));
+      fg_bits = SIMDAndU32(fg_bits, SIMDSetU32(0x7FFFu));
+
+      const SIMDU32 diff = SIMDAddU32(SIMDSubU32(bg_bits, fg_bits), SIMDSetU32(0x108420u));
+      const SIMDU32 borrow =
+        SIMDAndU32(SIMDSubU32(diff, SIMDAndU32(SIMDXorU32(bg_bits, fg_bits), SIMDSetU32(0x108420u))),
+                   SIMDSetU32(0x108420u));
+      return SIMDAndU32(SIMDSubU32(diff, borrow), SIMDSubU32(borrow, SIMDShrU32<5>(borrow)));
+    }
+
+    case GPUTransparencyMode::BackgroundPlusQuarterForeground:
+    case GPUTransparencyMode::BackgroundPlusForeground:
+    default:
+    {
+      bg_bits = SIMDAndU32(bg_bits, SIMDSetU32(0x7FFFu));
+      if (mode == GPUTransparencyMode::BackgroundPlusQuarterForeground)
+        fg_bits = SIMDOrU32(SIMDAndU32(SIMDShrU32<2>(fg_bits), SIMDSetU32(0x1CE7u)), SIMDSetU32(0x8000u));
+
+      const SIMDU32 sum = SIMDAddU32(fg_bits, bg_bits);
+      const SIMDU32 carry =
+        SIMDAndU32(SIMDSubU32(sum, SIMDAndU32(SIMDXorU32(fg_bits, bg_bits), SIMDSetU32(0x8421u))),
+                   SIMDSetU32(0x8420u));
+      return SIMDOrU32(SIMDSubU32(sum, carry), SIMDSubU32(carry, SIMDShrU32<5>(carry)));
+    }
+  }
+}
+
+template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
+void ALWAYS_INLINE_RELEASE GPU_SW_Backend::ShadePixels(const GPUBackendDrawCommand* cmd, u32 x, u32 y,
+                                                       const PixelLanes& lanes)
+{
+  u16* const dst_ptr = GetPixelPtr(x, y);
+  const SIMDU16 bg_color = SIMDLoadU16(dst_ptr);
+  const SIMDU16 channel_mask = SIMDSetU16(0x1F);
+  const SIMDU16 dither_offset = dithering_enable ? SIMDLoadU16(s_dither_offsets[y & 3u][x & 3u].data()) :
+                                                   SIMDSetU16(static_cast<u16>(DITHER_MATRIX[2][3]));
+
+  // Lanes which are left untouched.
+  SIMDU16 skip;
+  SIMDU16 color;
+  if constexpr (texture_enable)
+  {
+    alignas(16) u16 texels[SIMD_PIXELS];
+    for (u32 i = 0; i < SIMD_PIXELS; i++)
+      texels[i] = FetchTexel(cmd, lanes.u[i], lanes.v[i]);
+
+    const SIMDU16 texture_color = SIMDLoadU16(texels);
+    skip = SIMDCmpEqU16(texture_color, SIMDSetU16(0));
+
+    if constexpr (raw_texture_enable)
+    {
+      color = texture_color;
+    }
+    else
+    {
+      const SIMDU16 r = SIMDDitherChannel(
+        SIMDShrU16<4>(SIMDMulU16(SIMDAnd(texture_color, channel_mask), SIMDLoadU8ToU16(lanes.r))), dither_offset);
+      const SIMDU16 g = SIMDDitherChannel(
+        SIMDShrU16<4>(SIMDMulU16(SIMDAnd(SIMDShrU16<5>(texture_color), channel_mask), SIMDLoadU8ToU16(lanes.g))),
+        dither_offset);
+      const SIMDU16 b = SIMDDitherChannel(
+        SIMDShrU16<4>(SIMDMulU16(SIMDAnd(SIMDShrU16<10>(texture_color), channel_mask), SIMDLoadU8ToU16(lanes.b))),
+        dither_offset);
+      color = SIMDOr(SIMDOr(r, SIMDShlU16<5>(g)),
+                     SIMDOr(SIMDShlU16<10>(b), SIMDAnd(texture_color, SIMDSetU16(0x8000u))));
+    }
+  }
+  else
+  {
+    skip = SIMDSetU16(0);
+
+    const SIMDU16 r = SIMDDitherChannel(SIMDLoadU8ToU16(lanes.r), dither_offset);
+    const SIMDU16 g = SIMDDitherChannel(SIMDLoadU8ToU16(lanes.g), dither_offset);
+    const SIMDU16 b = SIMDDitherChannel(SIMDLoadU8ToU16(lanes.b), dither_offset);
+    color = SIMDOr(SIMDOr(r, SIMDShlU16<5>(g)),
+                   SIMDOr(SIMDShlU16<10>(b), SIMDSetU16(transparency_enable ? 0x8000u : 0u)));
+  }
+
+  if constexpr (transparency_enable)
+  {
+    const GPUTransparencyMode mode = cmd->draw_mode.transparency_mode;
+    SIMDU16 blended = SIMDNarrowU32(SIMDBlendPixels(mode, SIMDWidenLowU16(color), SIMDWidenLowU16(bg_color)),
+                                    SIMDBlendPixels(mode, SIMDWidenHighU16(color), SIMDWidenHighU16(bg_color)));
+    if constexpr (texture_enable)
+    {
+      // Only semi-transparent texels are blended.
+      const SIMDU16 opaque = SIMDCmpEqU16(SIMDAnd(color, SIMDSetU16(0x8000u)), SIMDSetU16(0));
+      color = SIMDSelect(opaque, color, blended);
+    }
+    else
+    {
+      color = SIMDAnd(blended, SIMDSetU16(0x7FFFu));
+    }
+  }
+
+  const SIMDU16 mask_passed = SIMDCmpEqU16(SIMDAnd(bg_color, SIMDSetU16(cmd->params.GetMaskAND())), SIMDSetU16(0));
+  const SIMDU16 write = SIMDSelect(skip, SIMDSetU16(0), mask_passed);
+  SIMDStoreU16(dst_ptr, SIMDSelect(write, SIMDOr(color, SIMDSetU16(cmd->params.GetMaskOR())), bg_color));
+}
+
+template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
+void ALWAYS_INLINE_RELEASE GPU_SW_Backend::DrawPixels(const GPUBackendDrawCommand* cmd, u32 x, u32 y,
+                                                      const PixelLanes& lanes)
+{
+  if (!m_simd_validation) [[likely]]
+  {
+    ShadePixels<texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(cmd, x, y, lanes);
+    return;
+  }
+
+  // Run both paths from the same starting state, and keep the scalar result.
+  u16* const dst_ptr = GetPixelPtr(x, y);
+  std::array<u16, SIMD_PIXELS> original, vector_result;
+  std::copy_n(dst_ptr, SIMD_PIXELS, original.begin());
+  ShadePixels<texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(cmd, x, y, lanes);
+  std::copy_n(dst_ptr, SIMD_PIXELS, vector_result.begin());
+  std::copy_n(original.begin(), SIMD_PIXELS, dst_ptr);
+
+  for (u32 i = 0; i < SIMD_PIXELS; i++)
+  {
+    ShadePixel<texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(
+      cmd, x + i, y, lanes.r[i], lanes.g[i], lanes.b[i], lanes.u[i], lanes.v[i]);
+  }
+
+  m_stat_simd_checks.fetch_add(1, std::memory_order_relaxed);
+  if (!std::equal(vector_result.begin(), vector_result.end(), dst_ptr))
+  {
+    if (m_stat_simd_mismatches.fetch_add(1, std::memory_order_relaxed) < 16)
+    {
+      Log_ErrorPrintf("SIMD mismatch at %u,%u (texture %u/%u, transparency %u/%u, dithering %u)", x, y,
+                      BoolToUInt32(texture_enable), static_cast<u32>(cmd->draw_mode.texture_mode.GetValue()),
+                      BoolToUInt32(transparency_enable),
+                      static_cast<u32>(cmd->draw_mode.transparency_mode.GetValue()), BoolToUInt32(dithering_enable));
+    }
+  }
+}
+
+#endif // GPU_SW_SIMD
+
 template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
-void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
+void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd, const Common::Rectangle<u32>& clip)
 {
   const s32 origin_x = cmd->x;
   const s32 origin_y = cmd->y;
@@ -234,7 +750,7 @@ void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
   for (u32 offset_y = 0; offset_y < cmd->height; offset_y++)
   {
     const s32 y = origin_y + static_cast<s32>(offset_y);
-    if (y < static_cast<s32>(m_drawing_area.top) || y > static_cast<s32>(m_drawing_area.bottom) ||
+    if (y < static_cast<s32>(clip.top) || y > static_cast<s32>(clip.bottom) ||
         (cmd->params.interlaced_rendering && cmd->params.active_line_lsb == (Truncate8(static_cast<u32>(y)) & 1u)))
     {
       continue;
@@ -242,10 +758,39 @@ void GPU_SW_Backend::DrawRectangle(const GPUBackendDrawRectangleCommand* cmd)
 
     const u8 texcoord_y = Truncate8(ZeroExtend32(origin_texcoord_y) + offset_y);
 
-    for (u32 offset_x = 0; offset_x < cmd->width; offset_x++)
+    u32 offset_x = 0;
+
+#ifdef GPU_SW_SIMD
+    const s32 simd_start = std::max(static_cast<s32>(clip.left) - origin_x, 0);
+    const s32 simd_end = std::min(static_cast<s32>(clip.right) + 1 - origin_x, static_cast<s32>(cmd->width));
+    if (m_use_simd && (simd_end - simd_start) >= static_cast<s32>(SIMD_PIXELS) &&
+        (!texture_enable || !SpanReadsOwnRow(cmd, static_cast<u32>(origin_x + simd_start), static_cast<u32>(y),
+                                             static_cast<u32>(simd_end - simd_start))))
+    {
+      PixelLanes lanes;
+      std::fill_n(lanes.r, SIMD_PIXELS, r);
+      std::fill_n(lanes.g, SIMD_PIXELS, g);
+      std::fill_n(lanes.b, SIMD_PIXELS, b);
+      std::fill_n(lanes.v, SIMD_PIXELS, texcoord_y);
+
+      s32 simd_x = simd_start;
+      for (; (simd_end - simd_x) >= static_cast<s32>(SIMD_PIXELS); simd_x += static_cast<s32>(SIMD_PIXELS))
+      {
+        for (u32 i = 0; i < SIMD_PIXELS; i++)
+          lanes.u[i] = Truncate8(ZeroExtend32(origin_texcoord_x) + static_cast<u32>(simd_x) + i);
+
+        DrawPixels<texture_enable, raw_texture_enable, transparency_enable, false>(
+          cmd, static_cast<u32>(origin_x + simd_x), static_cast<u32>(y), lanes);
+      }
+
+      offset_x = static_cast<u32>(simd_x);
+    }
+#endif
+
+    for (; offset_x < cmd->width; offset_x++)
     {
       const s32 x = origin_x + static_cast<s32>(offset_x);
-      if (x < static_cast<s32>(m_drawing_area.left) || x > static_cast<s32>(m_drawing_area.right))
+      if (x < static_cast<s32>(clip.left) || x > static_cast<s32>(clip.right))
         continue;
 
       const u8 texcoord_x = Truncate8(ZeroExtend32(origin_texcoord_x) + offset_x);
@@ -364,8 +909,8 @@ void ALWAYS_INLINE_RELEASE GPU_SW_Backend::AddIDeltas_DY(i_group& ig, const i_de
 
 template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
          bool dithering_enable>
-void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s32 x_start, s32 x_bound, i_group ig,
-                              const i_deltas& idl)
+void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip, s32 y,
+                              s32 x_start, s32 x_bound, i_group ig, const i_deltas& idl)
 {
   if (cmd->params.interlaced_rendering && cmd->params.active_line_lsb == (Truncate8(static_cast<u32>(y)) & 1u))
     return;
@@ -374,16 +919,16 @@ void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s3
   s32 w = x_bound - x_start;
   s32 x = TruncateGPUVertexPosition(x_start);
 
-  if (x < static_cast<s32>(m_drawing_area.left))
+  if (x < static_cast<s32>(clip.left))
   {
-    s32 delta = static_cast<s32>(m_drawing_area.left) - x;
+    s32 delta = static_cast<s32>(clip.left) - x;
     x_ig_adjust += delta;
     x += delta;
     w -= delta;
   }
 
-  if ((x + w) > (static_cast<s32>(m_drawing_area.right) + 1))
-    w = static_cast<s32>(m_drawing_area.right) + 1 - x;
+  if ((x + w) > (static_cast<s32>(clip.right) + 1))
+    w = static_cast<s32>(clip.right) + 1 - x;
 
   if (w <= 0)
     return;
@@ -391,6 +936,35 @@ void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s3
   AddIDeltas_DX<shading_enable, texture_enable>(ig, idl, x_ig_adjust);
   AddIDeltas_DY<shading_enable, texture_enable>(ig, idl, y);
 
+#ifdef GPU_SW_SIMD
+  if (m_use_simd && w >= static_cast<s32>(SIMD_PIXELS) &&
+      (!texture_enable || !SpanReadsOwnRow(cmd, static_cast<u32>(x), static_cast<u32>(y), static_cast<u32>(w))))
+  {
+    do
+    {
+      PixelLanes lanes;
+      for (u32 i = 0; i < SIMD_PIXELS; i++)
+      {
+        lanes.r[i] = Truncate8(ig.r >> (COORD_FBS + COORD_POST_PADDING));
+        lanes.g[i] = Truncate8(ig.g >> (COORD_FBS + COORD_POST_PADDING));
+        lanes.b[i] = Truncate8(ig.b >> (COORD_FBS + COORD_POST_PADDING));
+        lanes.u[i] = Truncate8(ig.u >> (COORD_FBS + COORD_POST_PADDING));
+        lanes.v[i] = Truncate8(ig.v >> (COORD_FBS + COORD_POST_PADDING));
+        AddIDeltas_DX<shading_enable, texture_enable>(ig, idl);
+      }
+
+      DrawPixels<texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(
+        cmd, static_cast<u32>(x), static_cast<u32>(y), lanes);
+
+      x += static_cast<s32>(SIMD_PIXELS);
+      w -= static_cast<s32>(SIMD_PIXELS);
+    } while (w >= static_cast<s32>(SIMD_PIXELS));
+
+    if (w <= 0)
+      return;
+  }
+#endif
+
   do
   {
     const u32 r = ig.r >> (COORD_FBS + COORD_POST_PADDING);
@@ -410,7 +984,7 @@ void GPU_SW_Backend::DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s3
 
 template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
          bool dithering_enable>
-void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd,
+void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip,
                                   const GPUBackendDrawPolygonCommand::Vertex* v0,
                                   const GPUBackendDrawPolygonCommand::Vertex* v1,
                                   const GPUBackendDrawPolygonCommand::Vertex* v2)
@@ -568,14 +1142,14 @@ void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd,
 
         s32 y = TruncateGPUVertexPosition(yi);
 
-        if (y < static_cast<s32>(m_drawing_area.top))
+        if (y < static_cast<s32>(clip.top))
           break;
 
-        if (y > static_cast<s32>(m_drawing_area.bottom))
+        if (y > static_cast<s32>(clip.bottom))
           continue;
 
         DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(
-          cmd, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
+          cmd, clip, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
       }
     }
     else
@@ -584,14 +1158,14 @@ void GPU_SW_Backend::DrawTriangle(const GPUBackendDrawPolygonCommand* cmd,
       {
         s32 y = TruncateGPUVertexPosition(yi);
 
-        if (y > static_cast<s32>(m_drawing_area.bottom))
+        if (y > static_cast<s32>(clip.bottom))
           break;
 
-        if (y >= static_cast<s32>(m_drawing_area.top))
+        if (y >= static_cast<s32>(clip.top))
         {
 
           DrawSpan<shading_enable, texture_enable, raw_texture_enable, transparency_enable, dithering_enable>(
-            cmd, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
+            cmd, clip, yi, GetPolyXFP_Int(lc), GetPolyXFP_Int(rc), ig, idl);
         }
 
         yi++;
@@ -636,8 +1210,8 @@ static ALWAYS_INLINE_RELEASE s64 LineDivide(s64 delta, s32 dk)
 }
 
 template<bool shading_enable, bool transparency_enable, bool dithering_enable>
-void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd, const GPUBackendDrawLineCommand::Vertex* p0,
-                              const GPUBackendDrawLineCommand::Vertex* p1)
+void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd, const Common::Rectangle<u32>& clip,
+                              const GPUBackendDrawLineCommand::Vertex* p0, const GPUBackendDrawLineCommand::Vertex* p1)
 {
   const s32 i_dx = std::abs(p1->x - p0->x);
   const s32 i_dy = std::abs(p1->y - p0->y);
@@ -697,8 +1271,8 @@ void GPU_SW_Backend::DrawLine(const GPUBackendDrawLineCommand* cmd, const GPUBac
     const s32 y = (cur_point.y >> Line_XY_FractBits) & 2047;
 
     if ((!cmd->params.interlaced_rendering || cmd->params.active_line_lsb != (Truncate8(static_cast<u32>(y)) & 1u)) &&
-        x >= static_cast<s32>(m_drawing_area.left) && x <= static_cast<s32>(m_drawing_area.right) &&
-        y >= static_cast<s32>(m_drawing_area.top) && y <= static_cast<s32>(m_drawing_area.bottom))
+        x >= static_cast<s32>(clip.left) && x <= static_cast<s32>(clip.right) &&
+        y >= static_cast<s32>(clip.top) && y <= static_cast<s32>(clip.bottom))
     {
       const u8 r = shading_enable ? static_cast<u8>(cur_point.r >> Line_RGB_FractBits) : p0->r;
       const u8 g = shading_enable ? static_cast<u8>(cur_point.g >> Line_RGB_FractBits) : p0->g;
@@ -874,7 +1448,318 @@ void GPU_SW_Backend::CopyVRAM(u32 src_x, u32 src_y, u32 dst_x, u32 dst_y, u32 wi
   }
 }
 
-void GPU_SW_Backend::FlushRender() {}
+bool GPU_SW_Backend::GetCommandWriteBounds(const GPUBackendDrawCommand* cmd, Common::Rectangle<u32>* bounds) const
+{
+  if (m_drawing_area.left > m_drawing_area.right || m_drawing_area.top > m_drawing_area.bottom)
+    return false;
+
+  // Conservative inclusive bounds of the pixels the command can touch. If any vertex is outside the range where the
+  // rasterizer's coordinate wrapping is an identity, fall back to the whole drawing area.
+  s32 min_x, min_y, max_x, max_y;
+  bool in_range;
+  switch (cmd->type)
+  {
+    case GPUBackendCommandType::DrawPolygon:
+    {
+      const GPUBackendDrawPolygonCommand* pcmd = static_cast<const GPUBackendDrawPolygonCommand*>(cmd);
+      const u32 num_vertices = pcmd->rc.quad_polygon ? 4 : 3;
+      min_x = max_x = pcmd->vertices[0].x;
+      min_y = max_y = pcmd->vertices[0].y;
+      for (u32 i = 1; i < num_vertices; i++)
+      {
+        min_x = std::min(min_x, pcmd->vertices[i].x);
+        max_x = std::max(max_x, pcmd->vertices[i].x);
+        min_y = std::min(min_y, pcmd->vertices[i].y);
+        max_y = std::max(max_y, pcmd->vertices[i].y);
+      }
+      in_range = (min_x > -1024 && max_x < 1023 && min_y > -1024 && max_y < 1023);
+    }
+    break;
+
+    case GPUBackendCommandType::DrawRectangle:
+    {
+      const GPUBackendDrawRectangleCommand* rcmd = static_cast<const GPUBackendDrawRectangleCommand*>(cmd);
+      if (rcmd->width == 0 || rcmd->height == 0)
+        return false;
+
+      min_x = rcmd->x;
+      max_x = rcmd->x + static_cast<s32>(rcmd->width) - 1;
+      min_y = rcmd->y;
+      max_y = rcmd->y + static_cast<s32>(rcmd->height) - 1;
+      in_range = true;
+    }
+    break;
+
+    case GPUBackendCommandType::DrawLine:
+    {
+      const GPUBackendDrawLineCommand* lcmd = static_cast<const GPUBackendDrawLineCommand*>(cmd);
+      if (lcmd->num_vertices == 0)
+        return false;
+
+      min_x = max_x = lcmd->vertices[0].x;
+      min_y = max_y = lcmd->vertices[0].y;
+      for (u32 i = 1; i < lcmd->num_vertices; i++)
+      {
+        min_x = std::min(min_x, lcmd->vertices[i].x);
+        max_x = std::max(max_x, lcmd->vertices[i].x);
+        min_y = std::min(min_y, lcmd->vertices[i].y);
+        max_y = std::max(max_y, lcmd->vertices[i].y);
+      }
+      in_range = (min_x >= 0 && max_x < 2047 && min_y >= 0 && max_y < 2047);
+    }
+    break;
+
+    default:
+      return false;
+  }
+
+  if (!in_range)
+  {
+    *bounds = m_drawing_area;
+  }
+  else
+  {
+    // Pad by a pixel to cover sub-pixel rounding at the edges.
+    min_x = std::max(min_x - 1, static_cast<s32>(m_drawing_area.left));
+    max_x = std::min(max_x + 1, static_cast<s32>(m_drawing_area.right));
+    min_y = std::max(min_y - 1, static_cast<s32>(m_drawing_area.top));
+    max_y = std::min(max_y + 1, static_cast<s32>(m_drawing_area.bottom));
+    if (min_x > max_x || min_y > max_y)
+      return false;
+
+    *bounds = Common::Rectangle<u32>(static_cast<u32>(min_x), static_cast<u32>(min_y), static_cast<u32>(max_x),
+                                     static_cast<u32>(max_y));
+  }
+
+  bounds->bottom = std::min<u32>(bounds->bottom, VRAM_HEIGHT - 1);
+  return (bounds->top <= bounds->bottom);
+}
+
+u32 GPU_SW_Backend::GetCommandReadBounds(const GPUBackendDrawCommand* cmd, Common::Rectangle<u32>* bounds)
+{
+  // Lines are never textured.
+  if (cmd->type == GPUBackendCommandType::DrawLine || !cmd->rc.texture_enable)
+    return 0;
+
+  // Texture coordinates wrap around horizontally, treat those pages as covering the whole width.
+  u32 count = 0;
+  bounds[count] = cmd->draw_mode.GetTexturePageRectangle();
+  if (bounds[count].right > VRAM_WIDTH)
+  {
+    bounds[count].left = 0;
+    bounds[count].right = VRAM_WIDTH;
+  }
+  count++;
+
+  if (cmd->draw_mode.IsUsingPalette())
+  {
+    bounds[count] = cmd->palette.GetRectangle(cmd->draw_mode.texture_mode);
+    if (bounds[count].right > VRAM_WIDTH)
+    {
+      bounds[count].left = 0;
+      bounds[count].right = VRAM_WIDTH;
+    }
+    count++;
+  }
+
+  return count;
+}
+
+void GPU_SW_Backend::QueueCommand(const GPUBackendDrawCommand* cmd)
+{
+  Common::Rectangle<u32> write_bounds;
+  if (!GetCommandWriteBounds(cmd, &write_bounds))
+    return;
+
+  const Common::Rectangle<u32> write_rect(write_bounds.left, write_bounds.top, write_bounds.right + 1,
+                                          write_bounds.bottom + 1);
+  Common::Rectangle<u32> read_rects[2];
+  const u32 num_read_rects = GetCommandReadBounds(cmd, read_rects);
+
+  // Primitives sampling from their own destination depend on the rasterization order within the primitive.
+  for (u32 i = 0; i < num_read_rects; i++)
+  {
+    if (read_rects[i].Intersects(write_rect))
+    {
+      FlushRender();
+      RasterizeCommand(cmd, m_drawing_area);
+      return;
+    }
+  }
+
+  const u32 cmd_size = Common::AlignUpPow2(cmd->size, 8);
+  bool needs_flush = ((m_batch_data.size() + cmd_size) > MAX_BATCH_DATA_SIZE ||
+                      (m_batch_read_rects.size() + num_read_rects) > MAX_BATCH_READ_RECTS);
+  for (u32 i = 0; i < num_read_rects && !needs_flush; i++)
+    needs_flush = read_rects[i].Intersects(m_batch_write_bounds);
+  for (size_t i = 0; i < m_batch_read_rects.size() && !needs_flush; i++)
+    needs_flush = m_batch_read_rects[i].Intersects(write_rect);
+  if (needs_flush)
+    FlushRender();
+
+  const u32 offset = static_cast<u32>(m_batch_data.size());
+  m_batch_data.resize(offset + cmd_size);
+  std::memcpy(&m_batch_data[offset], cmd, cmd->size);
+  m_batch_commands.push_back(
+    BatchCommand{offset, static_cast<u16>(write_bounds.top), static_cast<u16>(write_bounds.bottom)});
+  m_batch_write_bounds.Include(write_rect);
+
+  for (u32 i = 0; i < num_read_rects; i++)
+  {
+    if (std::none_of(m_batch_read_rects.begin(), m_batch_read_rects.end(),
+                     [&read_rect = read_rects[i]](const Common::Rectangle<u32>& rc) { return rc.Contains(read_rect); }))
+    {
+      m_batch_read_rects.push_back(read_rects[i]);
+    }
+  }
+}
+
+void GPU_SW_Backend::ExecuteBatch()
+{
+  const Common::Timer::Value start_time = Common::Timer::GetCurrentValue();
+  const u32 num_commands = static_cast<u32>(m_batch_commands.size());
+
+  if (num_commands < MIN_PARALLEL_BATCH_COMMANDS)
+  {
+    // Not worth waking the pool for.
+    for (const BatchCommand& bc : m_batch_commands)
+      RasterizeCommand(reinterpret_cast<const GPUBackendDrawCommand*>(&m_batch_data[bc.offset]), m_drawing_area);
+
+    m_stat_busy_time.fetch_add(Common::Timer::GetCurrentValue() - start_time, std::memory_order_relaxed);
+  }
+  else
+  {
+    for (std::vector<u32>& bin : m_rasterizer_bins)
+      bin.clear();
+    for (const BatchCommand& bc : m_batch_commands)
+    {
+      for (u32 bin = (bc.top >> RASTERIZER_BIN_SHIFT); bin <= (bc.bottom >> RASTERIZER_BIN_SHIFT); bin++)
+        m_rasterizer_bins[bin].push_back(bc.offset);
+    }
+
+    m_rasterizer_next_bin.store(0, std::memory_order_relaxed);
+    {
+      std::unique_lock lock(m_rasterizer_mutex);
+      m_rasterizer_active_threads = static_cast<u32>(m_rasterizer_threads.size());
+      m_rasterizer_generation++;
+    }
+    m_rasterizer_work_cv.notify_all();
+
+    // The GPU thread takes part as well.
+    RasterizeBins();
+
+    {
+      std::unique_lock lock(m_rasterizer_mutex);
+      m_rasterizer_done_cv.wait(lock, [this]() { return (m_rasterizer_active_threads == 0); });
+    }
+
+    m_stat_parallel_batches.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  m_stat_batches.fetch_add(1, std::memory_order_relaxed);
+  m_stat_commands.fetch_add(num_commands, std::memory_order_relaxed);
+  m_stat_wall_time.fetch_add(Common::Timer::GetCurrentValue() - start_time, std::memory_order_relaxed);
+}
+
+void GPU_SW_Backend::RasterizeBins()
+{
+  const Common::Timer::Value start_time = Common::Timer::GetCurrentValue();
+
+  u32 bin;
+  while ((bin = m_rasterizer_next_bin.fetch_add(1, std::memory_order_relaxed)) < RASTERIZER_NUM_BINS)
+  {
+    const std::vector<u32>& offsets = m_rasterizer_bins[bin];
+    if (offsets.empty())
+      continue;
+
+    const u32 bin_top = bin << RASTERIZER_BIN_SHIFT;
+    const u32 bin_bottom = bin_top + (1u << RASTERIZER_BIN_SHIFT) - 1;
+    const Common::Rectangle<u32> clip(m_drawing_area.left, std::max(m_drawing_area.top, bin_top),
+                                      m_drawing_area.right, std::min(m_drawing_area.bottom, bin_bottom));
+    for (const u32 offset : offsets)
+      RasterizeCommand(reinterpret_cast<const GPUBackendDrawCommand*>(&m_batch_data[offset]), clip);
+  }
+
+  m_stat_busy_time.fetch_add(Common::Timer::GetCurrentValue() - start_time, std::memory_order_relaxed);
+}
+
+void GPU_SW_Backend::StartRasterizerThreads(u32 count)
+{
+  // The GPU thread rasterizes too, so one less worker is needed.
+  if (count <= 1)
+    return;
+
+  m_rasterizer_shutdown = false;
+  m_rasterizer_generation = 0;
+  m_rasterizer_active_threads = 0;
+  m_batch_data.reserve(MAX_BATCH_DATA_SIZE);
+  m_batch_write_bounds.SetInvalid();
+
+  m_rasterizer_threads.reserve(count - 1);
+  for (u32 i = 1; i < count; i++)
+    m_rasterizer_threads.emplace_back().Start([this]() { RasterizerThreadEntryPoint(); });
+
+  Log_InfoPrintf("Software renderer using %u rasterizer threads.", count);
+}
+
+void GPU_SW_Backend::StopRasterizerThreads()
+{
+  if (m_rasterizer_threads.empty())
+    return;
+
+  {
+    std::unique_lock lock(m_rasterizer_mutex);
+    m_rasterizer_shutdown = true;
+  }
+  m_rasterizer_work_cv.notify_all();
+
+  for (Threading::Thread& thread : m_rasterizer_threads)
+    thread.Join();
+  m_rasterizer_threads.clear();
+
+  m_batch_data.clear();
+  m_batch_commands.clear();
+  m_batch_read_rects.clear();
+  m_batch_write_bounds.SetInvalid();
+}
+
+void GPU_SW_Backend::RasterizerThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("GPU Rasterizer");
+
+  // Generation starts at zero, so a thread which starts late still picks up the first batch.
+  u32 last_generation = 0;
+  std::unique_lock lock(m_rasterizer_mutex);
+  for (;;)
+  {
+    m_rasterizer_work_cv.wait(lock, [this, last_generation]() {
+      return (m_rasterizer_shutdown || m_rasterizer_generation != last_generation);
+    });
+    if (m_rasterizer_shutdown)
+      break;
+
+    last_generation = m_rasterizer_generation;
+    lock.unlock();
+    RasterizeBins();
+    lock.lock();
+
+    if ((--m_rasterizer_active_threads) == 0)
+      m_rasterizer_done_cv.notify_one();
+  }
+}
+
+void GPU_SW_Backend::FlushRender()
+{
+  if (m_batch_commands.empty())
+    return;
+
+  ExecuteBatch();
+
+  m_batch_data.clear();
+  m_batch_commands.clear();
+  m_batch_read_rects.clear();
+  m_batch_write_bounds.SetInvalid();
+}
 
 void GPU_SW_Backend::DrawingAreaChanged() {}
 
@@ -4,7 +4,10 @@
 #pragma once
 #include "gpu_backend.h"
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 class GPU_SW_Backend final : public GPUBackend
@@ -14,7 +17,24 @@ public:
   ~GPU_SW_Backend() override;
 
   bool Initialize(bool force_thread) override;
+  void UpdateSettings() override;
   void Reset(bool clear_vram) override;
+  void Shutdown() override;
+
+  /// Cumulative counters for the multithreaded rasterizer. Times are in Common::Timer ticks.
+  struct RasterizerStats
+  {
+    u64 batches;
+    u64 parallel_batches;
+    u64 commands;
+    u64 wall_time; // time spent executing batches on the GPU thread
+    u64 busy_time; // time spent rasterizing, summed across all rasterizer threads
+
+    u64 simd_checks;     // vector pixel groups compared against the scalar path
+    u64 simd_mismatches; // groups where the two paths produced different output
+  };
+
+  RasterizerStats GetRasterizerStats() const;
 
   ALWAYS_INLINE_RELEASE u16 GetPixel(const u32 x, const u32 y) const { return m_vram[VRAM_WIDTH * y + x]; }
   ALWAYS_INLINE_RELEASE const u16* GetPixelPtr(const u32 x, const u32 y) const { return &m_vram[VRAM_WIDTH * y + x]; }
@@ -26,6 +46,8 @@ public:
   using DitherLUT = std::array<std::array<std::array<u8, 512>, DITHER_MATRIX_SIZE>, DITHER_MATRIX_SIZE>;
   static constexpr DitherLUT ComputeDitherLUT();
 
+  static constexpr u32 SIMD_PIXELS = 8;
+
 protected:
   union VRAMPixel
   {
@@ -98,17 +120,44 @@ protected:
   void FlushRender() override;
   void DrawingAreaChanged() override;
 
+  void RasterizePolygon(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip);
+  void RasterizeRectangle(const GPUBackendDrawRectangleCommand* cmd, const Common::Rectangle<u32>& clip);
+  void RasterizeLine(const GPUBackendDrawLineCommand* cmd, const Common::Rectangle<u32>& clip);
+  void RasterizeCommand(const GPUBackendDrawCommand* cmd, const Common::Rectangle<u32>& clip);
+
   //////////////////////////////////////////////////////////////////////////
   // Rasterization
   //////////////////////////////////////////////////////////////////////////
+  u16 FetchTexel(const GPUBackendDrawCommand* cmd, u8 texcoord_x, u8 texcoord_y) const;
+
   template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
   void ShadePixel(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u8 color_r, u8 color_g, u8 color_b, u8 texcoord_x,
                   u8 texcoord_y);
 
+  // Vector span kernels shade SIMD_PIXELS horizontally-adjacent pixels at once. ShadePixel() remains the reference
+  // implementation, and is used for span tails, unsupported targets, and to validate the vector path.
+  struct PixelLanes
+  {
+    u8 r[SIMD_PIXELS];
+    u8 g[SIMD_PIXELS];
+    u8 b[SIMD_PIXELS];
+    u8 u[SIMD_PIXELS];
+    u8 v[SIMD_PIXELS];
+  };
+
+  static bool SpanReadsOwnRow(const GPUBackendDrawCommand* cmd, u32 x, u32 y, u32 width);
+
+  template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
+  void ShadePixels(const GPUBackendDrawCommand* cmd, u32 x, u32 y, const PixelLanes& lanes);
+
+  template<bool texture_enable, bool raw_texture_enable, bool transparency_enable, bool dithering_enable>
+  void DrawPixels(const GPUBackendDrawCommand* cmd, u32 x, u32 y, const PixelLanes& lanes);
+
   template<bool texture_enable, bool raw_texture_enable, bool transparency_enable>
-  void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd);
+  void DrawRectangle(const GPUBackendDrawRectangleCommand* cmd, const Common::Rectangle<u32>& clip);
 
-  using DrawRectangleFunction = void (GPU_SW_Backend::*)(const GPUBackendDrawRectangleCommand* cmd);
+  using DrawRectangleFunction = void (GPU_SW_Backend::*)(const GPUBackendDrawRectangleCommand* cmd,
+                                                         const Common::Rectangle<u32>& clip);
   DrawRectangleFunction GetDrawRectangleFunction(bool texture_enable, bool raw_texture_enable,
                                                  bool transparency_enable);
 
@@ -142,15 +191,17 @@ protected:
 
   template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
            bool dithering_enable>
-  void DrawSpan(const GPUBackendDrawPolygonCommand* cmd, s32 y, s32 x_start, s32 x_bound, i_group ig,
-                const i_deltas& idl);
+  void DrawSpan(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip, s32 y, s32 x_start,
+                s32 x_bound, i_group ig, const i_deltas& idl);
 
   template<bool shading_enable, bool texture_enable, bool raw_texture_enable, bool transparency_enable,
            bool dithering_enable>
-  void DrawTriangle(const GPUBackendDrawPolygonCommand* cmd, const GPUBackendDrawPolygonCommand::Vertex* v0,
-                    const GPUBackendDrawPolygonCommand::Vertex* v1, const GPUBackendDrawPolygonCommand::Vertex* v2);
+  void DrawTriangle(const GPUBackendDrawPolygonCommand* cmd, const Common::Rectangle<u32>& clip,
+                    const GPUBackendDrawPolygonCommand::Vertex* v0, const GPUBackendDrawPolygonCommand::Vertex* v1,
+                    const GPUBackendDrawPolygonCommand::Vertex* v2);
 
   using DrawTriangleFunction = void (GPU_SW_Backend::*)(const GPUBackendDrawPolygonCommand* cmd,
+                                                        const Common::Rectangle<u32>& clip,
                                                         const GPUBackendDrawPolygonCommand::Vertex* v0,
                                                         const GPUBackendDrawPolygonCommand::Vertex* v1,
                                                         const GPUBackendDrawPolygonCommand::Vertex* v2);
@@ -158,13 +209,74 @@ protected:
                                                bool transparency_enable, bool dithering_enable);
 
   template<bool shading_enable, bool transparency_enable, bool dithering_enable>
-  void DrawLine(const GPUBackendDrawLineCommand* cmd, const GPUBackendDrawLineCommand::Vertex* p0,
-                const GPUBackendDrawLineCommand::Vertex* p1);
+  void DrawLine(const GPUBackendDrawLineCommand* cmd, const Common::Rectangle<u32>& clip,
+                const GPUBackendDrawLineCommand::Vertex* p0, const GPUBackendDrawLineCommand::Vertex* p1);
 
   using DrawLineFunction = void (GPU_SW_Backend::*)(const GPUBackendDrawLineCommand* cmd,
+                                                    const Common::Rectangle<u32>& clip,
                                                     const GPUBackendDrawLineCommand::Vertex* p0,
                                                     const GPUBackendDrawLineCommand::Vertex* p1);
   DrawLineFunction GetDrawLineFunction(bool shading_enable, bool transparency_enable, bool dithering_enable);
 
+  //////////////////////////////////////////////////////////////////////////
+  // Multithreaded rasterization
+  //////////////////////////////////////////////////////////////////////////
+  // Draw commands between flush points are queued into a batch and binned into horizontal bands of VRAM rows. Each
+  // band is rasterized by a single thread in submission order, so overlapping primitives, blending and mask checks
+  // produce the same result as the serial path. Commands which sample from VRAM written earlier in the batch (or
+  // write to VRAM sampled earlier in the batch) force a flush, as bands are not synchronized with each other.
+  enum : u32
+  {
+    RASTERIZER_BIN_SHIFT = 4,
+    RASTERIZER_NUM_BINS = VRAM_HEIGHT >> RASTERIZER_BIN_SHIFT,
+    MAX_BATCH_DATA_SIZE = 1024 * 1024,
+    MAX_BATCH_READ_RECTS = 64,
+    MIN_PARALLEL_BATCH_COMMANDS = 8,
+  };
+
+  struct BatchCommand
+  {
+    u32 offset;
+    u16 top;
+    u16 bottom;
+  };
+
+  bool IsBatchingEnabled() const { return m_use_gpu_thread && !m_rasterizer_threads.empty(); }
+  void QueueCommand(const GPUBackendDrawCommand* cmd);
+  bool GetCommandWriteBounds(const GPUBackendDrawCommand* cmd, Common::Rectangle<u32>* bounds) const;
+  static u32 GetCommandReadBounds(const GPUBackendDrawCommand* cmd, Common::Rectangle<u32>* bounds);
+  void ExecuteBatch();
+  void RasterizeBins();
+
+  void StartRasterizerThreads(u32 count);
+  void StopRasterizerThreads();
+  void RasterizerThreadEntryPoint();
+
+  std::vector<u8> m_batch_data;
+  std::vector<BatchCommand> m_batch_commands;
+  std::vector<Common::Rectangle<u32>> m_batch_read_rects;
+  Common::Rectangle<u32> m_batch_write_bounds;
+  std::array<std::vector<u32>, RASTERIZER_NUM_BINS> m_rasterizer_bins;
+
+  std::vector<Threading::Thread> m_rasterizer_threads;
+  std::mutex m_rasterizer_mutex;
+  std::condition_variable m_rasterizer_work_cv;
+  std::condition_variable m_rasterizer_done_cv;
+  u32 m_rasterizer_generation = 0;
+  u32 m_rasterizer_active_threads = 0;
+  bool m_rasterizer_shutdown = false;
+  alignas(64) std::atomic<u32> m_rasterizer_next_bin{0};
+
+  std::atomic<u64> m_stat_batches{0};
+  std::atomic<u64> m_stat_parallel_batches{0};
+  std::atomic<u64> m_stat_commands{0};
+  std::atomic<u64> m_stat_wall_time{0};
+  std::atomic<u64> m_stat_busy_time{0};
+  std::atomic<u64> m_stat_simd_checks{0};
+  std::atomic<u64> m_stat_simd_mismatches{0};
+
+  bool m_use_simd = true;
+  bool m_simd_validation = false;
+
   std::array<u16, VRAM_WIDTH * VRAM_HEIGHT> m_vram;
 };
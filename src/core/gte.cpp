@@ -7,6 +7,7 @@
 #include "cpu_core_private.h"
 #include "cpu_pgxp.h"
 #include "settings.h"
+#include "subsystem_profiler.h"
 #include "timing_event.h"
 
 #include "util/gpu_device.h"
@@ -14,11 +15,16 @@
 
 #include "common/assert.h"
 #include "common/bitutils.h"
+#include "common/intrin.h"
 
 #include <algorithm>
 #include <array>
 #include <numeric>
 
+#if defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)
+#define GTE_SIMD 1
+#endif
+
 namespace GTE {
 
 static constexpr s64 MAC0_MIN_VALUE = -(INT64_C(1) << 31);
@@ -166,6 +172,7 @@ static void SetOTZ(s32 value);
 static void PushSXY(s32 x, s32 y);
 static void PushSZ(s32 value);
 static void PushRGBFromMAC();
+static void PushProjectedSXY(s64 result, s16 ir1, s16 ir2);
 static u32 UNRDivide(u32 lhs, u32 rhs);
 
 static void MulMatVec(const s16* M_, const s16 Vx, const s16 Vy, const s16 Vz, u8 shift, bool lm);
@@ -179,6 +186,13 @@ static void NCCS(const s16 V[3], u8 shift, bool lm);
 static void NCDS(const s16 V[3], u8 shift, bool lm);
 static void DPCS(const u8 color[3], u8 shift, bool lm);
 
+#ifdef GTE_SIMD
+static void RTPT_SIMD(u8 shift, bool lm);
+static void NCT_SIMD(u8 shift, bool lm);
+static void NCCT_SIMD(u8 shift, bool lm);
+static void NCDT_SIMD(u8 shift, bool lm);
+#endif
+
 static void Execute_MVMVA(Instruction inst);
 static void Execute_SQR(Instruction inst);
 static void Execute_OP(Instruction inst);
@@ -203,6 +217,11 @@ static void Execute_INTPL(Instruction inst);
 static void Execute_GPL(Instruction inst);
 static void Execute_GPF(Instruction inst);
 
+template<InstructionImpl impl>
+static void ProfiledInstruction(Instruction inst);
+template<InstructionImpl impl>
+static InstructionImpl GetProfiledInstructionImpl();
+
 } // namespace GTE
 
 void GTE::Initialize()
@@ -660,6 +679,44 @@ void GTE::Execute_OP(Instruction inst)
   REGS.FLAG.UpdateError();
 }
 
+ALWAYS_INLINE void GTE::PushProjectedSXY(s64 result, s16 ir1, s16 ir2)
+{
+  s64 Sx;
+  switch (s_aspect_ratio)
+  {
+    case DisplayAspectRatio::R16_9:
+      Sx = ((((s64(result) * s64(ir1)) * s64(3)) / s64(4)) + s64(REGS.OFX));
+      break;
+
+    case DisplayAspectRatio::R19_9:
+      Sx = ((((s64(result) * s64(ir1)) * s64(12)) / s64(19)) + s64(REGS.OFX));
+      break;
+
+    case DisplayAspectRatio::R20_9:
+      Sx = ((((s64(result) * s64(ir1)) * s64(3)) / s64(5)) + s64(REGS.OFX));
+      break;
+
+    case DisplayAspectRatio::Custom:
+    case DisplayAspectRatio::MatchWindow:
+      Sx = ((((s64(result) * s64(ir1)) * s64(s_custom_aspect_ratio_numerator)) /
+             s64(s_custom_aspect_ratio_denominator)) +
+            s64(REGS.OFX));
+      break;
+
+    case DisplayAspectRatio::Auto:
+    case DisplayAspectRatio::R4_3:
+    case DisplayAspectRatio::PAR1_1:
+    default:
+      Sx = (s64(result) * s64(ir1) + s64(REGS.OFX));
+      break;
+  }
+
+  const s64 Sy = s64(result) * s64(ir2) + s64(REGS.OFY);
+  CheckMACOverflow<0>(Sx);
+  CheckMACOverflow<0>(Sy);
+  PushSXY(s32(Sx >> 16), s32(Sy >> 16));
+}
+
 void GTE::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
 {
 #define dot3(i)                                                                                                        \
@@ -692,41 +749,7 @@ void GTE::RTPS(const s16 V[3], u8 shift, bool lm, bool last)
   // MAC0=(((H*20000h/SZ3)+1)/2)*IR1+OFX, SX2=MAC0/10000h ;ScrX FIFO -400h..+3FFh
   // MAC0=(((H*20000h/SZ3)+1)/2)*IR2+OFY, SY2=MAC0/10000h ;ScrY FIFO -400h..+3FFh
   const s64 result = static_cast<s64>(ZeroExtend64(UNRDivide(REGS.H, REGS.SZ3)));
-
-  s64 Sx;
-  switch (s_aspect_ratio)
-  {
-    case DisplayAspectRatio::R16_9:
-      Sx = ((((s64(result) * s64(REGS.IR1)) * s64(3)) / s64(4)) + s64(REGS.OFX));
-      break;
-
-    case DisplayAspectRatio::R19_9:
-      Sx = ((((s64(result) * s64(REGS.IR1)) * s64(12)) / s64(19)) + s64(REGS.OFX));
-      break;
-
-    case DisplayAspectRatio::R20_9:
-      Sx = ((((s64(result) * s64(REGS.IR1)) * s64(3)) / s64(5)) + s64(REGS.OFX));
-      break;
-
-    case DisplayAspectRatio::Custom:
-    case DisplayAspectRatio::MatchWindow:
-      Sx = ((((s64(result) * s64(REGS.IR1)) * s64(s_custom_aspect_ratio_numerator)) /
-             s64(s_custom_aspect_ratio_denominator)) +
-            s64(REGS.OFX));
-      break;
-
-    case DisplayAspectRatio::Auto:
-    case DisplayAspectRatio::R4_3:
-    case DisplayAspectRatio::PAR1_1:
-    default:
-      Sx = (s64(result) * s64(REGS.IR1) + s64(REGS.OFX));
-      break;
-  }
-
-  const s64 Sy = s64(result) * s64(REGS.IR2) + s64(REGS.OFY);
-  CheckMACOverflow<0>(Sx);
-  CheckMACOverflow<0>(Sy);
-  PushSXY(s32(Sx >> 16), s32(Sy >> 16));
+  PushProjectedSXY(result, REGS.IR1, REGS.IR2);
 
   if (g_settings.gpu_pgxp_enable)
   {
@@ -820,6 +843,15 @@ void GTE::Execute_RTPT(Instruction inst)
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
+#ifdef GTE_SIMD
+  if (g_settings.cpu_gte_use_simd && !g_settings.gpu_pgxp_enable)
+  {
+    RTPT_SIMD(shift, lm);
+    REGS.FLAG.UpdateError();
+    return;
+  }
+#endif
+
   RTPS(REGS.V0, shift, lm, false);
   RTPS(REGS.V1, shift, lm, false);
   RTPS(REGS.V2, shift, lm, true);
@@ -918,6 +950,15 @@ void GTE::Execute_NCT(Instruction inst)
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
+#ifdef GTE_SIMD
+  if (g_settings.cpu_gte_use_simd)
+  {
+    NCT_SIMD(shift, lm);
+    REGS.FLAG.UpdateError();
+    return;
+  }
+#endif
+
   NCS(REGS.V0, shift, lm);
   NCS(REGS.V1, shift, lm);
   NCS(REGS.V2, shift, lm);
@@ -959,6 +1000,15 @@ void GTE::Execute_NCCT(Instruction inst)
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
+#ifdef GTE_SIMD
+  if (g_settings.cpu_gte_use_simd)
+  {
+    NCCT_SIMD(shift, lm);
+    REGS.FLAG.UpdateError();
+    return;
+  }
+#endif
+
   NCCS(REGS.V0, shift, lm);
   NCCS(REGS.V1, shift, lm);
   NCCS(REGS.V2, shift, lm);
@@ -1003,6 +1053,15 @@ void GTE::Execute_NCDT(Instruction inst)
   const u8 shift = inst.GetShift();
   const bool lm = inst.lm;
 
+#ifdef GTE_SIMD
+  if (g_settings.cpu_gte_use_simd)
+  {
+    NCDT_SIMD(shift, lm);
+    REGS.FLAG.UpdateError();
+    return;
+  }
+#endif
+
   NCDS(REGS.V0, shift, lm);
   NCDS(REGS.V1, shift, lm);
   NCDS(REGS.V2, shift, lm);
@@ -1010,6 +1069,439 @@ void GTE::Execute_NCDT(Instruction inst)
   REGS.FLAG.UpdateError();
 }
 
+#ifdef GTE_SIMD
+
+// The triple-vertex commands run the same sequence for each vertex, and only share the FIFOs. So all three vertices
+// are computed at once, one per lane, with the remaining lane zero. MAC sums need more than 32 bits, those are done in
+// pairs of 64-bit lanes (vertices 0-1, then vertex 2). Thin wrappers over SSE2/NEON, as in the software renderer.
+#if defined(CPU_ARCH_SSE)
+
+using GTEVecS32 = __m128i;
+using GTEVecS64 = __m128i;
+
+static ALWAYS_INLINE GTEVecS32 GTESetS32(s32 v)
+{
+  return _mm_set1_epi32(v);
+}
+static ALWAYS_INLINE GTEVecS32 GTESetS32x3(s32 a, s32 b, s32 c)
+{
+  return _mm_setr_epi32(a, b, c, 0);
+}
+static ALWAYS_INLINE void GTEStoreS32(s32* dst, GTEVecS32 v)
+{
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v);
+}
+static ALWAYS_INLINE GTEVecS32 GTEOr(GTEVecS32 a, GTEVecS32 b)
+{
+  return _mm_or_si128(a, b);
+}
+static ALWAYS_INLINE GTEVecS32 GTESelect(GTEVecS32 mask, GTEVecS32 a, GTEVecS32 b)
+{
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+static ALWAYS_INLINE GTEVecS32 GTECmpGtS32(GTEVecS32 a, GTEVecS32 b)
+{
+  return _mm_cmpgt_epi32(a, b);
+}
+static ALWAYS_INLINE GTEVecS32 GTECmpLtS32(GTEVecS32 a, GTEVecS32 b)
+{
+  return _mm_cmplt_epi32(a, b);
+}
+static ALWAYS_INLINE bool GTEAnyLane3(GTEVecS32 mask)
+{
+  return (_mm_movemask_ps(_mm_castsi128_ps(mask)) & 0x7) != 0;
+}
+static ALWAYS_INLINE GTEVecS32 GTEAddS32(GTEVecS32 a, GTEVecS32 b)
+{
+  return _mm_add_epi32(a, b);
+}
+template<int n>
+static ALWAYS_INLINE GTEVecS32 GTEShlS32(GTEVecS32 a)
+{
+  return _mm_slli_epi32(a, n);
+}
+static ALWAYS_INLINE GTEVecS32 GTESarS32(GTEVecS32 a, u8 n)
+{
+  return _mm_sra_epi32(a, _mm_cvtsi32_si128(n));
+}
+static ALWAYS_INLINE GTEVecS32 GTEMulS16(GTEVecS32 a, s16 b)
+{
+  // Lanes of a must be in s16 range. With the upper half of b zero, pmaddwd is a 16x16->32 multiply.
+  return _mm_madd_epi16(a, _mm_set1_epi32(ZeroExtend32(static_cast<u16>(b))));
+}
+static ALWAYS_INLINE GTEVecS64 GTESetS64(s64 v)
+{
+  return _mm_set1_epi64x(v);
+}
+static ALWAYS_INLINE GTEVecS64 GTEWidenLowS32(GTEVecS32 v)
+{
+  return _mm_unpacklo_epi32(v, _mm_srai_epi32(v, 31));
+}
+static ALWAYS_INLINE GTEVecS64 GTEWidenHighS32(GTEVecS32 v)
+{
+  return _mm_unpackhi_epi32(v, _mm_srai_epi32(v, 31));
+}
+static ALWAYS_INLINE GTEVecS64 GTEAddS64(GTEVecS64 a, GTEVecS64 b)
+{
+  return _mm_add_epi64(a, b);
+}
+static ALWAYS_INLINE GTEVecS64 GTESubS64(GTEVecS64 a, GTEVecS64 b)
+{
+  return _mm_sub_epi64(a, b);
+}
+static ALWAYS_INLINE GTEVecS64 GTESarS64(GTEVecS64 v, u8 n)
+{
+  // No 64-bit arithmetic shift in SSE2, so shift the sign in separately. Shifting by 64 gives zero, so n can be 0.
+  const __m128i sign = _mm_shuffle_epi32(_mm_srai_epi32(v, 31), _MM_SHUFFLE(3, 3, 1, 1));
+  return _mm_or_si128(_mm_srl_epi64(v, _mm_cvtsi32_si128(n)), _mm_sll_epi64(sign, _mm_cvtsi32_si128(64 - n)));
+}
+template<int bits>
+static ALWAYS_INLINE GTEVecS64 GTESignExtendS64(GTEVecS64 v)
+{
+  return GTESarS64(_mm_slli_epi64(v, 64 - bits), 64 - bits);
+}
+static ALWAYS_INLINE GTEVecS32 GTENarrowLowS64(GTEVecS64 lo, GTEVecS64 hi)
+{
+  return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+static ALWAYS_INLINE GTEVecS32 GTENarrowHighS64(GTEVecS64 lo, GTEVecS64 hi)
+{
+  return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+#elif defined(CPU_ARCH_NEON)
+
+using GTEVecS32 = int32x4_t;
+using GTEVecS64 = int64x2_t;
+
+static ALWAYS_INLINE GTEVecS32 GTESetS32(s32 v)
+{
+  return vdupq_n_s32(v);
+}
+static ALWAYS_INLINE GTEVecS32 GTESetS32x3(s32 a, s32 b, s32 c)
+{
+  const s32 values[4] = {a, b, c, 0};
+  return vld1q_s32(values);
+}
+static ALWAYS_INLINE void GTEStoreS32(s32* dst, GTEVecS32 v)
+{
+  vst1q_s32(dst, v);
+}
+static ALWAYS_INLINE GTEVecS32 GTEOr(GTEVecS32 a, GTEVecS32 b)
+{
+  return vorrq_s32(a, b);
+}
+static ALWAYS_INLINE GTEVecS32 GTESelect(GTEVecS32 mask, GTEVecS32 a, GTEVecS32 b)
+{
+  return vbslq_s32(vreinterpretq_u32_s32(mask), a, b);
+}
+static ALWAYS_INLINE GTEVecS32 GTECmpGtS32(GTEVecS32 a, GTEVecS32 b)
+{
+  return vreinterpretq_s32_u32(vcgtq_s32(a, b));
+}
+static ALWAYS_INLINE GTEVecS32 GTECmpLtS32(GTEVecS32 a, GTEVecS32 b)
+{
+  return vreinterpretq_s32_u32(vcltq_s32(a, b));
+}
+static ALWAYS_INLINE bool GTEAnyLane3(GTEVecS32 mask)
+{
+  return vmaxvq_u32(vsetq_lane_u32(0, vreinterpretq_u32_s32(mask), 3)) != 0;
+}
+static ALWAYS_INLINE GTEVecS32 GTEAddS32(GTEVecS32 a, GTEVecS32 b)
+{
+  return vaddq_s32(a, b);
+}
+template<int n>
+static ALWAYS_INLINE GTEVecS32 GTEShlS32(GTEVecS32 a)
+{
+  return vshlq_n_s32(a, n);
+}
+static ALWAYS_INLINE GTEVecS32 GTESarS32(GTEVecS32 a, u8 n)
+{
+  return vshlq_s32(a, vdupq_n_s32(-static_cast<s32>(n)));
+}
+static ALWAYS_INLINE GTEVecS32 GTEMulS16(GTEVecS32 a, s16 b)
+{
+  return vmulq_n_s32(a, b);
+}
+static ALWAYS_INLINE GTEVecS64 GTESetS64(s64 v)
+{
+  return vdupq_n_s64(v);
+}
+static ALWAYS_INLINE GTEVecS64 GTEWidenLowS32(GTEVecS32 v)
+{
+  return vmovl_s32(vget_low_s32(v));
+}
+static ALWAYS_INLINE GTEVecS64 GTEWidenHighS32(GTEVecS32 v)
+{
+  return vmovl_high_s32(v);
+}
+static ALWAYS_INLINE GTEVecS64 GTEAddS64(GTEVecS64 a, GTEVecS64 b)
+{
+  return vaddq_s64(a, b);
+}
+static ALWAYS_INLINE GTEVecS64 GTESubS64(GTEVecS64 a, GTEVecS64 b)
+{
+  return vsubq_s64(a, b);
+}
+static ALWAYS_INLINE GTEVecS64 GTESarS64(GTEVecS64 v, u8 n)
+{
+  return vshlq_s64(v, vdupq_n_s64(-static_cast<s64>(n)));
+}
+template<int bits>
+static ALWAYS_INLINE GTEVecS64 GTESignExtendS64(GTEVecS64 v)
+{
+  return vshrq_n_s64(vshlq_n_s64(v, 64 - bits), 64 - bits);
+}
+static ALWAYS_INLINE GTEVecS32 GTENarrowLowS64(GTEVecS64 lo, GTEVecS64 hi)
+{
+  return vcombine_s32(vmovn_s64(lo), vmovn_s64(hi));
+}
+static ALWAYS_INLINE GTEVecS32 GTENarrowHighS64(GTEVecS64 lo, GTEVecS64 hi)
+{
+  return vuzp2q_s32(vreinterpretq_s32_s64(lo), vreinterpretq_s32_s64(hi));
+}
+
+#endif
+
+namespace GTE {
+// FLAG bits for row 0, i.e. MAC1/IR1/R. Rows 1 and 2 are the next lower bits.
+static constexpr u32 FLAG_MAC_OVERFLOW_BIT = 30;
+static constexpr u32 FLAG_MAC_UNDERFLOW_BIT = 27;
+static constexpr u32 FLAG_IR_SATURATED_BIT = 24;
+static constexpr u32 FLAG_COLOR_SATURATED_BIT = 21;
+
+/// CheckMACOverflow() for MAC1-3 of all three vertices.
+static ALWAYS_INLINE u32 SIMDCheckMACOverflow(u32 row, GTEVecS64 lo, GTEVecS64 hi)
+{
+  // Biasing by 2^43 moves the valid range to [0, 2^44), so only the upper halves need checking.
+  const GTEVecS64 bias = GTESetS64(-MAC123_MIN_VALUE);
+  const GTEVecS32 upper = GTENarrowHighS64(GTEAddS64(lo, bias), GTEAddS64(hi, bias));
+  u32 flags = 0;
+  if (GTEAnyLane3(GTECmpLtS32(upper, GTESetS32(0)))) [[unlikely]]
+    flags |= (1u << (FLAG_MAC_UNDERFLOW_BIT - row));
+  if (GTEAnyLane3(GTECmpGtS32(upper, GTESetS32((1 << 12) - 1)))) [[unlikely]]
+    flags |= (1u << (FLAG_MAC_OVERFLOW_BIT - row));
+  return flags;
+}
+
+/// Clamps each lane to [min_value, max_value], setting saturated if any vertex was clamped.
+static ALWAYS_INLINE GTEVecS32 SIMDSaturate(GTEVecS32 v, s32 min_value, s32 max_value, bool* saturated)
+{
+  const GTEVecS32 vmin = GTESetS32(min_value);
+  const GTEVecS32 vmax = GTESetS32(max_value);
+  const GTEVecS32 below = GTECmpLtS32(v, vmin);
+  const GTEVecS32 above = GTECmpGtS32(v, vmax);
+  *saturated = GTEAnyLane3(GTEOr(below, above));
+  return GTESelect(below, vmin, GTESelect(above, vmax, v));
+}
+
+/// TruncateAndSetIR() for IR1-3 of all three vertices.
+static ALWAYS_INLINE GTEVecS32 SIMDTruncateIR(u32 row, GTEVecS32 mac, bool lm, u32* flags)
+{
+  bool saturated;
+  const GTEVecS32 ir = SIMDSaturate(mac, lm ? 0 : IR123_MIN_VALUE, IR123_MAX_VALUE, &saturated);
+  *flags |= saturated ? (1u << (FLAG_IR_SATURATED_BIT - row)) : 0u;
+  return ir;
+}
+
+/// One row of MulMatVec() for all three vertices, returning MAC before it's shifted. Each partial sum is checked and
+/// wrapped to 44 bits like SignExtendMACResult(). Without a translation vector, the sums can't get near 44 bits.
+template<bool has_translation>
+static ALWAYS_INLINE void SIMDMulMatVecRow(u32 row, const s16 M[3], s32 T, const GTEVecS32 V[3], GTEVecS64* out_lo,
+                                           GTEVecS64* out_hi, u32* flags)
+{
+  GTEVecS64 lo = GTESetS64(s64(T) << 12);
+  GTEVecS64 hi = lo;
+  for (u32 i = 0; i < 3; i++)
+  {
+    const GTEVecS32 product = GTEMulS16(V[i], M[i]);
+    lo = GTEAddS64(lo, GTEWidenLowS32(product));
+    hi = GTEAddS64(hi, GTEWidenHighS32(product));
+    if constexpr (has_translation)
+    {
+      *flags |= SIMDCheckMACOverflow(row, lo, hi);
+      if (i < 2)
+      {
+        lo = GTESignExtendS64<44>(lo);
+        hi = GTESignExtendS64<44>(hi);
+      }
+    }
+  }
+
+  *out_lo = lo;
+  *out_hi = hi;
+}
+
+static ALWAYS_INLINE GTEVecS32 SIMDShiftAndTruncateMAC(GTEVecS64 lo, GTEVecS64 hi, u8 shift)
+{
+  return GTENarrowLowS64(GTESarS64(lo, shift), GTESarS64(hi, shift));
+}
+
+/// Writes the results of the last vertex to MAC1-3 and IR1-3.
+static ALWAYS_INLINE void SIMDSetMACAndIR(const GTEVecS32 mac[3], const GTEVecS32 ir[3])
+{
+  for (u32 i = 0; i < 3; i++)
+  {
+    alignas(16) s32 values[4];
+    GTEStoreS32(values, mac[i]);
+    REGS.dr32[25 + i] = static_cast<u32>(values[2]);
+    GTEStoreS32(values, ir[i]);
+    REGS.dr32[9 + i] = static_cast<u32>(values[2]);
+  }
+}
+
+/// PushRGBFromMAC() for all three vertices.
+static ALWAYS_INLINE void SIMDPushRGBFromMAC(const GTEVecS32 mac[3], u32* flags)
+{
+  alignas(16) s32 rgb[3][4];
+  for (u32 i = 0; i < 3; i++)
+  {
+    bool saturated;
+    GTEStoreS32(rgb[i], SIMDSaturate(GTESarS32(mac[i], 4), 0, 0xFF, &saturated));
+    *flags |= saturated ? (1u << (FLAG_COLOR_SATURATED_BIT - i)) : 0u;
+  }
+
+  const u32 c = ZeroExtend32(REGS.RGBC[3]) << 24;
+  REGS.dr32[20] = static_cast<u32>(rgb[0][0]) | (static_cast<u32>(rgb[1][0]) << 8) |
+                  (static_cast<u32>(rgb[2][0]) << 16) | c;
+  REGS.dr32[21] = static_cast<u32>(rgb[0][1]) | (static_cast<u32>(rgb[1][1]) << 8) |
+                  (static_cast<u32>(rgb[2][1]) << 16) | c;
+  REGS.dr32[22] = static_cast<u32>(rgb[0][2]) | (static_cast<u32>(rgb[1][2]) << 8) |
+                  (static_cast<u32>(rgb[2][2]) << 16) | c;
+}
+
+/// The LLM * V and BK + LCM * IR multiplies which the NCx commands start with.
+static ALWAYS_INLINE void SIMDNormalColor(u8 shift, bool lm, GTEVecS32 mac[3], GTEVecS32 ir[3], u32* flags)
+{
+  const GTEVecS32 V[3] = {GTESetS32x3(REGS.V0[0], REGS.V1[0], REGS.V2[0]),
+                          GTESetS32x3(REGS.V0[1], REGS.V1[1], REGS.V2[1]),
+                          GTESetS32x3(REGS.V0[2], REGS.V1[2], REGS.V2[2])};
+  GTEVecS32 light_ir[3];
+  for (u32 i = 0; i < 3; i++)
+  {
+    GTEVecS64 lo, hi;
+    SIMDMulMatVecRow<false>(i, REGS.LLM[i], 0, V, &lo, &hi, flags);
+    light_ir[i] = SIMDTruncateIR(i, SIMDShiftAndTruncateMAC(lo, hi, shift), lm, flags);
+  }
+
+  for (u32 i = 0; i < 3; i++)
+  {
+    GTEVecS64 lo, hi;
+    SIMDMulMatVecRow<true>(i, REGS.LCM[i], REGS.BK[i], light_ir, &lo, &hi, flags);
+    mac[i] = SIMDShiftAndTruncateMAC(lo, hi, shift);
+    ir[i] = SIMDTruncateIR(i, mac[i], lm, flags);
+  }
+}
+
+} // namespace GTE
+
+void GTE::RTPT_SIMD(u8 shift, bool lm)
+{
+  const GTEVecS32 V[3] = {GTESetS32x3(REGS.V0[0], REGS.V1[0], REGS.V2[0]),
+                          GTESetS32x3(REGS.V0[1], REGS.V1[1], REGS.V2[1]),
+                          GTESetS32x3(REGS.V0[2], REGS.V1[2], REGS.V2[2])};
+  u32 flags = 0;
+  GTEVecS32 mac[3], ir[3];
+  alignas(16) s32 sz[4];
+  for (u32 i = 0; i < 3; i++)
+  {
+    GTEVecS64 lo, hi;
+    SIMDMulMatVecRow<true>(i, REGS.RT[i], REGS.TR[i], V, &lo, &hi, &flags);
+    mac[i] = SIMDShiftAndTruncateMAC(lo, hi, shift);
+    if (i < 2)
+    {
+      ir[i] = SIMDTruncateIR(i, mac[i], lm, &flags);
+    }
+    else
+    {
+      // IR3 is saturated from MAC3, but the flag comes from MAC3 SAR 12, see RTPS().
+      const GTEVecS32 z = SIMDShiftAndTruncateMAC(lo, hi, 12);
+      GTEStoreS32(sz, z);
+      SIMDTruncateIR(i, z, false, &flags);
+
+      bool unused;
+      ir[i] = SIMDSaturate(mac[i], lm ? 0 : IR123_MIN_VALUE, IR123_MAX_VALUE, &unused);
+    }
+  }
+
+  REGS.FLAG.bits |= flags;
+  SIMDSetMACAndIR(mac, ir);
+
+  // Division and projection stay scalar, they're a table lookup and depend on the aspect ratio.
+  alignas(16) s32 ir1[4], ir2[4];
+  GTEStoreS32(ir1, ir[0]);
+  GTEStoreS32(ir2, ir[1]);
+  s64 result = 0;
+  for (u32 i = 0; i < 3; i++)
+  {
+    PushSZ(sz[i]);
+    result = static_cast<s64>(ZeroExtend64(UNRDivide(REGS.H, REGS.SZ3)));
+    PushProjectedSXY(result, static_cast<s16>(ir1[i]), static_cast<s16>(ir2[i]));
+  }
+
+  const s64 Sz = s64(result) * s64(REGS.DQA) + s64(REGS.DQB);
+  TruncateAndSetMAC<0>(Sz, 0);
+  TruncateAndSetIR<0>(s32(Sz >> 12), true);
+}
+
+void GTE::NCT_SIMD(u8 shift, bool lm)
+{
+  u32 flags = 0;
+  GTEVecS32 mac[3], ir[3];
+  SIMDNormalColor(shift, lm, mac, ir, &flags);
+  SIMDSetMACAndIR(mac, ir);
+  SIMDPushRGBFromMAC(mac, &flags);
+  REGS.FLAG.bits |= flags;
+}
+
+void GTE::NCCT_SIMD(u8 shift, bool lm)
+{
+  u32 flags = 0;
+  GTEVecS32 mac[3], ir[3];
+  SIMDNormalColor(shift, lm, mac, ir, &flags);
+
+  // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4, which fits in 32 bits.
+  for (u32 i = 0; i < 3; i++)
+  {
+    mac[i] = GTESarS32(GTEShlS32<4>(GTEMulS16(ir[i], static_cast<s16>(REGS.RGBC[i]))), shift);
+    ir[i] = SIMDTruncateIR(i, mac[i], lm, &flags);
+  }
+
+  SIMDSetMACAndIR(mac, ir);
+  SIMDPushRGBFromMAC(mac, &flags);
+  REGS.FLAG.bits |= flags;
+}
+
+void GTE::NCDT_SIMD(u8 shift, bool lm)
+{
+  u32 flags = 0;
+  GTEVecS32 mac[3], ir[3];
+  SIMDNormalColor(shift, lm, mac, ir, &flags);
+
+  for (u32 i = 0; i < 3; i++)
+  {
+    // [MAC1,MAC2,MAC3] = [R*IR1,G*IR2,B*IR3] SHL 4
+    const GTEVecS32 in_mac = GTEShlS32<4>(GTEMulS16(ir[i], static_cast<s16>(REGS.RGBC[i])));
+
+    // InterpolateColor(): ((FC SHL 12) - MAC) SAR (sf*12) can overflow, the second step can't.
+    const GTEVecS64 fc = GTESetS64(s64(REGS.FC[i]) << 12);
+    const GTEVecS64 lo = GTESubS64(fc, GTEWidenLowS32(in_mac));
+    const GTEVecS64 hi = GTESubS64(fc, GTEWidenHighS32(in_mac));
+    flags |= SIMDCheckMACOverflow(i, lo, hi);
+    const GTEVecS32 fc_ir = SIMDTruncateIR(i, SIMDShiftAndTruncateMAC(lo, hi, shift), false, &flags);
+
+    mac[i] = GTESarS32(GTEAddS32(GTEMulS16(fc_ir, REGS.IR0), in_mac), shift);
+    ir[i] = SIMDTruncateIR(i, mac[i], lm, &flags);
+  }
+
+  SIMDSetMACAndIR(mac, ir);
+  SIMDPushRGBFromMAC(mac, &flags);
+  REGS.FLAG.bits |= flags;
+}
+
+#endif // GTE_SIMD
+
 void GTE::Execute_CC(Instruction inst)
 {
   REGS.FLAG.Clear();
@@ -1175,6 +1667,8 @@ void GTE::Execute_GPF(Instruction inst)
 
 void GTE::ExecuteInstruction(u32 inst_bits)
 {
+  SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::GTE);
+
   const Instruction inst{inst_bits};
   switch (inst.command)
   {
@@ -1299,6 +1793,20 @@ void GTE::ExecuteInstruction(u32 inst_bits)
   }
 }
 
+template<GTE::InstructionImpl impl>
+void GTE::ProfiledInstruction(Instruction inst)
+{
+  SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::GTE);
+  impl(inst);
+}
+
+template<GTE::InstructionImpl impl>
+ALWAYS_INLINE GTE::InstructionImpl GTE::GetProfiledInstructionImpl()
+{
+  // Recompiled code calls the implementation directly, so wrap it when profiling.
+  return SubsystemProfiler::IsEnabled() ? &ProfiledInstruction<impl> : impl;
+}
+
 GTE::InstructionImpl GTE::GetInstructionImpl(u32 inst_bits, TickCount* ticks)
 {
   const Instruction inst{inst_bits};
@@ -1306,96 +1814,96 @@ GTE::InstructionImpl GTE::GetInstructionImpl(u32 inst_bits, TickCount* ticks)
   {
     case 0x01:
       *ticks = 15;
-      return &Execute_RTPS;
+      return GetProfiledInstructionImpl<&Execute_RTPS>();
 
     case 0x06:
     {
       *ticks = 8;
       if (g_settings.gpu_pgxp_enable && g_settings.gpu_pgxp_culling)
-        return &Execute_NCLIP_PGXP;
+        return GetProfiledInstructionImpl<&Execute_NCLIP_PGXP>();
       else
-        return &Execute_NCLIP;
+        return GetProfiledInstructionImpl<&Execute_NCLIP>();
     }
 
     case 0x0C:
       *ticks = 6;
-      return &Execute_OP;
+      return GetProfiledInstructionImpl<&Execute_OP>();
 
     case 0x10:
       *ticks = 8;
-      return &Execute_DPCS;
+      return GetProfiledInstructionImpl<&Execute_DPCS>();
 
     case 0x11:
       *ticks = 7;
-      return &Execute_INTPL;
+      return GetProfiledInstructionImpl<&Execute_INTPL>();
 
     case 0x12:
       *ticks = 8;
-      return &Execute_MVMVA;
+      return GetProfiledInstructionImpl<&Execute_MVMVA>();
 
     case 0x13:
       *ticks = 19;
-      return &Execute_NCDS;
+      return GetProfiledInstructionImpl<&Execute_NCDS>();
 
     case 0x14:
       *ticks = 13;
-      return &Execute_CDP;
+      return GetProfiledInstructionImpl<&Execute_CDP>();
 
     case 0x16:
       *ticks = 44;
-      return &Execute_NCDT;
+      return GetProfiledInstructionImpl<&Execute_NCDT>();
 
     case 0x1B:
       *ticks = 17;
-      return &Execute_NCCS;
+      return GetProfiledInstructionImpl<&Execute_NCCS>();
 
     case 0x1C:
       *ticks = 11;
-      return &Execute_CC;
+      return GetProfiledInstructionImpl<&Execute_CC>();
 
     case 0x1E:
       *ticks = 14;
-      return &Execute_NCS;
+      return GetProfiledInstructionImpl<&Execute_NCS>();
 
     case 0x20:
       *ticks = 30;
-      return &Execute_NCT;
+      return GetProfiledInstructionImpl<&Execute_NCT>();
 
     case 0x28:
       *ticks = 5;
-      return &Execute_SQR;
+      return GetProfiledInstructionImpl<&Execute_SQR>();
 
     case 0x29:
       *ticks = 8;
-      return &Execute_DCPL;
+      return GetProfiledInstructionImpl<&Execute_DCPL>();
 
     case 0x2A:
       *ticks = 17;
-      return &Execute_DPCT;
+      return GetProfiledInstructionImpl<&Execute_DPCT>();
 
     case 0x2D:
       *ticks = 5;
-      return &Execute_AVSZ3;
+      return GetProfiledInstructionImpl<&Execute_AVSZ3>();
 
     case 0x2E:
       *ticks = 6;
-      return &Execute_AVSZ4;
+      return GetProfiledInstructionImpl<&Execute_AVSZ4>();
 
     case 0x30:
       *ticks = 23;
-      return &Execute_RTPT;
+      return GetProfiledInstructionImpl<&Execute_RTPT>();
 
     case 0x3D:
       *ticks = 5;
-      return &Execute_GPF;
+      return GetProfiledInstructionImpl<&Execute_GPF>();
 
     case 0x3E:
       *ticks = 5;
-      return &Execute_GPL;
+      return GetProfiledInstructionImpl<&Execute_GPL>();
 
     case 0x3F:
       *ticks = 39;
-      return &Execute_NCCT;
+      return GetProfiledInstructionImpl<&Execute_NCCT>();
 
     default:
       Panic("Missing handler");
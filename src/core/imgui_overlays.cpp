@@ -393,6 +393,10 @@ void ImGuiManager::DrawPerformanceOverlay()
         text.assign("SW: ");
         FormatProcessorStat(text, System::GetSWThreadUsage(), System::GetSWThreadAverageTime());
         DRAW_LINE(fixed_font, text, IM_COL32(255, 255, 255, 255));
+
+        text.format("SW Queue: {}/{} KB, {:.2f}ms stall", (System::GetSWQueueAverageDepth() + 1023) / 1024,
+                    (System::GetSWQueueMaxDepth() + 1023) / 1024, System::GetSWStallAverageTime());
+        DRAW_LINE(fixed_font, text, IM_COL32(255, 255, 255, 255));
       }
 
 #if 0
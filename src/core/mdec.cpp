@@ -6,6 +6,7 @@
 #include "dma.h"
 #include "host.h"
 #include "interrupt_controller.h"
+#include "subsystem_profiler.h"
 #include "system.h"
 
 #include "util/imgui_manager.h"
@@ -365,6 +366,8 @@ void MDEC::WriteCommandRegister(u32 value)
 
 void MDEC::Execute()
 {
+  SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::MDEC);
+
   for (;;)
   {
     switch (s_state)
@@ -560,6 +563,7 @@ void MDEC::ScheduleBlockCopyOut(TickCount ticks)
 
 void MDEC::CopyOutBlock(void* param, TickCount ticks, TickCount ticks_late)
 {
+  SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::MDEC);
   Assert(s_state == State::WritingMacroblock);
   s_block_copy_out_event->Deactivate();
 
@@ -157,6 +157,8 @@ void Settings::Load(SettingsInterface& si)
   rewind_enable = si.GetBoolValue("Main", "RewindEnable", false);
   rewind_save_frequency = si.GetFloatValue("Main", "RewindFrequency", 10.0f);
   rewind_save_slots = static_cast<u32>(si.GetIntValue("Main", "RewindSaveSlots", 10));
+  rewind_keyframe_interval = static_cast<u32>(std::max(si.GetIntValue("Main", "RewindKeyframeInterval", 10), 1));
+  rewind_delta_compression = si.GetBoolValue("Main", "RewindDeltaCompression", false);
   runahead_frames = static_cast<u32>(si.GetIntValue("Main", "RunaheadFrameCount", 0));
 
   cpu_execution_mode =
@@ -170,6 +172,15 @@ void Settings::Load(SettingsInterface& si)
   cpu_recompiler_memory_exceptions = si.GetBoolValue("CPU", "RecompilerMemoryExceptions", false);
   cpu_recompiler_block_linking = si.GetBoolValue("CPU", "RecompilerBlockLinking", true);
   cpu_recompiler_icache = si.GetBoolValue("CPU", "RecompilerICache", false);
+  cpu_recompiler_compile_threshold = static_cast<u16>(std::clamp<int>(
+    si.GetIntValue("CPU", "RecompilerCompileThreshold", 0), 0, MAX_CPU_RECOMPILER_COMPILE_THRESHOLD));
+  cpu_recompiler_background_compile = si.GetBoolValue("CPU", "RecompilerBackgroundCompile", false);
+  cpu_recompiler_follow_jumps = si.GetBoolValue("CPU", "RecompilerFollowJumps", false);
+  cpu_recompiler_superblocks = si.GetBoolValue("CPU", "RecompilerSuperblocks", false);
+  cpu_recompiler_block_stats = si.GetBoolValue("CPU", "RecompilerBlockStats", false);
+  cpu_recompiler_idle_loop_skipping = si.GetBoolValue("CPU", "RecompilerIdleLoopSkipping", false);
+  cpu_cached_interpreter_threaded = si.GetBoolValue("CPU", "CachedInterpreterThreaded", false);
+  cpu_gte_use_simd = si.GetBoolValue("CPU", "GTEUseSIMD", true);
   cpu_fastmem_mode = ParseCPUFastmemMode(
                        si.GetStringValue("CPU", "FastmemMode", GetCPUFastmemModeName(DEFAULT_CPU_FASTMEM_MODE)).c_str())
                        .value_or(DEFAULT_CPU_FASTMEM_MODE);
@@ -187,6 +198,13 @@ void Settings::Load(SettingsInterface& si)
   gpu_disable_texture_copy_to_self = si.GetBoolValue("GPU", "DisableTextureCopyToSelf", false);
   gpu_per_sample_shading = si.GetBoolValue("GPU", "PerSampleShading", false);
   gpu_use_thread = si.GetBoolValue("GPU", "UseThread", true);
+  gpu_sw_rasterizer_threads =
+    static_cast<u8>(std::clamp(si.GetIntValue("GPU", "SoftwareRasterizerThreads", 0), 0,
+                               static_cast<int>(MAX_SW_RASTERIZER_THREADS)));
+  gpu_sw_use_simd = si.GetBoolValue("GPU", "SoftwareUseSIMD", true);
+  gpu_sw_simd_validation = si.GetBoolValue("GPU", "SoftwareSIMDValidation", false);
+  gpu_bulk_vram_writes = si.GetBoolValue("GPU", "BulkVRAMWrites", false);
+  gpu_direct_dma_commands = si.GetBoolValue("GPU", "DirectDMACommands", false);
   gpu_use_software_renderer_for_readbacks = si.GetBoolValue("GPU", "UseSoftwareRendererForReadbacks", false);
   gpu_threaded_presentation = si.GetBoolValue("GPU", "ThreadedPresentation", true);
   gpu_true_color = si.GetBoolValue("GPU", "TrueColor", true);
@@ -268,6 +286,10 @@ void Settings::Load(SettingsInterface& si)
 
   cdrom_readahead_sectors =
     static_cast<u8>(si.GetIntValue("CDROM", "ReadaheadSectors", DEFAULT_CDROM_READAHEAD_SECTORS));
+  cdrom_chd_hunk_cache_size = static_cast<u16>(std::clamp<int>(
+    si.GetIntValue("CDROM", "CHDHunkCacheSize", DEFAULT_CDROM_CHD_HUNK_CACHE_SIZE), 1, MAX_CDROM_CHD_HUNK_CACHE_SIZE));
+  cdrom_chd_prefetch_hunks = static_cast<u8>(std::clamp<int>(
+    si.GetIntValue("CDROM", "CHDPrefetchHunks", DEFAULT_CDROM_CHD_PREFETCH_HUNKS), 0, MAX_CDROM_CHD_PREFETCH_HUNKS));
   cdrom_mechacon_version =
     ParseCDROMMechVersionName(
       si.GetStringValue("CDROM", "MechaconVersion", GetCDROMMechVersionName(DEFAULT_CDROM_MECHACON_VERSION)).c_str())
@@ -295,6 +317,8 @@ void Settings::Load(SettingsInterface& si)
 
   audio_output_muted = si.GetBoolValue("Audio", "OutputMuted", false);
   audio_dump_on_boot = si.GetBoolValue("Audio", "DumpOnBoot", false);
+  audio_spu_use_simd = si.GetBoolValue("Audio", "SPUUseSIMD", false);
+  audio_spu_adpcm_cache = si.GetBoolValue("Audio", "SPUADPCMCache", true);
 
   use_old_mdec_routines = si.GetBoolValue("Hacks", "UseOldMDECRoutines", false);
   pcdrv_enable = si.GetBoolValue("PCDrv", "Enabled", false);
@@ -430,6 +454,8 @@ void Settings::Save(SettingsInterface& si) const
   si.SetBoolValue("Main", "RewindEnable", rewind_enable);
   si.SetFloatValue("Main", "RewindFrequency", rewind_save_frequency);
   si.SetIntValue("Main", "RewindSaveSlots", rewind_save_slots);
+  si.SetIntValue("Main", "RewindKeyframeInterval", rewind_keyframe_interval);
+  si.SetBoolValue("Main", "RewindDeltaCompression", rewind_delta_compression);
   si.SetIntValue("Main", "RunaheadFrameCount", runahead_frames);
 
   si.SetStringValue("CPU", "ExecutionMode", GetCPUExecutionModeName(cpu_execution_mode));
@@ -439,6 +465,14 @@ void Settings::Save(SettingsInterface& si) const
   si.SetBoolValue("CPU", "RecompilerMemoryExceptions", cpu_recompiler_memory_exceptions);
   si.SetBoolValue("CPU", "RecompilerBlockLinking", cpu_recompiler_block_linking);
   si.SetBoolValue("CPU", "RecompilerICache", cpu_recompiler_icache);
+  si.SetIntValue("CPU", "RecompilerCompileThreshold", cpu_recompiler_compile_threshold);
+  si.SetBoolValue("CPU", "RecompilerBackgroundCompile", cpu_recompiler_background_compile);
+  si.SetBoolValue("CPU", "RecompilerFollowJumps", cpu_recompiler_follow_jumps);
+  si.SetBoolValue("CPU", "RecompilerSuperblocks", cpu_recompiler_superblocks);
+  si.SetBoolValue("CPU", "RecompilerBlockStats", cpu_recompiler_block_stats);
+  si.SetBoolValue("CPU", "RecompilerIdleLoopSkipping", cpu_recompiler_idle_loop_skipping);
+  si.SetBoolValue("CPU", "CachedInterpreterThreaded", cpu_cached_interpreter_threaded);
+  si.SetBoolValue("CPU", "GTEUseSIMD", cpu_gte_use_simd);
   si.SetStringValue("CPU", "FastmemMode", GetCPUFastmemModeName(cpu_fastmem_mode));
 
   si.SetStringValue("GPU", "Renderer", GetRendererName(gpu_renderer));
@@ -453,6 +487,11 @@ void Settings::Save(SettingsInterface& si) const
   si.SetBoolValue("GPU", "DisableTextureCopyToSelf", gpu_disable_texture_copy_to_self);
   si.SetBoolValue("GPU", "PerSampleShading", gpu_per_sample_shading);
   si.SetBoolValue("GPU", "UseThread", gpu_use_thread);
+  si.SetIntValue("GPU", "SoftwareRasterizerThreads", gpu_sw_rasterizer_threads);
+  si.SetBoolValue("GPU", "SoftwareUseSIMD", gpu_sw_use_simd);
+  si.SetBoolValue("GPU", "SoftwareSIMDValidation", gpu_sw_simd_validation);
+  si.SetBoolValue("GPU", "BulkVRAMWrites", gpu_bulk_vram_writes);
+  si.SetBoolValue("GPU", "DirectDMACommands", gpu_direct_dma_commands);
   si.SetBoolValue("GPU", "ThreadedPresentation", gpu_threaded_presentation);
   si.SetBoolValue("GPU", "UseSoftwareRendererForReadbacks", gpu_use_software_renderer_for_readbacks);
   si.SetBoolValue("GPU", "TrueColor", gpu_true_color);
@@ -507,6 +546,8 @@ void Settings::Save(SettingsInterface& si) const
   si.SetFloatValue("Display", "OSDScale", display_osd_scale);
 
   si.SetIntValue("CDROM", "ReadaheadSectors", cdrom_readahead_sectors);
+  si.SetIntValue("CDROM", "CHDHunkCacheSize", cdrom_chd_hunk_cache_size);
+  si.SetIntValue("CDROM", "CHDPrefetchHunks", cdrom_chd_prefetch_hunks);
   si.SetStringValue("CDROM", "MechaconVersion", GetCDROMMechVersionName(cdrom_mechacon_version));
   si.SetBoolValue("CDROM", "RegionCheck", cdrom_region_check);
   si.SetBoolValue("CDROM", "LoadImageToRAM", cdrom_load_image_to_ram);
@@ -525,6 +566,8 @@ void Settings::Save(SettingsInterface& si) const
   si.SetUIntValue("Audio", "FastForwardVolume", audio_fast_forward_volume);
   si.SetBoolValue("Audio", "OutputMuted", audio_output_muted);
   si.SetBoolValue("Audio", "DumpOnBoot", audio_dump_on_boot);
+  si.SetBoolValue("Audio", "SPUUseSIMD", audio_spu_use_simd);
+  si.SetBoolValue("Audio", "SPUADPCMCache", audio_spu_adpcm_cache);
 
   si.SetBoolValue("Hacks", "UseOldMDECRoutines", use_old_mdec_routines);
   si.SetIntValue("Hacks", "DMAMaxSliceTicks", dma_max_slice_ticks);
@@ -69,6 +69,14 @@ struct Settings
   bool cpu_recompiler_memory_exceptions = false;
   bool cpu_recompiler_block_linking = true;
   bool cpu_recompiler_icache = false;
+  u16 cpu_recompiler_compile_threshold = 0;
+  bool cpu_recompiler_background_compile = false;
+  bool cpu_recompiler_follow_jumps = false;
+  bool cpu_recompiler_superblocks = false;
+  bool cpu_recompiler_block_stats = false;
+  bool cpu_recompiler_idle_loop_skipping = false;
+  bool cpu_cached_interpreter_threaded = false;
+  bool cpu_gte_use_simd = true;
   CPUFastmemMode cpu_fastmem_mode = DEFAULT_CPU_FASTMEM_MODE;
 
   float emulation_speed = 1.0f;
@@ -94,6 +102,8 @@ struct Settings
   bool rewind_enable = false;
   float rewind_save_frequency = 10.0f;
   u32 rewind_save_slots = 10;
+  u32 rewind_keyframe_interval = 10;
+  bool rewind_delta_compression = false;
   u32 runahead_frames = 0;
 
   GPURenderer gpu_renderer = DEFAULT_GPU_RENDERER;
@@ -101,6 +111,11 @@ struct Settings
   u32 gpu_resolution_scale = 1;
   u32 gpu_multisamples = 1;
   bool gpu_use_thread = true;
+  u8 gpu_sw_rasterizer_threads = 0;
+  bool gpu_sw_use_simd = true;
+  bool gpu_sw_simd_validation = false;
+  bool gpu_bulk_vram_writes = false;
+  bool gpu_direct_dma_commands = false;
   bool gpu_use_software_renderer_for_readbacks = false;
   bool gpu_threaded_presentation = true;
   bool gpu_use_debug_device = false;
@@ -160,6 +175,8 @@ struct Settings
   float gpu_pgxp_depth_clear_threshold = DEFAULT_GPU_PGXP_DEPTH_THRESHOLD / GPU_PGXP_DEPTH_THRESHOLD_SCALE;
 
   u8 cdrom_readahead_sectors = DEFAULT_CDROM_READAHEAD_SECTORS;
+  u16 cdrom_chd_hunk_cache_size = DEFAULT_CDROM_CHD_HUNK_CACHE_SIZE;
+  u8 cdrom_chd_prefetch_hunks = DEFAULT_CDROM_CHD_PREFETCH_HUNKS;
   CDROMMechaconVersion cdrom_mechacon_version = DEFAULT_CDROM_MECHACON_VERSION;
   bool cdrom_region_check = false;
   bool cdrom_load_image_to_ram = false;
@@ -178,6 +195,8 @@ struct Settings
   u32 audio_fast_forward_volume = 100;
   bool audio_output_muted = false;
   bool audio_dump_on_boot = false;
+  bool audio_spu_use_simd = false;
+  bool audio_spu_adpcm_cache = true;
 
   bool use_old_mdec_routines = false;
   bool pcdrv_enable = false;
@@ -330,6 +349,7 @@ struct Settings
     DEFAULT_DMA_HALT_TICKS = 100,
     DEFAULT_GPU_FIFO_SIZE = 16,
     DEFAULT_GPU_MAX_RUN_AHEAD = 128,
+    MAX_SW_RASTERIZER_THREADS = 16,
     DEFAULT_VRAM_WRITE_DUMP_WIDTH_THRESHOLD = 128,
     DEFAULT_VRAM_WRITE_DUMP_HEIGHT_THRESHOLD = 128,
   };
@@ -466,7 +486,13 @@ struct Settings
     DisplayExclusiveFullscreenControl::Automatic;
   static constexpr float DEFAULT_OSD_SCALE = 100.0f;
 
+  static constexpr u16 MAX_CPU_RECOMPILER_COMPILE_THRESHOLD = 1000;
+
   static constexpr u8 DEFAULT_CDROM_READAHEAD_SECTORS = 8;
+  static constexpr u16 DEFAULT_CDROM_CHD_HUNK_CACHE_SIZE = 16;
+  static constexpr u8 DEFAULT_CDROM_CHD_PREFETCH_HUNKS = 4;
+  static constexpr u16 MAX_CDROM_CHD_HUNK_CACHE_SIZE = 1024;
+  static constexpr u8 MAX_CDROM_CHD_PREFETCH_HUNKS = 64;
   static constexpr CDROMMechaconVersion DEFAULT_CDROM_MECHACON_VERSION = CDROMMechaconVersion::VC1A;
 
   static constexpr ControllerType DEFAULT_CONTROLLER_1_TYPE = ControllerType::AnalogController;
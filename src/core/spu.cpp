@@ -7,6 +7,7 @@
 #include "host.h"
 #include "imgui.h"
 #include "interrupt_controller.h"
+#include "subsystem_profiler.h"
 #include "system.h"
 
 #include "util/audio_stream.h"
@@ -14,9 +15,11 @@
 #include "util/state_wrapper.h"
 #include "util/wav_writer.h"
 
+#include "common/align.h"
 #include "common/bitfield.h"
 #include "common/bitutils.h"
 #include "common/fifo_queue.h"
+#include "common/intrin.h"
 #include "common/log.h"
 #include "common/path.h"
 
@@ -37,6 +40,142 @@ ALWAYS_INLINE static constexpr s32 ApplyVolume(s32 sample, s16 volume)
   return (sample * s32(volume)) >> 15;
 }
 
+#if (defined(CPU_ARCH_SSE) || defined(CPU_ARCH_NEON)) && !defined(SPU_DUMP_ALL_VOICES)
+#define SPU_SIMD 1
+
+// Voice mixing runs four frames of a voice at a time, one per lane, or four voices of a single frame when the frames
+// can't be mixed as a block. Thin wrappers over SSE2/NEON, as in the GTE.
+static constexpr u32 MIX_VEC_LANES = 4;
+static constexpr u32 MIX_BLOCK_FRAMES = 32;
+
+#if defined(CPU_ARCH_SSE)
+
+using MixVec = __m128i;
+
+ALWAYS_INLINE static MixVec MixVecSet(s32 v)
+{
+  return _mm_set1_epi32(v);
+}
+ALWAYS_INLINE static MixVec MixVecSet(s32 a, s32 b, s32 c, s32 d)
+{
+  return _mm_setr_epi32(a, b, c, d);
+}
+ALWAYS_INLINE static MixVec MixVecLoad(const s16* p)
+{
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(p));
+}
+ALWAYS_INLINE static MixVec MixVecLoad(const s32* p)
+{
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(p));
+}
+ALWAYS_INLINE static void MixVecStore(s32* p, MixVec v)
+{
+  _mm_store_si128(reinterpret_cast<__m128i*>(p), v);
+}
+ALWAYS_INLINE static MixVec MixVecAdd(MixVec a, MixVec b)
+{
+  return _mm_add_epi32(a, b);
+}
+ALWAYS_INLINE static MixVec MixVecAnd(MixVec a, MixVec b)
+{
+  return _mm_and_si128(a, b);
+}
+ALWAYS_INLINE static MixVec MixVecSar15(MixVec v)
+{
+  return _mm_srai_epi32(v, 15);
+}
+ALWAYS_INLINE static MixVec MixVecShr(MixVec v, u32 n)
+{
+  return _mm_srl_epi32(v, _mm_cvtsi32_si128(static_cast<int>(n)));
+}
+ALWAYS_INLINE static MixVec MixVecTestBits(MixVec v, MixVec bits)
+{
+  return _mm_cmpeq_epi32(_mm_and_si128(v, bits), bits);
+}
+ALWAYS_INLINE static MixVec MixVecMulAddPairs(MixVec a, MixVec b)
+{
+  // Lane n is a[2n] * b[2n] + a[2n + 1] * b[2n + 1] of the s16 halves. Only wraps if all four are -0x8000.
+  return _mm_madd_epi16(a, b);
+}
+ALWAYS_INLINE static MixVec MixVecMul(MixVec a, MixVec b)
+{
+  // No 32-bit multiply in SSE2. The low half of an unsigned 32x32 product is the same as the signed one.
+  const __m128i even = _mm_mul_epu32(a, b);
+  const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+ALWAYS_INLINE static s32 MixVecSum(MixVec v)
+{
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(v);
+}
+
+#elif defined(CPU_ARCH_NEON)
+
+using MixVec = int32x4_t;
+
+ALWAYS_INLINE static MixVec MixVecSet(s32 v)
+{
+  return vdupq_n_s32(v);
+}
+ALWAYS_INLINE static MixVec MixVecSet(s32 a, s32 b, s32 c, s32 d)
+{
+  const s32 values[4] = {a, b, c, d};
+  return vld1q_s32(values);
+}
+ALWAYS_INLINE static MixVec MixVecLoad(const s16* p)
+{
+  return vreinterpretq_s32_s16(vld1q_s16(p));
+}
+ALWAYS_INLINE static MixVec MixVecLoad(const s32* p)
+{
+  return vld1q_s32(p);
+}
+ALWAYS_INLINE static void MixVecStore(s32* p, MixVec v)
+{
+  vst1q_s32(p, v);
+}
+ALWAYS_INLINE static MixVec MixVecAdd(MixVec a, MixVec b)
+{
+  return vaddq_s32(a, b);
+}
+ALWAYS_INLINE static MixVec MixVecAnd(MixVec a, MixVec b)
+{
+  return vandq_s32(a, b);
+}
+ALWAYS_INLINE static MixVec MixVecSar15(MixVec v)
+{
+  return vshrq_n_s32(v, 15);
+}
+ALWAYS_INLINE static MixVec MixVecShr(MixVec v, u32 n)
+{
+  return vreinterpretq_s32_u32(vshlq_u32(vreinterpretq_u32_s32(v), vdupq_n_s32(-static_cast<s32>(n))));
+}
+ALWAYS_INLINE static MixVec MixVecTestBits(MixVec v, MixVec bits)
+{
+  return vreinterpretq_s32_u32(vceqq_s32(vandq_s32(v, bits), bits));
+}
+ALWAYS_INLINE static MixVec MixVecMulAddPairs(MixVec a, MixVec b)
+{
+  const int16x8_t a16 = vreinterpretq_s16_s32(a);
+  const int16x8_t b16 = vreinterpretq_s16_s32(b);
+  return vpaddq_s32(vmull_s16(vget_low_s16(a16), vget_low_s16(b16)), vmull_high_s16(a16, b16));
+}
+ALWAYS_INLINE static MixVec MixVecMul(MixVec a, MixVec b)
+{
+  return vmulq_s32(a, b);
+}
+ALWAYS_INLINE static s32 MixVecSum(MixVec v)
+{
+  return vaddvq_s32(v);
+}
+
+#endif
+
+#endif // SPU_SIMD
+
 namespace SPU {
 namespace {
 
@@ -53,7 +192,8 @@ enum : u32
   CAPTURE_BUFFER_SIZE_PER_CHANNEL = 0x400,
   MINIMUM_TICKS_BETWEEN_KEY_ON_OFF = 2,
   NUM_REVERB_REGS = 32,
-  FIFO_SIZE_IN_HALFWORDS = 32
+  FIFO_SIZE_IN_HALFWORDS = 32,
+  ADPCM_CACHE_SIZE = 2048
 };
 enum : s16
 {
@@ -207,6 +347,18 @@ struct ADPCMBlock
   u8 GetNibble(u32 index) const { return (data[index / 2] >> ((index % 2) * 4)) & 0x0F; }
 };
 
+// A block decoded from SPU RAM, so looping samples aren't decoded again every time they repeat. Decoding depends on
+// the previous two samples unless the filter is 0, so those are part of the key along with the address.
+struct DecodedADPCMBlock
+{
+  u16 address;
+  bool valid;
+  bool uses_last_samples;
+  ADPCMFlags flags;
+  std::array<s16, 2> last_samples;
+  std::array<s16, NUM_SAMPLES_PER_ADPCM_BLOCK> samples;
+};
+
 struct VolumeEnvelope
 {
   s32 counter;
@@ -264,6 +416,7 @@ struct Voice
   void ForceOff();
 
   void DecodeBlock(const ADPCMBlock& block);
+  void LoadDecodedBlock(const DecodedADPCMBlock& block);
   s32 Interpolate() const;
 
   // Switches to the specified phase, filling in target.
@@ -309,6 +462,43 @@ struct ReverbRegisters
     u16 rev[NUM_REVERB_REGS];
   };
 };
+
+#ifdef SPU_SIMD
+// Inputs and outputs of the vectorized voice mixer for one frame, one element per voice. Interpolation taps and
+// weights are stored in pairs, so one multiply-add covers two of them.
+struct VoiceMixState
+{
+  alignas(16) std::array<s16, NUM_VOICES * 2> taps_0_1;
+  alignas(16) std::array<s16, NUM_VOICES * 2> taps_2_3;
+  alignas(16) std::array<s16, NUM_VOICES * 2> weights_0_1;
+  alignas(16) std::array<s16, NUM_VOICES * 2> weights_2_3;
+  alignas(16) std::array<s32, NUM_VOICES> adsr_volume;
+  alignas(16) std::array<s32, NUM_VOICES> left_volume;
+  alignas(16) std::array<s32, NUM_VOICES> right_volume;
+  alignas(16) std::array<s32, NUM_VOICES> volume;
+};
+static_assert((NUM_VOICES % MIX_VEC_LANES) == 0);
+
+// Inputs and outputs of the block mixer, one element per frame. Each voice is mixed over the whole block before moving
+// on to the next, and its output is kept for pitch modulation of the next voice and the capture buffers.
+struct VoiceBlockMixState
+{
+  alignas(16) std::array<s16, MIX_BLOCK_FRAMES * 2> taps_0_1;
+  alignas(16) std::array<s16, MIX_BLOCK_FRAMES * 2> taps_2_3;
+  alignas(16) std::array<s16, MIX_BLOCK_FRAMES * 2> weights_0_1;
+  alignas(16) std::array<s16, MIX_BLOCK_FRAMES * 2> weights_2_3;
+  alignas(16) std::array<s32, MIX_BLOCK_FRAMES> adsr_volume;
+  alignas(16) std::array<s32, MIX_BLOCK_FRAMES> left_volume;
+  alignas(16) std::array<s32, MIX_BLOCK_FRAMES> right_volume;
+  alignas(16) std::array<s32, MIX_BLOCK_FRAMES> left_sum;
+  alignas(16) std::array<s32, MIX_BLOCK_FRAMES> right_sum;
+  alignas(16) std::array<s32, MIX_BLOCK_FRAMES> reverb_in_left;
+  alignas(16) std::array<s32, MIX_BLOCK_FRAMES> reverb_in_right;
+  alignas(16) std::array<std::array<s32, MIX_BLOCK_FRAMES>, NUM_VOICES> volume;
+  std::array<s16, MIX_BLOCK_FRAMES> noise_level;
+};
+static_assert((MIX_BLOCK_FRAMES % MIX_VEC_LANES) == 0);
+#endif
 } // namespace
 
 static ADSRPhase GetNextADSRPhase(ADSRPhase phase);
@@ -329,12 +519,29 @@ static void CheckForLateRAMIRQs();
 static void WriteToCaptureBuffer(u32 index, s16 value);
 static void IncrementCaptureBufferPosition();
 
+static void CheckADPCMBlockIRQ(u32 ram_address);
 static void ReadADPCMBlock(u16 address, ADPCMBlock* block);
+static u32 GetADPCMCacheIndex(u16 address);
+static void InvalidateADPCMCache(u32 ram_address);
+static void ClearADPCMCache();
+static void ReadVoiceBlock(u32 voice_index);
+static void AdvanceVoice(u32 voice_index);
 static std::tuple<s32, s32> SampleVoice(u32 voice_index);
+static void MixVoices(s32* left_sum, s32* right_sum, s32* reverb_in_left, s32* reverb_in_right);
+#ifdef SPU_SIMD
+static void GatherInterpolationInputs(const Voice& voice, bool noise, s16 noise_level, s16* taps_0_1, s16* taps_2_3,
+                                      s16* weights_0_1, s16* weights_2_3);
+static void MixVoicesSIMD(s32* left_sum, s32* right_sum, s32* reverb_in_left, s32* reverb_in_right);
+static bool CanMixVoiceBlock(u32 frames);
+static void MixVoiceBlock(u32 frames);
+#endif
+static void MixFrame(s16* output_frame, s32 left_sum, s32 right_sum, s32 reverb_in_left, s32 reverb_in_right,
+                     s32 capture_voice_1, s32 capture_voice_3);
 
 static void UpdateNoise();
 
 static u32 ReverbMemoryAddress(u32 address);
+static u32 ReverbMemoryAddress(u32 current_address, u32 address);
 static s16 ReverbRead(u32 address, s32 offset = 0);
 static void ReverbWrite(u32 address, s16 data);
 static void ProcessReverb(s16 left_in, s16 right_in, s32* left_out, s32* right_out);
@@ -401,6 +608,14 @@ static std::array<std::array<s16, 64>, 2> s_reverb_upsample_buffer;
 static s32 s_reverb_resample_buffer_position = 0;
 
 static std::array<Voice, NUM_VOICES> s_voices{};
+#ifdef SPU_SIMD
+static VoiceMixState s_voice_mix_state{};
+static VoiceBlockMixState s_voice_block_mix_state{};
+#endif
+
+static std::array<DecodedADPCMBlock, ADPCM_CACHE_SIZE> s_adpcm_cache{};
+static u64 s_adpcm_cache_hits = 0;
+static u64 s_adpcm_cache_misses = 0;
 
 static InlineFIFOQueue<u16, FIFO_SIZE_IN_HALFWORDS> s_transfer_fifo;
 
@@ -526,10 +741,13 @@ void SPU::Reset()
   s_transfer_fifo.Clear();
   s_transfer_event->Deactivate();
   s_ram.fill(0);
+  ClearADPCMCache();
+  s_adpcm_cache_hits = 0;
+  s_adpcm_cache_misses = 0;
   UpdateEventInterval();
 }
 
-bool SPU::DoState(StateWrapper& sw)
+bool SPU::DoState(StateWrapper& sw, bool include_ram)
 {
   sw.Do(&s_ticks_carry);
   sw.Do(&s_SPUCNT.bits);
@@ -588,10 +806,12 @@ bool SPU::DoState(StateWrapper& sw)
   }
 
   sw.Do(&s_transfer_fifo);
-  sw.DoBytes(s_ram.data(), RAM_SIZE);
+  if (include_ram)
+    sw.DoBytes(s_ram.data(), RAM_SIZE);
 
   if (sw.IsReading())
   {
+    ClearADPCMCache();
     UpdateEventInterval();
     UpdateTransferEvent();
   }
@@ -1190,6 +1410,7 @@ void SPU::WriteToCaptureBuffer(u32 index, s16 value)
   const u32 ram_address = (index * CAPTURE_BUFFER_SIZE_PER_CHANNEL) | ZeroExtend16(s_capture_buffer_position);
   // Log_DebugPrintf("write to capture buffer %u (0x%08X) <- 0x%04X", index, ram_address, u16(value));
   std::memcpy(&s_ram[ram_address], &value, sizeof(value));
+  InvalidateADPCMCache(ram_address);
   if (IsRAMIRQTriggerable() && CheckRAMIRQ(ram_address))
   {
     Log_DebugPrintf("Trigger IRQ @ %08X %04X from capture buffer", ram_address, ram_address / 8);
@@ -1228,6 +1449,7 @@ ALWAYS_INLINE_RELEASE void SPU::ExecuteFIFOWriteToRAM(TickCount& ticks)
   {
     u16 value = s_transfer_fifo.Pop();
     std::memcpy(&s_ram[s_transfer_address], &value, sizeof(u16));
+    InvalidateADPCMCache(s_transfer_address);
     s_transfer_address = (s_transfer_address + sizeof(u16)) & RAM_MASK;
     ticks -= TRANSFER_TICKS_PER_HALFWORD;
 
@@ -1303,6 +1525,7 @@ void SPU::ManualTransferWrite(u16 value)
   }
 
   std::memcpy(&s_ram[s_transfer_address], &value, sizeof(u16));
+  InvalidateADPCMCache(s_transfer_address);
   s_transfer_address = (s_transfer_address + sizeof(u16)) & RAM_MASK;
 
   if (IsRAMIRQTriggerable() && CheckRAMIRQ(s_transfer_address))
@@ -1536,6 +1759,8 @@ const std::array<u8, SPU::RAM_SIZE>& SPU::GetRAM()
 
 std::array<u8, SPU::RAM_SIZE>& SPU::GetWritableRAM()
 {
+  // Writes through this aren't tracked, so drop all decoded blocks.
+  ClearADPCMCache();
   return s_ram;
 }
 
@@ -1815,93 +2040,112 @@ void SPU::Voice::DecodeBlock(const ADPCMBlock& block)
   current_block_flags.bits = block.flags.bits;
 }
 
-s32 SPU::Voice::Interpolate() const
+void SPU::Voice::LoadDecodedBlock(const DecodedADPCMBlock& block)
 {
-  static constexpr std::array<s16, 0x200> gauss = {{
-    -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, //
-    -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, //
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0001, //
-    0x0001, 0x0001, 0x0001, 0x0002, 0x0002, 0x0002, 0x0003, 0x0003, //
-    0x0003, 0x0004, 0x0004, 0x0005, 0x0005, 0x0006, 0x0007, 0x0007, //
-    0x0008, 0x0009, 0x0009, 0x000A, 0x000B, 0x000C, 0x000D, 0x000E, //
-    0x000F, 0x0010, 0x0011, 0x0012, 0x0013, 0x0015, 0x0016, 0x0018, // entry
-    0x0019, 0x001B, 0x001C, 0x001E, 0x0020, 0x0021, 0x0023, 0x0025, // 000..07F
-    0x0027, 0x0029, 0x002C, 0x002E, 0x0030, 0x0033, 0x0035, 0x0038, //
-    0x003A, 0x003D, 0x0040, 0x0043, 0x0046, 0x0049, 0x004D, 0x0050, //
-    0x0054, 0x0057, 0x005B, 0x005F, 0x0063, 0x0067, 0x006B, 0x006F, //
-    0x0074, 0x0078, 0x007D, 0x0082, 0x0087, 0x008C, 0x0091, 0x0096, //
-    0x009C, 0x00A1, 0x00A7, 0x00AD, 0x00B3, 0x00BA, 0x00C0, 0x00C7, //
-    0x00CD, 0x00D4, 0x00DB, 0x00E3, 0x00EA, 0x00F2, 0x00FA, 0x0101, //
-    0x010A, 0x0112, 0x011B, 0x0123, 0x012C, 0x0135, 0x013F, 0x0148, //
-    0x0152, 0x015C, 0x0166, 0x0171, 0x017B, 0x0186, 0x0191, 0x019C, //
-    0x01A8, 0x01B4, 0x01C0, 0x01CC, 0x01D9, 0x01E5, 0x01F2, 0x0200, //
-    0x020D, 0x021B, 0x0229, 0x0237, 0x0246, 0x0255, 0x0264, 0x0273, //
-    0x0283, 0x0293, 0x02A3, 0x02B4, 0x02C4, 0x02D6, 0x02E7, 0x02F9, //
-    0x030B, 0x031D, 0x0330, 0x0343, 0x0356, 0x036A, 0x037E, 0x0392, //
-    0x03A7, 0x03BC, 0x03D1, 0x03E7, 0x03FC, 0x0413, 0x042A, 0x0441, //
-    0x0458, 0x0470, 0x0488, 0x04A0, 0x04B9, 0x04D2, 0x04EC, 0x0506, //
-    0x0520, 0x053B, 0x0556, 0x0572, 0x058E, 0x05AA, 0x05C7, 0x05E4, // entry
-    0x0601, 0x061F, 0x063E, 0x065C, 0x067C, 0x069B, 0x06BB, 0x06DC, // 080..0FF
-    0x06FD, 0x071E, 0x0740, 0x0762, 0x0784, 0x07A7, 0x07CB, 0x07EF, //
-    0x0813, 0x0838, 0x085D, 0x0883, 0x08A9, 0x08D0, 0x08F7, 0x091E, //
-    0x0946, 0x096F, 0x0998, 0x09C1, 0x09EB, 0x0A16, 0x0A40, 0x0A6C, //
-    0x0A98, 0x0AC4, 0x0AF1, 0x0B1E, 0x0B4C, 0x0B7A, 0x0BA9, 0x0BD8, //
-    0x0C07, 0x0C38, 0x0C68, 0x0C99, 0x0CCB, 0x0CFD, 0x0D30, 0x0D63, //
-    0x0D97, 0x0DCB, 0x0E00, 0x0E35, 0x0E6B, 0x0EA1, 0x0ED7, 0x0F0F, //
-    0x0F46, 0x0F7F, 0x0FB7, 0x0FF1, 0x102A, 0x1065, 0x109F, 0x10DB, //
-    0x1116, 0x1153, 0x118F, 0x11CD, 0x120B, 0x1249, 0x1288, 0x12C7, //
-    0x1307, 0x1347, 0x1388, 0x13C9, 0x140B, 0x144D, 0x1490, 0x14D4, //
-    0x1517, 0x155C, 0x15A0, 0x15E6, 0x162C, 0x1672, 0x16B9, 0x1700, //
-    0x1747, 0x1790, 0x17D8, 0x1821, 0x186B, 0x18B5, 0x1900, 0x194B, //
-    0x1996, 0x19E2, 0x1A2E, 0x1A7B, 0x1AC8, 0x1B16, 0x1B64, 0x1BB3, //
-    0x1C02, 0x1C51, 0x1CA1, 0x1CF1, 0x1D42, 0x1D93, 0x1DE5, 0x1E37, //
-    0x1E89, 0x1EDC, 0x1F2F, 0x1F82, 0x1FD6, 0x202A, 0x207F, 0x20D4, //
-    0x2129, 0x217F, 0x21D5, 0x222C, 0x2282, 0x22DA, 0x2331, 0x2389, // entry
-    0x23E1, 0x2439, 0x2492, 0x24EB, 0x2545, 0x259E, 0x25F8, 0x2653, // 100..17F
-    0x26AD, 0x2708, 0x2763, 0x27BE, 0x281A, 0x2876, 0x28D2, 0x292E, //
-    0x298B, 0x29E7, 0x2A44, 0x2AA1, 0x2AFF, 0x2B5C, 0x2BBA, 0x2C18, //
-    0x2C76, 0x2CD4, 0x2D33, 0x2D91, 0x2DF0, 0x2E4F, 0x2EAE, 0x2F0D, //
-    0x2F6C, 0x2FCC, 0x302B, 0x308B, 0x30EA, 0x314A, 0x31AA, 0x3209, //
-    0x3269, 0x32C9, 0x3329, 0x3389, 0x33E9, 0x3449, 0x34A9, 0x3509, //
-    0x3569, 0x35C9, 0x3629, 0x3689, 0x36E8, 0x3748, 0x37A8, 0x3807, //
-    0x3867, 0x38C6, 0x3926, 0x3985, 0x39E4, 0x3A43, 0x3AA2, 0x3B00, //
-    0x3B5F, 0x3BBD, 0x3C1B, 0x3C79, 0x3CD7, 0x3D35, 0x3D92, 0x3DEF, //
-    0x3E4C, 0x3EA9, 0x3F05, 0x3F62, 0x3FBD, 0x4019, 0x4074, 0x40D0, //
-    0x412A, 0x4185, 0x41DF, 0x4239, 0x4292, 0x42EB, 0x4344, 0x439C, //
-    0x43F4, 0x444C, 0x44A3, 0x44FA, 0x4550, 0x45A6, 0x45FC, 0x4651, //
-    0x46A6, 0x46FA, 0x474E, 0x47A1, 0x47F4, 0x4846, 0x4898, 0x48E9, //
-    0x493A, 0x498A, 0x49D9, 0x4A29, 0x4A77, 0x4AC5, 0x4B13, 0x4B5F, //
-    0x4BAC, 0x4BF7, 0x4C42, 0x4C8D, 0x4CD7, 0x4D20, 0x4D68, 0x4DB0, //
-    0x4DF7, 0x4E3E, 0x4E84, 0x4EC9, 0x4F0E, 0x4F52, 0x4F95, 0x4FD7, // entry
-    0x5019, 0x505A, 0x509A, 0x50DA, 0x5118, 0x5156, 0x5194, 0x51D0, // 180..1FF
-    0x520C, 0x5247, 0x5281, 0x52BA, 0x52F3, 0x532A, 0x5361, 0x5397, //
-    0x53CC, 0x5401, 0x5434, 0x5467, 0x5499, 0x54CA, 0x54FA, 0x5529, //
-    0x5558, 0x5585, 0x55B2, 0x55DE, 0x5609, 0x5632, 0x565B, 0x5684, //
-    0x56AB, 0x56D1, 0x56F6, 0x571B, 0x573E, 0x5761, 0x5782, 0x57A3, //
-    0x57C3, 0x57E2, 0x57FF, 0x581C, 0x5838, 0x5853, 0x586D, 0x5886, //
-    0x589E, 0x58B5, 0x58CB, 0x58E0, 0x58F4, 0x5907, 0x5919, 0x592A, //
-    0x593A, 0x5949, 0x5958, 0x5965, 0x5971, 0x597C, 0x5986, 0x598F, //
-    0x5997, 0x599E, 0x59A4, 0x59A9, 0x59AD, 0x59B0, 0x59B2, 0x59B3  //
-  }};
+  // same as DecodeBlock(), from the cached samples
+  current_block_samples[2] = current_block_samples[NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + NUM_SAMPLES_PER_ADPCM_BLOCK - 1];
+  current_block_samples[1] = current_block_samples[NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + NUM_SAMPLES_PER_ADPCM_BLOCK - 2];
+  current_block_samples[0] = current_block_samples[NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + NUM_SAMPLES_PER_ADPCM_BLOCK - 3];
+  std::copy(block.samples.begin(), block.samples.end(),
+            current_block_samples.begin() + NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK);
+
+  adpcm_last_samples[0] = block.samples[NUM_SAMPLES_PER_ADPCM_BLOCK - 1];
+  adpcm_last_samples[1] = block.samples[NUM_SAMPLES_PER_ADPCM_BLOCK - 2];
+  current_block_flags.bits = block.flags.bits;
+}
+
+static constexpr std::array<s16, 0x200> s_gauss_table = {{
+  -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, //
+  -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, //
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0001, //
+  0x0001, 0x0001, 0x0001, 0x0002, 0x0002, 0x0002, 0x0003, 0x0003, //
+  0x0003, 0x0004, 0x0004, 0x0005, 0x0005, 0x0006, 0x0007, 0x0007, //
+  0x0008, 0x0009, 0x0009, 0x000A, 0x000B, 0x000C, 0x000D, 0x000E, //
+  0x000F, 0x0010, 0x0011, 0x0012, 0x0013, 0x0015, 0x0016, 0x0018, // entry
+  0x0019, 0x001B, 0x001C, 0x001E, 0x0020, 0x0021, 0x0023, 0x0025, // 000..07F
+  0x0027, 0x0029, 0x002C, 0x002E, 0x0030, 0x0033, 0x0035, 0x0038, //
+  0x003A, 0x003D, 0x0040, 0x0043, 0x0046, 0x0049, 0x004D, 0x0050, //
+  0x0054, 0x0057, 0x005B, 0x005F, 0x0063, 0x0067, 0x006B, 0x006F, //
+  0x0074, 0x0078, 0x007D, 0x0082, 0x0087, 0x008C, 0x0091, 0x0096, //
+  0x009C, 0x00A1, 0x00A7, 0x00AD, 0x00B3, 0x00BA, 0x00C0, 0x00C7, //
+  0x00CD, 0x00D4, 0x00DB, 0x00E3, 0x00EA, 0x00F2, 0x00FA, 0x0101, //
+  0x010A, 0x0112, 0x011B, 0x0123, 0x012C, 0x0135, 0x013F, 0x0148, //
+  0x0152, 0x015C, 0x0166, 0x0171, 0x017B, 0x0186, 0x0191, 0x019C, //
+  0x01A8, 0x01B4, 0x01C0, 0x01CC, 0x01D9, 0x01E5, 0x01F2, 0x0200, //
+  0x020D, 0x021B, 0x0229, 0x0237, 0x0246, 0x0255, 0x0264, 0x0273, //
+  0x0283, 0x0293, 0x02A3, 0x02B4, 0x02C4, 0x02D6, 0x02E7, 0x02F9, //
+  0x030B, 0x031D, 0x0330, 0x0343, 0x0356, 0x036A, 0x037E, 0x0392, //
+  0x03A7, 0x03BC, 0x03D1, 0x03E7, 0x03FC, 0x0413, 0x042A, 0x0441, //
+  0x0458, 0x0470, 0x0488, 0x04A0, 0x04B9, 0x04D2, 0x04EC, 0x0506, //
+  0x0520, 0x053B, 0x0556, 0x0572, 0x058E, 0x05AA, 0x05C7, 0x05E4, // entry
+  0x0601, 0x061F, 0x063E, 0x065C, 0x067C, 0x069B, 0x06BB, 0x06DC, // 080..0FF
+  0x06FD, 0x071E, 0x0740, 0x0762, 0x0784, 0x07A7, 0x07CB, 0x07EF, //
+  0x0813, 0x0838, 0x085D, 0x0883, 0x08A9, 0x08D0, 0x08F7, 0x091E, //
+  0x0946, 0x096F, 0x0998, 0x09C1, 0x09EB, 0x0A16, 0x0A40, 0x0A6C, //
+  0x0A98, 0x0AC4, 0x0AF1, 0x0B1E, 0x0B4C, 0x0B7A, 0x0BA9, 0x0BD8, //
+  0x0C07, 0x0C38, 0x0C68, 0x0C99, 0x0CCB, 0x0CFD, 0x0D30, 0x0D63, //
+  0x0D97, 0x0DCB, 0x0E00, 0x0E35, 0x0E6B, 0x0EA1, 0x0ED7, 0x0F0F, //
+  0x0F46, 0x0F7F, 0x0FB7, 0x0FF1, 0x102A, 0x1065, 0x109F, 0x10DB, //
+  0x1116, 0x1153, 0x118F, 0x11CD, 0x120B, 0x1249, 0x1288, 0x12C7, //
+  0x1307, 0x1347, 0x1388, 0x13C9, 0x140B, 0x144D, 0x1490, 0x14D4, //
+  0x1517, 0x155C, 0x15A0, 0x15E6, 0x162C, 0x1672, 0x16B9, 0x1700, //
+  0x1747, 0x1790, 0x17D8, 0x1821, 0x186B, 0x18B5, 0x1900, 0x194B, //
+  0x1996, 0x19E2, 0x1A2E, 0x1A7B, 0x1AC8, 0x1B16, 0x1B64, 0x1BB3, //
+  0x1C02, 0x1C51, 0x1CA1, 0x1CF1, 0x1D42, 0x1D93, 0x1DE5, 0x1E37, //
+  0x1E89, 0x1EDC, 0x1F2F, 0x1F82, 0x1FD6, 0x202A, 0x207F, 0x20D4, //
+  0x2129, 0x217F, 0x21D5, 0x222C, 0x2282, 0x22DA, 0x2331, 0x2389, // entry
+  0x23E1, 0x2439, 0x2492, 0x24EB, 0x2545, 0x259E, 0x25F8, 0x2653, // 100..17F
+  0x26AD, 0x2708, 0x2763, 0x27BE, 0x281A, 0x2876, 0x28D2, 0x292E, //
+  0x298B, 0x29E7, 0x2A44, 0x2AA1, 0x2AFF, 0x2B5C, 0x2BBA, 0x2C18, //
+  0x2C76, 0x2CD4, 0x2D33, 0x2D91, 0x2DF0, 0x2E4F, 0x2EAE, 0x2F0D, //
+  0x2F6C, 0x2FCC, 0x302B, 0x308B, 0x30EA, 0x314A, 0x31AA, 0x3209, //
+  0x3269, 0x32C9, 0x3329, 0x3389, 0x33E9, 0x3449, 0x34A9, 0x3509, //
+  0x3569, 0x35C9, 0x3629, 0x3689, 0x36E8, 0x3748, 0x37A8, 0x3807, //
+  0x3867, 0x38C6, 0x3926, 0x3985, 0x39E4, 0x3A43, 0x3AA2, 0x3B00, //
+  0x3B5F, 0x3BBD, 0x3C1B, 0x3C79, 0x3CD7, 0x3D35, 0x3D92, 0x3DEF, //
+  0x3E4C, 0x3EA9, 0x3F05, 0x3F62, 0x3FBD, 0x4019, 0x4074, 0x40D0, //
+  0x412A, 0x4185, 0x41DF, 0x4239, 0x4292, 0x42EB, 0x4344, 0x439C, //
+  0x43F4, 0x444C, 0x44A3, 0x44FA, 0x4550, 0x45A6, 0x45FC, 0x4651, //
+  0x46A6, 0x46FA, 0x474E, 0x47A1, 0x47F4, 0x4846, 0x4898, 0x48E9, //
+  0x493A, 0x498A, 0x49D9, 0x4A29, 0x4A77, 0x4AC5, 0x4B13, 0x4B5F, //
+  0x4BAC, 0x4BF7, 0x4C42, 0x4C8D, 0x4CD7, 0x4D20, 0x4D68, 0x4DB0, //
+  0x4DF7, 0x4E3E, 0x4E84, 0x4EC9, 0x4F0E, 0x4F52, 0x4F95, 0x4FD7, // entry
+  0x5019, 0x505A, 0x509A, 0x50DA, 0x5118, 0x5156, 0x5194, 0x51D0, // 180..1FF
+  0x520C, 0x5247, 0x5281, 0x52BA, 0x52F3, 0x532A, 0x5361, 0x5397, //
+  0x53CC, 0x5401, 0x5434, 0x5467, 0x5499, 0x54CA, 0x54FA, 0x5529, //
+  0x5558, 0x5585, 0x55B2, 0x55DE, 0x5609, 0x5632, 0x565B, 0x5684, //
+  0x56AB, 0x56D1, 0x56F6, 0x571B, 0x573E, 0x5761, 0x5782, 0x57A3, //
+  0x57C3, 0x57E2, 0x57FF, 0x581C, 0x5838, 0x5853, 0x586D, 0x5886, //
+  0x589E, 0x58B5, 0x58CB, 0x58E0, 0x58F4, 0x5907, 0x5919, 0x592A, //
+  0x593A, 0x5949, 0x5958, 0x5965, 0x5971, 0x597C, 0x5986, 0x598F, //
+  0x5997, 0x599E, 0x59A4, 0x59A9, 0x59AD, 0x59B0, 0x59B2, 0x59B3  //
+}};
 
+s32 SPU::Voice::Interpolate() const
+{
   const u8 i = counter.interpolation_index;
   const u32 s = NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + ZeroExtend32(counter.sample_index.GetValue());
 
-  s32 out = s32(gauss[0x0FF - i]) * s32(current_block_samples[s - 3]);
-  out += s32(gauss[0x1FF - i]) * s32(current_block_samples[s - 2]);
-  out += s32(gauss[0x100 + i]) * s32(current_block_samples[s - 1]);
-  out += s32(gauss[0x000 + i]) * s32(current_block_samples[s - 0]);
+  s32 out = s32(s_gauss_table[0x0FF - i]) * s32(current_block_samples[s - 3]);
+  out += s32(s_gauss_table[0x1FF - i]) * s32(current_block_samples[s - 2]);
+  out += s32(s_gauss_table[0x100 + i]) * s32(current_block_samples[s - 1]);
+  out += s32(s_gauss_table[0x000 + i]) * s32(current_block_samples[s - 0]);
   return out >> 15;
 }
 
-void SPU::ReadADPCMBlock(u16 address, ADPCMBlock* block)
+void SPU::CheckADPCMBlockIRQ(u32 ram_address)
 {
-  u32 ram_address = (ZeroExtend32(address) * 8) & RAM_MASK;
   if (IsRAMIRQTriggerable() && (CheckRAMIRQ(ram_address) || CheckRAMIRQ((ram_address + 8) & RAM_MASK)))
   {
     Log_DebugPrintf("Trigger IRQ @ %08X %04X from ADPCM reader", ram_address, ram_address / 8);
     TriggerRAMIRQ();
   }
+}
+
+void SPU::ReadADPCMBlock(u16 address, ADPCMBlock* block)
+{
+  u32 ram_address = (ZeroExtend32(address) * 8) & RAM_MASK;
+  CheckADPCMBlockIRQ(ram_address);
 
   // fast path - no wrap-around
   if ((ram_address + sizeof(ADPCMBlock)) <= RAM_SIZE)
@@ -1921,58 +2165,82 @@ void SPU::ReadADPCMBlock(u16 address, ADPCMBlock* block)
   }
 }
 
-ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
+ALWAYS_INLINE u32 SPU::GetADPCMCacheIndex(u16 address)
+{
+  // Blocks are usually 16-byte aligned, i.e. at even addresses.
+  return (ZeroExtend32(address) >> 1) & (ADPCM_CACHE_SIZE - 1);
+}
+
+ALWAYS_INLINE_RELEASE void SPU::InvalidateADPCMCache(u32 ram_address)
+{
+  // Blocks are 16 bytes at 8-byte granularity, so a halfword write can be in the block starting in the same 8 bytes,
+  // or the one starting 8 bytes before.
+  const u16 address = Truncate16(ram_address / 8);
+  const u16 previous_address = address - 1;
+
+  DecodedADPCMBlock& entry = s_adpcm_cache[GetADPCMCacheIndex(address)];
+  if (entry.address == address)
+    entry.valid = false;
+
+  DecodedADPCMBlock& previous_entry = s_adpcm_cache[GetADPCMCacheIndex(previous_address)];
+  if (previous_entry.address == previous_address)
+    previous_entry.valid = false;
+}
+
+void SPU::ClearADPCMCache()
+{
+  for (DecodedADPCMBlock& entry : s_adpcm_cache)
+    entry.valid = false;
+}
+
+void SPU::ReadVoiceBlock(u32 voice_index)
 {
   Voice& voice = s_voices[voice_index];
-  if (!voice.IsOn() && !s_SPUCNT.irq9_enable)
+  if (g_settings.audio_spu_adpcm_cache)
   {
-    voice.last_volume = 0;
-
-#ifdef SPU_DUMP_ALL_VOICES
-    if (s_voice_dump_writers[voice_index])
+    DecodedADPCMBlock& entry = s_adpcm_cache[GetADPCMCacheIndex(voice.current_address)];
+    if (entry.valid && entry.address == voice.current_address &&
+        (!entry.uses_last_samples || entry.last_samples == voice.adpcm_last_samples))
     {
-      const s16 dump_samples[2] = {0, 0};
-      s_voice_dump_writers[voice_index]->WriteFrames(dump_samples, 1);
+      CheckADPCMBlockIRQ((ZeroExtend32(voice.current_address) * 8) & RAM_MASK);
+      voice.LoadDecodedBlock(entry);
+      s_adpcm_cache_hits++;
+    }
+    else
+    {
+      ADPCMBlock block;
+      ReadADPCMBlock(voice.current_address, &block);
+      entry.address = voice.current_address;
+      entry.valid = true;
+      entry.uses_last_samples = (block.GetFilter() != 0);
+      entry.last_samples = voice.adpcm_last_samples;
+
+      voice.DecodeBlock(block);
+      entry.flags.bits = voice.current_block_flags.bits;
+      std::copy_n(&voice.current_block_samples[NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK], NUM_SAMPLES_PER_ADPCM_BLOCK,
+                  entry.samples.begin());
+      s_adpcm_cache_misses++;
     }
-#endif
-
-    return {};
   }
-
-  if (!voice.has_samples)
+  else
   {
     ADPCMBlock block;
     ReadADPCMBlock(voice.current_address, &block);
     voice.DecodeBlock(block);
-    voice.has_samples = true;
-
-    if (voice.current_block_flags.loop_start && !voice.ignore_loop_address)
-    {
-      Log_TracePrintf("Voice %u loop start @ 0x%08X", voice_index, ZeroExtend32(voice.current_address));
-      voice.regs.adpcm_repeat_address = voice.current_address;
-    }
   }
 
-  // skip interpolation when the volume is muted anyway
-  s32 volume;
-  if (voice.regs.adsr_volume != 0)
-  {
-    // interpolate/sample and apply ADSR volume
-    s32 sample;
-    if (IsVoiceNoiseEnabled(voice_index))
-      sample = GetVoiceNoiseLevel();
-    else
-      sample = voice.Interpolate();
+  voice.has_samples = true;
 
-    volume = ApplyVolume(sample, voice.regs.adsr_volume);
-  }
-  else
+  if (voice.current_block_flags.loop_start && !voice.ignore_loop_address)
   {
-    volume = 0;
+    Log_TracePrintf("Voice %u loop start @ 0x%08X", voice_index, ZeroExtend32(voice.current_address));
+    voice.regs.adpcm_repeat_address = voice.current_address;
   }
+}
 
-  voice.last_volume = volume;
-
+ALWAYS_INLINE_RELEASE void SPU::AdvanceVoice(u32 voice_index)
+{
+  Voice& voice = s_voices[voice_index];
   if (voice.adsr_phase != ADSRPhase::Off)
     voice.TickADSR();
 
@@ -2016,6 +2284,49 @@ ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
       }
     }
   }
+}
+
+ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
+{
+  Voice& voice = s_voices[voice_index];
+  if (!voice.IsOn() && !s_SPUCNT.irq9_enable)
+  {
+    voice.last_volume = 0;
+
+#ifdef SPU_DUMP_ALL_VOICES
+    if (s_voice_dump_writers[voice_index])
+    {
+      const s16 dump_samples[2] = {0, 0};
+      s_voice_dump_writers[voice_index]->WriteFrames(dump_samples, 1);
+    }
+#endif
+
+    return {};
+  }
+
+  if (!voice.has_samples)
+    ReadVoiceBlock(voice_index);
+
+  // skip interpolation when the volume is muted anyway
+  s32 volume;
+  if (voice.regs.adsr_volume != 0)
+  {
+    // interpolate/sample and apply ADSR volume
+    s32 sample;
+    if (IsVoiceNoiseEnabled(voice_index))
+      sample = GetVoiceNoiseLevel();
+    else
+      sample = voice.Interpolate();
+
+    volume = ApplyVolume(sample, voice.regs.adsr_volume);
+  }
+  else
+  {
+    volume = 0;
+  }
+
+  voice.last_volume = volume;
+  AdvanceVoice(voice_index);
 
   // apply per-channel volume
   const s32 left = ApplyVolume(volume, voice.left_volume.current_level);
@@ -2034,6 +2345,285 @@ ALWAYS_INLINE_RELEASE std::tuple<s32, s32> SPU::SampleVoice(u32 voice_index)
   return std::make_tuple(left, right);
 }
 
+ALWAYS_INLINE_RELEASE void SPU::MixVoices(s32* left_sum, s32* right_sum, s32* reverb_in_left, s32* reverb_in_right)
+{
+  u32 reverb_on_register = s_reverb_on_register;
+
+  for (u32 voice = 0; voice < NUM_VOICES; voice++)
+  {
+    const auto [left, right] = SampleVoice(voice);
+    *left_sum += left;
+    *right_sum += right;
+
+    if (reverb_on_register & 1u)
+    {
+      *reverb_in_left += left;
+      *reverb_in_right += right;
+    }
+    reverb_on_register >>= 1;
+  }
+}
+
+#ifdef SPU_SIMD
+
+ALWAYS_INLINE_RELEASE void SPU::GatherInterpolationInputs(const Voice& voice, bool noise, s16 noise_level,
+                                                          s16* taps_0_1, s16* taps_2_3, s16* weights_0_1,
+                                                          s16* weights_2_3)
+{
+  if (noise)
+  {
+    // (noise * 0x4000) * 2 >> 15 is the noise level, so it goes through interpolation unchanged.
+    taps_0_1[0] = noise_level;
+    taps_0_1[1] = noise_level;
+    weights_0_1[0] = 0x4000;
+    weights_0_1[1] = 0x4000;
+    taps_2_3[0] = 0;
+    taps_2_3[1] = 0;
+  }
+  else
+  {
+    const u8 i = voice.counter.interpolation_index;
+    const u32 s = NUM_SAMPLES_FROM_LAST_ADPCM_BLOCK + ZeroExtend32(voice.counter.sample_index.GetValue());
+    taps_0_1[0] = voice.current_block_samples[s - 3];
+    taps_0_1[1] = voice.current_block_samples[s - 2];
+    taps_2_3[0] = voice.current_block_samples[s - 1];
+    taps_2_3[1] = voice.current_block_samples[s - 0];
+    weights_0_1[0] = s_gauss_table[0x0FF - i];
+    weights_0_1[1] = s_gauss_table[0x1FF - i];
+    weights_2_3[0] = s_gauss_table[0x100 + i];
+    weights_2_3[1] = s_gauss_table[0x000 + i];
+  }
+}
+
+ALWAYS_INLINE_RELEASE void SPU::MixVoicesSIMD(s32* left_sum, s32* right_sum, s32* reverb_in_left,
+                                              s32* reverb_in_right)
+{
+  VoiceMixState& ms = s_voice_mix_state;
+
+  // Gather the inputs for interpolation and volume. Decoding stays scalar, it branches per voice.
+  u32 active_voices = 0;
+  for (u32 voice_index = 0; voice_index < NUM_VOICES; voice_index++)
+  {
+    Voice& voice = s_voices[voice_index];
+    if (!voice.IsOn() && !s_SPUCNT.irq9_enable)
+    {
+      // Zero volume gives zero output and last_volume, whatever the stale taps are.
+      ms.adsr_volume[voice_index] = 0;
+      continue;
+    }
+
+    active_voices |= (1u << voice_index);
+    if (!voice.has_samples)
+      ReadVoiceBlock(voice_index);
+
+    const u32 pair = voice_index * 2;
+    GatherInterpolationInputs(voice, IsVoiceNoiseEnabled(voice_index), GetVoiceNoiseLevel(), &ms.taps_0_1[pair],
+                              &ms.taps_2_3[pair], &ms.weights_0_1[pair], &ms.weights_2_3[pair]);
+    ms.adsr_volume[voice_index] = voice.regs.adsr_volume;
+    ms.left_volume[voice_index] = voice.left_volume.current_level;
+    ms.right_volume[voice_index] = voice.right_volume.current_level;
+  }
+
+  // Interpolate, apply ADSR and channel volume, and sum, four voices at a time.
+  const MixVec reverb_on = MixVecSet(static_cast<s32>(s_reverb_on_register));
+  const MixVec lane_bits = MixVecSet(1, 2, 4, 8);
+  MixVec left_acc = MixVecSet(0);
+  MixVec right_acc = MixVecSet(0);
+  MixVec reverb_left_acc = MixVecSet(0);
+  MixVec reverb_right_acc = MixVecSet(0);
+  for (u32 voice_index = 0; voice_index < NUM_VOICES; voice_index += MIX_VEC_LANES)
+  {
+    const u32 pair = voice_index * 2;
+    const MixVec sample = MixVecSar15(
+      MixVecAdd(MixVecMulAddPairs(MixVecLoad(&ms.taps_0_1[pair]), MixVecLoad(&ms.weights_0_1[pair])),
+                MixVecMulAddPairs(MixVecLoad(&ms.taps_2_3[pair]), MixVecLoad(&ms.weights_2_3[pair]))));
+    const MixVec volume = MixVecSar15(MixVecMul(sample, MixVecLoad(&ms.adsr_volume[voice_index])));
+    MixVecStore(&ms.volume[voice_index], volume);
+
+    const MixVec left = MixVecSar15(MixVecMul(volume, MixVecLoad(&ms.left_volume[voice_index])));
+    const MixVec right = MixVecSar15(MixVecMul(volume, MixVecLoad(&ms.right_volume[voice_index])));
+    const MixVec reverb_mask = MixVecTestBits(MixVecShr(reverb_on, voice_index), lane_bits);
+    left_acc = MixVecAdd(left_acc, left);
+    right_acc = MixVecAdd(right_acc, right);
+    reverb_left_acc = MixVecAdd(reverb_left_acc, MixVecAnd(left, reverb_mask));
+    reverb_right_acc = MixVecAdd(reverb_right_acc, MixVecAnd(right, reverb_mask));
+  }
+
+  *left_sum += MixVecSum(left_acc);
+  *right_sum += MixVecSum(right_acc);
+  *reverb_in_left += MixVecSum(reverb_left_acc);
+  *reverb_in_right += MixVecSum(reverb_right_acc);
+
+  // Envelopes and counters are updated in voice order. Pitch modulation reads the previous voice's last_volume, which
+  // has been stored by then, same as the scalar path.
+  for (u32 voice_index = 0; voice_index < NUM_VOICES; voice_index++)
+  {
+    Voice& voice = s_voices[voice_index];
+    voice.last_volume = ms.volume[voice_index];
+    if (!(active_voices & (1u << voice_index)))
+      continue;
+
+    AdvanceVoice(voice_index);
+    voice.left_volume.Tick();
+    voice.right_volume.Tick();
+  }
+}
+
+bool SPU::CanMixVoiceBlock(u32 frames)
+{
+  // The block mixer reads a voice's ADPCM data for the whole block before the capture buffers and reverb work area
+  // are written for any of its frames. That's only the same as mixing frame by frame if no voice can reach RAM that
+  // the block writes. The step is below 0x4000, so a voice advances less than four samples per frame.
+  const u32 reach = ((frames * 4) / NUM_SAMPLES_PER_ADPCM_BLOCK + 2) * static_cast<u32>(sizeof(ADPCMBlock));
+  const u32 capture_end = CAPTURE_BUFFER_SIZE_PER_CHANNEL * 4;
+
+  u32 reverb_start = RAM_SIZE;
+  u32 reverb_end = 0;
+  if (s_SPUCNT.reverb_master_enable)
+  {
+    // The work area position moves on every second frame.
+    const ReverbRegisters& rr = s_reverb_registers;
+    const std::array<u16, 8> dests = {{rr.IIR_DEST_A[0], rr.IIR_DEST_A[1], rr.IIR_DEST_B[0], rr.IIR_DEST_B[1],
+                                       rr.MIX_DEST_A[0], rr.MIX_DEST_A[1], rr.MIX_DEST_B[0], rr.MIX_DEST_B[1]}};
+    u32 current_address = s_reverb_current_address;
+    for (u32 i = 0; i <= (frames / 2); i++)
+    {
+      for (const u16 dest : dests)
+      {
+        const u32 address = ReverbMemoryAddress(current_address, ZeroExtend32(dest) << 2);
+        reverb_start = std::min(reverb_start, address);
+        reverb_end = std::max<u32>(reverb_end, address + sizeof(s16));
+      }
+
+      current_address = (current_address + 1) & 0x3FFFFu;
+      if (current_address == 0)
+        current_address = s_reverb_base_address;
+    }
+  }
+
+  const auto reaches_written_ram = [reach, capture_end, reverb_start, reverb_end](u16 address) {
+    const u32 start = ZeroExtend32(address) << VOICE_ADDRESS_SHIFT;
+    const u32 end = start + reach;
+    return (start < capture_end || end > RAM_SIZE || (start < reverb_end && end > reverb_start));
+  };
+
+  for (u32 voice_index = 0; voice_index < NUM_VOICES; voice_index++)
+  {
+    const Voice& voice = s_voices[voice_index];
+    if (!voice.IsOn() && !s_SPUCNT.irq9_enable)
+      continue;
+
+    if (reaches_written_ram(voice.current_address) ||
+        reaches_written_ram(voice.regs.adpcm_repeat_address & ~u16(1)))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+ALWAYS_INLINE_RELEASE void SPU::MixVoiceBlock(u32 frames)
+{
+  VoiceBlockMixState& bs = s_voice_block_mix_state;
+  DebugAssert(frames <= MIX_BLOCK_FRAMES);
+
+  // Lanes past the end of the block are mixed as silence and never read back.
+  const u32 padded_frames = Common::AlignUpPow2(frames, MIX_VEC_LANES);
+  std::fill_n(bs.left_sum.begin(), padded_frames, 0);
+  std::fill_n(bs.right_sum.begin(), padded_frames, 0);
+  std::fill_n(bs.reverb_in_left.begin(), padded_frames, 0);
+  std::fill_n(bs.reverb_in_right.begin(), padded_frames, 0);
+
+  // The noise generator doesn't depend on the voices. Look ahead at its level for each frame of the block, and leave
+  // stepping it to the frame loop.
+  if (s_noise_mode_register != 0)
+  {
+    const u32 noise_count = s_noise_count;
+    const u32 noise_level = s_noise_level;
+    for (u32 frame = 0; frame < frames; frame++)
+    {
+      bs.noise_level[frame] = GetVoiceNoiseLevel();
+      UpdateNoise();
+    }
+    s_noise_count = noise_count;
+    s_noise_level = noise_level;
+  }
+
+  for (u32 voice_index = 0; voice_index < NUM_VOICES; voice_index++)
+  {
+    Voice& voice = s_voices[voice_index];
+    std::array<s32, MIX_BLOCK_FRAMES>& volume = bs.volume[voice_index];
+    if (!voice.IsOn() && !s_SPUCNT.irq9_enable)
+    {
+      // Only key on starts a voice, and that never happens inside a block.
+      std::fill_n(volume.begin(), padded_frames, 0);
+      voice.last_volume = 0;
+      continue;
+    }
+
+    // Decoding and envelopes stay scalar, they branch per frame.
+    const bool noise = IsVoiceNoiseEnabled(voice_index);
+    const bool pitch_modulation = IsPitchModulationEnabled(voice_index);
+    for (u32 frame = 0; frame < frames; frame++)
+    {
+      if (!voice.IsOn() && !s_SPUCNT.irq9_enable)
+      {
+        // Stopped partway through the block. Zero volume gives zero output, whatever the stale taps are.
+        bs.adsr_volume[frame] = 0;
+        continue;
+      }
+
+      if (!voice.has_samples)
+        ReadVoiceBlock(voice_index);
+
+      const u32 pair = frame * 2;
+      GatherInterpolationInputs(voice, noise, bs.noise_level[frame], &bs.taps_0_1[pair], &bs.taps_2_3[pair],
+                                &bs.weights_0_1[pair], &bs.weights_2_3[pair]);
+      bs.adsr_volume[frame] = voice.regs.adsr_volume;
+      bs.left_volume[frame] = voice.left_volume.current_level;
+      bs.right_volume[frame] = voice.right_volume.current_level;
+
+      // Pitch modulation reads the previous voice's output for the same frame.
+      if (pitch_modulation)
+        s_voices[voice_index - 1].last_volume = bs.volume[voice_index - 1][frame];
+
+      AdvanceVoice(voice_index);
+      voice.left_volume.Tick();
+      voice.right_volume.Tick();
+    }
+    std::fill(bs.adsr_volume.begin() + frames, bs.adsr_volume.begin() + padded_frames, 0);
+    if (pitch_modulation)
+      s_voices[voice_index - 1].last_volume = bs.volume[voice_index - 1][frames - 1];
+
+    // Interpolate, apply ADSR and channel volume, and sum, four frames at a time.
+    const bool reverb = ConvertToBoolUnchecked((s_reverb_on_register >> voice_index) & 1u);
+    for (u32 frame = 0; frame < padded_frames; frame += MIX_VEC_LANES)
+    {
+      const u32 pair = frame * 2;
+      const MixVec sample = MixVecSar15(
+        MixVecAdd(MixVecMulAddPairs(MixVecLoad(&bs.taps_0_1[pair]), MixVecLoad(&bs.weights_0_1[pair])),
+                  MixVecMulAddPairs(MixVecLoad(&bs.taps_2_3[pair]), MixVecLoad(&bs.weights_2_3[pair]))));
+      const MixVec frame_volume = MixVecSar15(MixVecMul(sample, MixVecLoad(&bs.adsr_volume[frame])));
+      MixVecStore(&volume[frame], frame_volume);
+
+      const MixVec left = MixVecSar15(MixVecMul(frame_volume, MixVecLoad(&bs.left_volume[frame])));
+      const MixVec right = MixVecSar15(MixVecMul(frame_volume, MixVecLoad(&bs.right_volume[frame])));
+      MixVecStore(&bs.left_sum[frame], MixVecAdd(MixVecLoad(&bs.left_sum[frame]), left));
+      MixVecStore(&bs.right_sum[frame], MixVecAdd(MixVecLoad(&bs.right_sum[frame]), right));
+      if (reverb)
+      {
+        MixVecStore(&bs.reverb_in_left[frame], MixVecAdd(MixVecLoad(&bs.reverb_in_left[frame]), left));
+        MixVecStore(&bs.reverb_in_right[frame], MixVecAdd(MixVecLoad(&bs.reverb_in_right[frame]), right));
+      }
+    }
+
+    voice.last_volume = volume[frames - 1];
+  }
+}
+
+#endif
+
 void SPU::UpdateNoise()
 {
   // Dr Hell's noise waveform, implementation borrowed from pcsx-r.
@@ -2064,10 +2654,15 @@ void SPU::UpdateNoise()
 /************************************************************************/
 
 u32 SPU::ReverbMemoryAddress(u32 address)
+{
+  return ReverbMemoryAddress(s_reverb_current_address, address);
+}
+
+u32 SPU::ReverbMemoryAddress(u32 current_address, u32 address)
 {
   // Ensures address does not leave the reverb work area.
   static constexpr u32 MASK = (RAM_SIZE - 1) / 2;
-  u32 offset = s_reverb_current_address + (address & MASK);
+  u32 offset = current_address + (address & MASK);
   offset += s_reverb_base_address & ((s32)(offset << 13) >> 31);
 
   // We address RAM in bytes. TODO: Change this to words.
@@ -2089,6 +2684,7 @@ void SPU::ReverbWrite(u32 address, s16 data)
   // TODO: This should check interrupts.
   const u32 real_address = ReverbMemoryAddress(address << 2);
   std::memcpy(&s_ram[real_address], &data, sizeof(data));
+  InvalidateADPCMCache(real_address);
 }
 
 // Zeroes optimized out; middle removed too(it's 16384)
@@ -2251,8 +2847,62 @@ void SPU::ProcessReverb(s16 left_in, s16 right_in, s32* left_out, s32* right_out
 #endif
 }
 
+ALWAYS_INLINE_RELEASE void SPU::MixFrame(s16* output_frame, s32 left_sum, s32 right_sum, s32 reverb_in_left,
+                                         s32 reverb_in_right, s32 capture_voice_1, s32 capture_voice_3)
+{
+  if (!s_SPUCNT.mute_n)
+  {
+    left_sum = 0;
+    right_sum = 0;
+  }
+
+  // Update noise once per frame.
+  UpdateNoise();
+
+  // Mix in CD audio.
+  const auto [cd_audio_left, cd_audio_right] = CDROM::GetAudioFrame();
+  if (s_SPUCNT.cd_audio_enable)
+  {
+    const s32 cd_audio_volume_left = ApplyVolume(s32(cd_audio_left), s_cd_audio_volume_left);
+    const s32 cd_audio_volume_right = ApplyVolume(s32(cd_audio_right), s_cd_audio_volume_right);
+
+    left_sum += cd_audio_volume_left;
+    right_sum += cd_audio_volume_right;
+
+    if (s_SPUCNT.cd_audio_reverb)
+    {
+      reverb_in_left += cd_audio_volume_left;
+      reverb_in_right += cd_audio_volume_right;
+    }
+  }
+
+  // Compute reverb.
+  s32 reverb_out_left, reverb_out_right;
+  ProcessReverb(static_cast<s16>(Clamp16(reverb_in_left)), static_cast<s16>(Clamp16(reverb_in_right)),
+                &reverb_out_left, &reverb_out_right);
+
+  // Mix in reverb.
+  left_sum += reverb_out_left;
+  right_sum += reverb_out_right;
+
+  // Apply main volume after clamping. A maximum volume should not overflow here because both are 16-bit values.
+  output_frame[0] = static_cast<s16>(ApplyVolume(Clamp16(left_sum), s_main_volume_left.current_level));
+  output_frame[1] = static_cast<s16>(ApplyVolume(Clamp16(right_sum), s_main_volume_right.current_level));
+  s_main_volume_left.Tick();
+  s_main_volume_right.Tick();
+
+  // Write to capture buffers.
+  WriteToCaptureBuffer(0, cd_audio_left);
+  WriteToCaptureBuffer(1, cd_audio_right);
+  WriteToCaptureBuffer(2, static_cast<s16>(Clamp16(capture_voice_1)));
+  WriteToCaptureBuffer(3, static_cast<s16>(Clamp16(capture_voice_3)));
+  IncrementCaptureBufferPosition();
+}
+
 void SPU::Execute(void* param, TickCount ticks, TickCount ticks_late)
 {
+  SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::SPU);
+
   u32 remaining_frames;
   if (g_settings.cpu_overclock_active)
   {
@@ -2277,76 +2927,45 @@ void SPU::Execute(void* param, TickCount ticks, TickCount ticks_late)
 
     s16* output_frame = output_frame_start;
     const u32 frames_in_this_batch = std::min(remaining_frames, output_frame_space);
-    for (u32 i = 0; i < frames_in_this_batch; i++)
+    for (u32 i = 0; i < frames_in_this_batch;)
     {
-      s32 left_sum = 0;
-      s32 right_sum = 0;
-      s32 reverb_in_left = 0;
-      s32 reverb_in_right = 0;
-
-      u32 reverb_on_register = s_reverb_on_register;
-
-      for (u32 voice = 0; voice < NUM_VOICES; voice++)
+#ifdef SPU_SIMD
+      // Key on/off happens after the first frame, so that frame is never part of a block.
+      const u32 block_frames = std::min(frames_in_this_batch - i, MIX_BLOCK_FRAMES);
+      if (g_settings.audio_spu_use_simd && block_frames >= MIX_VEC_LANES &&
+          (i > 0 || (s_key_off_register == 0 && s_key_on_register == 0)) && CanMixVoiceBlock(block_frames))
       {
-        const auto [left, right] = SampleVoice(voice);
-        left_sum += left;
-        right_sum += right;
-
-        if (reverb_on_register & 1u)
+        const VoiceBlockMixState& bs = s_voice_block_mix_state;
+        MixVoiceBlock(block_frames);
+        for (u32 frame = 0; frame < block_frames; frame++)
         {
-          reverb_in_left += left;
-          reverb_in_right += right;
+          MixFrame(output_frame, bs.left_sum[frame], bs.right_sum[frame], bs.reverb_in_left[frame],
+                   bs.reverb_in_right[frame], bs.volume[1][frame], bs.volume[3][frame]);
+          output_frame += NUM_CHANNELS;
         }
-        reverb_on_register >>= 1;
-      }
-
-      if (!s_SPUCNT.mute_n)
-      {
-        left_sum = 0;
-        right_sum = 0;
-      }
-
-      // Update noise once per frame.
-      UpdateNoise();
-
-      // Mix in CD audio.
-      const auto [cd_audio_left, cd_audio_right] = CDROM::GetAudioFrame();
-      if (s_SPUCNT.cd_audio_enable)
-      {
-        const s32 cd_audio_volume_left = ApplyVolume(s32(cd_audio_left), s_cd_audio_volume_left);
-        const s32 cd_audio_volume_right = ApplyVolume(s32(cd_audio_right), s_cd_audio_volume_right);
-
-        left_sum += cd_audio_volume_left;
-        right_sum += cd_audio_volume_right;
 
-        if (s_SPUCNT.cd_audio_reverb)
-        {
-          reverb_in_left += cd_audio_volume_left;
-          reverb_in_right += cd_audio_volume_right;
-        }
+        i += block_frames;
+        continue;
       }
+#endif
 
-      // Compute reverb.
-      s32 reverb_out_left, reverb_out_right;
-      ProcessReverb(static_cast<s16>(Clamp16(reverb_in_left)), static_cast<s16>(Clamp16(reverb_in_right)),
-                    &reverb_out_left, &reverb_out_right);
-
-      // Mix in reverb.
-      left_sum += reverb_out_left;
-      right_sum += reverb_out_right;
+      s32 left_sum = 0;
+      s32 right_sum = 0;
+      s32 reverb_in_left = 0;
+      s32 reverb_in_right = 0;
 
-      // Apply main volume after clamping. A maximum volume should not overflow here because both are 16-bit values.
-      *(output_frame++) = static_cast<s16>(ApplyVolume(Clamp16(left_sum), s_main_volume_left.current_level));
-      *(output_frame++) = static_cast<s16>(ApplyVolume(Clamp16(right_sum), s_main_volume_right.current_level));
-      s_main_volume_left.Tick();
-      s_main_volume_right.Tick();
+#ifdef SPU_SIMD
+      if (g_settings.audio_spu_use_simd)
+        MixVoicesSIMD(&left_sum, &right_sum, &reverb_in_left, &reverb_in_right);
+      else
+        MixVoices(&left_sum, &right_sum, &reverb_in_left, &reverb_in_right);
+#else
+      MixVoices(&left_sum, &right_sum, &reverb_in_left, &reverb_in_right);
+#endif
 
-      // Write to capture buffers.
-      WriteToCaptureBuffer(0, cd_audio_left);
-      WriteToCaptureBuffer(1, cd_audio_right);
-      WriteToCaptureBuffer(2, static_cast<s16>(Clamp16(s_voices[1].last_volume)));
-      WriteToCaptureBuffer(3, static_cast<s16>(Clamp16(s_voices[3].last_volume)));
-      IncrementCaptureBufferPosition();
+      MixFrame(output_frame, left_sum, right_sum, reverb_in_left, reverb_in_right, s_voices[1].last_volume,
+               s_voices[3].last_volume);
+      output_frame += NUM_CHANNELS;
 
       // Key off/on voices after the first frame.
       if (i == 0 && (s_key_off_register != 0 || s_key_on_register != 0))
@@ -2371,6 +2990,8 @@ void SPU::Execute(void* param, TickCount ticks, TickCount ticks_late)
           key_on_register >>= 1;
         }
       }
+
+      i++;
     }
 
     if (s_dump_writer)
@@ -2479,6 +3100,16 @@ void SPU::DrawDebugStateWindow()
     ImGui::SameLine(offsets[0]);
     ImGui::TextColored(s_transfer_event->IsActive() ? active_color : inactive_color, "%u halfwords (%u bytes)",
                        s_transfer_fifo.GetSize(), s_transfer_fifo.GetSize() * 2);
+
+    const u64 adpcm_cache_lookups = s_adpcm_cache_hits + s_adpcm_cache_misses;
+    ImGui::Text("ADPCM Cache: ");
+    ImGui::SameLine(offsets[0]);
+    ImGui::TextColored(g_settings.audio_spu_adpcm_cache ? active_color : inactive_color,
+                       "%.2f%% hit rate, %" PRIu64 " hits, %" PRIu64 " misses",
+                       (adpcm_cache_lookups > 0) ?
+                         (static_cast<double>(s_adpcm_cache_hits) / static_cast<double>(adpcm_cache_lookups) * 100.0) :
+                         0.0,
+                       s_adpcm_cache_hits, s_adpcm_cache_misses);
   }
 
   // draw voice states
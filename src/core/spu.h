@@ -22,7 +22,7 @@ void Initialize();
 void CPUClockChanged();
 void Shutdown();
 void Reset();
-bool DoState(StateWrapper& sw);
+bool DoState(StateWrapper& sw, bool include_ram);
 
 u16 ReadRegister(u32 offset);
 void WriteRegister(u32 offset, u16 value);
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2019-2023 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#include "subsystem_profiler.h"
+
+#include "common/file_system.h"
+#include "common/log.h"
+#include "common/timer.h"
+
+#include "fmt/format.h"
+
+#include <array>
+
+Log_SetChannel(SubsystemProfiler);
+
+namespace SubsystemProfiler {
+static void Charge(Common::Timer::Value now);
+
+static constexpr u32 MAX_DEPTH = 16;
+
+static constexpr std::array<const char*, static_cast<size_t>(Subsystem::Count)> s_subsystem_names = {
+  {"Host", "CPU", "CodeCompile", "GTE", "GPU", "SPU", "CDROM", "MDEC", "TimingEvents"}};
+
+static std::array<u64, static_cast<size_t>(Subsystem::Count)> s_times = {};
+static std::array<u64, static_cast<size_t>(Subsystem::Count)> s_counts = {};
+static std::array<Subsystem, MAX_DEPTH> s_stack = {};
+static u32 s_depth = 0;
+static Common::Timer::Value s_last_time = 0;
+} // namespace SubsystemProfiler
+
+bool SubsystemProfiler::g_enabled = false;
+
+void SubsystemProfiler::SetEnabled(bool enabled)
+{
+  if (g_enabled == enabled)
+    return;
+
+  g_enabled = enabled;
+  Reset();
+}
+
+void SubsystemProfiler::Reset()
+{
+  s_times.fill(0);
+  s_counts.fill(0);
+  s_depth = 0;
+  s_stack[0] = Subsystem::Host;
+  s_last_time = Common::Timer::GetCurrentValue();
+}
+
+ALWAYS_INLINE void SubsystemProfiler::Charge(Common::Timer::Value now)
+{
+  s_times[static_cast<size_t>(s_stack[s_depth])] += now - s_last_time;
+  s_last_time = now;
+}
+
+void SubsystemProfiler::Push(Subsystem subsystem)
+{
+  Charge(Common::Timer::GetCurrentValue());
+  s_counts[static_cast<size_t>(subsystem)]++;
+
+  // Deeper nesting than this doesn't happen in practice, but if it does, charge it to the outer subsystem.
+  if (s_depth == (MAX_DEPTH - 1))
+    return;
+
+  s_stack[++s_depth] = subsystem;
+}
+
+void SubsystemProfiler::Pop()
+{
+  Charge(Common::Timer::GetCurrentValue());
+  if (s_depth > 0)
+    s_depth--;
+}
+
+void SubsystemProfiler::SetBaseSubsystem(Subsystem subsystem)
+{
+  Charge(Common::Timer::GetCurrentValue());
+  s_depth = 0;
+  s_stack[0] = subsystem;
+}
+
+const char* SubsystemProfiler::GetSubsystemName(Subsystem subsystem)
+{
+  return s_subsystem_names[static_cast<size_t>(subsystem)];
+}
+
+u64 SubsystemProfiler::GetSubsystemTime(Subsystem subsystem)
+{
+  return s_times[static_cast<size_t>(subsystem)];
+}
+
+u64 SubsystemProfiler::GetSubsystemCount(Subsystem subsystem)
+{
+  return s_counts[static_cast<size_t>(subsystem)];
+}
+
+void SubsystemProfiler::LogReport(u32 frames, double elapsed_seconds)
+{
+  Charge(Common::Timer::GetCurrentValue());
+
+  const double elapsed_ms = elapsed_seconds * 1000.0;
+  Log_InfoPrintf("%u frames in %.3f seconds, %.2f FPS", frames, elapsed_seconds,
+                 (elapsed_seconds > 0.0) ? (static_cast<double>(frames) / elapsed_seconds) : 0.0);
+  for (u32 i = 0; i < static_cast<u32>(Subsystem::Count); i++)
+  {
+    const double ms = Common::Timer::ConvertValueToMilliseconds(s_times[i]);
+    Log_InfoPrintf("  %-12s %10.3f ms %6.2f%% %8.4f ms/frame %12" PRIu64 " calls", s_subsystem_names[i], ms,
+                   (elapsed_ms > 0.0) ? (ms / elapsed_ms * 100.0) : 0.0,
+                   (frames > 0) ? (ms / static_cast<double>(frames)) : 0.0, s_counts[i]);
+  }
+}
+
+std::string SubsystemProfiler::GetReportJSON(u32 frames, double elapsed_seconds)
+{
+  Charge(Common::Timer::GetCurrentValue());
+
+  const double elapsed_ms = elapsed_seconds * 1000.0;
+  std::string ret = fmt::format("{{\n  \"frames\": {},\n  \"elapsed\": {:.3f},\n  \"fps\": {:.2f},\n  \"subsystems\": {{",
+                                frames, elapsed_seconds,
+                                (elapsed_seconds > 0.0) ? (static_cast<double>(frames) / elapsed_seconds) : 0.0);
+  for (u32 i = 0; i < static_cast<u32>(Subsystem::Count); i++)
+  {
+    const double ms = Common::Timer::ConvertValueToMilliseconds(s_times[i]);
+    fmt::format_to(std::back_inserter(ret),
+                   "{}\n    \"{}\": {{\"time_ms\": {:.3f}, \"percent\": {:.2f}, \"ms_per_frame\": {:.4f}, \"calls\": {}}}",
+                   (i > 0) ? "," : "", s_subsystem_names[i], ms, (elapsed_ms > 0.0) ? (ms / elapsed_ms * 100.0) : 0.0,
+                   (frames > 0) ? (ms / static_cast<double>(frames)) : 0.0, s_counts[i]);
+  }
+  ret.append("\n  }\n}\n");
+  return ret;
+}
+
+bool SubsystemProfiler::WriteReport(const char* filename, u32 frames, double elapsed_seconds)
+{
+  if (!FileSystem::WriteStringToFile(filename, GetReportJSON(frames, elapsed_seconds)))
+  {
+    Log_ErrorPrintf("Failed to write benchmark report to '%s'.", filename);
+    return false;
+  }
+
+  Log_InfoPrintf("Wrote benchmark report to '%s'.", filename);
+  return true;
+}
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2019-2023 Connor McLaughlin <stenzek@gmail.com>
+// SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
+
+#pragma once
+
+#include "types.h"
+
+#include <string>
+
+// Attributes host time on the CPU thread to emulated subsystems, for benchmarking. Time is exclusive, i.e. time
+// spent in the GTE while the CPU is executing is only counted towards the GTE. Only usable from the CPU thread.
+namespace SubsystemProfiler {
+
+enum class Subsystem : u8
+{
+  Host,
+  CPU,
+  CodeCompile,
+  GTE,
+  GPU,
+  SPU,
+  CDROM,
+  MDEC,
+  TimingEvents,
+  Count
+};
+
+extern bool g_enabled;
+
+ALWAYS_INLINE bool IsEnabled()
+{
+  return g_enabled;
+}
+
+void SetEnabled(bool enabled);
+
+/// Clears all accumulated times.
+void Reset();
+
+void Push(Subsystem subsystem);
+void Pop();
+
+/// Discards any nested subsystems and makes the specified subsystem current. Needed around CPU execution, since
+/// leaving it can longjmp past scopes without running their destructors.
+void SetBaseSubsystem(Subsystem subsystem);
+
+const char* GetSubsystemName(Subsystem subsystem);
+u64 GetSubsystemTime(Subsystem subsystem);
+u64 GetSubsystemCount(Subsystem subsystem);
+
+/// Writes the accumulated times to the log.
+void LogReport(u32 frames, double elapsed_seconds);
+
+/// Returns the accumulated times as a JSON object.
+std::string GetReportJSON(u32 frames, double elapsed_seconds);
+bool WriteReport(const char* filename, u32 frames, double elapsed_seconds);
+
+class Scope
+{
+public:
+  ALWAYS_INLINE Scope(Subsystem subsystem) : m_active(g_enabled)
+  {
+    if (m_active)
+      Push(subsystem);
+  }
+  ALWAYS_INLINE ~Scope()
+  {
+    if (m_active)
+      Pop();
+  }
+
+private:
+  bool m_active;
+};
+
+} // namespace SubsystemProfiler
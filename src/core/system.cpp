@@ -17,6 +17,7 @@
 #include "game_database.h"
 #include "game_list.h"
 #include "gpu.h"
+#include "gpu_backend.h"
 #include "gte.h"
 #include "host.h"
 #include "host_interface_progress_callback.h"
@@ -31,6 +32,7 @@
 #include "save_state_version.h"
 #include "sio.h"
 #include "spu.h"
+#include "subsystem_profiler.h"
 #include "texture_replacements.h"
 #include "timers.h"
 
@@ -45,6 +47,7 @@
 #include "util/postprocessing.h"
 #include "util/state_wrapper.h"
 
+#include "common/align.h"
 #include "common/error.h"
 #include "common/file_system.h"
 #include "common/log.h"
@@ -60,10 +63,12 @@
 #include <cctype>
 #include <cinttypes>
 #include <cmath>
+#include <condition_variable>
 #include <cstdio>
 #include <deque>
 #include <fstream>
 #include <limits>
+#include <mutex>
 #include <thread>
 
 Log_SetChannel(System);
@@ -105,7 +110,8 @@ static void InternalReset();
 static void ClearRunningGame();
 static void DestroySystem();
 static std::string GetMediaPathFromSaveState(const char* path);
-static bool DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_display, bool is_memory_state);
+static bool DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_display, bool is_memory_state,
+                    bool include_ram = true);
 static bool CreateGPU(GPURenderer renderer, bool is_switching);
 static bool SaveUndoLoadState();
 static void WarnAboutUnsafeSettings();
@@ -116,6 +122,18 @@ static void Throttle();
 
 static void SetRewinding(bool enabled);
 static bool SaveRewindState();
+static bool SaveRewindDeltaState();
+static bool LoadRewindDeltaState();
+static void StartRewindDeltaThread();
+static void StopRewindDeltaThread();
+static void WaitForRewindDeltaThread();
+static void RewindDeltaThreadEntryPoint();
+static MemorySaveState EncodeRewindDeltaState(const GrowableMemoryByteStream* stream, bool keyframe);
+static void EncodeRewindDelta(std::vector<u8>* out, const u8* data, u32 size, const std::vector<u8>& base);
+static void ApplyRewindDelta(std::vector<u8>* buffer, const u8* delta, u32 delta_length, u32 size);
+static bool EvictRewindDeltaStates();
+static void AddMemorySaveStateSize(const MemorySaveState& mss, u64* ram_size, u64* vram_size);
+static void LogRewindMemoryUsage(bool delta_compression);
 static void DoRewind();
 
 static void SaveRunaheadState();
@@ -126,6 +144,7 @@ static bool FastForwardToFirstFrame();
 
 static bool UpdateGameSettingsLayer();
 static void UpdateRunningGame(const char* path, CDImage* image, bool booting);
+static std::string GetBlockProfilePath();
 static bool CheckForSBIFile(CDImage* image);
 static std::unique_ptr<MemoryCard> GetMemoryCardForSlot(u32 slot, MemoryCardType type);
 
@@ -177,6 +196,7 @@ static bool s_system_interrupted = false;
 static bool s_frame_step_request = false;
 static bool s_fast_forward_enabled = false;
 static bool s_turbo_enabled = false;
+static bool s_benchmark_mode = false;
 static bool s_throttler_enabled = true;
 static bool s_display_all_frames = true;
 static bool s_syncing_to_host = false;
@@ -195,6 +215,9 @@ static float s_cpu_thread_usage = 0.0f;
 static float s_cpu_thread_time = 0.0f;
 static float s_sw_thread_usage = 0.0f;
 static float s_sw_thread_time = 0.0f;
+static u32 s_sw_queue_average_depth = 0;
+static u32 s_sw_queue_max_depth = 0;
+static float s_sw_stall_time = 0.0f;
 static float s_average_gpu_time = 0.0f;
 static float s_accumulated_gpu_time = 0.0f;
 static float s_gpu_usage = 0.0f;
@@ -223,6 +246,29 @@ static s32 s_rewind_load_counter = -1;
 static s32 s_rewind_save_frequency = -1;
 static s32 s_rewind_save_counter = -1;
 static bool s_rewinding_first_save = false;
+static bool s_rewind_memory_usage_logged = false;
+
+// Delta-compressed rewind: the CPU thread snapshots the state into a pooled stream, and the encoder thread diffs it
+// against the decoded copy of the newest state. s_rewind_states is owned by the encoder thread while it is running.
+static constexpr u32 REWIND_DELTA_QUEUE_SIZE = 4;
+static std::thread s_rewind_delta_thread;
+static std::mutex s_rewind_delta_mutex;
+static std::condition_variable s_rewind_delta_work_cv;
+static std::condition_variable s_rewind_delta_done_cv;
+static std::deque<std::unique_ptr<GrowableMemoryByteStream>> s_rewind_delta_queue;
+static std::vector<std::unique_ptr<GrowableMemoryByteStream>> s_rewind_delta_free_streams;
+static u32 s_rewind_delta_stream_count = 0;
+static u32 s_rewind_delta_dropped_saves = 0;
+static u64 s_rewind_delta_state_ram_estimate = 0;
+static u64 s_rewind_delta_state_vram_estimate = 0;
+static u64 s_rewind_delta_budget = 0;
+static u32 s_rewind_delta_keyframe_interval = 0;
+static bool s_rewind_delta_thread_busy = false;
+static bool s_rewind_delta_thread_shutdown = false;
+static std::vector<u8> s_rewind_delta_base;
+static std::vector<u8> s_rewind_delta_encode_buffer;
+static bool s_rewind_delta_base_valid = false;
+static u32 s_rewind_saves_since_keyframe = 0;
 
 static std::deque<System::MemorySaveState> s_runahead_states;
 static bool s_runahead_replay_pending = false;
@@ -487,6 +533,18 @@ float System::GetSWThreadAverageTime()
 {
   return s_sw_thread_time;
 }
+u32 System::GetSWQueueAverageDepth()
+{
+  return s_sw_queue_average_depth;
+}
+u32 System::GetSWQueueMaxDepth()
+{
+  return s_sw_queue_max_depth;
+}
+float System::GetSWStallAverageTime()
+{
+  return s_sw_stall_time;
+}
 float System::GetGPUUsage()
 {
   return s_gpu_usage;
@@ -882,6 +940,16 @@ std::string System::GetInputProfilePath(const std::string_view& name)
   return Path::Combine(EmuFolders::InputProfiles, fmt::format("{}.ini", name));
 }
 
+std::string System::GetBlockProfilePath()
+{
+  if (s_running_game_serial.empty() || s_running_game_hash == 0)
+    return {};
+
+  return Path::Combine(EmuFolders::Cache,
+                       fmt::format("blockprofiles" FS_OSPATH_SEPARATOR_STR "{}_{:016X}.bin",
+                                   Path::SanitizeFileName(s_running_game_serial), s_running_game_hash));
+}
+
 bool System::RecreateGPU(GPURenderer renderer, bool force_recreate_device, bool update_display /* = true*/)
 {
   ClearMemorySaveStates();
@@ -968,6 +1036,9 @@ void System::ApplySettings(bool display_osd_messages)
 {
   Log_DevPrint("Applying settings...");
 
+  // The background compile thread reads the settings.
+  CPU::CodeCache::CancelBackgroundCompile();
+
   const Settings old_config(std::move(g_settings));
   g_settings = Settings();
   LoadSettings(display_osd_messages);
@@ -1539,6 +1610,9 @@ bool System::Initialize(bool force_software_renderer)
   s_cpu_thread_time = 0.0f;
   s_sw_thread_usage = 0.0f;
   s_sw_thread_time = 0.0f;
+  s_sw_queue_average_depth = 0;
+  s_sw_queue_max_depth = 0;
+  s_sw_stall_time = 0.0f;
   s_average_gpu_time = 0.0f;
   s_accumulated_gpu_time = 0.0f;
   s_gpu_usage = 0.0f;
@@ -1612,6 +1686,46 @@ bool System::Initialize(bool force_software_renderer)
   return true;
 }
 
+bool System::CreateGPUOnly()
+{
+  DebugAssert(s_state == State::Shutdown);
+  g_ticks_per_second = ScaleTicksToOverclock(MASTER_CLOCK);
+
+  TimingEvents::Initialize();
+  if (!CreateGPU(g_settings.gpu_renderer, false))
+  {
+    TimingEvents::Shutdown();
+    return false;
+  }
+
+  DMA::Initialize();
+  InterruptController::Initialize();
+  Timers::Initialize();
+  PostProcessing::Initialize();
+  g_gpu->Reset(true);
+  return true;
+}
+
+void System::DestroyGPUOnly()
+{
+  PostProcessing::Shutdown();
+  Timers::Shutdown();
+  g_gpu.reset();
+  InterruptController::Shutdown();
+  DMA::Shutdown();
+  TimingEvents::Shutdown();
+
+  if (s_keep_gpu_device_on_shutdown && g_gpu_device)
+  {
+    g_gpu_device->SetDisplayMaxFPS(0.0f);
+  }
+  else
+  {
+    Host::ReleaseGPUDevice();
+    Host::ReleaseRenderWindow();
+  }
+}
+
 void System::DestroySystem()
 {
   DebugAssert(!s_system_executing);
@@ -1649,6 +1763,7 @@ void System::DestroySystem()
   InterruptController::Shutdown();
   DMA::Shutdown();
   CPU::PGXP::Shutdown();
+  CPU::CodeCache::SetBlockProfilePath({});
   CPU::CodeCache::Shutdown();
   Bus::Shutdown();
   CPU::Shutdown();
@@ -1730,10 +1845,20 @@ void System::Execute()
         TimingEvents::UpdateCPUDowncount();
 
         if (s_rewind_load_counter >= 0)
+        {
           DoRewind();
+        }
         else
+        {
+          if (SubsystemProfiler::IsEnabled())
+            SubsystemProfiler::SetBaseSubsystem(SubsystemProfiler::Subsystem::CPU);
+
           CPU::Execute();
 
+          if (SubsystemProfiler::IsEnabled())
+            SubsystemProfiler::SetBaseSubsystem(SubsystemProfiler::Subsystem::Host);
+        }
+
         s_system_executing = false;
         continue;
       }
@@ -1755,6 +1880,8 @@ void System::FrameDone()
 {
   s_frame_number++;
 
+  CPU::CodeCache::PrecompileProfiledBlocks();
+
   // Vertex buffer is shared, need to flush what we have.
   g_gpu->FlushRender();
 
@@ -2029,7 +2156,8 @@ bool System::CreateGPU(GPURenderer renderer, bool is_switching)
   return true;
 }
 
-bool System::DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_display, bool is_memory_state)
+bool System::DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_display, bool is_memory_state,
+                     bool include_ram)
 {
   if (!sw.DoMarker("System"))
     return false;
@@ -2071,7 +2199,7 @@ bool System::DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_di
   if (sw.IsReading() && g_settings.gpu_pgxp_enable && !is_memory_state)
     CPU::PGXP::Reset();
 
-  if (!sw.DoMarker("Bus") || !Bus::DoState(sw))
+  if (!sw.DoMarker("Bus") || !Bus::DoState(sw, include_ram))
     return false;
 
   if (!sw.DoMarker("DMA") || !DMA::DoState(sw))
@@ -2093,7 +2221,7 @@ bool System::DoState(StateWrapper& sw, GPUTexture** host_texture, bool update_di
   if (!sw.DoMarker("Timers") || !Timers::DoState(sw))
     return false;
 
-  if (!sw.DoMarker("SPU") || !SPU::DoState(sw))
+  if (!sw.DoMarker("SPU") || !SPU::DoState(sw, include_ram))
     return false;
 
   if (!sw.DoMarker("MDEC") || !MDEC::DoState(sw))
@@ -2553,6 +2681,14 @@ void System::UpdatePerformanceCounters()
   s_sw_thread_usage = static_cast<float>(static_cast<double>(sw_delta) * pct_divider);
   s_sw_thread_time = static_cast<float>(static_cast<double>(sw_delta) * time_divider);
 
+  if (GPUBackend* sw_backend = g_gpu->GetSWBackend(); sw_backend)
+  {
+    const GPUBackend::QueueStats queue_stats = sw_backend->GetAndResetQueueStats();
+    s_sw_queue_average_depth = queue_stats.average_depth;
+    s_sw_queue_max_depth = queue_stats.max_depth;
+    s_sw_stall_time = queue_stats.stall_time / frames_run;
+  }
+
   s_fps_timer.ResetTo(now_ticks);
 
   if (g_gpu_device->IsGPUTimingEnabled())
@@ -2579,6 +2715,8 @@ void System::ResetPerformanceCounters()
     s_last_sw_time = sw_thread->GetCPUTime();
   else
     s_last_sw_time = 0;
+  if (GPUBackend* sw_backend = g_gpu->GetSWBackend(); sw_backend)
+    sw_backend->GetAndResetQueueStats();
 
   s_average_frame_time_accumulator = 0.0f;
   s_minimum_frame_time_accumulator = 0.0f;
@@ -2591,9 +2729,16 @@ void System::ResetPerformanceCounters()
 void System::UpdateSpeedLimiterState()
 {
   const float old_target_speed = s_target_speed;
-  s_target_speed = s_turbo_enabled ?
-                     g_settings.turbo_speed :
-                     (s_fast_forward_enabled ? g_settings.fast_forward_speed : g_settings.emulation_speed);
+  if (s_benchmark_mode)
+  {
+    s_target_speed = 0.0f;
+  }
+  else
+  {
+    s_target_speed = s_turbo_enabled ?
+                       g_settings.turbo_speed :
+                       (s_fast_forward_enabled ? g_settings.fast_forward_speed : g_settings.emulation_speed);
+  }
   s_throttler_enabled = (s_target_speed != 0.0f);
   s_display_all_frames = !s_throttler_enabled || g_settings.display_all_frames;
 
@@ -2681,6 +2826,27 @@ void System::SetFastForwardEnabled(bool enabled)
   UpdateSpeedLimiterState();
 }
 
+bool System::IsBenchmarkModeEnabled()
+{
+  return s_benchmark_mode;
+}
+
+void System::SetBenchmarkModeEnabled(bool enabled)
+{
+  if (s_benchmark_mode == enabled)
+    return;
+
+  s_benchmark_mode = enabled;
+  SubsystemProfiler::SetEnabled(enabled);
+
+  if (IsValid())
+  {
+    // Recompiled GTE calls are only profiled in blocks compiled while enabled.
+    CPU::CodeCache::Reset();
+    UpdateSpeedLimiterState();
+  }
+}
+
 bool System::IsTurboEnabled()
 {
   return s_turbo_enabled;
@@ -3351,6 +3517,7 @@ void System::UpdateRunningGame(const char* path, CDImage* image, bool booting)
   }
 
   g_texture_replacements.SetGameID(s_running_game_serial);
+  CPU::CodeCache::SetBlockProfilePath(GetBlockProfilePath());
 
   if (booting)
     Achievements::ResetHardcoreMode();
@@ -3604,6 +3771,12 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         (g_settings.cpu_recompiler_memory_exceptions != old_settings.cpu_recompiler_memory_exceptions ||
          g_settings.cpu_recompiler_block_linking != old_settings.cpu_recompiler_block_linking ||
          g_settings.cpu_recompiler_icache != old_settings.cpu_recompiler_icache ||
+         g_settings.cpu_recompiler_compile_threshold != old_settings.cpu_recompiler_compile_threshold ||
+         g_settings.cpu_recompiler_background_compile != old_settings.cpu_recompiler_background_compile ||
+         g_settings.cpu_recompiler_follow_jumps != old_settings.cpu_recompiler_follow_jumps ||
+         g_settings.cpu_recompiler_superblocks != old_settings.cpu_recompiler_superblocks ||
+         g_settings.cpu_recompiler_block_stats != old_settings.cpu_recompiler_block_stats ||
+         g_settings.cpu_recompiler_idle_loop_skipping != old_settings.cpu_recompiler_idle_loop_skipping ||
          g_settings.bios_tty_logging != old_settings.bios_tty_logging))
     {
       Host::AddIconOSDMessage("CPUFlushAllBlocks", ICON_FA_MICROCHIP,
@@ -3622,6 +3795,9 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
         g_settings.gpu_multisamples != old_settings.gpu_multisamples ||
         g_settings.gpu_per_sample_shading != old_settings.gpu_per_sample_shading ||
         g_settings.gpu_use_thread != old_settings.gpu_use_thread ||
+        g_settings.gpu_sw_rasterizer_threads != old_settings.gpu_sw_rasterizer_threads ||
+        g_settings.gpu_sw_use_simd != old_settings.gpu_sw_use_simd ||
+        g_settings.gpu_sw_simd_validation != old_settings.gpu_sw_simd_validation ||
         g_settings.gpu_use_software_renderer_for_readbacks != old_settings.gpu_use_software_renderer_for_readbacks ||
         g_settings.gpu_fifo_size != old_settings.gpu_fifo_size ||
         g_settings.gpu_max_run_ahead != old_settings.gpu_max_run_ahead ||
@@ -3680,6 +3856,12 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
     if (g_settings.cdrom_readahead_sectors != old_settings.cdrom_readahead_sectors)
       CDROM::SetReadaheadSectors(g_settings.cdrom_readahead_sectors);
 
+    if (g_settings.cdrom_chd_hunk_cache_size != old_settings.cdrom_chd_hunk_cache_size ||
+        g_settings.cdrom_chd_prefetch_hunks != old_settings.cdrom_chd_prefetch_hunks)
+    {
+      CDROM::SetReadCacheParameters(g_settings.cdrom_chd_hunk_cache_size, g_settings.cdrom_chd_prefetch_hunks);
+    }
+
     if (g_settings.memory_card_types != old_settings.memory_card_types ||
         g_settings.memory_card_paths != old_settings.memory_card_paths ||
         (g_settings.memory_card_use_playlist_title != old_settings.memory_card_use_playlist_title))
@@ -3690,6 +3872,8 @@ void System::CheckForSettingsChanges(const Settings& old_settings)
     if (g_settings.rewind_enable != old_settings.rewind_enable ||
         g_settings.rewind_save_frequency != old_settings.rewind_save_frequency ||
         g_settings.rewind_save_slots != old_settings.rewind_save_slots ||
+        g_settings.rewind_keyframe_interval != old_settings.rewind_keyframe_interval ||
+        g_settings.rewind_delta_compression != old_settings.rewind_delta_compression ||
         g_settings.runahead_frames != old_settings.runahead_frames)
     {
       UpdateMemorySaveStateSettings();
@@ -3860,7 +4044,7 @@ void System::LogUnsafeSettingsToConsole(const std::string& messages)
 
 void System::CalculateRewindMemoryUsage(u32 num_saves, u32 resolution_scale, u64* ram_usage, u64* vram_usage)
 {
-  const u64 real_resolution_scale = static_cast<u64>(std::max(g_settings.gpu_resolution_scale, 1u));
+  const u64 real_resolution_scale = static_cast<u64>(std::max(resolution_scale, 1u));
   *ram_usage = MAX_SAVE_STATE_SIZE * static_cast<u64>(num_saves);
   *vram_usage = ((VRAM_WIDTH * real_resolution_scale) * (VRAM_HEIGHT * real_resolution_scale) * 4) *
                 static_cast<u64>(g_settings.gpu_multisamples) * static_cast<u64>(num_saves);
@@ -3868,8 +4052,14 @@ void System::CalculateRewindMemoryUsage(u32 num_saves, u32 resolution_scale, u64
 
 void System::ClearMemorySaveStates()
 {
+  StopRewindDeltaThread();
   s_rewind_states.clear();
   s_runahead_states.clear();
+  s_rewind_delta_base = {};
+  s_rewind_delta_encode_buffer = {};
+  s_rewind_delta_base_valid = false;
+  s_rewind_saves_since_keyframe = 0;
+  s_rewind_memory_usage_logged = false;
 }
 
 void System::UpdateMemorySaveStateSettings()
@@ -3885,9 +4075,18 @@ void System::UpdateMemorySaveStateSettings()
 
     u64 ram_usage, vram_usage;
     CalculateRewindMemoryUsage(g_settings.rewind_save_slots, g_settings.gpu_resolution_scale, &ram_usage, &vram_usage);
-    Log_InfoPrintf(
-      "Rewind is enabled, saving every %d frames, with %u slots and %" PRIu64 "MB RAM and %" PRIu64 "MB VRAM usage",
-      std::max(s_rewind_save_frequency, 1), g_settings.rewind_save_slots, ram_usage / 1048576, vram_usage / 1048576);
+    if (g_settings.rewind_delta_compression)
+    {
+      Log_InfoPrintf("Rewind is enabled, saving every %d frames, with delta compression and a keyframe every %u saves, "
+                     "keeping as many states as fit in %" PRIu64 "MB RAM and no VRAM",
+                     std::max(s_rewind_save_frequency, 1), g_settings.rewind_keyframe_interval, ram_usage / 1048576);
+    }
+    else
+    {
+      Log_InfoPrintf(
+        "Rewind is enabled, saving every %d frames, with %u slots and %" PRIu64 "MB RAM and %" PRIu64 "MB VRAM usage",
+        std::max(s_rewind_save_frequency, 1), g_settings.rewind_save_slots, ram_usage / 1048576, vram_usage / 1048576);
+    }
   }
   else
   {
@@ -3946,6 +4145,9 @@ bool System::SaveRewindState()
   Common::Timer save_timer;
 #endif
 
+  if (g_settings.rewind_delta_compression)
+    return SaveRewindDeltaState();
+
   // try to reuse the frontmost slot
   const u32 save_slots = g_settings.rewind_save_slots;
   MemorySaveState mss;
@@ -3965,15 +4167,410 @@ bool System::SaveRewindState()
                 save_timer.GetTimeMilliseconds());
 #endif
 
+  if (!s_rewind_memory_usage_logged && s_rewind_states.size() >= save_slots)
+    LogRewindMemoryUsage(false);
+
+  return true;
+}
+
+bool System::SaveRewindDeltaState()
+{
+#ifdef PROFILE_MEMORY_SAVE_STATES
+  Common::Timer save_timer;
+#endif
+
+  if (!s_rewind_delta_thread.joinable())
+    StartRewindDeltaThread();
+
+  // Only the snapshot happens on the CPU thread. If the encoder has fallen behind and every buffer is in flight, drop
+  // this save rather than stalling the frame.
+  std::unique_ptr<GrowableMemoryByteStream> stream;
+  {
+    std::unique_lock lock(s_rewind_delta_mutex);
+    if (!s_rewind_delta_free_streams.empty())
+    {
+      stream = std::move(s_rewind_delta_free_streams.back());
+      s_rewind_delta_free_streams.pop_back();
+    }
+    else if (s_rewind_delta_stream_count < REWIND_DELTA_QUEUE_SIZE)
+    {
+      s_rewind_delta_stream_count++;
+    }
+    else
+    {
+      s_rewind_delta_dropped_saves++;
+      Log_DevPrintf("Dropping rewind state, %u saves dropped so far", s_rewind_delta_dropped_saves);
+      return false;
+    }
+  }
+
+  if (!stream)
+    stream = std::make_unique<GrowableMemoryByteStream>(nullptr, MAX_SAVE_STATE_SIZE);
+  else
+    stream->SeekAbsolute(0);
+
+  // RAM and SPU RAM are copied raw in front of everything else, which keeps them at the same offset for diffing.
+  const u32 ram_size = Bus::g_ram_size;
+  stream->Write(&ram_size, sizeof(ram_size));
+  stream->Write(Bus::g_ram, ram_size);
+  stream->Write(SPU::GetRAM().data(), SPU::RAM_SIZE);
+
+  // VRAM goes in the state without a host texture, so it is diffed along with everything else. Hardware renderers
+  // have to read it back for this, and rewinding restores it at native resolution, like loading a save state does.
+  StateWrapper sw(stream.get(), StateWrapper::Mode::Write, SAVE_STATE_VERSION);
+  const bool result = DoState(sw, nullptr, false, true, false);
+
+  std::unique_lock lock(s_rewind_delta_mutex);
+  if (!result)
+  {
+    Log_ErrorPrint("Failed to create rewind state.");
+    s_rewind_delta_free_streams.push_back(std::move(stream));
+    return false;
+  }
+
+  s_rewind_delta_queue.push_back(std::move(stream));
+  s_rewind_delta_work_cv.notify_one();
+
+#ifdef PROFILE_MEMORY_SAVE_STATES
+  Log_DevPrintf("Queued rewind state (%zu pending, took %.4f ms)", s_rewind_delta_queue.size(),
+                save_timer.GetTimeMilliseconds());
+#endif
+
+  return true;
+}
+
+void System::StartRewindDeltaThread()
+{
+  // Settings are captured here, since g_settings can change underneath the worker.
+  CalculateRewindMemoryUsage(1, g_settings.gpu_resolution_scale, &s_rewind_delta_state_ram_estimate,
+                             &s_rewind_delta_state_vram_estimate);
+  s_rewind_delta_budget = s_rewind_delta_state_ram_estimate * g_settings.rewind_save_slots;
+  s_rewind_delta_keyframe_interval = g_settings.rewind_keyframe_interval;
+  s_rewind_delta_thread_shutdown = false;
+  s_rewind_delta_thread = std::thread(RewindDeltaThreadEntryPoint);
+}
+
+void System::StopRewindDeltaThread()
+{
+  if (!s_rewind_delta_thread.joinable())
+    return;
+
+  {
+    std::unique_lock lock(s_rewind_delta_mutex);
+    s_rewind_delta_thread_shutdown = true;
+    s_rewind_delta_work_cv.notify_one();
+  }
+
+  s_rewind_delta_thread.join();
+  s_rewind_delta_queue.clear();
+  s_rewind_delta_free_streams.clear();
+  s_rewind_delta_stream_count = 0;
+  s_rewind_delta_dropped_saves = 0;
+}
+
+void System::WaitForRewindDeltaThread()
+{
+  std::unique_lock lock(s_rewind_delta_mutex);
+  s_rewind_delta_done_cv.wait(lock, []() { return (s_rewind_delta_queue.empty() && !s_rewind_delta_thread_busy); });
+}
+
+void System::RewindDeltaThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("Rewind Encoder");
+
+  std::unique_lock lock(s_rewind_delta_mutex);
+  for (;;)
+  {
+    s_rewind_delta_work_cv.wait(lock,
+                                []() { return (!s_rewind_delta_queue.empty() || s_rewind_delta_thread_shutdown); });
+    if (s_rewind_delta_thread_shutdown)
+      break;
+
+    std::unique_ptr<GrowableMemoryByteStream> stream = std::move(s_rewind_delta_queue.front());
+    s_rewind_delta_queue.pop_front();
+    s_rewind_delta_thread_busy = true;
+
+    const bool keyframe = (s_rewind_states.empty() || !s_rewind_delta_base_valid ||
+                           s_rewind_saves_since_keyframe >= s_rewind_delta_keyframe_interval);
+
+    lock.unlock();
+
+    MemorySaveState mss = EncodeRewindDeltaState(stream.get(), keyframe);
+
+    lock.lock();
+    s_rewind_states.push_back(std::move(mss));
+    if (EvictRewindDeltaStates() && !s_rewind_memory_usage_logged)
+      LogRewindMemoryUsage(true);
+
+    s_rewind_delta_free_streams.push_back(std::move(stream));
+    s_rewind_delta_thread_busy = false;
+    s_rewind_delta_done_cv.notify_all();
+  }
+}
+
+bool System::EvictRewindDeltaStates()
+{
+  // Instead of a fixed number of slots, keep as many states as fit in the system memory that the configured number of
+  // full states would use. VRAM is part of each state, so no GPU memory is held. Deltas are useless without their
+  // keyframe, so the oldest keyframe group is only evicted once the newer states fill the budget by themselves. That
+  // way the history never shrinks below the budget, and never grows past it by more than one group.
+  const auto get_state_size = [](const MemorySaveState& mss) -> u64 {
+    return mss.state_stream ? mss.state_stream->GetMemorySize() : 0;
+  };
+
+  u64 held = 0;
+  for (const MemorySaveState& mss : s_rewind_states)
+    held += get_state_size(mss);
+
+  bool evicted = false;
+  for (;;)
+  {
+    size_t group_length = 0;
+    u64 group_size = 0;
+    do
+    {
+      group_size += get_state_size(s_rewind_states[group_length]);
+      group_length++;
+    } while (group_length < s_rewind_states.size() && !s_rewind_states[group_length].delta_keyframe);
+
+    if (group_length == s_rewind_states.size() || (held - group_size) < s_rewind_delta_budget)
+      break;
+
+    s_rewind_states.erase(s_rewind_states.begin(), s_rewind_states.begin() + group_length);
+    held -= group_size;
+    evicted = true;
+  }
+
+  return evicted;
+}
+
+void System::AddMemorySaveStateSize(const MemorySaveState& mss, u64* ram_size, u64* vram_size)
+{
+  *ram_size += mss.state_stream ? mss.state_stream->GetMemorySize() : 0;
+  if (mss.vram_texture)
+  {
+    *vram_size += static_cast<u64>(mss.vram_texture->GetWidth()) * mss.vram_texture->GetHeight() *
+                  mss.vram_texture->GetSamples() * mss.vram_texture->GetPixelSize();
+  }
+}
+
+System::MemorySaveState System::EncodeRewindDeltaState(const GrowableMemoryByteStream* stream, bool keyframe)
+{
+#ifdef PROFILE_MEMORY_SAVE_STATES
+  Common::Timer encode_timer;
+#endif
+
+  if (keyframe)
+  {
+    s_rewind_delta_base.clear();
+    s_rewind_saves_since_keyframe = 0;
+  }
+
+  const u32 state_size = static_cast<u32>(stream->GetPosition());
+  const u8* state_data = stream->GetMemoryPointer();
+  EncodeRewindDelta(&s_rewind_delta_encode_buffer, state_data, state_size, s_rewind_delta_base);
+
+  // Deltas are usually far smaller than a full state, so allocate exactly what's needed rather than reusing slots.
+  const u32 encoded_size = static_cast<u32>(s_rewind_delta_encode_buffer.size());
+  MemorySaveState mss;
+  mss.state_stream = std::make_unique<GrowableMemoryByteStream>(nullptr, encoded_size);
+  mss.state_stream->Write(s_rewind_delta_encode_buffer.data(), encoded_size);
+  mss.delta_size = state_size;
+  mss.delta_keyframe = keyframe;
+
+  // Base for the next delta is this state, zero-padded to a whole number of words.
+  s_rewind_delta_base.resize(Common::AlignUpPow2(state_size, sizeof(u64)));
+  std::memcpy(s_rewind_delta_base.data(), state_data, state_size);
+  std::memset(s_rewind_delta_base.data() + state_size, 0, s_rewind_delta_base.size() - state_size);
+  s_rewind_delta_base_valid = true;
+  s_rewind_saves_since_keyframe++;
+
+#ifdef PROFILE_MEMORY_SAVE_STATES
+  Log_DevPrintf("Encoded rewind %s (%u bytes, %u encoded, took %.4f ms)", keyframe ? "keyframe" : "delta", state_size,
+                encoded_size, encode_timer.GetTimeMilliseconds());
+#endif
+
+  return mss;
+}
+
+void System::EncodeRewindDelta(std::vector<u8>* out, const u8* data, u32 size, const std::vector<u8>& base)
+{
+  // Encoded as a sequence of [u32 unchanged words][u32 changed words][changed words XOR base], in 64-bit words.
+  // Short runs of unchanged words are folded into the changed run, to avoid wasting space on tiny tokens.
+  static constexpr u32 MIN_UNCHANGED_RUN = 4;
+
+  const u32 num_words = Common::AlignUpPow2(size, sizeof(u64)) / sizeof(u64);
+  const u32 num_base_words = static_cast<u32>(base.size() / sizeof(u64));
+  const auto get_word = [data, size, &base, num_base_words](u32 index) {
+    u64 value = 0;
+    const u32 offset = index * sizeof(u64);
+    std::memcpy(&value, data + offset, std::min<u32>(size - offset, sizeof(u64)));
+    if (index < num_base_words)
+    {
+      u64 base_value;
+      std::memcpy(&base_value, base.data() + offset, sizeof(base_value));
+      value ^= base_value;
+    }
+    return value;
+  };
+
+  out->clear();
+
+  u32 word = 0;
+  while (word < num_words)
+  {
+    const u32 unchanged_start = word;
+    while (word < num_words && get_word(word) == 0)
+      word++;
+    if (word == num_words)
+      break;
+
+    const u32 changed_start = word;
+    u32 unchanged_run = 0;
+    while (word < num_words)
+    {
+      if (get_word(word) != 0)
+      {
+        unchanged_run = 0;
+      }
+      else if (++unchanged_run == MIN_UNCHANGED_RUN)
+      {
+        word++;
+        break;
+      }
+
+      word++;
+    }
+    word -= unchanged_run;
+
+    const u32 header[2] = {changed_start - unchanged_start, word - changed_start};
+    const size_t pos = out->size();
+    out->resize(pos + sizeof(header) + header[1] * sizeof(u64));
+    u8* out_ptr = out->data() + pos;
+    std::memcpy(out_ptr, header, sizeof(header));
+    out_ptr += sizeof(header);
+    for (u32 i = changed_start; i < word; i++, out_ptr += sizeof(u64))
+    {
+      const u64 value = get_word(i);
+      std::memcpy(out_ptr, &value, sizeof(value));
+    }
+  }
+}
+
+void System::ApplyRewindDelta(std::vector<u8>* buffer, const u8* delta, u32 delta_length, u32 size)
+{
+  // Growing zero-fills, which matches the encoder treating missing base words as zero.
+  buffer->resize(Common::AlignUpPow2(size, sizeof(u64)));
+
+  u8* ptr = buffer->data();
+  const u8* const delta_end = delta + delta_length;
+  while (delta < delta_end)
+  {
+    u32 header[2];
+    std::memcpy(header, delta, sizeof(header));
+    delta += sizeof(header);
+    ptr += header[0] * sizeof(u64);
+
+    DebugAssert((ptr + header[1] * sizeof(u64)) <= (buffer->data() + buffer->size()));
+    for (u32 i = 0; i < header[1]; i++, ptr += sizeof(u64), delta += sizeof(u64))
+    {
+      u64 value, delta_value;
+      std::memcpy(&value, ptr, sizeof(value));
+      std::memcpy(&delta_value, delta, sizeof(delta_value));
+      value ^= delta_value;
+      std::memcpy(ptr, &value, sizeof(value));
+    }
+  }
+}
+
+bool System::LoadRewindDeltaState()
+{
+  // Walk back to the keyframe, then reapply each delta up to the newest state.
+  size_t start = s_rewind_states.size() - 1;
+  while (start > 0 && !s_rewind_states[start].delta_keyframe)
+    start--;
+
+  std::vector<u8> buffer;
+  for (size_t i = start; i < s_rewind_states.size(); i++)
+  {
+    const MemorySaveState& mss = s_rewind_states[i];
+    ApplyRewindDelta(&buffer, mss.state_stream->GetMemoryPointer(), static_cast<u32>(mss.state_stream->GetSize()),
+                     mss.delta_size);
+  }
+
+  // RAM and SPU RAM are raw in front of the state, and are copied in once it has set the RAM size.
+  const MemorySaveState& newest = s_rewind_states.back();
+  u32 ram_size = 0;
+  std::memcpy(&ram_size, buffer.data(), sizeof(ram_size));
+  const u32 raw_size = sizeof(ram_size) + ram_size + SPU::RAM_SIZE;
+
+  bool result = (newest.delta_size > raw_size);
+  if (result)
+  {
+    std::unique_ptr<ReadOnlyMemoryByteStream> stream =
+      ByteStream::CreateReadOnlyMemoryStream(buffer.data() + raw_size, newest.delta_size - raw_size);
+    StateWrapper sw(stream.get(), StateWrapper::Mode::Read, SAVE_STATE_VERSION);
+    result = (DoState(sw, nullptr, true, true, false) && ram_size == Bus::g_ram_size);
+  }
+  if (!result)
+  {
+    Host::ReportErrorAsync("Error", "Failed to load memory save state, resetting.");
+    InternalReset();
+    return false;
+  }
+
+  std::memcpy(Bus::g_ram, buffer.data() + sizeof(ram_size), ram_size);
+  std::memcpy(SPU::GetWritableRAM().data(), buffer.data() + sizeof(ram_size) + ram_size, SPU::RAM_SIZE);
+
+  // Next save can be diffed against the state we just loaded.
+  s_rewind_delta_base = std::move(buffer);
+  s_rewind_delta_base_valid = true;
   return true;
 }
 
+void System::LogRewindMemoryUsage(bool delta_compression)
+{
+  u64 ram_held = 0;
+  u64 vram_held = 0;
+  u32 keyframes = 0;
+  for (const MemorySaveState& mss : s_rewind_states)
+  {
+    AddMemorySaveStateSize(mss, &ram_held, &vram_held);
+    keyframes += BoolToUInt32(mss.delta_keyframe);
+  }
+
+  // The delta encoder runs off the CPU thread, so it uses the estimate from when it started, not g_settings.
+  const u32 num_states = static_cast<u32>(s_rewind_states.size());
+  u64 ram_estimate, vram_estimate;
+  if (delta_compression)
+  {
+    ram_estimate = s_rewind_delta_state_ram_estimate * num_states;
+    vram_estimate = s_rewind_delta_state_vram_estimate * num_states;
+  }
+  else
+  {
+    CalculateRewindMemoryUsage(num_states, g_settings.gpu_resolution_scale, &ram_estimate, &vram_estimate);
+  }
+
+  Log_InfoPrintf("Rewind buffer holds %zu states (%u keyframes) in %" PRIu64 " KB RAM and %" PRIu64
+                 " KB VRAM, estimated %" PRIu64 " KB RAM and %" PRIu64 " KB VRAM",
+                 s_rewind_states.size(), keyframes, ram_held / 1024, vram_held / 1024, ram_estimate / 1024,
+                 vram_estimate / 1024);
+  s_rewind_memory_usage_logged = true;
+}
+
 bool System::LoadRewindState(u32 skip_saves /*= 0*/, bool consume_state /*=true */)
 {
+  // Make sure any states still being encoded have made it into the list.
+  if (s_rewind_delta_thread.joinable())
+    WaitForRewindDeltaThread();
+
   while (skip_saves > 0 && !s_rewind_states.empty())
   {
-    g_gpu_device->RecycleTexture(std::move(s_rewind_states.back().vram_texture));
+    if (s_rewind_states.back().vram_texture)
+      g_gpu_device->RecycleTexture(std::move(s_rewind_states.back().vram_texture));
     s_rewind_states.pop_back();
+    s_rewind_delta_base_valid = false;
     skip_saves--;
   }
 
@@ -3984,11 +4581,15 @@ bool System::LoadRewindState(u32 skip_saves /*= 0*/, bool consume_state /*=true
   Common::Timer load_timer;
 #endif
 
-  if (!LoadMemoryState(s_rewind_states.back()))
+  const bool is_delta_state = (s_rewind_states.back().delta_size > 0);
+  if (is_delta_state ? !LoadRewindDeltaState() : !LoadMemoryState(s_rewind_states.back()))
     return false;
 
   if (consume_state)
+  {
     s_rewind_states.pop_back();
+    s_rewind_delta_base_valid = false;
+  }
 
 #ifdef PROFILE_MEMORY_SAVE_STATES
   Log_DevPrintf("Rewind load took %.4f ms", load_timer.GetTimeMilliseconds());
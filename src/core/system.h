@@ -224,6 +224,9 @@ float GetCPUThreadUsage();
 float GetCPUThreadAverageTime();
 float GetSWThreadUsage();
 float GetSWThreadAverageTime();
+u32 GetSWQueueAverageDepth();
+u32 GetSWQueueMaxDepth();
+float GetSWStallAverageTime();
 float GetGPUUsage();
 float GetGPUAverageTime();
 const FrameTimeHistory& GetFrameTimeHistory();
@@ -241,6 +244,11 @@ bool ReloadGameSettings(bool display_osd_messages);
 
 bool BootSystem(SystemBootParameters parameters);
 void PauseSystem(bool paused);
+
+/// Creates only the GPU, and the timers, DMA and interrupt controller it signals, without a BIOS, CPU or memory. Used
+/// for replaying GPU dumps, the system stays shut down. Must be released with DestroyGPUOnly().
+bool CreateGPUOnly();
+void DestroyGPUOnly();
 void ResetSystem();
 
 /// Loads state from the specified filename.
@@ -253,6 +261,11 @@ struct MemorySaveState
 {
   std::unique_ptr<GPUTexture> vram_texture;
   std::unique_ptr<GrowableMemoryByteStream> state_stream;
+
+  // For delta-compressed rewind states, state_stream holds the encoded difference against the previous state (or
+  // against zero for keyframes), and delta_size is the size of the state once decoded.
+  u32 delta_size = 0;
+  bool delta_keyframe = false;
 };
 bool SaveMemoryState(MemorySaveState* mss);
 bool LoadMemoryState(const MemorySaveState& mss);
@@ -355,6 +368,10 @@ void UpdateSpeedLimiterState();
 bool IsFastForwardEnabled();
 void SetFastForwardEnabled(bool enabled);
 
+/// Benchmark mode runs unthrottled, with host time attributed to each subsystem. See subsystem_profiler.h.
+bool IsBenchmarkModeEnabled();
+void SetBenchmarkModeEnabled(bool enabled);
+
 /// Toggles turbo state.
 bool IsTurboEnabled();
 void SetTurboEnabled(bool enabled);
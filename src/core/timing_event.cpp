@@ -6,14 +6,35 @@
 #include "common/log.h"
 #include "cpu_core.h"
 #include "cpu_core_private.h"
+#include "subsystem_profiler.h"
 #include "system.h"
 #include "util/state_wrapper.h"
+
+#include <algorithm>
+
 Log_SetChannel(TimingEvents);
 
 namespace TimingEvents {
 
+#if TIMING_EVENTS_USE_HEAP
+static void SortEvent(TimingEvent* event, TickCount old_downcount);
+#else
+static void SortEvent(TimingEvent* event);
+#endif
+static void AddActiveEvent(TimingEvent* event);
+static void RemoveActiveEvent(TimingEvent* event);
+static std::vector<TimingEvent*> GetActiveEventsInOrder();
+static void SortEvents(const std::vector<TimingEvent*>& events);
+static TimingEvent* FindActiveEvent(const char* name);
+
 static TimingEvent* s_active_events_head;
+#if TIMING_EVENTS_USE_HEAP
+static std::vector<TimingEvent*> s_active_events;
+static s64 s_next_front_order = 0;
+static s64 s_next_back_order = 1;
+#else
 static TimingEvent* s_active_events_tail;
+#endif
 static TimingEvent* s_current_event = nullptr;
 static u32 s_active_event_count = 0;
 static u32 s_global_tick_counter = 0;
@@ -61,6 +82,155 @@ TimingEvent** GetHeadEventPtr()
   return &s_active_events_head;
 }
 
+#if TIMING_EVENTS_USE_HEAP
+
+// Ties are broken by m_order, a sequence number which reproduces where the list would insert the event: in front of
+// other events with the same downcount when it is added or moved later, and behind them when it is moved earlier.
+ALWAYS_INLINE static bool IsEventBefore(const TimingEvent* lhs, const TimingEvent* rhs)
+{
+  return (lhs->m_downcount < rhs->m_downcount ||
+          (lhs->m_downcount == rhs->m_downcount && lhs->m_order < rhs->m_order));
+}
+
+ALWAYS_INLINE static void SetHeapEvent(u32 index, TimingEvent* event)
+{
+  s_active_events[index] = event;
+  event->m_heap_index = index;
+}
+
+static void SiftUp(u32 index)
+{
+  TimingEvent* event = s_active_events[index];
+  while (index > 0)
+  {
+    const u32 parent = (index - 1) / 2;
+    if (!IsEventBefore(event, s_active_events[parent]))
+      break;
+
+    SetHeapEvent(index, s_active_events[parent]);
+    index = parent;
+  }
+
+  SetHeapEvent(index, event);
+}
+
+static void SiftDown(u32 index)
+{
+  TimingEvent* event = s_active_events[index];
+  const u32 count = static_cast<u32>(s_active_events.size());
+  for (;;)
+  {
+    u32 child = (index * 2) + 1;
+    if (child >= count)
+      break;
+    if ((child + 1) < count && IsEventBefore(s_active_events[child + 1], s_active_events[child]))
+      child++;
+    if (!IsEventBefore(s_active_events[child], event))
+      break;
+
+    SetHeapEvent(index, s_active_events[child]);
+    index = child;
+  }
+
+  SetHeapEvent(index, event);
+}
+
+static void SiftEvent(u32 index)
+{
+  if (index > 0 && IsEventBefore(s_active_events[index], s_active_events[(index - 1) / 2]))
+    SiftUp(index);
+  else
+    SiftDown(index);
+}
+
+static void UpdateHeadEvent()
+{
+  TimingEvent* head = s_active_events.empty() ? nullptr : s_active_events.front();
+  if (s_active_events_head == head)
+    return;
+
+  s_active_events_head = head;
+  if (head)
+    UpdateCPUDowncount();
+}
+
+static void SortEvent(TimingEvent* event, TickCount old_downcount)
+{
+  if (event == s_current_event)
+  {
+    // The list leaves the running event at the head until its callback returns, and then sorts it forwards, in front
+    // of any events with the same downcount. The heap can't be left out of order, so sort it now, the same way.
+    event->m_order = s_next_front_order--;
+  }
+  else
+  {
+    if (event->m_downcount == old_downcount)
+      return;
+
+    event->m_order = (event->m_downcount < old_downcount) ? s_next_back_order++ : s_next_front_order--;
+  }
+
+  SiftEvent(event->m_heap_index);
+  UpdateHeadEvent();
+}
+
+static void AddActiveEvent(TimingEvent* event)
+{
+  s_active_event_count++;
+
+  event->m_order = s_next_front_order--;
+  s_active_events.push_back(event);
+  SiftUp(static_cast<u32>(s_active_events.size() - 1));
+  UpdateHeadEvent();
+}
+
+static void RemoveActiveEvent(TimingEvent* event)
+{
+  DebugAssert(s_active_event_count > 0 && s_active_events[event->m_heap_index] == event);
+
+  const u32 index = event->m_heap_index;
+  TimingEvent* last = s_active_events.back();
+  s_active_events.pop_back();
+  if (last != event)
+  {
+    SetHeapEvent(index, last);
+    SiftEvent(index);
+  }
+
+  s_active_event_count--;
+  UpdateHeadEvent();
+}
+
+static std::vector<TimingEvent*> GetActiveEventsInOrder()
+{
+  std::vector<TimingEvent*> events(s_active_events);
+  std::sort(events.begin(), events.end(), IsEventBefore);
+  return events;
+}
+
+static void SortEvents(const std::vector<TimingEvent*>& events)
+{
+  s_active_events.clear();
+  s_active_events_head = nullptr;
+  s_active_event_count = 0;
+
+  for (TimingEvent* event : events)
+    AddActiveEvent(event);
+}
+
+static TimingEvent* FindActiveEvent(const char* name)
+{
+  for (TimingEvent* event : s_active_events)
+  {
+    if (event->GetName().compare(name) == 0)
+      return event;
+  }
+
+  return nullptr;
+}
+
+#else
+
 static void SortEvent(TimingEvent* event)
 {
   const TickCount event_downcount = event->m_downcount;
@@ -235,19 +405,22 @@ static void RemoveActiveEvent(TimingEvent* event)
   s_active_event_count--;
 }
 
-static void SortEvents()
+static std::vector<TimingEvent*> GetActiveEventsInOrder()
 {
   std::vector<TimingEvent*> events;
   events.reserve(s_active_event_count);
+  for (TimingEvent* event = s_active_events_head; event; event = event->next)
+    events.push_back(event);
 
-  TimingEvent* next = s_active_events_head;
-  while (next)
+  return events;
+}
+
+static void SortEvents(const std::vector<TimingEvent*>& events)
+{
+  for (TimingEvent* event : events)
   {
-    TimingEvent* current = next;
-    events.push_back(current);
-    next = current->next;
-    current->prev = nullptr;
-    current->next = nullptr;
+    event->prev = nullptr;
+    event->next = nullptr;
   }
 
   s_active_events_head = nullptr;
@@ -269,6 +442,8 @@ static TimingEvent* FindActiveEvent(const char* name)
   return nullptr;
 }
 
+#endif
+
 bool IsRunningEvents()
 {
   return (s_current_event != nullptr);
@@ -283,6 +458,7 @@ void SetFrameDone()
 void RunEvents()
 {
   DebugAssert(!s_current_event);
+  SubsystemProfiler::Scope profile_scope(SubsystemProfiler::Subsystem::TimingEvents);
 
   do
   {
@@ -302,7 +478,11 @@ void RunEvents()
 
         // Apply downcount to all events.
         // This will result in a negative downcount for those events which are late.
+#if TIMING_EVENTS_USE_HEAP
+        for (TimingEvent* event : s_active_events)
+#else
         for (TimingEvent* event = s_active_events_head; event; event = event->next)
+#endif
         {
           event->m_downcount -= time;
           event->m_time_since_last_run += time;
@@ -318,13 +498,23 @@ void RunEvents()
           // Factor late time into the time for the next invocation.
           const TickCount ticks_late = -event->m_downcount;
           const TickCount ticks_to_execute = event->m_time_since_last_run;
+#if TIMING_EVENTS_USE_HEAP
+          const TickCount old_downcount = event->m_downcount;
+#endif
           event->m_downcount += event->m_interval;
           event->m_time_since_last_run = 0;
 
+#if TIMING_EVENTS_USE_HEAP
+          // The heap has to stay in order while the callback runs, in case it schedules other events.
+          SortEvent(event, old_downcount);
+#endif
+
           // The cycles_late is only an indicator, it doesn't modify the cycles to execute.
           event->m_callback(event->m_callback_param, ticks_to_execute, ticks_late);
+#if !TIMING_EVENTS_USE_HEAP
           if (event->m_active)
             SortEvent(event);
+#endif
         }
       } while (pending_ticks > 0);
 
@@ -334,6 +524,8 @@ void RunEvents()
     if (s_frame_done)
     {
       s_frame_done = false;
+
+      SubsystemProfiler::Scope frame_scope(SubsystemProfiler::Subsystem::Host);
       System::FrameDone();
     }
 
@@ -349,6 +541,8 @@ bool DoState(StateWrapper& sw)
   {
     // Load timestamps for the clock events.
     // Any oneshot events should be recreated by the load state method, so we can fix up their times here.
+    // The events are re-added in their current order afterwards, capture it before changing any downcounts.
+    const std::vector<TimingEvent*> events = GetActiveEventsInOrder();
     u32 event_count = 0;
     sw.Do(&event_count);
 
@@ -385,14 +579,14 @@ bool DoState(StateWrapper& sw)
     }
 
     Log_DebugPrintf("Loaded %u events from save state.", event_count);
-    SortEvents();
+    SortEvents(events);
   }
   else
   {
 
     sw.Do(&s_active_event_count);
 
-    for (TimingEvent* event = s_active_events_head; event; event = event->next)
+    for (TimingEvent* event : GetActiveEventsInOrder())
     {
       sw.Do(&event->m_name);
       sw.Do(&event->m_downcount);
@@ -440,10 +634,17 @@ void TimingEvent::Delay(TickCount ticks)
     return;
   }
 
+#if TIMING_EVENTS_USE_HEAP
+  const TickCount old_downcount = m_downcount;
+#endif
   m_downcount += ticks;
 
   DebugAssert(TimingEvents::s_current_event != this);
+#if TIMING_EVENTS_USE_HEAP
+  TimingEvents::SortEvent(this, old_downcount);
+#else
   TimingEvents::SortEvent(this);
+#endif
   if (TimingEvents::s_active_events_head == this)
     TimingEvents::UpdateCPUDowncount();
 }
@@ -451,6 +652,9 @@ void TimingEvent::Delay(TickCount ticks)
 void TimingEvent::Schedule(TickCount ticks)
 {
   const TickCount pending_ticks = CPU::GetPendingTicks();
+#if TIMING_EVENTS_USE_HEAP
+  const TickCount old_downcount = m_downcount;
+#endif
   m_downcount = pending_ticks + ticks;
 
   if (!m_active)
@@ -463,6 +667,12 @@ void TimingEvent::Schedule(TickCount ticks)
   else
   {
     // Event is already active, so we leave the time since last run alone, and just modify the downcount.
+#if TIMING_EVENTS_USE_HEAP
+    // The heap sorts the running event before its callback, so it has to be re-sorted here too.
+    TimingEvents::SortEvent(this, old_downcount);
+    if (TimingEvents::s_active_events_head == this)
+      TimingEvents::UpdateCPUDowncount();
+#else
     // If this is a call from an IO handler for example, re-sort the event queue.
     if (TimingEvents::s_current_event != this)
     {
@@ -470,6 +680,7 @@ void TimingEvent::Schedule(TickCount ticks)
       if (TimingEvents::s_active_events_head == this)
         TimingEvents::UpdateCPUDowncount();
     }
+#endif
   }
 }
 
@@ -491,14 +702,23 @@ void TimingEvent::Reset()
   if (!m_active)
     return;
 
+#if TIMING_EVENTS_USE_HEAP
+  const TickCount old_downcount = m_downcount;
+#endif
   m_downcount = m_interval;
   m_time_since_last_run = 0;
+#if TIMING_EVENTS_USE_HEAP
+  TimingEvents::SortEvent(this, old_downcount);
+  if (TimingEvents::s_active_events_head == this)
+    TimingEvents::UpdateCPUDowncount();
+#else
   if (TimingEvents::s_current_event != this)
   {
     TimingEvents::SortEvent(this);
     if (TimingEvents::s_active_events_head == this)
       TimingEvents::UpdateCPUDowncount();
   }
+#endif
 }
 
 void TimingEvent::InvokeEarly(bool force /* = false */)
@@ -511,15 +731,27 @@ void TimingEvent::InvokeEarly(bool force /* = false */)
   if ((!force && ticks_to_execute < m_period) || ticks_to_execute <= 0)
     return;
 
+#if TIMING_EVENTS_USE_HEAP
+  const TickCount old_downcount = m_downcount;
+#endif
   m_downcount = pending_ticks + m_interval;
   m_time_since_last_run -= ticks_to_execute;
-  m_callback(m_callback_param, ticks_to_execute, 0);
 
-  // Since we've changed the downcount, we need to re-sort the events.
+  // Since we've changed the downcount, we need to re-sort the events. The heap has to do it before the callback.
   DebugAssert(TimingEvents::s_current_event != this);
+#if TIMING_EVENTS_USE_HEAP
+  TimingEvents::SortEvent(this, old_downcount);
+  if (TimingEvents::s_active_events_head == this)
+    TimingEvents::UpdateCPUDowncount();
+#endif
+
+  m_callback(m_callback_param, ticks_to_execute, 0);
+
+#if !TIMING_EVENTS_USE_HEAP
   TimingEvents::SortEvent(this);
   if (TimingEvents::s_active_events_head == this)
     TimingEvents::UpdateCPUDowncount();
+#endif
 }
 
 void TimingEvent::Activate()
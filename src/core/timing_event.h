@@ -9,6 +9,15 @@
 
 #include "types.h"
 
+// Active events are kept in a sorted linked list by default. Building with TIMING_EVENTS_USE_HEAP=1 keeps them in a
+// binary heap instead, making reschedules O(log n) rather than O(n). The order is not always the same: the list leaves
+// the running event at the head until its callback returns, so events scheduled from a callback can be inserted ahead
+// of earlier ones and fire late. The heap always fires the earliest event first, so timings can differ when callbacks
+// reschedule other events.
+#ifndef TIMING_EVENTS_USE_HEAP
+#define TIMING_EVENTS_USE_HEAP 0
+#endif
+
 class StateWrapper;
 
 // Event callback type. Second parameter is the number of cycles the event was executed "late".
@@ -63,8 +72,14 @@ public:
   void SetInterval(TickCount interval) { m_interval = interval; }
   void SetPeriod(TickCount period) { m_period = period; }
 
+#if TIMING_EVENTS_USE_HEAP
+  // Position in the heap, and tie-breaker for events with the same downcount.
+  u32 m_heap_index = 0;
+  s64 m_order = 0;
+#else
   TimingEvent* prev = nullptr;
   TimingEvent* next = nullptr;
+#endif
 
   TimingEventCallback m_callback;
   void* m_callback_param;
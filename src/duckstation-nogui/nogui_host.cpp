@@ -14,6 +14,7 @@
 #include "core/host.h"
 #include "core/imgui_overlays.h"
 #include "core/settings.h"
+#include "core/subsystem_profiler.h"
 #include "core/system.h"
 
 #include "util/gpu_device.h"
@@ -34,6 +35,7 @@
 #include "common/path.h"
 #include "common/string_util.h"
 #include "common/threading.h"
+#include "common/timer.h"
 
 #include <cinttypes>
 #include <cmath>
@@ -88,6 +90,7 @@ static void UpdateWindowTitle(const std::string& game_title);
 static void CancelAsyncOp();
 static void StartAsyncOp(std::function<void(ProgressCallback*)> callback);
 static void AsyncOpThreadEntryPoint(std::function<void(ProgressCallback*)> callback);
+static void UpdateBenchmark();
 } // namespace NoGUIHost
 
 //////////////////////////////////////////////////////////////////////////
@@ -97,6 +100,10 @@ static std::unique_ptr<INISettingsInterface> s_base_settings_interface;
 static bool s_batch_mode = false;
 static bool s_is_fullscreen = false;
 static bool s_was_paused_by_focus_loss = false;
+static u32 s_benchmark_frames = 0;
+static u32 s_benchmark_frames_run = 0;
+static std::string s_benchmark_report_filename;
+static Common::Timer s_benchmark_timer;
 
 static Threading::Thread s_cpu_thread;
 static Threading::KernelSemaphore s_platform_window_updated;
@@ -731,6 +738,14 @@ void Host::OnSystemStarting()
 
 void Host::OnSystemStarted()
 {
+  if (s_benchmark_frames > 0)
+  {
+    Log_InfoPrintf("Running benchmark for %u frames...", s_benchmark_frames);
+    System::SetBenchmarkModeEnabled(true);
+    SubsystemProfiler::Reset();
+    s_benchmark_frames_run = 0;
+    s_benchmark_timer.Reset();
+  }
 }
 
 void Host::OnSystemPaused()
@@ -809,6 +824,21 @@ void Host::PumpMessagesOnCPUThread()
 {
   NoGUIHost::ProcessCPUThreadPlatformMessages();
   NoGUIHost::ProcessCPUThreadEvents(false);
+  NoGUIHost::UpdateBenchmark();
+}
+
+void NoGUIHost::UpdateBenchmark()
+{
+  if (!System::IsBenchmarkModeEnabled() || !System::IsRunning() || ++s_benchmark_frames_run < s_benchmark_frames)
+    return;
+
+  const double elapsed = s_benchmark_timer.GetTimeSeconds();
+  SubsystemProfiler::LogReport(s_benchmark_frames_run, elapsed);
+  if (!s_benchmark_report_filename.empty())
+    SubsystemProfiler::WriteReport(s_benchmark_report_filename.c_str(), s_benchmark_frames_run, elapsed);
+
+  System::ShutdownSystem(false);
+  s_running.store(false, std::memory_order_release);
 }
 
 std::unique_ptr<NoGUIPlatform> NoGUIHost::CreatePlatform()
@@ -1035,6 +1065,9 @@ void NoGUIHost::PrintCommandLineHelp(const char* progname)
   std::fprintf(stderr, "  -settings <filename>: Loads a custom settings configuration from the\n"
                        "    specified filename. Default settings applied if file not found.\n");
   std::fprintf(stderr, "  -earlyconsole: Creates console as early as possible, for logging.\n");
+  std::fprintf(stderr, "  -benchmark <frames>: Runs the specified number of frames unthrottled, logs the time\n"
+                       "    spent in each emulated subsystem, and exits.\n");
+  std::fprintf(stderr, "  -benchmarkreport <filename>: Writes the benchmark results to a JSON file.\n");
   std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
                        "    parameters make up the filename. Use when the filename contains\n"
                        "    spaces or starts with a dash.\n");
@@ -1155,6 +1188,24 @@ bool NoGUIHost::ParseCommandLineParametersAndInitializeConfig(int argc, char* ar
         Log_InfoPrintf("Command Line: Overriding settings filename: %s", settings_filename.c_str());
         continue;
       }
+      else if (CHECK_ARG_PARAM("-benchmark"))
+      {
+        s_benchmark_frames = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_benchmark_frames == 0)
+        {
+          Log_ErrorPrintf("Invalid benchmark frame count");
+          return false;
+        }
+
+        Log_InfoPrintf("Command Line: Benchmarking for %u frames.", s_benchmark_frames);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-benchmarkreport"))
+      {
+        s_benchmark_report_filename = argv[++i];
+        Log_InfoPrintf("Command Line: Writing benchmark report to '%s'.", s_benchmark_report_filename.c_str());
+        continue;
+      }
       else if (CHECK_ARG("-earlyconsole"))
       {
         InitializeEarlyConsole();
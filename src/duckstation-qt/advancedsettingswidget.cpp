@@ -311,6 +311,14 @@ void AdvancedSettingsWidget::addTweakOptions()
                         "RecompilerMemoryExceptions", false);
   addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Block Linking"), "CPU",
                         "RecompilerBlockLinking", true);
+  addIntRangeTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Recompiler Compile Threshold"), "CPU",
+                         "RecompilerCompileThreshold", 0, Settings::MAX_CPU_RECOMPILER_COMPILE_THRESHOLD, 0);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Jump Following"), "CPU", "RecompilerFollowJumps",
+                        false);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Superblocks"), "CPU",
+                        "RecompilerSuperblocks", false);
+  addBooleanTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Skip Idle Loops"), "CPU", "RecompilerIdleLoopSkipping",
+                        false);
   addChoiceTweakOption(m_dialog, m_ui.tweakOptionTable, tr("Enable Recompiler Fast Memory Access"), "CPU",
                        "FastmemMode", Settings::ParseCPUFastmemMode, Settings::GetCPUFastmemModeName,
                        Settings::GetCPUFastmemModeDisplayName, static_cast<u32>(CPUFastmemMode::Count),
@@ -395,6 +403,9 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
                              Settings::DEFAULT_GPU_PGXP_DEPTH_THRESHOLD); // PGXP depth clear threshold
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);             // Recompiler memory exceptions
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, true);              // Recompiler block linking
+    setIntRangeTweakOption(m_ui.tweakOptionTable, i++, 0);                // Recompiler compile threshold
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);             // Recompiler jump following
+    setBooleanTweakOption(m_ui.tweakOptionTable, i++, true);              // Skip idle loops
     setChoiceTweakOption(m_ui.tweakOptionTable, i++, Settings::DEFAULT_CPU_FASTMEM_MODE); // Recompiler fastmem mode
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, false);                             // Use Old MDEC Routines
     setBooleanTweakOption(m_ui.tweakOptionTable, i++, false); // VRAM write texture replacement
@@ -453,6 +464,10 @@ void AdvancedSettingsWidget::onResetToDefaultClicked()
   sif->DeleteValue("GPU", "PGXPDepthClearThreshold");
   sif->DeleteValue("CPU", "RecompilerMemoryExceptions");
   sif->DeleteValue("CPU", "RecompilerBlockLinking");
+  sif->DeleteValue("CPU", "RecompilerCompileThreshold");
+  sif->DeleteValue("CPU", "RecompilerFollowJumps");
+  sif->DeleteValue("CPU", "RecompilerSuperblocks");
+  sif->DeleteValue("CPU", "RecompilerIdleLoopSkipping");
   sif->DeleteValue("CPU", "FastmemMode");
   sif->DeleteValue("TextureReplacements", "EnableVRAMWriteReplacements");
   sif->DeleteValue("TextureReplacements", "PreloadTextures");
@@ -2,10 +2,21 @@
 // SPDX-License-Identifier: (GPL-3.0 OR CC-BY-NC-ND-4.0)
 
 #include "core/achievements.h"
+#include "core/bus.h"
+#include "core/cpu_code_cache.h"
+#include "core/cpu_core.h"
+#include "core/dma.h"
 #include "core/game_list.h"
 #include "core/gpu.h"
+#include "core/gpu_dump.h"
+#include "core/gpu_sw.h"
+#include "core/gte.h"
 #include "core/host.h"
+#include "core/settings.h"
+#include "core/spu.h"
+#include "core/subsystem_profiler.h"
 #include "core/system.h"
+#include "core/timing_event.h"
 
 #include "scmversion/scmversion.h"
 
@@ -16,14 +27,18 @@
 
 #include "common/assert.h"
 #include "common/crash_handler.h"
+#include "common/error.h"
 #include "common/file_system.h"
 #include "common/log.h"
 #include "common/memory_settings_interface.h"
 #include "common/path.h"
+#include "common/perf_scope.h"
 #include "common/string_util.h"
+#include "common/timer.h"
 
 #include <csignal>
 #include <cstdio>
+#include <cstring>
 
 Log_SetChannel(RegTestHost);
 
@@ -36,6 +51,20 @@ static void InitializeEarlyConsole();
 static void HookSignals();
 static bool SetFolders();
 static std::string GetFrameDumpFilename(u32 frame);
+static void UpdateRasterizerStats(u32 frame);
+static bool PrintRasterizerStatsSummary();
+static bool RunGameListBenchmark(const std::string& path);
+static bool RunTimingEventBenchmark(u32 iterations);
+static bool RunGTESIMDCheck(u32 iterations);
+static bool RunVRAMUploadBenchmark(u32 iterations);
+static bool StartGPURecording();
+static const char* GetGP0CommandName(u32 command);
+static bool RunGPUReplay(const std::string& path, double* elapsed_seconds);
+static bool HashAudioDump();
+static bool WriteReport(const char* status, double elapsed_seconds);
+static bool OpenHashLog();
+static bool LoadGoldenHashLog();
+static void UpdateFrameHash(u32 frame);
 } // namespace RegTestHost
 
 static std::unique_ptr<MemorySettingsInterface> s_base_settings_interface;
@@ -44,6 +73,37 @@ static u32 s_frames_to_run = 60 * 60;
 static u32 s_frame_dump_interval = 0;
 static std::string s_dump_base_directory;
 static std::string s_dump_game_directory;
+static std::string s_game_list_benchmark_path;
+static u32 s_timing_event_benchmark_iterations = 0;
+static u32 s_gte_simd_check_iterations = 0;
+static u32 s_vram_upload_benchmark_iterations = 0;
+static std::string s_gpu_record_filename;
+static u32 s_gpu_record_start_frame = 0;
+static bool s_gpu_record_failed = false;
+static std::string s_gpu_replay_filename;
+static std::string s_audio_dump_filename;
+static std::optional<u64> s_audio_dump_hash;
+static std::optional<u64> s_expected_audio_hash;
+static std::string s_report_filename;
+static std::string s_benchmark_report_filename;
+static std::string s_block_stats_filename;
+static std::string s_game_serial;
+static std::string s_game_title;
+static u32 s_frames_executed = 0;
+static float s_target_frame_rate = 0.0f;
+static std::vector<std::pair<u32, u64>> s_frame_hashes;
+static std::string s_hash_log_filename;
+static std::string s_golden_hash_log_filename;
+static FileSystem::ManagedCFilePtr s_hash_log_file;
+static std::unordered_map<u32, u64> s_golden_hashes;
+static u32 s_golden_mismatches = 0;
+static u32 s_golden_mismatch_dumps = 0;
+static u32 s_first_golden_mismatch = 0;
+
+// Divergence usually persists once it happens, so don't fill the disk with every frame after it.
+static constexpr u32 MAX_GOLDEN_MISMATCH_DUMPS = 16;
+static GPU_SW_Backend::RasterizerStats s_rasterizer_stats = {};
+static GPU_SW_Backend::RasterizerStats s_total_rasterizer_stats = {};
 
 bool RegTestHost::SetFolders()
 {
@@ -258,6 +318,8 @@ void Host::OnGameChanged(const std::string& disc_path, const std::string& game_s
   Log_InfoPrintf("Disc Path: %s", disc_path.c_str());
   Log_InfoPrintf("Game Serial: %s", game_serial.c_str());
   Log_InfoPrintf("Game Name: %s", game_name.c_str());
+  s_game_serial = game_serial;
+  s_game_title = game_name;
 
   if (!s_dump_base_directory.empty())
   {
@@ -275,9 +337,23 @@ void Host::OnGameChanged(const std::string& disc_path, const std::string& game_s
 
 void Host::PumpMessagesOnCPUThread()
 {
+  s_frames_executed++;
+  s_target_frame_rate = System::GetThrottleFrequency();
+  if (!s_gpu_record_filename.empty() && s_gpu_record_start_frame > 0 && s_frames_executed == s_gpu_record_start_frame &&
+      !RegTestHost::StartGPURecording())
+  {
+    System::ShutdownSystem(false);
+    return;
+  }
+
   s_frames_to_run--;
   if (s_frames_to_run == 0)
+  {
+    if (g_gpu->IsRecording() && !g_gpu->StopRecording())
+      s_gpu_record_failed = true;
+
     System::ShutdownSystem(false);
+  }
 }
 
 void Host::RunOnCPUThread(std::function<void()> function, bool block /* = false */)
@@ -325,12 +401,717 @@ void Host::ReleaseRenderWindow()
 
 void Host::BeginPresentFrame()
 {
-  const u32 frame = System::GetFrameNumber();
+  // Replays don't run the system, so count the frames replayed instead.
+  const u32 frame = s_gpu_replay_filename.empty() ? System::GetFrameNumber() : s_frames_executed;
   if (s_frame_dump_interval > 0 && (s_frame_dump_interval == 1 || (frame % s_frame_dump_interval) == 0))
   {
-    std::string dump_filename(RegTestHost::GetFrameDumpFilename(frame));
-    g_gpu->WriteDisplayTextureToFile(std::move(dump_filename));
+    if (!s_dump_game_directory.empty())
+    {
+      std::string dump_filename(RegTestHost::GetFrameDumpFilename(frame));
+      g_gpu->WriteDisplayTextureToFile(std::move(dump_filename));
+    }
+
+    if (!s_report_filename.empty())
+      s_frame_hashes.emplace_back(frame, g_gpu->GetVRAMHash());
+  }
+
+  RegTestHost::UpdateFrameHash(frame);
+  RegTestHost::UpdateRasterizerStats(frame);
+}
+
+bool RegTestHost::OpenHashLog()
+{
+  s_hash_log_file = FileSystem::OpenManagedCFile(s_hash_log_filename.c_str(), "wb");
+  if (!s_hash_log_file)
+  {
+    Log_ErrorPrintf("Failed to open hash log '%s'.", s_hash_log_filename.c_str());
+    return false;
+  }
+
+  Log_InfoPrintf("Writing frame hashes to '%s'.", s_hash_log_filename.c_str());
+  return true;
+}
+
+bool RegTestHost::LoadGoldenHashLog()
+{
+  const std::optional<std::string> data = FileSystem::ReadFileToString(s_golden_hash_log_filename.c_str());
+  if (!data.has_value())
+  {
+    Log_ErrorPrintf("Failed to read golden hash log '%s'.", s_golden_hash_log_filename.c_str());
+    return false;
+  }
+
+  // One "<frame> <hash>" pair per line, as written by -hashlog.
+  u32 line_number = 0;
+  for (const std::string_view line : StringUtil::SplitString(data.value(), '\n'))
+  {
+    line_number++;
+    const std::string_view trimmed = StringUtil::StripWhitespace(line);
+    if (trimmed.empty())
+      continue;
+
+    const std::string_view::size_type pos = trimmed.find(' ');
+    const std::optional<u32> frame =
+      (pos != std::string_view::npos) ? StringUtil::FromChars<u32>(trimmed.substr(0, pos)) : std::nullopt;
+    const std::optional<u64> hash =
+      (pos != std::string_view::npos) ? StringUtil::FromChars<u64>(trimmed.substr(pos + 1), 16) : std::nullopt;
+    if (!frame.has_value() || !hash.has_value())
+    {
+      Log_ErrorPrintf("Malformed line %u in golden hash log '%s'.", line_number, s_golden_hash_log_filename.c_str());
+      return false;
+    }
+
+    s_golden_hashes[frame.value()] = hash.value();
+  }
+
+  Log_InfoPrintf("Loaded %zu frame hashes from golden log '%s'.", s_golden_hashes.size(),
+                 s_golden_hash_log_filename.c_str());
+  return true;
+}
+
+void RegTestHost::UpdateFrameHash(u32 frame)
+{
+  if (!s_hash_log_file && s_golden_hashes.empty())
+    return;
+
+  const u64 hash = g_gpu->GetVRAMHash();
+  if (s_hash_log_file)
+    std::fprintf(s_hash_log_file.get(), "%u %016" PRIx64 "\n", frame, hash);
+
+  if (s_golden_hashes.empty())
+    return;
+
+  const auto iter = s_golden_hashes.find(frame);
+  if (iter == s_golden_hashes.end() || iter->second == hash)
+    return;
+
+  if (s_golden_mismatches++ == 0)
+  {
+    s_first_golden_mismatch = frame;
+    Log_ErrorPrintf("Frame %u: hash %016" PRIx64 " diverges from golden hash %016" PRIx64 ".", frame, hash,
+                    iter->second);
+  }
+
+  if (!s_dump_game_directory.empty() && s_golden_mismatch_dumps < MAX_GOLDEN_MISMATCH_DUMPS)
+  {
+    s_golden_mismatch_dumps++;
+    g_gpu->WriteDisplayTextureToFile(GetFrameDumpFilename(frame));
+  }
+}
+
+void RegTestHost::UpdateRasterizerStats(u32 frame)
+{
+  if ((g_settings.gpu_sw_rasterizer_threads <= 1 && !g_settings.gpu_sw_simd_validation) ||
+      g_gpu->IsHardwareRenderer())
+  {
+    return;
+  }
+
+  const GPU_SW_Backend::RasterizerStats stats =
+    static_cast<const GPU_SW*>(g_gpu.get())->GetBackend().GetRasterizerStats();
+  if (stats.batches < s_rasterizer_stats.batches || stats.simd_checks < s_rasterizer_stats.simd_checks)
+    s_rasterizer_stats = {};
+
+  const u64 batches = stats.batches - s_rasterizer_stats.batches;
+  const u64 parallel_batches = stats.parallel_batches - s_rasterizer_stats.parallel_batches;
+  const u64 commands = stats.commands - s_rasterizer_stats.commands;
+  const u64 wall_time = stats.wall_time - s_rasterizer_stats.wall_time;
+  const u64 busy_time = stats.busy_time - s_rasterizer_stats.busy_time;
+  const u64 simd_checks = stats.simd_checks - s_rasterizer_stats.simd_checks;
+  const u64 simd_mismatches = stats.simd_mismatches - s_rasterizer_stats.simd_mismatches;
+  s_rasterizer_stats = stats;
+
+  s_total_rasterizer_stats.batches += batches;
+  s_total_rasterizer_stats.parallel_batches += parallel_batches;
+  s_total_rasterizer_stats.commands += commands;
+  s_total_rasterizer_stats.wall_time += wall_time;
+  s_total_rasterizer_stats.busy_time += busy_time;
+  s_total_rasterizer_stats.simd_checks += simd_checks;
+  s_total_rasterizer_stats.simd_mismatches += simd_mismatches;
+
+  if (g_settings.gpu_sw_rasterizer_threads > 1)
+  {
+    Log_InfoPrintf("Frame %u: %" PRIu64 " batches (%" PRIu64 " parallel), %" PRIu64
+                   " commands, rasterize %.3f ms, speedup %.2fx",
+                   frame, batches, parallel_batches, commands, Common::Timer::ConvertValueToMilliseconds(wall_time),
+                   (wall_time > 0) ? (static_cast<double>(busy_time) / static_cast<double>(wall_time)) : 1.0);
+  }
+
+  if (simd_mismatches > 0)
+  {
+    Log_ErrorPrintf("Frame %u: %" PRIu64 " of %" PRIu64 " SIMD pixel groups differ from the scalar renderer.", frame,
+                    simd_mismatches, simd_checks);
+  }
+}
+
+bool RegTestHost::PrintRasterizerStatsSummary()
+{
+  const GPU_SW_Backend::RasterizerStats& stats = s_total_rasterizer_stats;
+  if (stats.batches > 0)
+  {
+    Log_InfoPrintf("Rasterizer: %" PRIu64 " batches (%" PRIu64 " parallel), %" PRIu64
+                   " commands, rasterize %.3f ms, busy %.3f ms, speedup %.2fx",
+                   stats.batches, stats.parallel_batches, stats.commands,
+                   Common::Timer::ConvertValueToMilliseconds(stats.wall_time),
+                   Common::Timer::ConvertValueToMilliseconds(stats.busy_time),
+                   (stats.wall_time > 0) ?
+                     (static_cast<double>(stats.busy_time) / static_cast<double>(stats.wall_time)) :
+                     1.0);
+  }
+
+  if (g_settings.gpu_sw_simd_validation)
+  {
+    if (stats.simd_mismatches > 0)
+    {
+      Log_ErrorPrintf("SIMD validation: %" PRIu64 " of %" PRIu64 " pixel groups differ from the scalar renderer.",
+                      stats.simd_mismatches, stats.simd_checks);
+      return false;
+    }
+
+    Log_InfoPrintf("SIMD validation: %" PRIu64 " pixel groups match the scalar renderer.", stats.simd_checks);
+  }
+
+  return true;
+}
+
+bool RegTestHost::RunGameListBenchmark(const std::string& path)
+{
+  if (!FileSystem::DirectoryExists(path.c_str()))
+  {
+    Log_ErrorPrintf("Game list benchmark directory '%s' does not exist.", path.c_str());
+    return false;
+  }
+
+  // Report the directory size alongside the rate, since that's what the scan time mostly depends on.
+  FileSystem::FindResultsArray files;
+  FileSystem::FindFiles(path.c_str(), "*",
+                        FILESYSTEM_FIND_FILES | FILESYSTEM_FIND_HIDDEN_FILES | FILESYSTEM_FIND_RECURSIVE, &files);
+  u32 scannable_files = 0;
+  u64 scannable_size = 0;
+  for (const FILESYSTEM_FIND_DATA& ffd : files)
+  {
+    if (!GameList::IsScannableFilename(ffd.FileName))
+      continue;
+
+    scannable_files++;
+    scannable_size += static_cast<u64>(ffd.Size);
+  }
+
+  const double scannable_mb = static_cast<double>(scannable_size) / 1048576.0;
+  Log_InfoPrintf("Game list benchmark: %zu files, %u scannable (%.2f MB) in '%s'", files.size(), scannable_files,
+                 scannable_mb, path.c_str());
+
+  s_base_settings_interface->SetStringList("GameList", "Paths", {});
+  s_base_settings_interface->SetStringList("GameList", "RecursivePaths", {path});
+
+  // Cache is invalidated each time, so every pass opens every file.
+  for (u32 threads = 1; threads <= 8; threads *= 2)
+  {
+    s_base_settings_interface->SetUIntValue("GameList", "ScanThreads", threads);
+
+    Common::Timer timer;
+    GameList::Refresh(true, false, nullptr);
+    const double seconds = timer.GetTimeSeconds();
+    const u32 entries = GameList::GetEntryCount();
+    Log_InfoPrintf("  %u thread(s): %u entries in %.3f seconds, %.1f files/sec, %.1f MB/sec", threads, entries,
+                   seconds, static_cast<double>(entries) / seconds, scannable_mb / seconds);
+  }
+
+  s_base_settings_interface->DeleteValue("GameList", "ScanThreads");
+  return true;
+}
+
+bool RegTestHost::RunTimingEventBenchmark(u32 iterations)
+{
+  // Mimics the event churn while running a game: a set of periodic events, where both the "CPU" and the callbacks
+  // keep rescheduling events. Times are multiples of 64, so plenty of events share a downcount. The order hash can be
+  // compared between builds, but it is expected to differ between the list and heap queues, see timing_event.h.
+  static constexpr u32 NUM_EVENTS = 24;
+
+  struct BenchmarkState
+  {
+    std::array<std::unique_ptr<TimingEvent>, NUM_EVENTS> events;
+    std::array<std::pair<BenchmarkState*, u32>, NUM_EVENTS> params;
+    u64 order_hash = 0xCBF29CE484222325ULL;
+    u64 callbacks = 0;
+    u64 reschedules = 0;
+    u32 rng = 0x12345678u;
+
+    u32 Random()
+    {
+      rng ^= rng << 13;
+      rng ^= rng >> 17;
+      rng ^= rng << 5;
+      return rng;
+    }
+
+    void Churn(u32 running_index)
+    {
+      // Event 0 is never touched, so there's always at least one active event. Running events can't be delayed or
+      // deactivated from within their own callback, so they're only rescheduled.
+      const u32 value = Random();
+      const u32 index = 1 + (value % (NUM_EVENTS - 1));
+      TimingEvent* event = events[index].get();
+      const TickCount ticks = static_cast<TickCount>(((value >> 8) % 16) * 64);
+      if (index == running_index)
+      {
+        if ((value >> 16) % 2)
+          event->Schedule(ticks + 64);
+        else
+          event->Reset();
+
+        reschedules++;
+        return;
+      }
+
+      switch ((value >> 16) % 4)
+      {
+        case 0:
+          event->Schedule(ticks + 64);
+          break;
+        case 1:
+          event->SetState(!event->IsActive());
+          break;
+        default:
+        {
+          if (event->IsActive())
+            event->Delay(ticks);
+          else
+            event->Schedule(ticks + 64);
+        }
+        break;
+      }
+
+      reschedules++;
+    }
+
+    static void Callback(void* param, TickCount ticks, TickCount ticks_late)
+    {
+      const auto& [state, index] = *static_cast<std::pair<BenchmarkState*, u32>*>(param);
+      state->order_hash = (state->order_hash ^ ((static_cast<u64>(index) << 32) | static_cast<u32>(ticks))) *
+                          0x100000001B3ULL;
+      state->callbacks++;
+      if ((state->Random() % 4) == 0)
+        state->Churn(index);
+    }
+  };
+
+  BenchmarkState state;
+  TimingEvents::Initialize();
+  for (u32 i = 0; i < NUM_EVENTS; i++)
+  {
+    const TickCount period = static_cast<TickCount>(64 * (1 + (i % 8)));
+    state.params[i] = std::make_pair(&state, i);
+    state.events[i] = TimingEvents::CreateTimingEvent(fmt::format("Bench{}", i), period, period,
+                                                      &BenchmarkState::Callback, &state.params[i], true);
+  }
+
+  Common::Timer timer;
+  for (u32 i = 0; i < iterations; i++)
+  {
+    state.Churn(0);
+    CPU::AddPendingTicks(static_cast<TickCount>(1 + (state.Random() % 128)));
+    if (CPU::GetPendingTicks() >= CPU::g_state.downcount)
+      TimingEvents::RunEvents();
+  }
+  const double elapsed = timer.GetTimeSeconds();
+
+  Log_InfoPrintf("Timing event benchmark (%s queue): %u iterations in %.3f ms, %.1f ns per iteration",
+                 TIMING_EVENTS_USE_HEAP ? "heap" : "list", iterations, elapsed * 1000.0,
+                 (iterations > 0) ? (elapsed * 1000000000.0 / static_cast<double>(iterations)) : 0.0);
+  Log_InfoPrintf("  %" PRIu64 " reschedules, %" PRIu64 " callbacks, order hash %016" PRIX64, state.reschedules,
+                 state.callbacks, state.order_hash);
+
+  for (std::unique_ptr<TimingEvent>& event : state.events)
+    event.reset();
+  TimingEvents::Shutdown();
+  CPU::g_state.pending_ticks = 0;
+  return true;
+}
+
+bool RegTestHost::RunGTESIMDCheck(u32 iterations)
+{
+  // Runs the triple-vertex commands on random register contents through both the vectorized and scalar paths, and
+  // compares every register afterwards. Half of the iterations use values in the range games use, since random
+  // registers saturate nearly everything. The rest mix in full-range and edge values to hit the overflow checks.
+  static constexpr std::array<u8, 4> commands = {{0x30, 0x20, 0x3F, 0x16}}; // RTPT, NCT, NCCT, NCDT
+  static constexpr std::array<const char*, 4> command_names = {{"RTPT", "NCT", "NCCT", "NCDT"}};
+  static constexpr std::array<u16, 6> edge_values = {{0x0000, 0x0001, 0x1000, 0x7FFF, 0x8000, 0xFFFF}};
+  static constexpr u32 MAX_REPORTED_MISMATCHES = 8;
+
+  u32 rng = 0x12345678u;
+  const auto random = [&rng]() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+  };
+  const auto random_small = [&random]() { return static_cast<s32>(random() % 0x2001) - 0x1000; };
+  const auto random_half = [&random]() -> u16 {
+    const u32 value = random();
+    switch (value % 3)
+    {
+      case 0:
+        return static_cast<u16>(value >> 16);
+      case 1:
+        return edge_values[(value >> 8) % edge_values.size()];
+      default:
+        return static_cast<u16>(static_cast<s32>((value >> 8) % 0x101) - 0x80);
+    }
+  };
+
+  const bool old_use_simd = g_settings.cpu_gte_use_simd;
+  GTE::Regs input, simd_result;
+  u32 mismatches = 0;
+  std::array<u32, 4> command_mismatches = {};
+  double simd_time = 0.0, scalar_time = 0.0;
+  GTE::Reset();
+
+  for (u32 i = 0; i < iterations; i++)
+  {
+    const bool in_range = (random() % 2) == 0;
+    for (u32 reg = 0; reg < GTE::NUM_REGS; reg++)
+    {
+      u32 value;
+      if (in_range)
+      {
+        // TR, BK, FC, OFX/OFY/H and DQB are 32-bit, everything else used by these commands is pairs of 16-bit values.
+        const bool is_32bit = (reg >= 37 && reg <= 39) || (reg >= 45 && reg <= 47) || (reg >= 53 && reg <= 58) ||
+                              (reg == 60);
+        value = is_32bit ? static_cast<u32>(random_small()) :
+                           (ZeroExtend32(static_cast<u16>(random_small())) |
+                            (ZeroExtend32(static_cast<u16>(random_small())) << 16));
+      }
+      else
+      {
+        value = ((random() % 8) == 0) ? random() : (ZeroExtend32(random_half()) | (ZeroExtend32(random_half()) << 16));
+      }
+
+      GTE::WriteRegister(reg, value);
+    }
+
+    const u32 command_index = random() % commands.size();
+    const u32 bits = random();
+    const u32 inst_bits = ZeroExtend32(commands[command_index]) | (bits & ((1u << 19) | (1u << 10)));
+    std::memcpy(&input, &CPU::g_state.gte_regs, sizeof(input));
+
+    g_settings.cpu_gte_use_simd = true;
+    Common::Timer timer;
+    GTE::ExecuteInstruction(inst_bits);
+    simd_time += timer.GetTimeSeconds();
+    std::memcpy(&simd_result, &CPU::g_state.gte_regs, sizeof(simd_result));
+
+    std::memcpy(&CPU::g_state.gte_regs, &input, sizeof(input));
+    g_settings.cpu_gte_use_simd = false;
+    timer.Reset();
+    GTE::ExecuteInstruction(inst_bits);
+    scalar_time += timer.GetTimeSeconds();
+
+    if (std::memcmp(&simd_result, &CPU::g_state.gte_regs, sizeof(simd_result)) == 0)
+      continue;
+
+    command_mismatches[command_index]++;
+    if ((mismatches++) < MAX_REPORTED_MISMATCHES)
+    {
+      Log_ErrorPrintf("%s (sf=%u lm=%u) mismatch at iteration %u:", command_names[command_index], (bits >> 19) & 1u,
+                      (bits >> 10) & 1u, i);
+      for (u32 reg = 0; reg < GTE::NUM_REGS; reg++)
+      {
+        if (simd_result.r32[reg] != CPU::g_state.gte_regs.r32[reg])
+        {
+          Log_ErrorPrintf("  reg %u: input %08X simd %08X scalar %08X", reg, input.r32[reg], simd_result.r32[reg],
+                          CPU::g_state.gte_regs.r32[reg]);
+        }
+      }
+    }
+  }
+
+  g_settings.cpu_gte_use_simd = old_use_simd;
+
+  Log_InfoPrintf("GTE SIMD check: %u iterations, %u mismatches (RTPT %u, NCT %u, NCCT %u, NCDT %u)", iterations,
+                 mismatches, command_mismatches[0], command_mismatches[1], command_mismatches[2],
+                 command_mismatches[3]);
+  Log_InfoPrintf("  SIMD %.1f ns per command, scalar %.1f ns per command",
+                 simd_time * 1000000000.0 / static_cast<double>(iterations),
+                 scalar_time * 1000000000.0 / static_cast<double>(iterations));
+  return (mismatches == 0);
+}
+
+bool RegTestHost::RunVRAMUploadBenchmark(u32 iterations)
+{
+  // Streams 320x240 frames from RAM to VRAM over GPU DMA in request mode, like FMV playback, with and without the bulk
+  // VRAM write path. Goes through the booted system's DMA controller and GPU, and overwrites part of RAM and VRAM, so
+  // the run stops afterwards. Each DMA is kept within one slice, so it completes without running any events.
+  static constexpr u32 WIDTH = 320;
+  static constexpr u32 HEIGHT = 240;
+  static constexpr u32 WORDS = (WIDTH * HEIGHT) / 2;
+  static constexpr u32 BLOCK_SIZE = 16;
+  static constexpr u32 BLOCKS_PER_DMA = 32;
+  static constexpr u32 RAM_ADDRESS = 0x100000;
+  static constexpr u32 GPU_DMA_REGISTERS = 0x20;
+  static constexpr u32 DMA_BUSY = (1u << 24);
+
+  const Settings old_settings = g_settings;
+  const u32 old_dpcr = DMA::ReadRegister(0x70);
+  u32* const ram_words = reinterpret_cast<u32*>(Bus::g_ram + RAM_ADDRESS);
+  bool result = true;
+
+  for (const bool bulk : {false, true})
+  {
+    g_settings.gpu_bulk_vram_writes = bulk;
+    g_gpu->UpdateSettings(old_settings);
+
+    // Different contents each pass, so the readback can't pass from the previous run.
+    u32 rng = bulk ? 0x9E3779B9u : 0x12345678u;
+    for (u32 i = 0; i < WORDS; i++)
+    {
+      rng ^= rng << 13;
+      rng ^= rng >> 17;
+      rng ^= rng << 5;
+      ram_words[i] = rng;
+    }
+
+    g_gpu->WriteRegister(0x04, 0x01000000); // Clear FIFO
+    g_gpu->WriteRegister(0x04, 0x04000002); // DMA direction CPU->GP0
+    g_gpu->WriteRegister(0x00, 0xE6000000); // No mask bit setting/checking
+    DMA::WriteRegister(0x70, old_dpcr | (0x8u << (static_cast<u32>(DMA::Channel::GPU) * 4)));
+
+    Common::Timer timer;
+    for (u32 frame = 0; frame < iterations && result; frame++)
+    {
+      g_gpu->WriteRegister(0x00, 0xA0000000);
+      g_gpu->WriteRegister(0x00, 0x00000000);
+      g_gpu->WriteRegister(0x00, (HEIGHT << 16) | WIDTH);
+
+      for (u32 block = 0; block < (WORDS / BLOCK_SIZE); block += BLOCKS_PER_DMA)
+      {
+        const u32 count = std::min(BLOCKS_PER_DMA, (WORDS / BLOCK_SIZE) - block);
+        DMA::WriteRegister(GPU_DMA_REGISTERS + 0x00, RAM_ADDRESS + (block * BLOCK_SIZE * sizeof(u32)));
+        DMA::WriteRegister(GPU_DMA_REGISTERS + 0x04, (count << 16) | BLOCK_SIZE);
+        DMA::WriteRegister(GPU_DMA_REGISTERS + 0x08, DMA_BUSY | (1u << 9) | 1u); // Request mode, from RAM
+        if (DMA::ReadRegister(GPU_DMA_REGISTERS + 0x08) & DMA_BUSY)
+        {
+          Log_ErrorPrintf("GPU DMA did not complete within a slice, lower BLOCKS_PER_DMA or raise the slice size.");
+          result = false;
+          break;
+        }
+      }
+    }
+    const double elapsed = timer.GetTimeSeconds();
+    if (!result)
+      break;
+
+    // Read the last frame back through GPUREAD.
+    g_gpu->WriteRegister(0x00, 0xC0000000);
+    g_gpu->WriteRegister(0x00, 0x00000000);
+    g_gpu->WriteRegister(0x00, (HEIGHT << 16) | WIDTH);
+    u32 mismatches = 0;
+    for (u32 i = 0; i < WORDS; i++)
+      mismatches += BoolToUInt32(g_gpu->ReadRegister(0x00) != ram_words[i]);
+
+    const double megabytes = static_cast<double>(iterations) * static_cast<double>(WORDS * sizeof(u32)) / 1048576.0;
+    Log_InfoPrintf("VRAM upload benchmark (%s): %u frames in %.3f ms, %.1f MB/s, %u mismatched words",
+                   bulk ? "bulk" : "FIFO", iterations, elapsed * 1000.0, (elapsed > 0.0) ? (megabytes / elapsed) : 0.0,
+                   mismatches);
+    result &= (mismatches == 0);
+  }
+
+  DMA::WriteRegister(0x70, old_dpcr);
+  g_settings.gpu_bulk_vram_writes = old_settings.gpu_bulk_vram_writes;
+  g_gpu->UpdateSettings(old_settings);
+  return result;
+}
+
+bool RegTestHost::StartGPURecording()
+{
+  Error error;
+  if (!g_gpu->StartRecording(s_gpu_record_filename.c_str(), &error))
+  {
+    Log_ErrorPrintf("Failed to start GPU recording: %s", error.GetDescription().c_str());
+    s_gpu_record_failed = true;
+    return false;
+  }
+
+  return true;
+}
+
+bool RegTestHost::HashAudioDump()
+{
+  // FNV-1a over the whole WAV file, so runs with different mixing paths can be compared.
+  const std::optional<std::vector<u8>> data = FileSystem::ReadBinaryFile(s_audio_dump_filename.c_str());
+  if (!data.has_value())
+  {
+    Log_ErrorPrintf("Failed to read audio dump '%s'.", s_audio_dump_filename.c_str());
+    return false;
+  }
+
+  u64 hash = 0xCBF29CE484222325ULL;
+  for (const u8 byte : data.value())
+    hash = (hash ^ byte) * 0x100000001B3ULL;
+
+  s_audio_dump_hash = hash;
+  Log_InfoPrintf("Audio dump '%s': %zu bytes, hash %016" PRIx64, s_audio_dump_filename.c_str(), data->size(), hash);
+  if (s_expected_audio_hash.has_value() && s_expected_audio_hash.value() != hash)
+  {
+    Log_ErrorPrintf("Audio dump hash does not match the expected hash %016" PRIx64 ".", s_expected_audio_hash.value());
+    return false;
+  }
+
+  return true;
+}
+
+const char* RegTestHost::GetGP0CommandName(u32 command)
+{
+  if (command >= 0x20 && command <= 0x3F)
+    return "Polygon";
+  else if (command >= 0x40 && command <= 0x5F)
+    return "Line";
+  else if (command >= 0x60 && command <= 0x7F)
+    return "Rectangle";
+  else if (command >= 0x80 && command <= 0x9F)
+    return "CopyVRAMToVRAM";
+  else if (command >= 0xA0 && command <= 0xBF)
+    return "CopyCPUToVRAM";
+  else if (command >= 0xC0 && command <= 0xDF)
+    return "CopyVRAMToCPU";
+
+  switch (command)
+  {
+    case 0x01:
+      return "ClearCache";
+    case 0x02:
+      return "FillVRAM";
+    case 0x1F:
+      return "InterruptRequest";
+    case 0xE1:
+      return "SetDrawMode";
+    case 0xE2:
+      return "SetTextureWindow";
+    case 0xE3:
+      return "SetDrawingAreaTopLeft";
+    case 0xE4:
+      return "SetDrawingAreaBottomRight";
+    case 0xE5:
+      return "SetDrawingOffset";
+    case 0xE6:
+      return "SetMaskBit";
+    default:
+      return "NOP";
+  }
+}
+
+bool RegTestHost::RunGPUReplay(const std::string& path, double* elapsed_seconds)
+{
+  // Feeds a GPU dump to a GPU created on its own, without a BIOS, CPU or memory, so only the renderer is measured.
+  // Commands execute as soon as they're read and frames are presented unthrottled. The GPU thread is disabled for
+  // replays, so command times include rasterization.
+  Error error;
+  std::unique_ptr<GPUDump::Player> player = GPUDump::Player::Open(path.c_str(), &error);
+  if (!player)
+  {
+    Log_ErrorPrintf("Failed to open GPU dump: %s", error.GetDescription().c_str());
+    return false;
+  }
+
+  if (!System::CreateGPUOnly())
+  {
+    Log_ErrorPrint("Failed to create GPU for replay.");
+    return false;
+  }
+
+  Log_InfoPrintf("Replaying %u frames from '%s'...", player->GetFrameCount(), path.c_str());
+
+  GPU::CommandTimings timings = {};
+  g_gpu->SetCommandTimings(&timings);
+
+  Common::Timer timer;
+  while (player->ProcessFrame())
+  {
+    s_frames_executed++;
+    System::PresentDisplay(false);
+  }
+  *elapsed_seconds = timer.GetTimeSeconds();
+  g_gpu->SetCommandTimings(nullptr);
+
+  const u64 vram_hash = g_gpu->GetVRAMHash();
+  if (s_frame_hashes.empty() || s_frame_hashes.back().first != s_frames_executed)
+    s_frame_hashes.emplace_back(s_frames_executed, vram_hash);
+  System::DestroyGPUOnly();
+
+  Log_InfoPrintf("GPU replay: %u frames in %.3f seconds, %.2f FPS, final VRAM hash %016" PRIx64, s_frames_executed,
+                 *elapsed_seconds,
+                 (*elapsed_seconds > 0.0) ? (static_cast<double>(s_frames_executed) / *elapsed_seconds) : 0.0,
+                 vram_hash);
+
+  std::array<u32, 256> commands;
+  for (u32 i = 0; i < static_cast<u32>(commands.size()); i++)
+    commands[i] = i;
+  std::sort(commands.begin(), commands.end(),
+            [&timings](u32 lhs, u32 rhs) { return timings.time[lhs] > timings.time[rhs]; });
+
+  for (const u32 command : commands)
+  {
+    if (timings.count[command] == 0)
+      continue;
+
+    const double ms = Common::Timer::ConvertValueToMilliseconds(timings.time[command]);
+    Log_InfoPrintf("  GP0(%02X) %-26s %12" PRIu64 " calls %10.3f ms %10.1f ns/call", command,
+                   GetGP0CommandName(command), timings.count[command], ms,
+                   ms * 1000000.0 / static_cast<double>(timings.count[command]));
+  }
+
+  return true;
+}
+
+bool RegTestHost::WriteReport(const char* status, double elapsed_seconds)
+{
+  const auto escape = [](const std::string& str) {
+    std::string ret;
+    ret.reserve(str.length());
+    for (const char ch : str)
+    {
+      if (ch == '"' || ch == '\\')
+      {
+        ret.push_back('\\');
+        ret.push_back(ch);
+      }
+      else if (static_cast<unsigned char>(ch) < 0x20)
+      {
+        ret.append(fmt::format("\\u{:04x}", static_cast<unsigned>(ch)));
+      }
+      else
+      {
+        ret.push_back(ch);
+      }
+    }
+    return ret;
+  };
+
+  // Speed is relative to the console's frame rate, so 100% is full speed.
+  const double fps = (elapsed_seconds > 0.0) ? (static_cast<double>(s_frames_executed) / elapsed_seconds) : 0.0;
+  const double speed =
+    (s_target_frame_rate > 0.0f) ? (fps / static_cast<double>(s_target_frame_rate) * 100.0) : 0.0;
+
+  std::string hashes;
+  for (const auto& [frame, hash] : s_frame_hashes)
+    hashes.append(fmt::format("{}{{\"frame\": {}, \"hash\": \"{:016x}\"}}", hashes.empty() ? "" : ", ", frame, hash));
+
+  const std::string report = fmt::format(
+    "{{\n  \"status\": \"{}\",\n  \"serial\": \"{}\",\n  \"title\": \"{}\",\n  \"renderer\": \"{}\",\n"
+    "  \"frames\": {},\n  \"elapsed\": {:.3f},\n  \"fps\": {:.2f},\n  \"speed\": {:.2f},\n  \"hashes\": [{}],\n"
+    "  \"golden_mismatches\": {},\n  \"first_golden_mismatch\": {},\n  \"audio_hash\": {}\n}}\n",
+    status, escape(s_game_serial), escape(s_game_title), Settings::GetRendererName(g_settings.gpu_renderer),
+    s_frames_executed, elapsed_seconds, fps, speed, hashes, s_golden_mismatches,
+    (s_golden_mismatches > 0) ? fmt::format("{}", s_first_golden_mismatch) : std::string("null"),
+    s_audio_dump_hash.has_value() ? fmt::format("\"{:016x}\"", s_audio_dump_hash.value()) : std::string("null"));
+
+  if (!FileSystem::WriteStringToFile(s_report_filename.c_str(), report))
+  {
+    Log_ErrorPrintf("Failed to write report to '%s'.", s_report_filename.c_str());
+    return false;
   }
+
+  return true;
 }
 
 void Host::OpenURL(const std::string_view& url)
@@ -462,6 +1243,53 @@ void RegTestHost::PrintCommandLineHelp(const char* progname)
   std::fprintf(stderr, "  -frames: Sets the number of frames to execute.\n");
   std::fprintf(stderr, "  -log <level>: Sets the log level. Defaults to verbose.\n");
   std::fprintf(stderr, "  -renderer <renderer>: Sets the graphics renderer. Default to software.\n");
+  std::fprintf(stderr, "  -swthreads <count>: Sets the number of software rasterizer threads.\n");
+  std::fprintf(stderr, "  -swscalar: Disables the vectorized software renderer span kernels.\n");
+  std::fprintf(stderr, "  -swsimdcheck: Compares vectorized software rendering against the scalar path.\n");
+  std::fprintf(stderr, "  -gamelistbench <dir>: Times game list scanning of a directory and exits.\n");
+  std::fprintf(stderr, "  -eventbench <iterations>: Times rescheduling of timing events and exits.\n");
+  std::fprintf(stderr, "  -gtescalar: Disables the vectorized GTE triple-vertex commands.\n");
+  std::fprintf(stderr, "  -vrambench <frames>: After booting, times CPU->VRAM uploads over DMA with and\n"
+                       "    without the bulk path, and exits.\n");
+  std::fprintf(stderr, "  -gpurecord <file>: Records everything sent to the GPU to a dump file, which can be\n"
+                       "    replayed with -gpureplay.\n");
+  std::fprintf(stderr, "  -gpurecordframe <frame>: Starts the GPU recording at the specified frame instead\n"
+                       "    of at boot.\n");
+  std::fprintf(stderr, "  -gpureplay <file>: Replays a GPU dump as fast as possible with only the GPU\n"
+                       "    created, no BIOS or boot path is needed. Prints frame rate, time per GP0\n"
+                       "    command and the final VRAM hash, and exits.\n");
+  std::fprintf(stderr, "  -spusimd: Enables the vectorized SPU voice mixer.\n");
+  std::fprintf(stderr, "  -spunocache: Decodes every SPU ADPCM block from RAM, without the block cache.\n");
+  std::fprintf(stderr, "  -audiodump <file>: Dumps the SPU output to a WAV file from boot, and prints a\n"
+                       "    hash of it after the run.\n");
+  std::fprintf(stderr, "  -audiohash <hash>: Fails the run if the hash of the audio dump doesn't match.\n");
+  std::fprintf(stderr, "  -bulkvram: Copies DMA VRAM writes to VRAM in bulk instead of through the GPU FIFO.\n");
+  std::fprintf(stderr, "  -directdma: Executes DMA GP0 commands from RAM instead of sending them through\n"
+                       "    the GPU FIFO.\n");
+  std::fprintf(stderr, "  -gtesimdcheck <iterations>: Compares vectorized GTE commands against the scalar\n"
+                       "    path on random registers and exits.\n");
+  std::fprintf(stderr, "  -report <file>: Writes a JSON summary of the run, including VRAM hashes at the\n"
+                       "    dump interval, to the specified file.\n");
+  std::fprintf(stderr, "  -benchmark <file>: Attributes host time to each emulated subsystem, and writes\n"
+                       "    a JSON report of the breakdown to the specified file.\n");
+  std::fprintf(stderr, "  -blockstats <file>: Counts executions of each recompiled block, and writes the\n"
+                       "    hottest blocks to the specified file.\n");
+  std::fprintf(stderr, "  -jitdump <dir>: Writes recompiled code to a jitdump file in the specified\n"
+                       "    directory, for annotation with perf inject --jit. Linux only.\n");
+  std::fprintf(stderr, "  -hashlog <file>: Writes a hash of VRAM for every frame to the specified file.\n");
+  std::fprintf(stderr, "  -golden <file>: Compares every frame against a hash log, and dumps the first %u\n"
+                       "    divergent frames to the dump directory.\n",
+               MAX_GOLDEN_MISMATCH_DUMPS);
+  std::fprintf(stderr, "  -followjumps: Continues new recompiler blocks through short forward jumps.\n");
+  std::fprintf(stderr, "  -compilethreshold <count>: Interprets blocks this many times before recompiling them.\n");
+  std::fprintf(stderr, "  -backgroundcompile: Compiles hot blocks on a separate thread with the new recompiler.\n"
+                       "    Needs -compilethreshold.\n");
+  std::fprintf(stderr, "  -superblocks: Continues new recompiler blocks through jumps and biased branches.\n"
+                       "    Needs -compilethreshold.\n");
+  std::fprintf(stderr, "  -threaded: Uses threaded dispatch in the cached interpreter.\n");
+  std::fprintf(stderr, "  -rewind <slots>: Enables rewind with the specified number of save slots, saving\n"
+                       "    every 10 frames. Memory usage is logged once the buffer is full.\n");
+  std::fprintf(stderr, "  -rewinddelta: Stores rewind states delta-compressed.\n");
   std::fprintf(stderr, "  --: Signals that no more arguments will follow and the remaining\n"
                        "    parameters make up the filename. Use when the filename contains\n"
                        "    spaces or starts with a dash.\n");
@@ -554,6 +1382,118 @@ bool RegTestHost::ParseCommandLineParameters(int argc, char* argv[], std::option
         s_base_settings_interface->SetStringValue("GPU", "Renderer", Settings::GetRendererName(renderer.value()));
         continue;
       }
+      else if (CHECK_ARG_PARAM("-swthreads"))
+      {
+        const u32 threads = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (threads == 0 || threads > Settings::MAX_SW_RASTERIZER_THREADS)
+        {
+          Log_ErrorPrint("Invalid software rasterizer thread count.");
+          return false;
+        }
+
+        Log_InfoFmt("Setting software rasterizer threads to {}.", threads);
+        s_base_settings_interface->SetIntValue("GPU", "SoftwareRasterizerThreads", static_cast<s32>(threads));
+        continue;
+      }
+      else if (CHECK_ARG("-swscalar"))
+      {
+        Log_InfoPrint("Disabling software renderer SIMD kernels.");
+        s_base_settings_interface->SetBoolValue("GPU", "SoftwareUseSIMD", false);
+        continue;
+      }
+      else if (CHECK_ARG("-swsimdcheck"))
+      {
+        Log_InfoPrint("Validating software renderer SIMD kernels against the scalar path.");
+        s_base_settings_interface->SetBoolValue("GPU", "SoftwareUseSIMD", true);
+        s_base_settings_interface->SetBoolValue("GPU", "SoftwareSIMDValidation", true);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-gamelistbench"))
+      {
+        s_game_list_benchmark_path = argv[++i];
+        if (s_game_list_benchmark_path.empty())
+        {
+          Log_ErrorPrint("Invalid game list benchmark directory.");
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-eventbench"))
+      {
+        s_timing_event_benchmark_iterations = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_timing_event_benchmark_iterations == 0)
+        {
+          Log_ErrorPrint("Invalid timing event benchmark iteration count.");
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-report"))
+      {
+        s_report_filename = argv[++i];
+        if (s_report_filename.empty())
+        {
+          Log_ErrorPrint("Invalid report filename.");
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-benchmark"))
+      {
+        s_benchmark_report_filename = argv[++i];
+        if (s_benchmark_report_filename.empty())
+        {
+          Log_ErrorPrint("Invalid benchmark report filename.");
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-blockstats"))
+      {
+        s_block_stats_filename = argv[++i];
+        if (s_block_stats_filename.empty())
+        {
+          Log_ErrorPrint("Invalid block stats filename.");
+          return false;
+        }
+
+        s_base_settings_interface->SetBoolValue("CPU", "RecompilerBlockStats", true);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-jitdump"))
+      {
+        const char* directory = argv[++i];
+        if (!PerfScope::OpenJitDump(directory))
+          Log_WarningPrintf("Failed to open jitdump file in '%s', continuing without it.", directory);
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-hashlog"))
+      {
+        s_hash_log_filename = argv[++i];
+        if (s_hash_log_filename.empty())
+        {
+          Log_ErrorPrint("Invalid hash log filename.");
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-golden"))
+      {
+        s_golden_hash_log_filename = argv[++i];
+        if (s_golden_hash_log_filename.empty())
+        {
+          Log_ErrorPrint("Invalid golden hash log filename.");
+          return false;
+        }
+
+        continue;
+      }
       else if (CHECK_ARG_PARAM("-upscale"))
       {
         const u32 upscale = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
@@ -594,6 +1534,162 @@ bool RegTestHost::ParseCommandLineParameters(int argc, char* argv[], std::option
         s_base_settings_interface->SetBoolValue("GPU", "PGXPCPU", true);
         continue;
       }
+      else if (CHECK_ARG("-followjumps"))
+      {
+        Log_InfoPrint("Enabling recompiler jump following.");
+        s_base_settings_interface->SetBoolValue("CPU", "RecompilerFollowJumps", true);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-compilethreshold"))
+      {
+        const u32 threshold = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (threshold == 0 || threshold > Settings::MAX_CPU_RECOMPILER_COMPILE_THRESHOLD)
+        {
+          Log_ErrorPrint("Invalid compile threshold.");
+          return false;
+        }
+
+        Log_InfoFmt("Compiling blocks after {} executions.", threshold);
+        s_base_settings_interface->SetIntValue("CPU", "RecompilerCompileThreshold", static_cast<s32>(threshold));
+        continue;
+      }
+      else if (CHECK_ARG("-backgroundcompile"))
+      {
+        Log_InfoPrint("Enabling background compilation.");
+        s_base_settings_interface->SetBoolValue("CPU", "RecompilerBackgroundCompile", true);
+        continue;
+      }
+      else if (CHECK_ARG("-superblocks"))
+      {
+        Log_InfoPrint("Enabling recompiler superblocks.");
+        s_base_settings_interface->SetBoolValue("CPU", "RecompilerSuperblocks", true);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-vrambench"))
+      {
+        s_vram_upload_benchmark_iterations = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_vram_upload_benchmark_iterations == 0)
+        {
+          Log_ErrorPrint("Invalid VRAM upload benchmark frame count.");
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-gpurecord"))
+      {
+        s_gpu_record_filename = argv[++i];
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-gpurecordframe"))
+      {
+        s_gpu_record_start_frame = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_gpu_record_start_frame == 0)
+        {
+          Log_ErrorPrint("Invalid GPU recording start frame.");
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-gpureplay"))
+      {
+        s_gpu_replay_filename = argv[++i];
+        Log_InfoPrint("Disabling the GPU thread for replay.");
+        s_base_settings_interface->SetBoolValue("GPU", "UseThread", false);
+        continue;
+      }
+      else if (CHECK_ARG("-spusimd"))
+      {
+        Log_InfoPrint("Enabling vectorized SPU voice mixing.");
+        s_base_settings_interface->SetBoolValue("Audio", "SPUUseSIMD", true);
+        continue;
+      }
+      else if (CHECK_ARG("-spunocache"))
+      {
+        Log_InfoPrint("Disabling the SPU ADPCM block cache.");
+        s_base_settings_interface->SetBoolValue("Audio", "SPUADPCMCache", false);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-audiodump"))
+      {
+        s_audio_dump_filename = argv[++i];
+        if (s_audio_dump_filename.empty())
+        {
+          Log_ErrorPrint("Invalid audio dump filename.");
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-audiohash"))
+      {
+        s_expected_audio_hash = StringUtil::FromChars<u64>(argv[++i], 16);
+        if (!s_expected_audio_hash.has_value())
+        {
+          Log_ErrorPrint("Invalid audio hash.");
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG("-bulkvram"))
+      {
+        Log_InfoPrint("Enabling bulk DMA VRAM writes.");
+        s_base_settings_interface->SetBoolValue("GPU", "BulkVRAMWrites", true);
+        continue;
+      }
+      else if (CHECK_ARG("-directdma"))
+      {
+        Log_InfoPrint("Enabling direct execution of DMA GP0 commands.");
+        s_base_settings_interface->SetBoolValue("GPU", "DirectDMACommands", true);
+        continue;
+      }
+      else if (CHECK_ARG("-gtescalar"))
+      {
+        Log_InfoPrint("Disabling vectorized GTE commands.");
+        s_base_settings_interface->SetBoolValue("CPU", "GTEUseSIMD", false);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-gtesimdcheck"))
+      {
+        s_gte_simd_check_iterations = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (s_gte_simd_check_iterations == 0)
+        {
+          Log_ErrorPrint("Invalid GTE SIMD check iteration count.");
+          return false;
+        }
+
+        continue;
+      }
+      else if (CHECK_ARG("-threaded"))
+      {
+        Log_InfoPrint("Enabling threaded dispatch in the cached interpreter.");
+        s_base_settings_interface->SetBoolValue("CPU", "CachedInterpreterThreaded", true);
+        continue;
+      }
+      else if (CHECK_ARG_PARAM("-rewind"))
+      {
+        const u32 slots = StringUtil::FromChars<u32>(argv[++i]).value_or(0);
+        if (slots == 0)
+        {
+          Log_ErrorPrint("Invalid rewind slot count.");
+          return false;
+        }
+
+        // Regtest runs unthrottled, so the frequency is in frames at 60hz.
+        Log_InfoFmt("Enabling rewind with {} slots, saving every 10 frames.", slots);
+        s_base_settings_interface->SetBoolValue("Main", "RewindEnable", true);
+        s_base_settings_interface->SetIntValue("Main", "RewindSaveSlots", static_cast<s32>(slots));
+        s_base_settings_interface->SetFloatValue("Main", "RewindFrequency", 10.0f / 60.0f);
+        continue;
+      }
+      else if (CHECK_ARG("-rewinddelta"))
+      {
+        Log_InfoPrint("Enabling rewind delta compression.");
+        s_base_settings_interface->SetBoolValue("Main", "RewindDeltaCompression", true);
+        continue;
+      }
       else if (CHECK_ARG("--"))
       {
         no_more_args = true;
@@ -633,16 +1729,53 @@ int main(int argc, char* argv[])
   if (!RegTestHost::ParseCommandLineParameters(argc, argv, autoboot))
     return EXIT_FAILURE;
 
+  if (!s_game_list_benchmark_path.empty())
+  {
+    System::Internal::ProcessStartup();
+    const bool benchmark_result = RegTestHost::RunGameListBenchmark(s_game_list_benchmark_path);
+    System::Internal::ProcessShutdown();
+    return benchmark_result ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if (s_timing_event_benchmark_iterations > 0)
+    return RegTestHost::RunTimingEventBenchmark(s_timing_event_benchmark_iterations) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  if (s_gte_simd_check_iterations > 0)
+    return RegTestHost::RunGTESIMDCheck(s_gte_simd_check_iterations) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  if (!s_gpu_replay_filename.empty())
+  {
+    System::Internal::ProcessStartup();
+    double replay_time = 0.0;
+    bool replay_result = RegTestHost::RunGPUReplay(s_gpu_replay_filename, &replay_time);
+    if (!s_report_filename.empty())
+      replay_result = RegTestHost::WriteReport(replay_result ? "ok" : "gpureplay_failed", replay_time) && replay_result;
+    System::Internal::ProcessShutdown();
+    return replay_result ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
   if (!autoboot || autoboot->filename.empty())
   {
     Log_ErrorPrintf("No boot path specified.");
     return EXIT_FAILURE;
   }
 
+  if ((!s_hash_log_filename.empty() && !RegTestHost::OpenHashLog()) ||
+      (!s_golden_hash_log_filename.empty() && !RegTestHost::LoadGoldenHashLog()))
+  {
+    return EXIT_FAILURE;
+  }
+
   System::Internal::ProcessStartup();
   RegTestHost::HookSignals();
 
+  if (!s_benchmark_report_filename.empty())
+    System::SetBenchmarkModeEnabled(true);
+
   int result = -1;
+  const char* status = "boot_failed";
+  Common::Timer run_timer;
+  double run_time = 0.0;
   Log_InfoPrintf("Trying to boot '%s'...", autoboot->filename.c_str());
   if (!System::BootSystem(std::move(autoboot.value())))
   {
@@ -652,22 +1785,103 @@ int main(int argc, char* argv[])
 
   if (s_frame_dump_interval > 0)
   {
-    if (s_dump_base_directory.empty())
+    // With a report, the interval can be used for hashing only.
+    if (s_dump_base_directory.empty() && s_report_filename.empty())
     {
       Log_ErrorPrint("Dump directory not specified.");
+      status = "invalid_parameters";
       goto cleanup;
     }
 
-    Log_InfoPrintf("Dumping every %dth frame to '%s'.", s_frame_dump_interval, s_dump_base_directory.c_str());
+    if (!s_dump_base_directory.empty())
+      Log_InfoPrintf("Dumping every %dth frame to '%s'.", s_frame_dump_interval, s_dump_base_directory.c_str());
+  }
+
+  if (!s_gpu_record_filename.empty() && s_gpu_record_start_frame == 0 && !RegTestHost::StartGPURecording())
+  {
+    status = "gpurecord_failed";
+    goto cleanup;
+  }
+
+  if (!s_audio_dump_filename.empty() && !SPU::StartDumpingAudio(s_audio_dump_filename.c_str()))
+  {
+    status = "audiodump_failed";
+    goto cleanup;
+  }
+
+  if (s_vram_upload_benchmark_iterations > 0)
+  {
+    const bool benchmark_result = RegTestHost::RunVRAMUploadBenchmark(s_vram_upload_benchmark_iterations);
+    status = benchmark_result ? "ok" : "vrambench_failed";
+    result = benchmark_result ? 0 : -1;
+    goto cleanup;
   }
 
   Log_InfoPrintf("Running for %d frames...", s_frames_to_run);
+  SubsystemProfiler::Reset();
+  run_timer.Reset();
   System::Execute();
+  run_time = run_timer.GetTimeSeconds();
+
+  if (System::IsBenchmarkModeEnabled())
+  {
+    SubsystemProfiler::LogReport(s_frames_executed, run_time);
+    if (!SubsystemProfiler::WriteReport(s_benchmark_report_filename.c_str(), s_frames_executed, run_time))
+    {
+      status = "benchmark_failed";
+      goto cleanup;
+    }
+  }
+
+  if (s_gpu_record_failed)
+  {
+    status = "gpurecord_failed";
+    goto cleanup;
+  }
+
+  // The dump is closed when the system shuts down at the end of the run.
+  if (!s_audio_dump_filename.empty() && !RegTestHost::HashAudioDump())
+  {
+    status = "audio_mismatch";
+    goto cleanup;
+  }
+
+  if (!s_block_stats_filename.empty() && !CPU::CodeCache::WriteBlockStatsReport(s_block_stats_filename.c_str()))
+  {
+    status = "blockstats_failed";
+    goto cleanup;
+  }
+
+  if (!RegTestHost::PrintRasterizerStatsSummary())
+  {
+    status = "simd_mismatch";
+    goto cleanup;
+  }
+
+  if (!s_golden_hashes.empty())
+  {
+    if (s_golden_mismatches > 0)
+    {
+      Log_ErrorPrintf("%u frames diverge from the golden hash log, starting at frame %u.", s_golden_mismatches,
+                      s_first_golden_mismatch);
+      status = "golden_mismatch";
+      goto cleanup;
+    }
+
+    Log_InfoPrintf("All frames match the golden hash log.");
+  }
 
   Log_InfoPrintf("Exiting with success.");
+  status = "ok";
   result = 0;
 
 cleanup:
+  if (!s_report_filename.empty() && !RegTestHost::WriteReport(status, run_time))
+    result = -1;
+
+  s_hash_log_file.reset();
+  PerfScope::CloseJitDump();
+
   System::Internal::ProcessShutdown();
   return result;
 }
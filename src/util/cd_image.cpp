@@ -391,6 +391,15 @@ s64 CDImage::GetSizeOnDisk() const
   return -1;
 }
 
+void CDImage::SetReadCacheParameters(u32 cache_blocks, u32 prefetch_blocks)
+{
+}
+
+bool CDImage::GetReadCacheStats(ReadCacheStats* stats) const
+{
+  return false;
+}
+
 void CDImage::ClearTOC()
 {
   m_lba_count = 0;
@@ -229,6 +229,15 @@ public:
     bool is_pregap;
   };
 
+  struct ReadCacheStats
+  {
+    u64 hits;           // block lookups satisfied from the cache
+    u64 misses;         // block lookups which had to be decompressed synchronously
+    u64 prefetched;     // blocks decompressed ahead of time by the prefetch workers
+    u64 prefetch_hits;  // hits on blocks which were filled by the prefetch workers
+    u64 prefetch_waits; // lookups which had to wait for an in-flight prefetch to complete
+  };
+
   // Helper functions.
   static u32 GetBytesPerSector(TrackMode mode);
   static void DeinterleaveSubcode(const u8* subcode_in, u8* subcode_out);
@@ -332,6 +341,13 @@ public:
   // If this function returns -1, it means the size could not be computed.
   virtual s64 GetSizeOnDisk() const;
 
+  // Configures the decompressed block cache for compressed formats. A prefetch count of zero disables readahead.
+  // Must not be called while another thread is reading from the image.
+  virtual void SetReadCacheParameters(u32 cache_blocks, u32 prefetch_blocks);
+
+  // Returns false if the image does not have a decompressed block cache.
+  virtual bool GetReadCacheStats(ReadCacheStats* stats) const;
+
 protected:
   void ClearTOC();
   void CopyTOC(const CDImage* image);
@@ -14,6 +14,7 @@
 #include "common/log.h"
 #include "common/path.h"
 #include "common/string_util.h"
+#include "common/threading.h"
 
 #include "fmt/format.h"
 #include "libchdr/cdrom.h"
@@ -21,11 +22,14 @@
 
 #include <algorithm>
 #include <cerrno>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <limits>
 #include <mutex>
 #include <optional>
+#include <thread>
 
 Log_SetChannel(CDImageCHD);
 
@@ -70,6 +74,9 @@ public:
   bool IsPrecached() const override;
   s64 GetSizeOnDisk() const override;
 
+  void SetReadCacheParameters(u32 cache_blocks, u32 prefetch_blocks) override;
+  bool GetReadCacheStats(ReadCacheStats* stats) const override;
+
 protected:
   bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
 
@@ -77,20 +84,64 @@ private:
   static constexpr u32 CHD_CD_SECTOR_DATA_SIZE = 2352 + 96;
   static constexpr u32 CHD_CD_TRACK_ALIGNMENT = 4;
   static constexpr u32 MAX_PARENTS = 32; // Surely someone wouldn't be insane enough to go beyond this...
+  static constexpr u32 MAX_HUNK_CACHE_SIZE = 1024;
+  static constexpr u32 MAX_PREFETCH_THREADS = 2;
+  static constexpr u32 INVALID_SLOT = static_cast<u32>(-1);
+
+  enum class HunkState : u8
+  {
+    Empty,
+    Decoding,
+    Ready,
+  };
+
+  struct HunkSlot
+  {
+    u32 hunk_index;
+    HunkState state;
+    bool prefetched; // filled by a worker, not yet read by the foreground
+    u64 last_access;
+  };
 
   chd_file* OpenCHD(std::string_view filename, FileSystem::ManagedCFilePtr fp, Error* error, u32 recursion_level);
   bool UpdateHunkBuffer(const Index& index, LBA lba_in_index, u32& hunk_offset);
+  const u8* LookupHunk(u32 hunk_index);
+
+  ALWAYS_INLINE u8* GetSlotBuffer(u32 slot) { return &m_hunk_buffer[static_cast<size_t>(slot) * m_slot_stride]; }
+  u32 FindSlot(u32 hunk_index) const;
+  u32 AllocateSlot(bool for_prefetch);
+  void ResizeHunkCache(u32 cache_size);
+  void QueuePrefetch(u32 hunk_index);
+  void StartPrefetchThreads(u32 count);
+  void StopPrefetchThreads();
+  void PrefetchThreadEntryPoint();
 
   static void CopyAndSwap(void* dst_ptr, const u8* src_ptr);
 
   chd_file* m_chd = nullptr;
   u32 m_hunk_size = 0;
+  u32 m_hunk_count = 0;
   u32 m_sectors_per_hunk = 0;
 
+  // Decompressed hunks, one slot per cached hunk. The slot being read by the foreground is never evicted by the
+  // prefetch workers, and slots in the Decoding state are owned by whichever thread is filling them.
   DynamicHeapArray<u8, 16> m_hunk_buffer;
+  std::vector<HunkSlot> m_hunk_slots;
+  u32 m_slot_stride = 0;
+  u32 m_current_slot = INVALID_SLOT;
   u32 m_current_hunk_index = static_cast<u32>(-1);
+  u32 m_prefetch_count = 0;
+  u64 m_access_counter = 0;
+  ReadCacheStats m_cache_stats = {};
   bool m_precached = false;
 
+  mutable std::mutex m_hunk_cache_mutex;
+  std::condition_variable m_hunk_ready_cv;
+  std::condition_variable m_prefetch_cv;
+  std::deque<u32> m_prefetch_queue;
+  std::vector<std::thread> m_prefetch_threads;
+  bool m_prefetch_shutdown = false;
+
   CDSubChannelReplacement m_sbi;
 };
 } // namespace
@@ -99,6 +150,15 @@ CDImageCHD::CDImageCHD() = default;
 
 CDImageCHD::~CDImageCHD()
 {
+  StopPrefetchThreads();
+
+  if (m_cache_stats.hits > 0 || m_cache_stats.misses > 0)
+  {
+    Log_DevFmt("Hunk cache: {} hits, {} misses, {} prefetched, {} prefetch hits, {} prefetch waits",
+               m_cache_stats.hits, m_cache_stats.misses, m_cache_stats.prefetched, m_cache_stats.prefetch_hits,
+               m_cache_stats.prefetch_waits);
+  }
+
   if (m_chd)
     chd_close(m_chd);
 }
@@ -260,8 +320,10 @@ bool CDImageCHD::Open(const char* filename, Error* error)
     return false;
   }
 
+  m_hunk_count = header->totalhunks;
   m_sectors_per_hunk = m_hunk_size / CHD_CD_SECTOR_DATA_SIZE;
-  m_hunk_buffer.resize(m_hunk_size);
+  m_slot_stride = Common::AlignUpPow2(m_hunk_size, 16);
+  ResizeHunkCache(1);
   m_filename = filename;
 
   u32 disc_lba = 0;
@@ -468,7 +530,9 @@ CDImage::PrecacheResult CDImageCHD::Precache(ProgressCallback* progress)
   if (chd_precache_progress(m_chd, callback, progress) != CHDERR_NONE)
     return CDImage::PrecacheResult::ReadError;
 
+  // Everything is in memory now, the prefetch workers would only be going back to disk.
   m_precached = true;
+  SetReadCacheParameters(static_cast<u32>(m_hunk_slots.size()), 0);
   return CDImage::PrecacheResult::Success;
 }
 
@@ -555,23 +619,264 @@ ALWAYS_INLINE_RELEASE bool CDImageCHD::UpdateHunkBuffer(const Index& index, LBA
   hunk_offset = static_cast<u32>((disc_frame % m_sectors_per_hunk) * CHD_CD_SECTOR_DATA_SIZE);
   DebugAssert((m_hunk_size - hunk_offset) >= CHD_CD_SECTOR_DATA_SIZE);
 
-  if (m_current_hunk_index == hunk_index)
-    return true;
+  // The current slot is never evicted by the prefetch workers, so no lock is needed to read it.
+  if (m_current_hunk_index != hunk_index && !LookupHunk(hunk_index))
+    return false;
 
-  const chd_error err = chd_read(m_chd, hunk_index, m_hunk_buffer.data());
-  if (err != CHDERR_NONE)
+  // Offset is relative to the start of the cache buffer.
+  hunk_offset += m_current_slot * m_slot_stride;
+  return true;
+}
+
+const u8* CDImageCHD::LookupHunk(u32 hunk_index)
+{
+  std::unique_lock lock(m_hunk_cache_mutex);
+  const u32 last_hunk_index = m_current_hunk_index;
+
+  // If a worker is currently decompressing this hunk, it's going to be faster to wait for it than to start over.
+  u32 slot;
+  for (;;)
   {
-    Log_ErrorFmt("chd_read({}) failed: %s", hunk_index, chd_error_string(err));
+    slot = FindSlot(hunk_index);
+    if (slot == INVALID_SLOT || m_hunk_slots[slot].state == HunkState::Ready)
+      break;
 
-    // data might have been partially written
+    m_cache_stats.prefetch_waits++;
+    m_hunk_ready_cv.wait(lock);
+  }
+
+  if (slot != INVALID_SLOT)
+  {
+    HunkSlot& hs = m_hunk_slots[slot];
+    m_cache_stats.hits++;
+    if (hs.prefetched)
+    {
+      m_cache_stats.prefetch_hits++;
+      hs.prefetched = false;
+    }
+  }
+  else
+  {
+    m_cache_stats.misses++;
+
+    // Foreground can always evict the current slot, we're moving away from it.
+    slot = AllocateSlot(false);
+    DebugAssert(slot != INVALID_SLOT);
+    m_current_slot = INVALID_SLOT;
     m_current_hunk_index = static_cast<u32>(-1);
-    return false;
+
+    HunkSlot& hs = m_hunk_slots[slot];
+    hs.hunk_index = hunk_index;
+    hs.state = HunkState::Decoding;
+    hs.prefetched = false;
+
+    lock.unlock();
+    const chd_error err = chd_read(m_chd, hunk_index, GetSlotBuffer(slot));
+    lock.lock();
+
+    if (err != CHDERR_NONE)
+    {
+      Log_ErrorFmt("chd_read({}) failed: {}", hunk_index, chd_error_string(err));
+
+      // data might have been partially written
+      hs.state = HunkState::Empty;
+      return nullptr;
+    }
+
+    hs.state = HunkState::Ready;
   }
 
+  m_hunk_slots[slot].last_access = ++m_access_counter;
+  m_current_slot = slot;
   m_current_hunk_index = hunk_index;
+
+  // Only predict for sequential access, random seeks would just waste decompression time.
+  if (m_prefetch_count > 0 && hunk_index == (last_hunk_index + 1))
+    QueuePrefetch(hunk_index);
+
+  return GetSlotBuffer(slot);
+}
+
+u32 CDImageCHD::FindSlot(u32 hunk_index) const
+{
+  for (u32 i = 0; i < static_cast<u32>(m_hunk_slots.size()); i++)
+  {
+    const HunkSlot& hs = m_hunk_slots[i];
+    if (hs.hunk_index == hunk_index && hs.state != HunkState::Empty)
+      return i;
+  }
+
+  return INVALID_SLOT;
+}
+
+u32 CDImageCHD::AllocateSlot(bool for_prefetch)
+{
+  u32 lru_slot = INVALID_SLOT;
+  for (u32 i = 0; i < static_cast<u32>(m_hunk_slots.size()); i++)
+  {
+    const HunkSlot& hs = m_hunk_slots[i];
+    if (hs.state == HunkState::Empty)
+      return i;
+    else if (hs.state == HunkState::Decoding)
+      continue;
+
+    // Workers must not evict the hunk being read, or hunks which were prefetched and haven't been used yet.
+    if (for_prefetch && (i == m_current_slot || hs.prefetched))
+      continue;
+
+    if (lru_slot == INVALID_SLOT || hs.last_access < m_hunk_slots[lru_slot].last_access)
+      lru_slot = i;
+  }
+
+  return lru_slot;
+}
+
+void CDImageCHD::ResizeHunkCache(u32 cache_size)
+{
+  // Contents are discarded, so don't bother copying them.
+  m_hunk_buffer.deallocate();
+  m_hunk_buffer.resize(static_cast<size_t>(cache_size) * m_slot_stride);
+  m_hunk_slots.clear();
+  m_hunk_slots.resize(cache_size, HunkSlot{static_cast<u32>(-1), HunkState::Empty, false, 0});
+  m_current_slot = INVALID_SLOT;
+  m_current_hunk_index = static_cast<u32>(-1);
+  m_access_counter = 0;
+}
+
+void CDImageCHD::QueuePrefetch(u32 hunk_index)
+{
+  // Anything still queued is from an older prediction.
+  m_prefetch_queue.clear();
+
+  const u32 end_hunk_index = std::min(hunk_index + 1 + m_prefetch_count, m_hunk_count);
+  for (u32 i = hunk_index + 1; i < end_hunk_index; i++)
+  {
+    if (FindSlot(i) == INVALID_SLOT)
+      m_prefetch_queue.push_back(i);
+  }
+
+  if (!m_prefetch_queue.empty())
+    m_prefetch_cv.notify_all();
+}
+
+void CDImageCHD::SetReadCacheParameters(u32 cache_blocks, u32 prefetch_blocks)
+{
+  // Prefetch workers read through their own handles, which would bypass the precache.
+  if (m_precached)
+    prefetch_blocks = 0;
+
+  // Need room for the current hunk and each in-flight prefetch, otherwise the workers would just thrash the cache.
+  prefetch_blocks = std::min(prefetch_blocks, MAX_HUNK_CACHE_SIZE / 2);
+  const u32 num_threads = std::min(prefetch_blocks, MAX_PREFETCH_THREADS);
+  cache_blocks = std::clamp(cache_blocks, prefetch_blocks + num_threads + 1, MAX_HUNK_CACHE_SIZE);
+  if (cache_blocks == m_hunk_slots.size() && prefetch_blocks == m_prefetch_count)
+    return;
+
+  StopPrefetchThreads();
+
+  Log_DevFmt("Hunk cache size set to {} hunks ({} KB), prefetching {} hunks", cache_blocks,
+             (cache_blocks * m_slot_stride) / 1024, prefetch_blocks);
+  ResizeHunkCache(cache_blocks);
+  m_prefetch_count = prefetch_blocks;
+
+  if (prefetch_blocks > 0)
+    StartPrefetchThreads(num_threads);
+}
+
+bool CDImageCHD::GetReadCacheStats(ReadCacheStats* stats) const
+{
+  std::unique_lock lock(m_hunk_cache_mutex);
+  *stats = m_cache_stats;
   return true;
 }
 
+void CDImageCHD::StartPrefetchThreads(u32 count)
+{
+  m_prefetch_shutdown = false;
+  for (u32 i = 0; i < count; i++)
+    m_prefetch_threads.emplace_back(&CDImageCHD::PrefetchThreadEntryPoint, this);
+}
+
+void CDImageCHD::StopPrefetchThreads()
+{
+  if (m_prefetch_threads.empty())
+    return;
+
+  {
+    std::unique_lock lock(m_hunk_cache_mutex);
+    m_prefetch_shutdown = true;
+    m_prefetch_queue.clear();
+    m_prefetch_cv.notify_all();
+  }
+
+  for (std::thread& thread : m_prefetch_threads)
+    thread.join();
+  m_prefetch_threads.clear();
+}
+
+void CDImageCHD::PrefetchThreadEntryPoint()
+{
+  Threading::SetNameOfCurrentThread("CHD Prefetch");
+
+  // libchdr handles are not thread safe, so each worker decompresses through its own.
+  Error error;
+  auto fp = FileSystem::OpenManagedSharedCFile(m_filename.c_str(), "rb", FileSystem::FileShareMode::DenyWrite);
+  chd_file* chd = fp ? OpenCHD(m_filename, std::move(fp), &error, 0) : nullptr;
+  if (!chd)
+  {
+    Log_ErrorFmt("Failed to open CHD for prefetching: {}", error.GetDescription());
+    return;
+  }
+
+  std::unique_lock lock(m_hunk_cache_mutex);
+  for (;;)
+  {
+    m_prefetch_cv.wait(lock, [this]() { return (m_prefetch_shutdown || !m_prefetch_queue.empty()); });
+    if (m_prefetch_shutdown)
+      break;
+
+    const u32 hunk_index = m_prefetch_queue.front();
+    m_prefetch_queue.pop_front();
+    if (FindSlot(hunk_index) != INVALID_SLOT)
+      continue;
+
+    // If everything is in use or still waiting to be read, there's no point decompressing any further ahead.
+    const u32 slot = AllocateSlot(true);
+    if (slot == INVALID_SLOT)
+    {
+      m_prefetch_queue.clear();
+      continue;
+    }
+
+    HunkSlot& hs = m_hunk_slots[slot];
+    hs.hunk_index = hunk_index;
+    hs.state = HunkState::Decoding;
+    hs.prefetched = true;
+
+    lock.unlock();
+    const chd_error err = chd_read(chd, hunk_index, GetSlotBuffer(slot));
+    lock.lock();
+
+    if (err != CHDERR_NONE)
+    {
+      Log_ErrorFmt("Prefetch chd_read({}) failed: {}", hunk_index, chd_error_string(err));
+      hs.state = HunkState::Empty;
+      hs.prefetched = false;
+    }
+    else
+    {
+      hs.state = HunkState::Ready;
+      hs.last_access = ++m_access_counter;
+      m_cache_stats.prefetched++;
+    }
+
+    m_hunk_ready_cv.notify_all();
+  }
+
+  lock.unlock();
+  chd_close(chd);
+}
+
 s64 CDImageCHD::GetSizeOnDisk() const
 {
   return static_cast<s64>(chd_get_compressed_size(m_chd));
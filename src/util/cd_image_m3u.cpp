@@ -36,6 +36,9 @@ public:
   std::string GetSubImageMetadata(u32 index, const std::string_view& type) const override;
   bool SwitchSubImage(u32 index, Error* error) override;
 
+  void SetReadCacheParameters(u32 cache_blocks, u32 prefetch_blocks) override;
+  bool GetReadCacheStats(ReadCacheStats* stats) const override;
+
 protected:
   bool ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index) override;
 
@@ -50,6 +53,8 @@ private:
   std::vector<Entry> m_entries;
   std::unique_ptr<CDImage> m_current_image;
   u32 m_current_image_index = UINT32_C(0xFFFFFFFF);
+  u32 m_read_cache_blocks = 0;
+  u32 m_read_cache_prefetch_blocks = 0;
   bool m_apply_patches = false;
 };
 
@@ -149,6 +154,9 @@ bool CDImageM3u::SwitchSubImage(u32 index, Error* error)
     return false;
   }
 
+  if (m_read_cache_blocks > 0)
+    new_image->SetReadCacheParameters(m_read_cache_blocks, m_read_cache_prefetch_blocks);
+
   CopyTOC(new_image.get());
   m_current_image = std::move(new_image);
   m_current_image_index = index;
@@ -171,6 +179,19 @@ std::string CDImageM3u::GetSubImageMetadata(u32 index, const std::string_view& t
   return CDImage::GetSubImageMetadata(index, type);
 }
 
+void CDImageM3u::SetReadCacheParameters(u32 cache_blocks, u32 prefetch_blocks)
+{
+  // Remember them for when the sub-image changes.
+  m_read_cache_blocks = cache_blocks;
+  m_read_cache_prefetch_blocks = prefetch_blocks;
+  m_current_image->SetReadCacheParameters(cache_blocks, prefetch_blocks);
+}
+
+bool CDImageM3u::GetReadCacheStats(ReadCacheStats* stats) const
+{
+  return m_current_image->GetReadCacheStats(stats);
+}
+
 bool CDImageM3u::ReadSectorFromIndex(void* buffer, const Index& index, LBA lba_in_index)
 {
   return m_current_image->ReadSectorFromIndex(buffer, index, lba_in_index);
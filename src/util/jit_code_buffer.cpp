@@ -85,11 +85,13 @@ bool JitCodeBuffer::Allocate(u32 size /* = 64 * 1024 * 1024 */, u32 far_code_siz
   m_free_code_ptr = m_code_ptr;
   m_code_size = size;
   m_code_used = 0;
+  m_code_limit = size;
 
   m_far_code_ptr = static_cast<u8*>(m_code_ptr) + size;
   m_free_far_code_ptr = m_far_code_ptr;
   m_far_code_size = far_code_size;
   m_far_code_used = 0;
+  m_far_code_limit = far_code_size;
 
   m_old_protection = 0;
   m_owns_buffer = true;
@@ -212,11 +214,13 @@ bool JitCodeBuffer::Initialize(void* buffer, u32 size, u32 far_code_size /* = 0
   m_free_code_ptr = m_code_ptr + guard_size;
   m_code_size = size - far_code_size - (guard_size * 2);
   m_code_used = 0;
+  m_code_limit = m_code_size;
 
   m_far_code_ptr = static_cast<u8*>(m_code_ptr) + m_code_size;
   m_free_far_code_ptr = m_far_code_ptr;
   m_far_code_size = far_code_size - guard_size;
   m_far_code_used = 0;
+  m_far_code_limit = m_far_code_size;
 
   m_guard_size = guard_size;
   m_owns_buffer = false;
@@ -251,11 +255,13 @@ void JitCodeBuffer::Destroy()
   m_free_code_ptr = nullptr;
   m_code_size = 0;
   m_code_reserve_size = 0;
+  m_code_limit = 0;
   m_code_used = 0;
   m_far_code_ptr = nullptr;
   m_free_far_code_ptr = nullptr;
   m_far_code_size = 0;
   m_far_code_used = 0;
+  m_far_code_limit = 0;
   m_total_size = 0;
   m_guard_size = 0;
   m_old_protection = 0;
@@ -270,6 +276,7 @@ void JitCodeBuffer::ReserveCode(u32 size)
   m_code_reserve_size += size;
   m_free_code_ptr += size;
   m_code_size -= size;
+  m_code_limit = m_code_size;
 }
 
 void JitCodeBuffer::CommitCode(u32 length)
@@ -282,7 +289,7 @@ void JitCodeBuffer::CommitCode(u32 length)
   FlushInstructionCache(m_free_code_ptr, length);
 #endif
 
-  Assert(length <= (m_code_size - m_code_used));
+  Assert(length <= (m_code_limit - m_code_used));
   m_free_code_ptr += length;
   m_code_used += length;
 }
@@ -297,7 +304,7 @@ void JitCodeBuffer::CommitFarCode(u32 length)
   FlushInstructionCache(m_free_far_code_ptr, length);
 #endif
 
-  Assert(length <= (m_far_code_size - m_far_code_used));
+  Assert(length <= (m_far_code_limit - m_far_code_used));
   m_free_far_code_ptr += length;
   m_far_code_used += length;
 }
@@ -308,6 +315,7 @@ void JitCodeBuffer::Reset()
 
   m_free_code_ptr = m_code_ptr + m_guard_size + m_code_reserve_size;
   m_code_used = 0;
+  m_code_limit = m_code_size;
   std::memset(m_free_code_ptr, 0, m_code_size);
   FlushInstructionCache(m_free_code_ptr, m_code_size);
 
@@ -315,6 +323,7 @@ void JitCodeBuffer::Reset()
   {
     m_free_far_code_ptr = m_far_code_ptr;
     m_far_code_used = 0;
+    m_far_code_limit = m_far_code_size;
     std::memset(m_free_far_code_ptr, 0, m_far_code_size);
     FlushInstructionCache(m_free_far_code_ptr, m_far_code_size);
   }
@@ -322,6 +331,20 @@ void JitCodeBuffer::Reset()
   MemMap::EndCodeWrite();
 }
 
+void JitCodeBuffer::SetAllocationRange(u32 code_start, u32 code_end, u32 far_code_start, u32 far_code_end)
+{
+  Assert(code_start <= code_end && code_end <= m_code_size);
+  Assert(far_code_start <= far_code_end && far_code_end <= m_far_code_size);
+
+  m_free_code_ptr = m_code_ptr + m_guard_size + m_code_reserve_size + code_start;
+  m_code_used = code_start;
+  m_code_limit = code_end;
+
+  m_free_far_code_ptr = m_far_code_ptr + far_code_start;
+  m_far_code_used = far_code_start;
+  m_far_code_limit = far_code_end;
+}
+
 void JitCodeBuffer::Align(u32 alignment, u8 padding_value)
 {
   DebugAssert(Common::IsPow2(alignment));
@@ -31,15 +31,24 @@ public:
   }
   ALWAYS_INLINE u32 GetTotalUsed() const { return m_code_used + m_far_code_used; }
 
+  ALWAYS_INLINE u32 GetCodeSize() const { return m_code_size; }
+  ALWAYS_INLINE u32 GetCodeUsed() const { return m_code_used; }
   ALWAYS_INLINE u8* GetFreeCodePointer() const { return m_free_code_ptr; }
-  ALWAYS_INLINE u32 GetFreeCodeSpace() const { return static_cast<u32>(m_code_size - m_code_used); }
+  ALWAYS_INLINE u32 GetFreeCodeSpace() const { return static_cast<u32>(m_code_limit - m_code_used); }
   void ReserveCode(u32 size);
   void CommitCode(u32 length);
 
+  ALWAYS_INLINE u32 GetFarCodeSize() const { return m_far_code_size; }
+  ALWAYS_INLINE u32 GetFarCodeUsed() const { return m_far_code_used; }
   ALWAYS_INLINE u8* GetFreeFarCodePointer() const { return m_free_far_code_ptr; }
-  ALWAYS_INLINE u32 GetFreeFarCodeSpace() const { return static_cast<u32>(m_far_code_size - m_far_code_used); }
+  ALWAYS_INLINE u32 GetFreeFarCodeSpace() const { return static_cast<u32>(m_far_code_limit - m_far_code_used); }
   void CommitFarCode(u32 length);
 
+  /// Moves the free code pointers to the start of the specified ranges, and prevents allocations past their ends.
+  /// Offsets are relative to the start of the near/far code areas, excluding reserved code. Existing code in the
+  /// ranges is not cleared, the caller is responsible for making sure it is no longer referenced.
+  void SetAllocationRange(u32 code_start, u32 code_end, u32 far_code_start, u32 far_code_end);
+
   /// Adjusts the free code pointer to the specified alignment, padding with bytes.
   /// Assumes alignment is a power-of-two.
   void Align(u32 alignment, u8 padding_value);
@@ -55,11 +64,13 @@ private:
   u32 m_code_size = 0;
   u32 m_code_reserve_size = 0;
   u32 m_code_used = 0;
+  u32 m_code_limit = 0;
 
   u8* m_far_code_ptr = nullptr;
   u8* m_free_far_code_ptr = nullptr;
   u32 m_far_code_size = 0;
   u32 m_far_code_used = 0;
+  u32 m_far_code_limit = 0;
 
   u32 m_total_size = 0;
   u32 m_guard_size = 0;